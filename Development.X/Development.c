@@ -25,7 +25,7 @@ int main(void){
  *
  * Fires once every millisecond.
  */
-void __attribute__((vector(_TIMER_2_VECTOR), interrupt(IPL6SRS))) timer2_inthnd(void) {
+void ISR(_TIMER_2_VECTOR, IPL6SRS) timer2_inthnd(void) {
   //millis++;// Increment millis count
   //if (!(millis%250)){
   //    PIC_LED_LAT = !PIC_LED_LAT;
@@ -26,6 +26,30 @@
 #define TIRE_TEMP_RL_ID 0x003
 #define TIRE_TEMP_RR_ID 0x004
 
+// Added to a node's ID for its CAN health message, see CAN_health_init()
+#define HEALTH_ID_OFFSET 0x00E
+
+// Added to a node's ID for ISO-TP requests to it and its responses, see FSAE_isotp.h
+#define ISOTP_REQ_OFFSET  0x00C
+#define ISOTP_RESP_OFFSET 0x00D
+
+/**
+ * ISO-TP service codes, the first byte of a request
+ */
+#define NVM_READ_REQ  0x01 // [code, addr (4), len (4)] -> [status, data...]
+#define NVM_WRITE_REQ 0x02 // [code, addr (4), data...] -> [status]
+#define NVM_REQ_HDR   5    // Bytes before the data of a write request
+#define NVM_WRITE_MAX 4096 // Most data in one write request
+#define BAD_REQ_REPLY 0xFF // Status replied to an unknown or malformed request
+
+// Firmware updates, see FSAE_boot.h. Values are big-endian, as above.
+#define BOOT_BEGIN_REQ  0x10 // [code, size (4), crc (4)] -> [status]
+#define BOOT_BLOCK_REQ  0x11 // [code, offset (4), crc (4), data...] -> [status]
+#define BOOT_COMMIT_REQ 0x12 // [code] -> [status], then the node restarts
+#define BOOT_STATUS_REQ 0x13 // [code] -> [status, seq (4), size (4), crc (4)]
+#define BOOT_REQ_HDR    9    // Bytes before the data of a block request
+#define BOOT_BLOCK_MAX  2048 // Most data in one block request, one flash row
+
 /**
  * Byte position of channels in their CAN messages
  */
@@ -39,6 +63,14 @@
 #define ORIGIN_BYTE         0
 #define ERRNO_BYTE          2
 
+// From CAN Health Message
+#define TEC_BYTE            0
+#define REC_BYTE            1
+#define CAN_STATE_BYTE      2 // Bits 0-1 state, bits 2-7 bus-off count
+#define CAN_ERRORS_BYTE     3
+#define CAN_RX_FRAMES_BYTE  4
+#define CAN_TX_FRAMES_BYTE  6
+
 // From Rear AnalogHub
 #define SPRL_BYTE           0
 #define SPRR_BYTE           2
@@ -22,6 +22,7 @@ SPIConn* init_ad7490(uint8_t bus, uint32_t *cs_lat, uint8_t cs_num) {
 
   SPIConn * currConn = &ad7490connections[ad7490ConnIdx];
   currConn->send_fp = get_send_spi(bus);
+  currConn->bus = bus;
   currConn->cs_lat = cs_lat;
   currConn->cs_num = cs_num;
 
@@ -32,5 +32,6 @@
 
 // Function definitions
 void init_adc(void (*specific_init)(void));
+uint32_t read_adc_chn(uint8_t chn);
 
 #endif /* FSAE_adc_H */
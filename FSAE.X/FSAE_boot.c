@@ -0,0 +1,362 @@
+/**
+ * FSAE Library Bootloader
+ *
+ * Processor:   PIC32MZ2048EFM100
+ * Compiler:    Microchip XC32
+ * Created:     2026
+ */
+#include "FSAE_boot.h"
+
+// Image being received into the upper panel, none while <BOOT_size> is 0
+static uint32_t BOOT_size = 0;
+static uint32_t BOOT_crc = 0;
+static uint32_t BOOT_written = 0;
+
+// Set once an image is committed, to restart after the reply is sent
+static uint8_t BOOT_committed = 0;
+static uint32_t BOOT_commit_tmr = 0;
+
+static uint8_t BOOT_reply[13];
+
+// Check that the car is parked before an update begins or commits, if any
+static BOOT_guard BOOT_parked = NULL;
+
+// Source of row programming, which the NVM controller reads from physical
+// memory, so it must not sit in a dirty cache line
+static uint8_t BOOT_row[BOOT_ROW_SIZE] COHERENT __attribute__((aligned(16)));
+
+/**
+ * uint32_t BOOT_get32(const uint8_t* data)
+ *
+ * @returns The big-endian word at <data>
+ */
+static uint32_t BOOT_get32(const uint8_t* data) {
+  return ((uint32_t) data[0] << 24) | ((uint32_t) data[1] << 16) |
+    ((uint32_t) data[2] << 8) | data[3];
+}
+
+/**
+ * void BOOT_put32(uint8_t* data, uint32_t value)
+ *
+ * Stores <value> big-endian at <data>.
+ */
+static void BOOT_put32(uint8_t* data, uint32_t value) {
+  data[0] = value >> 24;
+  data[1] = (value >> 16) & 0xFF;
+  data[2] = (value >> 8) & 0xFF;
+  data[3] = value & 0xFF;
+}
+
+/**
+ * const uint8_t* BOOT_flash(uint32_t addr)
+ *
+ * @returns Uncached access to flash at physical address <addr>, so reads see
+ *     what was just programmed
+ */
+static const uint8_t* BOOT_flash(uint32_t addr) {
+  return (const uint8_t*) PA_TO_KVA1(addr);
+}
+
+/**
+ * uint8_t BOOT_flash_op(uint32_t op, uint32_t addr)
+ *
+ * Runs one NVM controller operation on the flash at physical address <addr>
+ * and waits for it to finish.
+ *
+ * @returns BOOT_SUCCESS or BOOT_ERR_FLASH
+ */
+static uint8_t BOOT_flash_op(uint32_t op, uint32_t addr) {
+  uint32_t status;
+
+  NVMADDR = addr;
+  NVMCONCLR = _NVMCON_NVMOP_MASK;
+  NVMCONSET = _NVMCON_WREN_MASK | op; // Write Enable, NVM Operation
+
+  // The unlock sequence must not be interrupted
+  CLI_SAVE(status);
+  NVMKEY = 0;
+  NVMKEY = 0xAA996655;
+  NVMKEY = 0x556699AA;
+  NVMCONSET = _NVMCON_WR_MASK; // Start the operation
+  STI_RESTORE(status);
+
+  while (NVMCON & _NVMCON_WR_MASK);
+  NVMCONCLR = _NVMCON_WREN_MASK;
+
+  if (NVMCON & (_NVMCON_WRERR_MASK | _NVMCON_LVDERR_MASK)) {
+    return BOOT_ERR_FLASH;
+  }
+  return BOOT_SUCCESS;
+}
+
+/**
+ * uint8_t BOOT_program(uint32_t addr, const uint8_t* data, uint32_t len)
+ *
+ * Programs <len> bytes at physical address <addr>, a whole row at once or
+ * else by quad words, padding the last one with erased bytes.
+ *
+ * @returns BOOT_SUCCESS or BOOT_ERR_FLASH
+ */
+static uint8_t BOOT_program(uint32_t addr, const uint8_t* data, uint32_t len) {
+  uint8_t quad[BOOT_QUAD_SIZE];
+  uint32_t pos;
+
+  if (len == BOOT_ROW_SIZE) {
+    memcpy(BOOT_row, data, BOOT_ROW_SIZE);
+    NVMSRCADDR = KVA_TO_PA(BOOT_row);
+    return BOOT_flash_op(_BOOT_OP_ROW, addr);
+  }
+
+  for (pos = 0; pos < len; pos += BOOT_QUAD_SIZE) {
+    uint32_t size = len - pos < BOOT_QUAD_SIZE ? len - pos : BOOT_QUAD_SIZE;
+    memset(quad, 0xFF, BOOT_QUAD_SIZE);
+    memcpy(quad, data + pos, size);
+    NVMDATA0 = quad[0] | (quad[1] << 8) | (quad[2] << 16) | ((uint32_t) quad[3] << 24);
+    NVMDATA1 = quad[4] | (quad[5] << 8) | (quad[6] << 16) | ((uint32_t) quad[7] << 24);
+    NVMDATA2 = quad[8] | (quad[9] << 8) | (quad[10] << 16) | ((uint32_t) quad[11] << 24);
+    NVMDATA3 = quad[12] | (quad[13] << 8) | (quad[14] << 16) | ((uint32_t) quad[15] << 24);
+    if (BOOT_flash_op(_BOOT_OP_QUAD, addr + pos) != BOOT_SUCCESS) {
+      return BOOT_ERR_FLASH;
+    }
+  }
+  return BOOT_SUCCESS;
+}
+
+/**
+ * const BOOT_trailer* BOOT_trailer_at(uint32_t panel)
+ *
+ * @returns The trailer of the panel at physical address <panel>, or NULL if
+ *     the panel holds no complete image
+ */
+static const BOOT_trailer* BOOT_trailer_at(uint32_t panel) {
+  const BOOT_trailer* trailer = (const BOOT_trailer*) BOOT_flash(panel + BOOT_IMAGE_MAX);
+  if (trailer->magic != BOOT_MAGIC || trailer->size > BOOT_IMAGE_MAX) {
+    return NULL;
+  }
+  return trailer;
+}
+
+/**
+ * void BOOT_swap_restart(void)
+ *
+ * Swaps the flash panels and runs the startup code again, which sets the
+ * caches up afresh so nothing of the old panel is left in them. Runs from
+ * RAM, since the code at any flash address changes under it as the panels
+ * swap. A reset would clear PFSWAP and undo the swap.
+ */
+static RAMFUNC void BOOT_swap_restart(void) {
+  uint32_t swapped = NVMCON & _NVMCON_PFSWAP_MASK;
+
+  CLI();
+  NVMKEY = 0;
+  NVMKEY = 0xAA996655;
+  NVMKEY = 0x556699AA;
+  if (swapped) {
+    NVMCONCLR = _NVMCON_PFSWAP_MASK;
+  } else {
+    NVMCONSET = _NVMCON_PFSWAP_MASK;
+  }
+
+  BOOT_RESTART();
+  while (1);
+}
+
+/**
+ * void BOOT_reset(void)
+ *
+ * Performs a software reset.
+ */
+static void BOOT_reset(void) {
+  unlock_config();
+  RSWRSTSET = 1;
+  uint32_t dummy = RSWRST;
+  (void) dummy;
+  while (1);
+}
+
+/**
+ * void BOOT_select(void)
+ *
+ * Swaps the flash panels and starts again if the upper panel holds a complete
+ * image newer than the running one whose CRC32 still matches. Call first
+ * thing in main(), before any peripheral is set up. After every reset, the
+ * panels are unswapped and this swaps them again.
+ */
+void BOOT_select(void) {
+  const BOOT_trailer* lower = BOOT_trailer_at(BOOT_LOWER);
+  const BOOT_trailer* upper = BOOT_trailer_at(BOOT_UPPER);
+
+  if (upper == NULL || (lower != NULL && upper->seq <= lower->seq)) {
+    return;
+  }
+  if (crc32(0, BOOT_flash(BOOT_UPPER), upper->size) != upper->crc) {
+    return;
+  }
+  BOOT_swap_restart();
+}
+
+/**
+ * void BOOT_set_guard(BOOT_guard parked)
+ *
+ * Makes begin and commit requests fail with BOOT_ERR_PARKED unless <parked>
+ * returns nonzero, so an update cannot stall the node or restart it while the
+ * car is running. NULL allows them at any time, as before a guard is set.
+ */
+void BOOT_set_guard(BOOT_guard parked) {
+  BOOT_parked = parked;
+}
+
+/**
+ * uint8_t BOOT_begin(uint32_t size, uint32_t crc)
+ *
+ * Starts receiving an image. Erases the upper panel's trailer first, so it is
+ * never taken for a complete image until this one is committed.
+ */
+static uint8_t BOOT_begin(uint32_t size, uint32_t crc) {
+  if (size == 0 || size > BOOT_IMAGE_MAX) {
+    return BOOT_ERR_SIZE;
+  }
+  BOOT_size = 0;
+  if (BOOT_flash_op(_BOOT_OP_PAGE, BOOT_UPPER + BOOT_IMAGE_MAX) != BOOT_SUCCESS) {
+    return BOOT_ERR_FLASH;
+  }
+  BOOT_size = size;
+  BOOT_crc = crc;
+  BOOT_written = 0;
+  return BOOT_SUCCESS;
+}
+
+/**
+ * uint8_t BOOT_block(uint32_t offset, uint32_t crc, const uint8_t* data, uint32_t len)
+ *
+ * Programs one block of the image. Blocks are whole rows, except the last,
+ * and come in order. A block sent again because its reply was lost is
+ * accepted if flash already holds it.
+ */
+static uint8_t BOOT_block(uint32_t offset, uint32_t crc, const uint8_t* data, uint32_t len) {
+  uint8_t result;
+
+  if (BOOT_size == 0) {
+    return BOOT_ERR_ORDER;
+  }
+  if (crc32(0, data, len) != crc) {
+    return BOOT_ERR_CRC;
+  }
+  if (offset > BOOT_size || len > BOOT_size - offset) {
+    return BOOT_ERR_SIZE;
+  }
+  if (offset + len <= BOOT_written) {
+    if (crc32(0, BOOT_flash(BOOT_UPPER + offset), len) != crc) {
+      return BOOT_ERR_ORDER;
+    }
+    return BOOT_SUCCESS;
+  }
+  if (offset != BOOT_written || (len != BOOT_ROW_SIZE && offset + len != BOOT_size)) {
+    return BOOT_ERR_ORDER;
+  }
+
+  if (offset % BOOT_PAGE_SIZE == 0) {
+    result = BOOT_flash_op(_BOOT_OP_PAGE, BOOT_UPPER + offset);
+    if (result != BOOT_SUCCESS) {
+      return result;
+    }
+  }
+  result = BOOT_program(BOOT_UPPER + offset, data, len);
+  if (result != BOOT_SUCCESS) {
+    return result;
+  }
+  if (crc32(0, BOOT_flash(BOOT_UPPER + offset), len) != crc) {
+    return BOOT_ERR_VERIFY;
+  }
+  BOOT_written += len;
+  return BOOT_SUCCESS;
+}
+
+/**
+ * uint8_t BOOT_commit(void)
+ *
+ * Checks the whole image against the CRC32 it began with and writes the
+ * upper panel's trailer, which BOOT_select() looks for after the restart.
+ */
+static uint8_t BOOT_commit(void) {
+  const BOOT_trailer* lower = BOOT_trailer_at(BOOT_LOWER);
+  BOOT_trailer trailer;
+  uint8_t result;
+
+  if (BOOT_size == 0 || BOOT_written != BOOT_size) {
+    return BOOT_ERR_SIZE;
+  }
+  if (crc32(0, BOOT_flash(BOOT_UPPER), BOOT_size) != BOOT_crc) {
+    return BOOT_ERR_CRC;
+  }
+
+  trailer.magic = BOOT_MAGIC;
+  trailer.seq = (lower != NULL ? lower->seq : 0) + 1;
+  trailer.size = BOOT_size;
+  trailer.crc = BOOT_crc;
+  result = BOOT_program(BOOT_UPPER + BOOT_IMAGE_MAX, (const uint8_t*) &trailer,
+      sizeof(trailer));
+  if (result != BOOT_SUCCESS) {
+    return result;
+  }
+  if (memcmp(BOOT_flash(BOOT_UPPER + BOOT_IMAGE_MAX), &trailer, sizeof(trailer)) != 0) {
+    return BOOT_ERR_VERIFY;
+  }
+
+  BOOT_size = 0;
+  BOOT_committed = 1;
+  BOOT_commit_tmr = millis;
+  return BOOT_SUCCESS;
+}
+
+/**
+ * void BOOT_request(ISOTP_link* link, uint8_t* data, uint32_t len)
+ *
+ * Runs a firmware update request received on <link> and replies on it. Any
+ * other request gets BAD_REQ_REPLY. Can be a link's receive handler, or be
+ * called from one for the requests it doesn't handle itself.
+ *
+ * @param data The request, see BOOT_BEGIN_REQ and the codes after it
+ */
+void BOOT_request(ISOTP_link* link, uint8_t* data, uint32_t len) {
+  const BOOT_trailer* running;
+  uint32_t reply_len = 1;
+  uint8_t status = BAD_REQ_REPLY;
+
+  if (((len == BOOT_REQ_HDR && data[0] == BOOT_BEGIN_REQ) ||
+      (len == 1 && data[0] == BOOT_COMMIT_REQ)) && BOOT_parked != NULL && !BOOT_parked()) {
+    status = BOOT_ERR_PARKED;
+  } else if (len == BOOT_REQ_HDR && data[0] == BOOT_BEGIN_REQ) {
+    status = BOOT_begin(BOOT_get32(&data[1]), BOOT_get32(&data[5]));
+  } else if (len > BOOT_REQ_HDR && len <= BOOT_REQ_HDR + BOOT_BLOCK_MAX &&
+      data[0] == BOOT_BLOCK_REQ) {
+    status = BOOT_block(BOOT_get32(&data[1]), BOOT_get32(&data[5]),
+        &data[BOOT_REQ_HDR], len - BOOT_REQ_HDR);
+  } else if (len == 1 && data[0] == BOOT_COMMIT_REQ) {
+    status = BOOT_commit();
+  } else if (len == 1 && data[0] == BOOT_STATUS_REQ) {
+    running = BOOT_trailer_at(BOOT_LOWER);
+    status = BOOT_SUCCESS;
+    BOOT_put32(&BOOT_reply[1], running != NULL ? running->seq : 0);
+    BOOT_put32(&BOOT_reply[5], running != NULL ? running->size : 0);
+    BOOT_put32(&BOOT_reply[9], running != NULL ? running->crc : 0);
+    reply_len = 13;
+  }
+
+  BOOT_reply[0] = status;
+  ISOTP_send(link, BOOT_reply, reply_len);
+}
+
+/**
+ * void BOOT_service(ISOTP_link* link)
+ *
+ * Restarts the node once an image has been committed and the reply to the
+ * commit request has had time to reach the bus. Call from the main loop after
+ * ISOTP_service().
+ */
+void BOOT_service(ISOTP_link* link) {
+  if (BOOT_committed && link->tx_state == ISOTP_IDLE &&
+      millis - BOOT_commit_tmr >= BOOT_RESET_MS) {
+    BOOT_reset();
+  }
+}
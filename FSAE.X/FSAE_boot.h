@@ -0,0 +1,96 @@
+/**
+ * FSAE Library Bootloader Header
+ *
+ * Processor:   PIC32MZ2048EFM100
+ * Compiler:    Microchip XC32
+ * Created:     2026
+ */
+#ifndef FSAE_BOOT_H
+#define FSAE_BOOT_H
+
+#include <xc.h>
+#include <sys/kmem.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include "CAN.h"
+#include "FSAE_config.h"
+#include "FSAE_crc.h"
+#include "FSAE_isotp.h"
+
+/**
+ * Firmware updates over CAN
+ *
+ * The program flash is two panels of BOOT_PANEL_SIZE. The running image is
+ * always in the lower one, and a new image is written to the upper one over
+ * ISO-TP while the node keeps running. Each block carries a CRC32, which is
+ * checked before it is programmed and again after reading it back from flash.
+ *
+ * Nothing changes until the commit request. The node then checks the CRC32
+ * of the whole image given at the start and only writes the trailer that
+ * marks the panel as holding a good image once it matches, then resets.
+ * BOOT_select(), the first thing each node's main() calls, swaps the panels
+ * when the upper one holds a good image newer than the lower one and runs the
+ * startup code again. Every reset clears PFSWAP, so it swaps them again on
+ * each start rather than resetting, which would only unswap them. The old
+ * image stays in the upper panel until the next update starts, which erases
+ * its trailer first, so an update cut off part way leaves the node on the
+ * image it was running.
+ *
+ * Images are raw program flash contents linked at BOOT_LOWER, of at most
+ * BOOT_IMAGE_MAX bytes so the last page stays free for the trailer. The node
+ * blocks while it erases a page or programs a row, a few milliseconds each,
+ * so updates are meant for a parked car. A node can pass BOOT_set_guard() a
+ * check that the car is parked, and begin and commit requests are refused
+ * with BOOT_ERR_PARKED while it fails.
+ */
+#define BOOT_LOWER      0x1D000000 // Physical address of the lower panel
+#define BOOT_UPPER      0x1D100000
+#define BOOT_PANEL_SIZE 0x100000
+#define BOOT_PAGE_SIZE  0x4000     // Erase unit
+#define BOOT_ROW_SIZE   0x800      // Row program unit, BOOT_BLOCK_MAX
+#define BOOT_QUAD_SIZE  16         // Quad word program unit
+#define BOOT_IMAGE_MAX  (BOOT_PANEL_SIZE - BOOT_PAGE_SIZE)
+#define BOOT_MAGIC      0x45415346 // "FSAE"
+#define BOOT_RESET_MS   50         // Time for the commit reply to reach the bus
+#define BOOT_RESET_VEC  0xBFC00000 // Start of the startup code, uncached
+
+// NVM controller operations
+#define _BOOT_OP_QUAD 0x2
+#define _BOOT_OP_ROW  0x3
+#define _BOOT_OP_PAGE 0x4
+
+// Request results, the status byte of each reply
+#define BOOT_SUCCESS    0
+#define BOOT_ERR_SIZE   1 // Image too large, or commit before every block
+#define BOOT_ERR_ORDER  2 // Block out of order or without a begin request
+#define BOOT_ERR_CRC    3 // Block or image does not match its CRC32
+#define BOOT_ERR_FLASH  4 // The NVM controller reported an error
+#define BOOT_ERR_VERIFY 5 // Flash reads back different from what was written
+#define BOOT_ERR_PARKED 6 // The node's guard says the car is not parked
+
+// Runs the startup code again without a reset, which would clear PFSWAP. The
+// host backend runs the node again in the same process.
+#ifdef FSAE_HOST
+#define BOOT_RESTART() host_restart()
+#else
+#define BOOT_RESTART() ((void (*)(void)) BOOT_RESET_VEC)()
+#endif
+
+// Marks a panel as holding a complete image, at the start of its last page
+typedef struct {
+  uint32_t magic;
+  uint32_t seq;  // One more than the image it replaced
+  uint32_t size;
+  uint32_t crc;
+} BOOT_trailer;
+
+// Whether it is safe to begin or commit an update, see BOOT_set_guard()
+typedef uint8_t (*BOOT_guard)(void);
+
+// Function definitions
+void BOOT_select(void);
+void BOOT_set_guard(BOOT_guard parked);
+void BOOT_request(ISOTP_link* link, uint8_t* data, uint32_t len);
+void BOOT_service(ISOTP_link* link);
+
+#endif /* FSAE_BOOT_H */
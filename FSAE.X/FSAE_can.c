@@ -15,98 +15,1253 @@
  * (16 bytes) 2 for the CAN message data and 2 for a timestamp. Note that on a
  * PIC32 an int is 1 word (4 bytes).
  *
- * Here, we allocate 256 words, enough for 32 message buffers in two FIFOs.
+ * Here, we allocate 256 words. 224 are used: 32 message buffers in the receive
+ * FIFO, CAN_TX_HW_DEPTH in each of the two transmit FIFOs and 16 in the
+ * critical receive FIFO.
  */
 static volatile uint32_t CAN_FIFO_Buffers[256];
 
+// Depth of the receive FIFOs and where they start in CAN_FIFO_Buffers
+#define CAN_RX_FIFO_SIZE   32
+#define CAN_CRIT_FIFO_SIZE 16
+#define CAN_RX_FIFO_WORD   0
+#define CAN_CRIT_FIFO_WORD ((CAN_RX_FIFO_SIZE + 2 * CAN_TX_HW_DEPTH) * 4)
+
 // Used to count the number of receive and transmit buffer overflows
 volatile uint32_t CAN_rx_ovf = 0;
 volatile uint32_t CAN_tx_ovf = 0;
 
+// Software transmit queue, a binary heap ordered by CAN_tx_before()
+static CAN_tx_entry CAN_tx_queue[CAN_TX_QUEUE_SIZE];
+static uint32_t CAN_tx_len = 0;
+static uint32_t CAN_tx_seq = 0;
+
+// Lowest key loaded into TX FIFO 2 since it was last empty
+static uint32_t CAN_tx_fifo2_min = UINT32_MAX;
+
+// Number of frames of each ID dropped from the full transmit queue
+volatile uint16_t CAN_tx_drops[CAN_SID_COUNT] = {0};
+
+// Receive handler for each ID and which IDs are critical, see CAN_subscribe()
+static CAN_handler CAN_handlers[CAN_SID_COUNT] = {NULL};
+static uint32_t CAN_critical[CAN_SID_COUNT / 32] = {0};
+
+// Extended ID subscriptions, see CAN_subscribe_ext()
+typedef struct {
+  uint32_t id;
+  uint32_t mask;
+  CAN_handler handler;
+  uint8_t critical;
+} CAN_ext_sub;
+static CAN_ext_sub CAN_ext_subs[CAN_EXT_SUBS];
+static uint32_t CAN_ext_len = 0;
+
+// Receives every frame before it is dispatched, see CAN_set_rx_log()
+static CAN_handler CAN_rx_log = NULL;
+
+// Timestamp timer count minus the low 16 bits of millis in microseconds
+static uint16_t CAN_ts_phase = 0;
+
+// Frames and bytes moved since the last health interval, see CAN_health_service()
+static volatile uint32_t CAN_rx_frames = 0;
+static volatile uint32_t CAN_rx_bytes = 0;
+static volatile uint32_t CAN_tx_frames = 0;
+static volatile uint32_t CAN_tx_bytes = 0;
+
+// Error counts and bus-off recovery, see CAN_health_service()
+#define CAN_RECOVERY_NONE  0 // Online
+#define CAN_RECOVERY_STOP  1 // Waiting for configuration mode
+#define CAN_RECOVERY_WAIT  2 // Backing off
+#define CAN_RECOVERY_START 3 // Waiting for normal operation mode
+CAN_health_stats CAN_health = {0};
+static uint32_t CAN_health_id = CAN_SID_COUNT;
+static uint32_t CAN_health_tmr = 0;
+static uint32_t CAN_errors = 0;
+static uint8_t CAN_last_tec = 0;
+static uint8_t CAN_last_rec = 0;
+static uint8_t CAN_recovery = CAN_RECOVERY_NONE;
+static uint32_t CAN_recovery_tmr = 0;
+static uint32_t CAN_recovered_tmr = 0;
+
+// Periodic messages, see CAN_sched_service()
+typedef struct {
+  CAN_packer pack;
+  uint32_t due;  // millis of the next periodic send
+  uint32_t last; // millis of the last send
+  volatile uint8_t triggers; // Calls to CAN_sched_trigger(), wrapping
+  uint8_t handled; // Value of <triggers> at the last send
+
+  // Counts for the current interval
+  uint16_t requested;
+  uint16_t sent;
+  uint16_t triggered;
+  uint16_t coalesced;
+  uint16_t missed;
+} CAN_sched_entry;
+CAN_sched_stats CAN_sched[CAN_SCHED_MAX] = {{0}};
+uint32_t CAN_sched_len = 0;
+static CAN_sched_entry CAN_sched_entries[CAN_SCHED_MAX];
+static uint32_t CAN_sched_tmr = 0;
+
+// Filter blocks covering the subscribed IDs, see CAN_filter_plan()
+#define CAN_BLOCK_LIMIT   64
+#define CAN_BLOCK_REMOVED 0xFF
+static CAN_filter_block CAN_blocks[CAN_BLOCK_LIMIT];
+static uint32_t CAN_block_len = 0;
+
+// Acceptance filter registers, indexed by filter or mask number
+static volatile uint32_t* const CAN_rxf[CAN_FILTERS] = {
+  &C1RXF0, &C1RXF1, &C1RXF2, &C1RXF3, &C1RXF4, &C1RXF5, &C1RXF6, &C1RXF7,
+  &C1RXF8, &C1RXF9, &C1RXF10, &C1RXF11, &C1RXF12, &C1RXF13, &C1RXF14, &C1RXF15,
+  &C1RXF16, &C1RXF17, &C1RXF18, &C1RXF19, &C1RXF20, &C1RXF21, &C1RXF22, &C1RXF23,
+  &C1RXF24, &C1RXF25, &C1RXF26, &C1RXF27, &C1RXF28, &C1RXF29, &C1RXF30, &C1RXF31
+};
+static volatile uint32_t* const CAN_rxm[CAN_MASKS] = {
+  &C1RXM0, &C1RXM1, &C1RXM2, &C1RXM3
+};
+static volatile uint32_t* const CAN_fltcon[CAN_FILTERS / 4] = {
+  &C1FLTCON0, &C1FLTCON1, &C1FLTCON2, &C1FLTCON3,
+  &C1FLTCON4, &C1FLTCON5, &C1FLTCON6, &C1FLTCON7
+};
+
+/**
+ * uint32_t CAN_tx_key(uint32_t id)
+ *
+ * Lays out the arbitration field so that the frame that wins arbitration has
+ * the lower key: the 11 bit base ID, the RTR bit of a standard frame or the
+ * SRR of an extended one, IDE, then the 18 extension bits and RTR of an
+ * extended frame. The key of a standard data frame is its ID << 21.
+ *
+ * @returns The arbitration key of <id>, flags included
+ */
+static uint32_t CAN_tx_key(uint32_t id) {
+  if (id & CAN_EXT_FLAG) {
+    return ((id & CAN_EID_MASK) >> 18 << 21) | (0x3u << 19) | ((id & 0x3FFFF) << 1) |
+      ((id & CAN_RTR_FLAG) ? 1 : 0);
+  }
+  return ((id & CAN_SID_MASK) << 21) | ((id & CAN_RTR_FLAG) ? (1u << 20) : 0);
+}
+
+/**
+ * uint8_t CAN_tx_before(CAN_tx_entry* a, CAN_tx_entry* b)
+ *
+ * @returns Whether <a> should be sent before <b>: it would win arbitration, or
+ *     has the same ID and was queued earlier.
+ */
+static uint8_t CAN_tx_before(CAN_tx_entry* a, CAN_tx_entry* b) {
+  if (a->key != b->key) {
+    return a->key < b->key;
+  }
+  return (int32_t) (a->seq - b->seq) < 0;
+}
+
+/**
+ * void CAN_tx_swap(uint32_t i, uint32_t j)
+ *
+ * Swaps two entries of the transmit queue.
+ */
+static void CAN_tx_swap(uint32_t i, uint32_t j) {
+  CAN_tx_entry tmp = CAN_tx_queue[i];
+  CAN_tx_queue[i] = CAN_tx_queue[j];
+  CAN_tx_queue[j] = tmp;
+}
+
+/**
+ * void CAN_tx_sift(uint32_t i)
+ *
+ * Moves the entry at <i> up or down until the heap is ordered again.
+ */
+static void CAN_tx_sift(uint32_t i) {
+  while (i > 0 && CAN_tx_before(&CAN_tx_queue[i], &CAN_tx_queue[(i - 1) / 2])) {
+    CAN_tx_swap(i, (i - 1) / 2);
+    i = (i - 1) / 2;
+  }
+
+  for (;;) {
+    uint32_t first = i;
+    uint32_t left = 2 * i + 1;
+    uint32_t right = 2 * i + 2;
+    if (left < CAN_tx_len && CAN_tx_before(&CAN_tx_queue[left], &CAN_tx_queue[first])) {
+      first = left;
+    }
+    if (right < CAN_tx_len && CAN_tx_before(&CAN_tx_queue[right], &CAN_tx_queue[first])) {
+      first = right;
+    }
+    if (first == i) {
+      break;
+    }
+    CAN_tx_swap(i, first);
+    i = first;
+  }
+}
+
+/**
+ * void CAN_tx_remove(uint32_t i)
+ *
+ * Removes the entry at <i> from the transmit queue.
+ */
+static void CAN_tx_remove(uint32_t i) {
+  CAN_tx_len--;
+  if (i != CAN_tx_len) {
+    CAN_tx_queue[i] = CAN_tx_queue[CAN_tx_len];
+    CAN_tx_sift(i);
+  }
+}
+
+/**
+ * uint32_t CAN_tx_victim(void)
+ *
+ * @returns The index of the oldest entry with the lowest priority ID. Every
+ *     entry is checked, as the oldest of several sharing that ID can sit above
+ *     the leaves of the heap.
+ */
+static uint32_t CAN_tx_victim(void) {
+  uint32_t victim = 0;
+  uint32_t i;
+  for (i = 1; i < CAN_tx_len; i++) {
+    if (CAN_tx_queue[i].key > CAN_tx_queue[victim].key ||
+        (CAN_tx_queue[i].key == CAN_tx_queue[victim].key &&
+         (int32_t) (CAN_tx_queue[i].seq - CAN_tx_queue[victim].seq) < 0)) {
+      victim = i;
+    }
+  }
+  return victim;
+}
+
+/**
+ * void CAN_tx_fill(void)
+ *
+ * Moves frames from the head of the transmit queue into the hardware TX FIFOs
+ * until the queue is empty or the head cannot be placed. Must be called with
+ * interrupts disabled.
+ *
+ * FIFO 1 always transmits before FIFO 2, so a frame only goes into FIFO 1 if
+ * its ID is lower than every ID in FIFO 2. This lets urgent frames pass a
+ * backlog in FIFO 2 without ever reordering frames that share an ID.
+ */
+static void CAN_tx_fill(void) {
+  if (C1FIFOINT2bits.TXEMPTYIF) {
+    CAN_tx_fifo2_min = UINT32_MAX;
+  }
+
+  while (CAN_tx_len > 0) {
+    CanTxMessageBuffer* transmit;
+    uint8_t fifo;
+
+    // Get pointer to the next location in the FIFO this frame belongs in
+    if (C1FIFOINT1bits.TXNFULLIF && CAN_tx_queue[0].key < CAN_tx_fifo2_min) {
+      transmit = (CanTxMessageBuffer*) (PA_TO_KVA1(C1FIFOUA1));
+      fifo = 1;
+    } else if (C1FIFOINT2bits.TXNFULLIF) {
+      transmit = (CanTxMessageBuffer*) (PA_TO_KVA1(C1FIFOUA2));
+      fifo = 2;
+      if (CAN_tx_queue[0].key < CAN_tx_fifo2_min) {
+        CAN_tx_fifo2_min = CAN_tx_queue[0].key;
+      }
+    } else {
+      break;
+    }
+
+    // Copy message to send into transmit FIFO location
+    transmit->messageWord[0] = 0;
+    transmit->messageWord[1] = 0;
+    if (CAN_tx_queue[0].id & CAN_EXT_FLAG) {
+      transmit->CMSGSID.SID = (CAN_tx_queue[0].id & CAN_EID_MASK) >> 18;
+      transmit->CMSGEID.EID = CAN_tx_queue[0].id & 0x3FFFF;
+      transmit->CMSGEID.IDE = 1; // Extended Identifier (Message will transmit extended identifier)
+      transmit->CMSGEID.SRR = 1; // Substitute Remote Request (Must be set for extended frames)
+    } else {
+      transmit->CMSGSID.SID = CAN_tx_queue[0].id;
+    }
+    transmit->CMSGEID.RTR = (CAN_tx_queue[0].id & CAN_RTR_FLAG) != 0;
+    transmit->CMSGEID.DLC = CAN_tx_queue[0].dlc;
+    transmit->messageWord[2] = CAN_tx_queue[0].data.word0;
+    transmit->messageWord[3] = CAN_tx_queue[0].data.word1;
+    CAN_tx_frames++;
+    CAN_tx_bytes += CAN_tx_queue[0].dlc;
+    CAN_tx_remove(0);
+
+    // Signal to the CAN module that we have finished queuing a message and
+    // request transmission
+    if (fifo == 1) {
+      C1FIFOCON1bits.UINC = 1;
+      C1FIFOCON1bits.TXREQ = 1;
+    } else {
+      C1FIFOCON2bits.UINC = 1;
+      C1FIFOCON2bits.TXREQ = 1;
+    }
+  }
+
+  // Only interrupt for refills while frames are waiting
+  C1FIFOINT1bits.TXHALFIE = CAN_tx_len > 0;
+  C1FIFOINT2bits.TXHALFIE = CAN_tx_len > 0;
+}
+
 /**
- * Construct and send a CAN message based on data provided by the caller.
+ * Queue a CAN message for transmission based on data provided by the caller.
+ * The message is handed to the CAN module immediately if it has room.
  *
- * @param id The message ID of the CAN message we are sending
+ * @param id The message ID of the CAN message we are sending, with
+ *     CAN_EXT_FLAG for an extended ID and CAN_RTR_FLAG for a remote request
  * @param dlc The number of data bytes in the message
  * @param data A Pointer to the data bytes
- * @return -1 on failure, 0 on success
  */
 void CAN_send_message(uint32_t id, uint32_t dlc, CAN_data data) {
-  // Reset the FIFO and count a TX overflow if the TX FIFO is full
-  if (!C1FIFOINT1bits.TXNFULLIF) {
-    C1FIFOCON1bits.FRESET = 1;
-    while (C1FIFOCON1bits.FRESET == 1);
+  CAN_tx_entry entry;
+  uint32_t status;
+  entry.id = id & ((id & CAN_EXT_FLAG) ? (CAN_EXT_FLAG | CAN_RTR_FLAG | CAN_EID_MASK) :
+      (CAN_RTR_FLAG | CAN_SID_MASK));
+  entry.key = CAN_tx_key(entry.id);
+  entry.dlc = dlc;
+  entry.data = data;
+
+  CLI_SAVE(status);
+  entry.seq = CAN_tx_seq++;
+
+  // Make room by dropping the oldest of the lowest priority frames, or this
+  // one if its ID is lower priority than all of them
+  if (CAN_tx_len == CAN_TX_QUEUE_SIZE) {
+    uint32_t victim = CAN_tx_victim();
     CAN_tx_ovf++;
+    if (entry.key > CAN_tx_queue[victim].key) {
+      CAN_tx_drops[entry.key >> 21]++;
+      STI_RESTORE(status);
+      return;
+    }
+    CAN_tx_drops[CAN_tx_queue[victim].key >> 21]++;
+    CAN_tx_remove(victim);
   }
 
-  // Get pointer to correct location in transmit FIFO
-  CanTxMessageBuffer* transmit = (CanTxMessageBuffer*) (PA_TO_KVA1(C1FIFOUA1));
+  CAN_tx_queue[CAN_tx_len] = entry;
+  CAN_tx_len++;
+  CAN_tx_sift(CAN_tx_len - 1);
+
+  CAN_tx_fill();
+  STI_RESTORE(status);
+}
 
-  // Clear location in transmit FIFO
-  transmit->messageWord[0] = 0;
-  transmit->messageWord[1] = 0;
-  transmit->messageWord[2] = 0;
-  transmit->messageWord[3] = 0;
+/**
+ * Refill the hardware TX FIFOs from the transmit queue. Call from the CAN
+ * interrupt handler when C1INTbits.TBIF is set.
+ */
+void CAN_tx_service(void) {
+  uint32_t status;
+  CLI_SAVE(status);
+  CAN_tx_fill();
+  STI_RESTORE(status);
+}
 
-  // Copy message to send into transmit FIFO location
-  transmit->CMSGSID.SID = id;
-  transmit->CMSGEID.DLC = dlc;
+/**
+ * uint32_t CAN_tx_free(void)
+ *
+ * @returns How many more frames the transmit queue takes before dropping one
+ */
+uint32_t CAN_tx_free(void) {
+  return CAN_TX_QUEUE_SIZE - CAN_tx_len;
+}
 
-  // CMSGDATA0
-  if (dlc >= 2) {
-    ((uint16_t*) &(transmit->messageWord[2]))[0] = data.halfword0;
-  }
-  if (dlc >= 4) {
-    ((uint16_t*) &(transmit->messageWord[2]))[1] = data.halfword1;
+/**
+ * const CanRxMessageBuffer* CAN_rx_peek(uint8_t* fifo)
+ *
+ * Finds the next received frame, taking frames from the critical FIFO first.
+ *
+ * @param fifo Set to the FIFO the frame is in
+ * @returns The frame in place in the FIFO, or NULL if both FIFOs are empty
+ */
+static const CanRxMessageBuffer* CAN_rx_peek(uint8_t* fifo) {
+  if (C1FIFOINT3bits.RXNEMPTYIF) {
+    *fifo = 3;
+    return (const CanRxMessageBuffer*) (PA_TO_KVA1(C1FIFOUA3));
+  } else if (C1FIFOINT0bits.RXNEMPTYIF) {
+    *fifo = 0;
+    return (const CanRxMessageBuffer*) (PA_TO_KVA1(C1FIFOUA0));
   }
+  return NULL;
+}
 
-  // CMSGDATA1
-  if (dlc >= 6) {
-    ((uint16_t*) &(transmit->messageWord[3]))[0] = data.halfword2;
+/**
+ * void CAN_rx_release(uint8_t fifo, const CanRxMessageBuffer* frames, uint32_t count)
+ *
+ * Signals to the CAN module that we've processed the <count> frames at
+ * <frames>, the head of the FIFO, so their buffers can be reused.
+ */
+static void CAN_rx_release(uint8_t fifo, const CanRxMessageBuffer* frames, uint32_t count) {
+  uint32_t i;
+  for (i = 0; i < count; i++) {
+    CAN_rx_bytes += frames[i].CMSGEID.DLC;
   }
+  CAN_rx_frames += count;
 
-  if (dlc >= 8) {
-    ((uint16_t*) &(transmit->messageWord[3]))[1] = data.halfword3;
+  while (count--) {
+    if (fifo == 3) {
+      C1FIFOCON3bits.UINC = 1;
+    } else {
+      C1FIFOCON0bits.UINC = 1;
+    }
   }
-
-  // Signal to the CAN module that we have finished queuing a message
-  C1FIFOCON1bits.UINC = 1;
-
-  // Request transmission of the message
-  C1FIFOCON1bits.TXREQ = 1;
 }
 
 /**
  * Receive and handle any available CAN messages.
  *
  * This function calls the provided handler function once for each received
- * message. There can be anywhere from 0 to 32 available messages, so the
- * handler function can be called up to 32 times before this function will return.
+ * message. Frames waiting in the critical FIFO are always handled before the
+ * next frame from FIFO 0, so the handler can be called up to 48 times before
+ * this function will return.
  *
  * @param handler The handler function to call with each received message
  */
-void CAN_recv_messages(void (*handler)(CAN_message msg)) {
-    CanRxMessageBuffer* receive = NULL;
+void CAN_recv_messages(CAN_handler handler) {
+  const CanRxMessageBuffer* receive;
+  uint8_t fifo;
 
-    // Keep polling until the FIFO isn't empty
-    while(C1FIFOINT0bits.RXNEMPTYIF == 1) {
+  while ((receive = CAN_rx_peek(&fifo)) != NULL) {
 
-      // Get pointer to the next available message
-      receive = (CanRxMessageBuffer*) (PA_TO_KVA1(C1FIFOUA0));
+    // Copy data from the receive FIFO into a CAN_message struct
+    CAN_message msg;
+    msg.id = CAN_FRAME_ID(receive);
+    msg.dlc = receive->CMSGEID.DLC;
+    ((uint32_t*) msg.data)[0] = receive->messageWord[2];
+    ((uint32_t*) msg.data)[1] = receive->messageWord[3];
+    msg.timestamp = CAN_frame_timestamp(receive);
 
-      // Copy data from the receive FIFO into a CAN_message struct
-      CAN_message msg;
-      msg.id = receive->CMSGSID.SID;
-      msg.dlc = receive->CMSGEID.DLC;
-      ((uint32_t*) msg.data)[0] = receive->messageWord[2];
-      ((uint32_t*) msg.data)[1] = receive->messageWord[3];
+    CAN_rx_release(fifo, receive, 1);
 
-      // Signal to the CAN module that we've processed a message
-      C1FIFOCON0bits.UINC = 1;
+    // Call the provided handler function
+    handler(msg);
+  }
+}
+
+/**
+ * Receive and handle any available CAN messages without copying them.
+ *
+ * Like CAN_recv_messages(), but the handler is passed a pointer to the frame
+ * in the receive FIFO. The buffer is released once the handler returns.
+ *
+ * @param handler The handler function to call with each received frame
+ */
+void CAN_recv_frames(CAN_frame_handler handler) {
+  const CanRxMessageBuffer* receive;
+  uint8_t fifo;
+
+  while ((receive = CAN_rx_peek(&fifo)) != NULL) {
+    handler(receive);
+    CAN_rx_release(fifo, receive, 1);
+  }
+}
+
+/**
+ * uint32_t CAN_rx_batch(uint8_t fifo, CAN_batch_handler handler)
+ *
+ * Passes the frames waiting at the head of a receive FIFO to the handler in
+ * one call, stopping where the FIFO wraps around, then releases them.
+ *
+ * @returns The number of frames handled
+ */
+static uint32_t CAN_rx_batch(uint8_t fifo, CAN_batch_handler handler) {
+  uintptr_t base;
+  uintptr_t head;
+  uint32_t size;
+  uint32_t next;
+  uint32_t full;
+  uint32_t index;
+  uint32_t count;
+
+  // Read CI before RXFULLIF, so a FIFO that fills in between reads as full
+  if (fifo == 3) {
+    if (!C1FIFOINT3bits.RXNEMPTYIF) {
+      return 0;
+    }
+    next = C1FIFOCI3 & 0x1F;
+    full = C1FIFOINT3bits.RXFULLIF;
+    head = C1FIFOUA3;
+    base = KVA_TO_PA(&CAN_FIFO_Buffers[CAN_CRIT_FIFO_WORD]);
+    size = CAN_CRIT_FIFO_SIZE;
+  } else {
+    if (!C1FIFOINT0bits.RXNEMPTYIF) {
+      return 0;
+    }
+    next = C1FIFOCI0 & 0x1F;
+    full = C1FIFOINT0bits.RXFULLIF;
+    head = C1FIFOUA0;
+    base = KVA_TO_PA(&CAN_FIFO_Buffers[CAN_RX_FIFO_WORD]);
+    size = CAN_RX_FIFO_SIZE;
+  }
+
+  index = (head - base) / sizeof(CanRxMessageBuffer);
+  count = full ? size : (next + size - index) % size;
+  if (index + count > size) {
+    count = size - index;
+  }
+
+  handler((const CanRxMessageBuffer*) (PA_TO_KVA1(head)), count);
+  CAN_rx_release(fifo, (const CanRxMessageBuffer*) (PA_TO_KVA1(head)), count);
+  return count;
+}
+
+/**
+ * Receive and handle all available CAN messages in batches without copying
+ * them.
+ *
+ * The handler is passed runs of frames that are contiguous in a receive FIFO,
+ * so a FIFO that has wrapped around takes two calls. Runs from the critical
+ * FIFO are handled before each run from FIFO 0.
+ *
+ * @param handler The handler function to call with each run of frames
+ */
+void CAN_recv_batch(CAN_batch_handler handler) {
+  while (CAN_rx_batch(3, handler) || CAN_rx_batch(0, handler));
+}
+
+/**
+ * Register a handler for <count> consecutive IDs starting at <id>. Must be
+ * called before init_can(), which programs the acceptance filters from the
+ * registered IDs. A later subscription replaces an earlier one for the same ID.
+ *
+ * @param id The first message ID to receive
+ * @param count The number of consecutive IDs to receive
+ * @param handler The function CAN_dispatch_messages() calls for these IDs
+ * @param critical CAN_CRITICAL to receive these IDs into the critical FIFO
+ */
+void CAN_subscribe(uint32_t id, uint32_t count, CAN_handler handler, uint8_t critical) {
+  uint32_t i;
+  for (i = id; i < id + count && i < CAN_SID_COUNT; i++) {
+    CAN_handlers[i] = handler;
+    if (critical) {
+      CAN_critical[i / 32] |= 1u << (i % 32);
+    } else {
+      CAN_critical[i / 32] &= ~(1u << (i % 32));
+    }
+  }
+}
+
+/**
+ * Register a handler for the extended IDs that equal <id> in the bits set in
+ * <mask>. Must be called before init_can(). Up to CAN_EXT_SUBS are kept, and
+ * CAN_dispatch_messages() uses the first that matches. A later subscription
+ * with the same ID and mask replaces an earlier one.
+ *
+ * @param id The 29 bit extended ID to receive, CAN_EXT_FLAG is optional
+ * @param mask The bits of <id> to match
+ * @param handler The function CAN_dispatch_messages() calls for these IDs
+ * @param critical CAN_CRITICAL to receive these IDs into the critical FIFO
+ */
+void CAN_subscribe_ext(uint32_t id, uint32_t mask, CAN_handler handler, uint8_t critical) {
+  uint32_t i;
+  id &= CAN_EID_MASK;
+  mask &= CAN_EID_MASK;
+
+  for (i = 0; i < CAN_ext_len; i++) {
+    if (CAN_ext_subs[i].id == (id & mask) && CAN_ext_subs[i].mask == mask) {
+      break;
+    }
+  }
+  if (i == CAN_EXT_SUBS) {
+    return;
+  }
+  if (i == CAN_ext_len) {
+    CAN_ext_len++;
+  }
+
+  CAN_ext_subs[i].id = id & mask;
+  CAN_ext_subs[i].mask = mask;
+  CAN_ext_subs[i].handler = handler;
+  CAN_ext_subs[i].critical = critical;
+}
 
-      // Call the provided handler function
-      handler(msg);
+/**
+ * CAN_handler CAN_ext_handler(uint32_t id)
+ *
+ * @returns The handler of the first extended subscription matching <id>, or
+ *     NULL if none does
+ */
+static CAN_handler CAN_ext_handler(uint32_t id) {
+  uint32_t i;
+  for (i = 0; i < CAN_ext_len; i++) {
+    if ((id & CAN_ext_subs[i].mask) == CAN_ext_subs[i].id) {
+      return CAN_ext_subs[i].handler;
     }
+  }
+  return NULL;
+}
+
+/**
+ * void CAN_dispatch(CAN_message msg)
+ *
+ * Calls the handler subscribed to the message's ID, if there is one. Remote
+ * requests go to the same handler as data frames with their ID.
+ */
+static void CAN_dispatch(CAN_message msg) {
+  CAN_handler handler = (msg.id & CAN_EXT_FLAG) ? CAN_ext_handler(msg.id & CAN_EID_MASK) :
+    CAN_handlers[msg.id & CAN_SID_MASK];
+  if (CAN_rx_log != NULL) {
+    CAN_rx_log(msg);
+  }
+  if (handler != NULL) {
+    handler(msg);
+  }
+}
+
+/**
+ * Receive all available CAN messages and pass each one to the handler
+ * subscribed to its ID. Call from the CAN interrupt handler when
+ * C1INTbits.RBIF is set.
+ */
+void CAN_dispatch_messages(void) {
+  CAN_recv_messages(CAN_dispatch);
+}
+
+/**
+ * Set a function that CAN_dispatch_messages() passes every received message
+ * to, with its timestamp, before the subscribed handler. This includes
+ * messages that passed the filters but have no handler. Pass NULL to stop.
+ *
+ * @param log The function to call with each received message
+ */
+void CAN_set_rx_log(CAN_handler log) {
+  CAN_rx_log = log;
+}
+
+/**
+ * uint32_t CAN_micros(void)
+ *
+ * init_can() sets the module's 16 bit timestamp timer to count microseconds.
+ * Its count is extended to 32 bits by taking the value with the same low 16
+ * bits that lies nearest millis, so frames keep their time however long they
+ * wait to be handled, as long as millis is counting. The result wraps every
+ * 71 minutes, so compare times by unsigned subtraction.
+ *
+ * @returns The current time in microseconds on the receive timestamp base
+ */
+uint32_t CAN_micros(void) {
+  uint32_t approx = millis * 1000 + CAN_ts_phase;
+  uint16_t now = C1TMRbits.CANTS;
+  return approx + (int16_t) (now - (uint16_t) approx);
+}
+
+/**
+ * uint32_t CAN_frame_id(const CanRxMessageBuffer* frame)
+ *
+ * A standard remote request is marked by SRR and an extended one by RTR, as
+ * the module stores them.
+ *
+ * @returns The frame's ID with CAN_EXT_FLAG and CAN_RTR_FLAG as they apply
+ */
+uint32_t CAN_frame_id(const CanRxMessageBuffer* frame) {
+  if (frame->CMSGEID.IDE) {
+    return CAN_EXT_FLAG | ((uint32_t) frame->CMSGSID.SID << 18) | frame->CMSGEID.EID |
+      (frame->CMSGEID.RTR ? CAN_RTR_FLAG : 0);
+  }
+  return frame->CMSGSID.SID | (frame->CMSGEID.SRR ? CAN_RTR_FLAG : 0);
+}
+
+/**
+ * uint8_t CAN_dlc_to_len(uint8_t dlc)
+ *
+ * @returns The payload length in bytes of a frame with DLC code <dlc>, at
+ *     most CAN_MAX_DLEN
+ */
+uint8_t CAN_dlc_to_len(uint8_t dlc) {
+  static const uint8_t lengths[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+  uint8_t len = lengths[dlc & 0xF];
+  return len > CAN_MAX_DLEN ? CAN_MAX_DLEN : len;
+}
+
+/**
+ * uint8_t CAN_len_to_dlc(uint8_t len)
+ *
+ * @returns The smallest DLC code whose payload holds <len> bytes, limited to
+ *     CAN_MAX_DLEN. Payloads between the CAN FD sizes are padded up.
+ */
+uint8_t CAN_len_to_dlc(uint8_t len) {
+  uint8_t dlc = 0;
+  if (len > CAN_MAX_DLEN) {
+    len = CAN_MAX_DLEN;
+  }
+  while (CAN_dlc_to_len(dlc) < len) {
+    dlc++;
+  }
+  return dlc;
+}
+
+/**
+ * uint32_t CAN_frame_timestamp(const CanRxMessageBuffer* frame)
+ *
+ * @returns The time the frame was received, in microseconds on the
+ *     CAN_micros() time base. Valid for frames up to 65ms old.
+ */
+uint32_t CAN_frame_timestamp(const CanRxMessageBuffer* frame) {
+  uint32_t now = CAN_micros();
+  return now - (uint16_t) ((uint16_t) now - frame->CMSGSID.CMSGTS);
+}
+
+/**
+ * void CAN_health_init(uint32_t id)
+ *
+ * Starts publishing the node's health message, normally <node>_ID +
+ * HEALTH_ID_OFFSET, from CAN_health_service() every CAN_HEALTH_INTV ms.
+ *
+ * @param id The ID of the health message
+ */
+void CAN_health_init(uint32_t id) {
+  CAN_health_id = id & (CAN_SID_COUNT - 1);
+  CAN_health_tmr = millis;
+}
+
+/**
+ * void CAN_health_recover(uint8_t busOff)
+ *
+ * Steps the bus-off recovery: take the module offline when it goes bus-off,
+ * wait out the backoff in configuration mode, then bring it back.
+ */
+static void CAN_health_recover(uint8_t busOff) {
+  switch (CAN_recovery) {
+    case CAN_RECOVERY_NONE:
+      if (busOff) {
+        // Back off for longer if the module failed again soon after recovering
+        if (CAN_health.bus_offs > 0 && millis - CAN_recovered_tmr < CAN_BACKOFF_STABLE_MS) {
+          CAN_health.backoff *= 2;
+          if (CAN_health.backoff > CAN_BACKOFF_MAX_MS) {
+            CAN_health.backoff = CAN_BACKOFF_MAX_MS;
+          }
+        } else {
+          CAN_health.backoff = CAN_BACKOFF_MIN_MS;
+        }
+        CAN_health.bus_offs++;
+        CAN_errors++;
+
+        C1CONbits.REQOP = 0b100; // Request Operation Mode (Set Configuration mode)
+        CAN_recovery = CAN_RECOVERY_STOP;
+      }
+      break;
+    case CAN_RECOVERY_STOP:
+      if (C1CONbits.OPMOD == 0b100) {
+        CAN_recovery_tmr = millis;
+        CAN_recovery = CAN_RECOVERY_WAIT;
+      }
+      break;
+    case CAN_RECOVERY_WAIT:
+      if (millis - CAN_recovery_tmr >= CAN_health.backoff) {
+        C1CONbits.REQOP = 0b000; // Request Operation Mode (Set Normal Operation mode)
+        CAN_recovery = CAN_RECOVERY_START;
+      }
+      break;
+    default:
+      if (C1CONbits.OPMOD == 0b000) {
+        // Line the timestamp timer up with millis again, see CAN_micros()
+        CAN_ts_phase = C1TMRbits.CANTS - (uint16_t) (millis * 1000);
+        CAN_recovered_tmr = millis;
+        CAN_recovery = CAN_RECOVERY_NONE;
+      }
+      break;
+  }
+}
+
+/**
+ * void CAN_health_service(void)
+ *
+ * Updates CAN_health from C1TREC, recovers from bus-off and publishes the
+ * health message when the interval has passed. Call from the main loop.
+ */
+void CAN_health_service(void) {
+  uint8_t tec = C1TRECbits.TERRCNT;
+  uint8_t rec = C1TRECbits.RERRCNT;
+  uint8_t busOff = C1TRECbits.TXBO;
+  uint32_t status;
+
+  // Each transmit error adds 8 to TEC and each receive error 1 to REC
+  if (CAN_recovery == CAN_RECOVERY_NONE && !busOff) {
+    if (tec > CAN_last_tec) {
+      CAN_errors += (tec - CAN_last_tec + 7) / 8;
+    }
+    if (rec > CAN_last_rec) {
+      CAN_errors += rec - CAN_last_rec;
+    }
+  }
+  CAN_last_tec = tec;
+  CAN_last_rec = rec;
+
+  CAN_health_recover(busOff);
+
+  CAN_health.tec = tec;
+  CAN_health.rec = rec;
+  if (busOff || CAN_recovery != CAN_RECOVERY_NONE) {
+    CAN_health.state = CAN_BUS_OFF;
+  } else if (C1TRECbits.TXBP || C1TRECbits.RXBP) {
+    CAN_health.state = CAN_PASSIVE;
+  } else if (C1TRECbits.EWARN) {
+    CAN_health.state = CAN_WARNING;
+  } else {
+    CAN_health.state = CAN_ACTIVE;
+  }
+
+  if (millis - CAN_health_tmr >= CAN_HEALTH_INTV) {
+    CAN_health_tmr = millis;
+
+    CLI_SAVE(status);
+    CAN_health.rx_frames = CAN_rx_frames;
+    CAN_health.rx_bytes = CAN_rx_bytes;
+    CAN_health.tx_frames = CAN_tx_frames;
+    CAN_health.tx_bytes = CAN_tx_bytes;
+    CAN_rx_frames = 0;
+    CAN_rx_bytes = 0;
+    CAN_tx_frames = 0;
+    CAN_tx_bytes = 0;
+    STI_RESTORE(status);
+    CAN_health.errors = CAN_errors;
+    CAN_errors = 0;
+
+    if (CAN_health_id < CAN_SID_COUNT) {
+      CAN_data data = {0};
+      data.byte0 = CAN_health.tec;
+      data.byte1 = CAN_health.rec;
+      data.byte2 = CAN_health.state |
+        ((CAN_health.bus_offs > 63 ? 63 : CAN_health.bus_offs) << 2);
+      data.byte3 = CAN_health.errors > 255 ? 255 : CAN_health.errors;
+      data.halfword2 = CAN_health.rx_frames > 0xFFFF ? 0xFFFF : CAN_health.rx_frames;
+      data.halfword3 = CAN_health.tx_frames > 0xFFFF ? 0xFFFF : CAN_health.tx_frames;
+      CAN_send_message(CAN_health_id, 8, data);
+    }
+  }
+}
+
+/**
+ * uint32_t CAN_sched_gcd(uint32_t a, uint32_t b)
+ *
+ * @returns The greatest common divisor of <a> and <b>
+ */
+static uint32_t CAN_sched_gcd(uint32_t a, uint32_t b) {
+  while (b != 0) {
+    uint32_t r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+/**
+ * uint32_t CAN_sched_phase(uint32_t skip, uint32_t period)
+ *
+ * Two messages with periods p and q and phases a and b are sent in the same
+ * millisecond once every lcm(p, q) ms if a and b are equal modulo gcd(p, q),
+ * and never otherwise. Picks the phase for a message with <period> that
+ * minimizes the summed rate of these collisions with every registered message
+ * but <skip>.
+ *
+ * @returns The phase with the fewest collisions, the lowest on a tie
+ */
+static uint32_t CAN_sched_phase(uint32_t skip, uint32_t period) {
+  uint32_t best = 0;
+  uint32_t bestCost = UINT32_MAX;
+  uint32_t phase;
+
+  for (phase = 0; phase < period && bestCost > 0; phase++) {
+    uint32_t cost = 0;
+    uint32_t i;
+    for (i = 0; i < CAN_sched_len; i++) {
+      uint32_t gcd;
+      if (i == skip) {
+        continue;
+      }
+      // Collisions per ms are gcd / (period * other), drop the common 1/period
+      gcd = CAN_sched_gcd(period, CAN_sched[i].period);
+      if (phase % gcd == CAN_sched[i].phase % gcd) {
+        cost += (gcd << 16) / CAN_sched[i].period;
+      }
+    }
+    if (cost < bestCost) {
+      best = phase;
+      bestCost = cost;
+    }
+  }
+  return best;
+}
+
+/**
+ * void CAN_sched_add(uint32_t id, uint32_t period, uint32_t phase, CAN_packer pack)
+ *
+ * Registers a message for CAN_sched_service() to send every <period> ms. Up to
+ * CAN_SCHED_MAX are kept, and registering an ID again replaces it.
+ *
+ * @param id The ID of the message, flags included
+ * @param period The time between sends in ms, up to 0xFFFF
+ * @param phase When in the period to send in ms, or CAN_SCHED_AUTO
+ * @param pack Fills in the data each time the message is sent
+ */
+void CAN_sched_add(uint32_t id, uint32_t period, uint32_t phase, CAN_packer pack) {
+  CAN_sched_entry* entry;
+  uint32_t now = millis;
+  uint32_t i;
+
+  if (period == 0 || period > 0xFFFF || pack == NULL) {
+    return;
+  }
+  for (i = 0; i < CAN_sched_len; i++) {
+    if (CAN_sched[i].id == id) {
+      break;
+    }
+  }
+  if (i == CAN_SCHED_MAX) {
+    return;
+  }
+  if (CAN_sched_len == 0) {
+    CAN_sched_tmr = now;
+  }
+
+  phase = phase == CAN_SCHED_AUTO ? CAN_sched_phase(i, period) : phase % period;
+  CAN_sched[i].id = id;
+  CAN_sched[i].period = period;
+  CAN_sched[i].phase = phase;
+  if (i == CAN_sched_len) {
+    CAN_sched_len++;
+  }
+
+  entry = &CAN_sched_entries[i];
+  entry->pack = pack;
+  entry->due = now + (phase + period - now % period) % period;
+  entry->last = entry->due - period;
+  entry->handled = entry->triggers;
+}
+
+/**
+ * void CAN_sched_send(uint32_t i, uint32_t now, uint8_t triggers)
+ *
+ * Packs and queues periodic message <i>, which answers every trigger up to
+ * <triggers>.
+ */
+static void CAN_sched_send(uint32_t i, uint32_t now, uint8_t triggers) {
+  CAN_sched_entry* entry = &CAN_sched_entries[i];
+  CAN_data data = {0};
+  uint32_t dlc = entry->pack(CAN_sched[i].id, &data);
+
+  entry->handled = triggers;
+  entry->last = now;
+  if (dlc > 0) {
+    CAN_send_message(CAN_sched[i].id, dlc, data);
+    entry->sent++;
+  }
+}
+
+/**
+ * void CAN_sched_trigger(uint32_t id)
+ *
+ * Asks for periodic message <id> to be sent early because its contents have
+ * changed. The next call to CAN_sched_service() sends it, once
+ * CAN_SCHED_HOLDOFF_MS has passed since it was last sent, and any further
+ * triggers until then are merged into that send. Safe to call from an
+ * interrupt.
+ *
+ * @param id The ID passed to CAN_sched_add()
+ */
+void CAN_sched_trigger(uint32_t id) {
+  uint32_t i;
+  for (i = 0; i < CAN_sched_len; i++) {
+    if (CAN_sched[i].id == id) {
+      CAN_sched_entries[i].triggers++;
+      return;
+    }
+  }
+}
+
+/**
+ * void CAN_sched_service(void)
+ *
+ * Sends the periodic messages that are due and the triggered messages whose
+ * holdoff has passed, and updates CAN_sched every CAN_SCHED_INTV ms. Call
+ * from the main loop, at least once a millisecond to keep to the phases.
+ */
+void CAN_sched_service(void) {
+  uint32_t now = millis;
+  uint32_t i;
+
+  for (i = 0; i < CAN_sched_len; i++) {
+    CAN_sched_entry* entry = &CAN_sched_entries[i];
+    uint32_t period = CAN_sched[i].period;
+    uint8_t triggers = entry->triggers;
+
+    if ((int32_t) (now - entry->due) >= 0) {
+      uint32_t behind = (now - entry->due) / period;
+      entry->missed += behind;
+      entry->requested += behind + 1;
+      entry->due += behind * period;
+
+      // A send just before the deadline, triggered or late, stands in for it
+      if ((int32_t) (entry->due - entry->last) <= (int32_t) (period / CAN_SCHED_COALESCE)) {
+        entry->coalesced++;
+      } else {
+        entry->coalesced += (uint8_t) (triggers - entry->handled);
+        CAN_sched_send(i, now, triggers);
+      }
+      entry->due += period;
+    }
+
+    if (triggers != entry->handled && now - entry->last >= CAN_SCHED_HOLDOFF_MS) {
+      entry->triggered++;
+      entry->coalesced += (uint8_t) (triggers - entry->handled - 1);
+      CAN_sched_send(i, now, triggers);
+    }
+  }
+
+  if (CAN_sched_len > 0 && now - CAN_sched_tmr >= CAN_SCHED_INTV) {
+    CAN_sched_tmr = now;
+    for (i = 0; i < CAN_sched_len; i++) {
+      CAN_sched_entry* entry = &CAN_sched_entries[i];
+      CAN_sched[i].requested = entry->requested;
+      CAN_sched[i].sent = entry->sent;
+      CAN_sched[i].triggered = entry->triggered;
+      CAN_sched[i].coalesced = entry->coalesced;
+      CAN_sched[i].missed = entry->missed;
+      entry->requested = 0;
+      entry->sent = 0;
+      entry->triggered = 0;
+      entry->coalesced = 0;
+      entry->missed = 0;
+    }
+  }
+}
+
+/**
+ * uint32_t CAN_range_count(uint32_t base, uint32_t size, uint32_t* critical)
+ *
+ * Counts the subscribed IDs in [base, base + size).
+ *
+ * @param critical Set to the number of those IDs that are critical
+ * @returns The number of subscribed IDs
+ */
+static uint32_t CAN_range_count(uint32_t base, uint32_t size, uint32_t* critical) {
+  uint32_t count = 0;
+  uint32_t i;
+  *critical = 0;
+  for (i = base; i < base + size; i++) {
+    if (CAN_handlers[i] != NULL) {
+      count++;
+      *critical += (CAN_critical[i / 32] >> (i % 32)) & 0x1;
+    }
+  }
+  return count;
+}
+
+/**
+ * uint8_t CAN_filter_split(uint8_t level)
+ *
+ * Covers the subscribed IDs with aligned blocks of at least 2^level IDs. Runs
+ * of IDs that are all subscribed and share a priority are merged into the
+ * largest aligned blocks that fit them.
+ *
+ * @returns 1 if the blocks fit in CAN_blocks, 0 if <level> must be raised
+ */
+static uint8_t CAN_filter_split(uint8_t level) {
+  uint32_t id = 0;
+  CAN_block_len = 0;
+
+  while (id < CAN_SID_COUNT) {
+    uint32_t critical;
+    uint32_t count = CAN_range_count(id, 1u << level, &critical);
+    uint8_t k = level;
+
+    if (count == 0) {
+      id += 1u << level;
+      continue;
+    }
+
+    // Grow the block while the wider block is fully subscribed at one priority
+    while (k < 11 && id % (1u << (k + 1)) == 0) {
+      uint32_t wideCritical;
+      uint32_t size = 1u << (k + 1);
+      if (CAN_range_count(id, size, &wideCritical) != size ||
+          wideCritical != (critical ? size : 0)) {
+        break;
+      }
+      k++;
+    }
+
+    if (CAN_block_len == CAN_BLOCK_LIMIT) {
+      return 0;
+    }
+    CAN_blocks[CAN_block_len].base = id;
+    CAN_blocks[CAN_block_len].k = k;
+    CAN_blocks[CAN_block_len].critical = critical > 0;
+    CAN_block_len++;
+    id += 1u << k;
+  }
+
+  return 1;
+}
+
+/**
+ * uint32_t CAN_filter_sizes(void)
+ *
+ * @returns A bitmap of the block sizes in use, bit k set for blocks of 2^k
+ */
+static uint32_t CAN_filter_sizes(void) {
+  uint32_t sizes = 0;
+  uint32_t i;
+  for (i = 0; i < CAN_block_len; i++) {
+    sizes |= 1u << CAN_blocks[i].k;
+  }
+  return sizes;
+}
+
+/**
+ * uint8_t CAN_count_bits(uint32_t bits)
+ *
+ * @returns The number of set bits in <bits>
+ */
+static uint8_t CAN_count_bits(uint32_t bits) {
+  uint8_t count = 0;
+  while (bits) {
+    bits &= bits - 1;
+    count++;
+  }
+  return count;
+}
+
+/**
+ * void CAN_filter_plan(uint32_t filters, uint8_t masks)
+ *
+ * Fills CAN_blocks with at most <filters> blocks using at most <masks> block
+ * sizes that together cover every subscribed standard ID. The smallest blocks are
+ * widened until the plan fits. Blocks are aligned, so widening one either
+ * leaves it apart from the others or swallows them whole. A block holding any
+ * critical ID is received into the critical FIFO.
+ */
+static void CAN_filter_plan(uint32_t filters, uint8_t masks) {
+  uint8_t level = 0;
+  uint32_t sizes;
+
+  while (!CAN_filter_split(level)) {
+    level++;
+  }
+
+  // Nothing subscribed, receive every standard ID into FIFO 0
+  if (CAN_block_len == 0 && CAN_ext_len == 0) {
+    CAN_blocks[0].base = 0;
+    CAN_blocks[0].k = 11;
+    CAN_blocks[0].critical = 0;
+    CAN_block_len = 1;
+  }
+
+  sizes = CAN_filter_sizes();
+  while (CAN_block_len > filters || CAN_count_bits(sizes) > masks) {
+    uint8_t from = 0;
+    uint8_t to;
+    uint32_t i;
+    uint32_t j;
+
+    while (!(sizes & (1u << from))) {
+      from++;
+    }
+
+    // Merge into the next size in use if that frees a mask, else grow by one
+    to = from + 1;
+    if (CAN_count_bits(sizes) > masks) {
+      while (!(sizes & (1u << to))) {
+        to++;
+      }
+    }
+
+    for (i = 0; i < CAN_block_len; i++) {
+      if (CAN_blocks[i].k == from) {
+        CAN_blocks[i].k = to;
+        CAN_blocks[i].base &= ~((1u << to) - 1);
+      }
+    }
+
+    // Drop blocks that now lie inside another block
+    for (i = 0; i < CAN_block_len; i++) {
+      for (j = 0; j < CAN_block_len; j++) {
+        if (j != i && CAN_blocks[i].k != CAN_BLOCK_REMOVED &&
+            CAN_blocks[j].k <= CAN_blocks[i].k &&
+            (CAN_blocks[j].base & ~((1u << CAN_blocks[i].k) - 1)) == CAN_blocks[i].base) {
+          CAN_blocks[i].critical |= CAN_blocks[j].critical;
+          CAN_blocks[j].k = CAN_BLOCK_REMOVED;
+        }
+      }
+    }
+
+    for (i = 0, j = 0; i < CAN_block_len; i++) {
+      if (CAN_blocks[i].k != CAN_BLOCK_REMOVED) {
+        CAN_blocks[j++] = CAN_blocks[i];
+      }
+    }
+    CAN_block_len = j;
+
+    sizes = CAN_filter_sizes();
+  }
+}
+
+/**
+ * uint32_t CAN_ext_fields(uint32_t id)
+ *
+ * @returns The SID and EID fields of a filter or mask register for the 29 bit
+ *     extended ID <id>
+ */
+static uint32_t CAN_ext_fields(uint32_t id) {
+  return ((id >> 18) << 21) | (id & 0x3FFFF);
+}
+
+/**
+ * void CAN_program_filters(void)
+ *
+ * Programs the acceptance masks and filters from CAN_filter_plan(), followed
+ * by one filter for each extended subscription. Must be called in
+ * configuration mode.
+ */
+static void CAN_program_filters(void) {
+  uint32_t fltcon[CAN_FILTERS / 4] = {0};
+  uint32_t extMask = CAN_EID_MASK;
+  uint8_t mask[12];
+  uint8_t masks = 0;
+  uint32_t sizes;
+  uint32_t i;
+
+  CAN_filter_plan(CAN_FILTERS - CAN_ext_len, CAN_MASKS - (CAN_ext_len > 0));
+
+  // Filters must be disabled before modification
+  for (i = 0; i < CAN_FILTERS / 4; i++) {
+    *CAN_fltcon[i] = 0;
+  }
+
+  // One mask per block size, comparing the SID bits above the block
+  sizes = CAN_filter_sizes();
+  for (i = 0; i < 12; i++) {
+    if (sizes & (1u << i)) {
+      *CAN_rxm[masks] = (((0x7FFu << i) & 0x7FF) << 21) | // SID (Bits above the block compared)
+        (1u << 19) | // MIDE (Match only message types that correspond to EXID bit in filter)
+        0x3FFFF;     // EID (All bits included in filter comparison)
+      mask[i] = masks++;
+    }
+  }
+
+  // Filters match standard identifiers only, EXID and EID are left as zero
+  for (i = 0; i < CAN_block_len; i++) {
+    *CAN_rxf[i] = (uint32_t) CAN_blocks[i].base << 21;
+    fltcon[i / 4] |= (0x80u | // FLTEN (Filter is enabled)
+        ((uint32_t) mask[CAN_blocks[i].k] << 5) | // MSEL (Mask for this block size)
+        (CAN_blocks[i].critical ? 3 : 0)) << (8 * (i % 4)); // FSEL (FIFO 3 or FIFO 0)
+  }
+
+  // Extended subscriptions share one mask, the bits every one of them matches
+  if (CAN_ext_len > 0) {
+    for (i = 0; i < CAN_ext_len; i++) {
+      extMask &= CAN_ext_subs[i].mask;
+    }
+    *CAN_rxm[masks] = CAN_ext_fields(extMask) | // SID and EID (Bits compared by every extended filter)
+      (1u << 19); // MIDE (Match only message types that correspond to EXID bit in filter)
+
+    for (i = 0; i < CAN_ext_len; i++) {
+      uint32_t n = CAN_block_len + i;
+      *CAN_rxf[n] = CAN_ext_fields(CAN_ext_subs[i].id) | // SID and EID (Subscribed ID)
+        (1u << 19); // EXID (Match only messages with extended identifier addresses)
+      fltcon[n / 4] |= (0x80u | // FLTEN (Filter is enabled)
+          ((uint32_t) masks << 5) | // MSEL (Mask for extended IDs)
+          (CAN_ext_subs[i].critical ? 3 : 0)) << (8 * (n % 4)); // FSEL (FIFO 3 or FIFO 0)
+    }
+  }
+
+  for (i = 0; i < CAN_FILTERS / 4; i++) {
+    *CAN_fltcon[i] = fltcon[i];
+  }
 }
 
 /**
@@ -136,6 +1291,7 @@ void init_can(void) {
 
   // C1CON
   C1CONbits.CANCAP = 1; // CAN Message Receive Timestamp Timer Capture Enable (Enabled)
+  C1TMRbits.CANTSPRE = PBCLK5 - 1; // CAN Time Stamp Timer Prescaler bits (Increments every microsecond)
   C1CONbits.SIDL = 0;   // CAN Stop in Idle (CAN continues operation when system enters idle mode)
 
   /**
@@ -167,41 +1323,44 @@ void init_can(void) {
 
   // CAN1 FIFO 0
   C1FIFOCON0bits.TXEN = 0;        // TX/RX Buffer Selection (Receive FIFO)
-  C1FIFOCON0bits.FSIZE = 0b11111; // FIFO Size bits (32 messages deep)
+  C1FIFOCON0bits.FSIZE = CAN_RX_FIFO_SIZE - 1; // FIFO Size bits (32 messages deep)
   C1FIFOCON0bits.DONLY = 0;       // Store Message Data Only (Full message is stored, including identifier)
-  C1FIFOINT0bits.RXHALFIE = 1;    // FIFO Half Full Interrupt Enable (Enabled)
+  C1FIFOINT0bits.RXHALFIE = 0;    // FIFO Half Full Interrupt Enable (Disabled)
   C1FIFOINT0bits.RXFULLIE = 0;    // FIFO Full Interrupt Enable (Disabled)
-  C1FIFOINT0bits.RXNEMPTYIE = 0;  // FIFO Not Empty Interrupt Enable (Disabled)
+  C1FIFOINT0bits.RXNEMPTYIE = 1;  // FIFO Not Empty Interrupt Enable (Enabled, only subscribed IDs get this far)
   C1FIFOINT0bits.RXOVFLIE = 1;    // FIFO Overflow Interrupt Enable (Enabled)
 
   // CAN1 FIFO 1
-  C1FIFOCON1bits.TXEN = 1;        // TX/RX Buffer Selection (Transmit FIFO)
-  C1FIFOCON1bits.FSIZE = 0b11111; // FIFO Size bits (32 messages deep)
+  C1FIFOCON1bits.TXEN = 1;                  // TX/RX Buffer Selection (Transmit FIFO)
+  C1FIFOCON1bits.FSIZE = CAN_TX_HW_DEPTH - 1; // FIFO Size bits (CAN_TX_HW_DEPTH messages deep)
+  C1FIFOCON1bits.TXPRI = 0b11;              // Message Transmit Priority (Highest)
   C1FIFOINT1bits.TXEMPTYIE = 0;  // FIFO TX Empty Interrupt Enable (Disabled)
-  C1FIFOINT1bits.TXHALFIE = 0;   // FIFO TX Half Full Interrupt Enable (Disabled)
+  C1FIFOINT1bits.TXHALFIE = 0;   // FIFO TX Half Full Interrupt Enable (Enabled by CAN_tx_fill while frames are queued)
   C1FIFOINT1bits.TXNFULLIE = 0;  // FIFO TX Not Full Interrupt Enable (Disabled)
 
-  /**
-   * Here, we set up the first CAN acceptance filter to allow any messages with standard
-   * identifiers to be sent to the receive buffer (FIFO 0). All messages with extended
-   * identifiers are ignored.
-   */
-
-  // CAN1 Acceptance Filter 0
-  C1RXF0bits.SID = 0;  // Standard Identifier bits (Must be all zeros (minus mask) to match)
-  C1RXF0bits.EXID = 0; // Extended Identifier Enable bits (Match only standard identifier)
-  C1RXF0bits.EID = 0;  // Extended Identifier bits (Must be all zeros (minus mask) to match)
+  // CAN1 FIFO 2
+  C1FIFOCON2bits.TXEN = 1;                  // TX/RX Buffer Selection (Transmit FIFO)
+  C1FIFOCON2bits.FSIZE = CAN_TX_HW_DEPTH - 1; // FIFO Size bits (CAN_TX_HW_DEPTH messages deep)
+  C1FIFOCON2bits.TXPRI = 0b10;              // Message Transmit Priority (High intermediate)
+  C1FIFOINT2bits.TXEMPTYIE = 0;  // FIFO TX Empty Interrupt Enable (Disabled)
+  C1FIFOINT2bits.TXHALFIE = 0;   // FIFO TX Half Full Interrupt Enable (Enabled by CAN_tx_fill while frames are queued)
+  C1FIFOINT2bits.TXNFULLIE = 0;  // FIFO TX Not Full Interrupt Enable (Disabled)
 
-  // CAN1 Acceptance Filter Mask 0
-  C1RXM0bits.SID = 0;       // Standard Identifier bits (No bits included in filter comparison)
-  C1RXM0bits.MIDE = 1;      // Identifier Receive Mode bit (Match only message types that correspond to EXID bit in filter)
-  C1RXM0bits.EID = 0x3FFFF; // Extended Identifier bits (All bits included in filter comparison)
+  // CAN1 FIFO 3
+  C1FIFOCON3bits.TXEN = 0;       // TX/RX Buffer Selection (Receive FIFO)
+  C1FIFOCON3bits.FSIZE = CAN_CRIT_FIFO_SIZE - 1; // FIFO Size bits (16 messages deep)
+  C1FIFOCON3bits.DONLY = 0;      // Store Message Data Only (Full message is stored, including identifier)
+  C1FIFOINT3bits.RXHALFIE = 0;   // FIFO Half Full Interrupt Enable (Disabled)
+  C1FIFOINT3bits.RXFULLIE = 0;   // FIFO Full Interrupt Enable (Disabled)
+  C1FIFOINT3bits.RXNEMPTYIE = 1; // FIFO Not Empty Interrupt Enable (Enabled, critical frames are handled immediately)
+  C1FIFOINT3bits.RXOVFLIE = 1;   // FIFO Overflow Interrupt Enable (Enabled)
 
-  // CAN1 Filter 0 - Filter must be disabled before modification
-  C1FLTCON0bits.FLTEN0 = 0;       // Filter 0 Enable bit (Filter is disabled)
-  C1FLTCON0bits.MSEL0 = 0b00;     // Filter 0 Mask Select bits (Acceptance Mask 0 selected)
-  C1FLTCON0bits.FSEL0 = 0b00000;  // FIFO Selection bits (Message matching filter is stored in FIFO 0)
-  C1FLTCON0bits.FLTEN0 = 1;       // Filter 0 Enable bit (Filter is enabled)
+  /**
+   * Program the acceptance filters from the IDs subscribed with
+   * CAN_subscribe() and CAN_subscribe_ext(). Critical IDs are stored in FIFO 3
+   * and the rest in FIFO 0. Extended IDs that aren't subscribed are ignored.
+   */
+  CAN_program_filters();
 
   // Set up CAN1 Interrupt
   IFS4bits.CAN1IF = 0;  // CAN1 Interrupt Flag Status (No interrupt request has occurred)
@@ -213,10 +1372,14 @@ void init_can(void) {
   C1INTbits.RBIE = 1; // Receive Buffer Interrupt Enable (Enabled)
   C1INTbits.RBOVIF = 0; // Receive Buffer Overflow Interrupt Flag (Not pending)
   C1INTbits.RBOVIE = 1; // Receive Buffer Overflow Interrupt Enable (Enabled)
+  C1INTbits.TBIE = 1;   // Transmit Buffer Interrupt Enable (Enabled)
 
   C1CONbits.REQOP = 0b000; // Request Operation Mode (Set Normal Operation mode)
   while(C1CONbits.OPMOD != 0b000); // Wait for the module to finish
 
+  // Line the timestamp timer up with millis, see CAN_micros()
+  CAN_ts_phase = C1TMRbits.CANTS - (uint16_t) (millis * 1000);
+
   CFGCONbits.IOLOCK = 1; // Peripheral Pin Select Lock (Locked)
   lock_config();
 }
@@ -226,15 +1389,93 @@ void init_can(void) {
 */
 double CAN_extract_numeric(uint8_t * data, uint8_t pos, uint8_t length, 
 		Endian endianness, uint8_t sgn, double scl, double off) {
-	uint32_t rawField = CAN_parse_bytes(data, pos, length, endianness);
 	if(sgn) {
-		return (((double) ((int32_t) rawField)) - off) * scl;
+		return (((double) CAN_extract_raw(data, pos, length, endianness, sgn)) - off) * scl;
 	} else {
-		return (((double) rawField) - off) * scl;
+		return (((double) CAN_parse_bytes(data, pos, length, endianness)) - off) * scl;
 	}
 
 }
 
+/**
+ * Integer parsing function for a numeric CAN field. Signed fields are sign
+ * extended from their length, so a signed 1 or 2 byte field decodes the same
+ * as a 4 byte one. Unsigned 4 byte fields above INT32_MAX wrap, use
+ * CAN_parse_bytes for those.
+ */
+int32_t CAN_extract_raw(uint8_t * data, uint8_t pos, uint8_t length,
+		Endian endianness, uint8_t sgn) {
+	uint32_t rawField = CAN_parse_bytes(data, pos, length, endianness);
+	if(sgn) {
+		switch (length) {
+			case 1:
+				return (int8_t) rawField;
+			case 2:
+				return (int16_t) rawField;
+			default:
+				break;
+		}
+	}
+	return (int32_t) rawField;
+}
+
+/**
+ * int64_t CAN_mul_sat(int64_t a, int32_t b)
+ *
+ * @returns a * b, saturated to +/-INT64_MAX. A raw field less an int32_t
+ *     offset is below 2^33, so |a * b| always fits in a uint64_t.
+ */
+static int64_t CAN_mul_sat(int64_t a, int32_t b) {
+	uint64_t mag = (uint64_t) (a < 0 ? -a : a) * (uint64_t) (b < 0 ? -(int64_t) b : b);
+	if(mag > INT64_MAX) {
+		return (a < 0) != (b < 0) ? -INT64_MAX : INT64_MAX;
+	}
+	return a * b;
+}
+
+/**
+ * Fixed point version of CAN_extract_numeric for use in interrupts. Returns
+ * (raw - off) * scl in Q16.16, where scl is a compile time constant such as
+ * Q16(ENG_RPM_SCL). The product is formed in 64 bits (a single mult on the
+ * PIC32) and saturates to the q16_t range, +/-32768. Rounding scl to Q16.16
+ * limits the relative error to 2^-17 / scl, so about 0.008% for a scl of 0.1.
+ */
+q16_t CAN_extract_q16(uint8_t * data, uint8_t pos, uint8_t length,
+		Endian endianness, uint8_t sgn, q16_t scl, int32_t off) {
+	int64_t rawField = sgn ? (int64_t) CAN_extract_raw(data, pos, length, endianness, sgn) :
+		(int64_t) CAN_parse_bytes(data, pos, length, endianness);
+	int64_t value = CAN_mul_sat(rawField - off, scl);
+	if(value > INT32_MAX) {
+		return INT32_MAX;
+	} else if(value < INT32_MIN) {
+		return INT32_MIN;
+	}
+	return (q16_t) value;
+}
+
+/**
+ * Fixed point version of CAN_extract_numeric for signals that outgrow Q16.16.
+ * Returns (raw - off) * num / den rounded toward zero, so with a scalar of 0.1
+ * a num of 100 and den of 1 gives the value in hundredths. num and den should
+ * be compile time constants; a den of 1 avoids the divide entirely.
+ */
+int32_t CAN_extract_scaled(uint8_t * data, uint8_t pos, uint8_t length,
+		Endian endianness, uint8_t sgn, int32_t num, int32_t den, int32_t off) {
+	int64_t rawField = sgn ? (int64_t) CAN_extract_raw(data, pos, length, endianness, sgn) :
+		(int64_t) CAN_parse_bytes(data, pos, length, endianness);
+	// A product that saturates is above 2^63, so still saturates once divided
+	int64_t value = CAN_mul_sat(rawField - off, num);
+	if(den != 1) {
+		value /= den;
+	}
+	if(value > INT32_MAX) {
+		return INT32_MAX;
+	} else if(value < INT32_MIN) {
+		return INT32_MIN;
+	}
+	return (int32_t) value;
+}
+
 double CAN_extract_bit(uint8_t * data, uint8_t bytePos, uint8_t length, Endian endianness, uint8_t bitPos) {
 	uint32_t rawField = CAN_parse_bytes(data, bytePos, length, endianness);
 	return (double) ((rawField & (0x1 << bitPos)) >> bitPos);
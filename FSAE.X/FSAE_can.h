@@ -12,14 +12,40 @@
 #include <xc.h>
 #include <sys/kmem.h>
 #include <sys/types.h>
+#include <stdint.h>
 
 /**
- * A friendly struct for storing CAN message data.
+ * Identifiers
+ *
+ * IDs are 11 bit standard identifiers unless CAN_EXT_FLAG is set, in which
+ * case the low 29 bits are an extended identifier. CAN_RTR_FLAG marks a remote
+ * request, which carries no data. The flags sit above the identifier as in
+ * Linux SocketCAN, so standard data frames keep their plain 11 bit IDs.
+ */
+#define CAN_EXT_FLAG 0x80000000u
+#define CAN_RTR_FLAG 0x40000000u
+#define CAN_SID_MASK 0x000007FFu
+#define CAN_EID_MASK 0x1FFFFFFFu
+
+/**
+ * Payload length
+ *
+ * The PIC32MZ module is classic CAN, so frames carry up to 8 bytes and DLC
+ * codes above 8 still mean 8 bytes. CAN FD uses those codes for 12 to 64
+ * bytes; CAN_dlc_to_len() and CAN_len_to_dlc() convert either way up to
+ * CAN_MAX_DLEN, which is the only thing to raise for an FD module.
+ */
+#define CAN_MAX_DLEN 8
+
+/**
+ * A friendly struct for storing CAN message data. The payload is last so it
+ * can grow with CAN_MAX_DLEN without moving the other fields.
  */
 typedef struct {
-    uint32_t id;
+    uint32_t id; // Identifier and flags, see CAN_EXT_FLAG
     uint32_t dlc;
-    uint8_t data[8];
+    uint32_t timestamp; // Receive time in microseconds, see CAN_micros()
+    uint8_t data[CAN_MAX_DLEN];
 } CAN_message;
 
 /**
@@ -108,6 +134,26 @@ typedef union uCanRxMessageBuffer {
   int messageWord[4];
 } CanRxMessageBuffer;
 
+/**
+ * Zero-copy receive
+ *
+ * CAN_recv_frames() passes the handler a pointer to each frame where it sits
+ * in the receive FIFO, and CAN_recv_batch() passes every waiting frame that is
+ * contiguous in the FIFO at once. The buffers go back to the CAN module when
+ * the handler returns, so handlers must copy anything they keep.
+ */
+typedef void (*CAN_frame_handler)(const CanRxMessageBuffer* frame);
+typedef void (*CAN_batch_handler)(const CanRxMessageBuffer* frames, uint32_t count);
+
+// IDE and SRR in CMSGEID, set for extended frames and standard remote requests
+#define CAN_FRAME_FLAG_BITS 0x30000000
+
+// CAN_FRAME_ID() only calls CAN_frame_id() for frames that aren't standard data
+#define CAN_FRAME_ID(frame)   (((frame)->messageWord[1] & CAN_FRAME_FLAG_BITS) ? \
+    CAN_frame_id(frame) : (uint32_t) (frame)->CMSGSID.SID)
+#define CAN_FRAME_DLC(frame)  ((frame)->CMSGEID.DLC)
+#define CAN_FRAME_DATA(frame) ((const uint8_t*) &(frame)->messageWord[2])
+
 /**
  * CanTxMessageBuffer struct
  */
@@ -158,19 +204,215 @@ typedef union uCanTxMessageBuffer {
   int messageWord[4];
 } CanTxMessageBuffer;
 
+/**
+ * Software transmit queue
+ *
+ * CAN_send_message() places frames in a RAM queue ordered by ID, lowest ID
+ * first, then by age. The queue feeds two shallow hardware TX FIFOs: FIFO 1
+ * at the higher TXPRI takes frames more urgent than anything in FIFO 2, and
+ * FIFO 2 takes the rest, so a new high priority frame waits behind at most
+ * CAN_TX_HW_DEPTH frames already handed to the module. The FIFOs are refilled
+ * from the CAN interrupt when they fall to half full, so nodes must call
+ * CAN_tx_service() when C1INTbits.TBIF is set.
+ *
+ * Frames are ordered as they would win arbitration, so an extended frame
+ * follows the standard frames that share its top 11 bits. When the queue is
+ * full the lowest priority frame is dropped, the oldest one if several share
+ * that ID, and counted in CAN_tx_ovf and in CAN_tx_drops under the top 11 bits
+ * of its ID.
+ */
+#define CAN_TX_QUEUE_SIZE 64
+#define CAN_TX_HW_DEPTH   4
+#define CAN_SID_COUNT     2048
+
+typedef struct {
+  uint32_t id;
+  uint32_t key; // Arbitration order, see CAN_tx_key()
+  uint32_t dlc;
+  CAN_data data;
+  uint32_t seq;
+} CAN_tx_entry;
+
+/**
+ * Receive filtering and dispatch
+ *
+ * Nodes register a handler for each ID or range of IDs they use with
+ * CAN_subscribe() before calling init_can(). init_can() then programs the
+ * acceptance filters so the module only stores subscribed IDs, and
+ * CAN_dispatch_messages() calls each frame's handler through a table indexed
+ * by ID. Critical subscriptions are received into FIFO 3, which interrupts on
+ * every frame and is always drained before FIFO 0.
+ *
+ * The module has 32 filters but only 4 masks, so the subscribed IDs are
+ * covered with aligned power of two blocks using at most 4 block sizes. Blocks
+ * are widened until they fit, so unrelated IDs can get through the filters;
+ * those have no handler and are discarded by the dispatcher. If nothing is
+ * subscribed every standard ID is received into FIFO 0.
+ *
+ * Extended IDs are subscribed by value and mask with CAN_subscribe_ext(). Each
+ * takes one filter, and together they take one of the masks, so the standard
+ * IDs are covered with the rest.
+ */
+#define CAN_NORMAL   0
+#define CAN_CRITICAL 1
+#define CAN_FILTERS  32
+#define CAN_MASKS    4
+#define CAN_EXT_SUBS 4
+
+typedef void (*CAN_handler)(CAN_message msg);
+
+// Aligned block of 2^k IDs starting at base, matched by one filter
+typedef struct {
+  uint16_t base;
+  uint8_t k;
+  uint8_t critical;
+} CAN_filter_block;
+
+/**
+ * CAN health
+ *
+ * CAN_health_service() watches the module's error counters in C1TREC from the
+ * main loop. When the module goes bus-off it is taken offline through
+ * configuration mode, which clears the counters, and brought back after a
+ * backoff. The backoff starts at CAN_BACKOFF_MIN_MS and doubles, up to
+ * CAN_BACKOFF_MAX_MS, each time the module goes bus-off again within
+ * CAN_BACKOFF_STABLE_MS of recovering. Frames sent while the module is offline
+ * wait in the transmit queue.
+ *
+ * Every CAN_HEALTH_INTV ms the frame, byte and error counts for the interval
+ * are copied to CAN_health, and published in the node's health message if
+ * CAN_health_init() has been called. Errors are counted from the rise in the
+ * error counters between calls, so call CAN_health_service() often.
+ */
+#define CAN_ACTIVE  0 // Error active
+#define CAN_WARNING 1 // An error counter has reached 96
+#define CAN_PASSIVE 2 // An error counter has reached 128
+#define CAN_BUS_OFF 3 // TEC passed 255, offline until recovered
+
+#define CAN_HEALTH_INTV       1000
+#define CAN_BACKOFF_MIN_MS    10
+#define CAN_BACKOFF_MAX_MS    1000
+#define CAN_BACKOFF_STABLE_MS 5000
+
+typedef struct {
+  uint8_t state;     // CAN_ACTIVE, CAN_WARNING, CAN_PASSIVE or CAN_BUS_OFF
+  uint8_t tec;       // Transmit error counter
+  uint8_t rec;       // Receive error counter
+  uint32_t bus_offs; // Times the module has gone bus-off
+  uint32_t backoff;  // Time offline in ms after the last bus-off
+
+  // Counts for the last complete interval
+  uint32_t rx_frames;
+  uint32_t rx_bytes;
+  uint32_t tx_frames; // Frames handed to the module
+  uint32_t tx_bytes;
+  uint32_t errors;
+} CAN_health_stats;
+
+/**
+ * Periodic messages
+ *
+ * CAN_sched_add() registers a message to be sent every <period> ms, at the
+ * times where millis % period == phase. When the message is due,
+ * CAN_sched_service() calls its pack function to fill in the data and queues
+ * the frame. With CAN_SCHED_AUTO the phase is chosen to collide with as few
+ * of the messages already registered as possible, so messages with the same
+ * period are spread over it rather than sent in a burst.
+ *
+ * CAN_sched_trigger() has a message sent early when its contents have
+ * changed, as OVERRIDE did for the hand-written send functions. The next call
+ * to CAN_sched_service() sends it, and every trigger since the last send is
+ * merged into that one frame. A triggered message is sent at most once every
+ * CAN_SCHED_HOLDOFF_MS. A triggered send in the last 1/CAN_SCHED_COALESCE of a
+ * period stands in for the periodic send at its end, so the gap between sends
+ * is at most that much over the period.
+ *
+ * Every CAN_SCHED_INTV ms the counts for the interval are copied to CAN_sched,
+ * where the sends achieved can be compared with those requested.
+ */
+#define CAN_SCHED_MAX        16
+#define CAN_SCHED_AUTO       0xFFFF
+#define CAN_SCHED_HOLDOFF_MS 1
+#define CAN_SCHED_COALESCE   8
+#define CAN_SCHED_INTV       1000
+
+/**
+ * Fills in <data> for the periodic message <id>.
+ *
+ * @returns The DLC to send, or 0 to skip this send
+ */
+typedef uint32_t (*CAN_packer)(uint32_t id, CAN_data* data);
+
+typedef struct {
+  uint32_t id;
+  uint16_t period; // Requested period in ms
+  uint16_t phase;  // Offset of the periodic sends within the period in ms
+
+  // Counts for the last complete interval
+  uint16_t requested; // Periodic sends that fell due
+  uint16_t sent;      // Frames queued, periodic and triggered
+  uint16_t triggered; // Frames queued by CAN_sched_trigger()
+  uint16_t coalesced; // Triggers and periodic sends merged into another send
+  uint16_t missed;    // Periodic sends skipped, CAN_sched_service() was late
+} CAN_sched_stats;
+
+/**
+ * Q16.16 fixed point type used to decode CAN fields without floating point
+ */
+typedef int32_t q16_t;
+#define Q16_SHIFT 16
+#define Q16_ONE   (1 << Q16_SHIFT)
+
+// Converts a constant such as a *_SCL define to Q16.16 at compile time
+#define Q16(x) ((q16_t) ((x) * 65536.0 + ((x) < 0 ? -0.5 : 0.5)))
+
+// Integer part of a Q16.16 value, rounded toward negative infinity
+#define Q16_TO_INT(q) ((q) >> Q16_SHIFT)
+
+// Defined by each node, incremented every millisecond
+extern volatile uint32_t millis;
+
 // Defined in FSAE_CAN.c
 extern volatile uint32_t CAN_rx_ovf;
 extern volatile uint32_t CAN_tx_ovf;
+extern volatile uint16_t CAN_tx_drops[CAN_SID_COUNT];
+extern CAN_health_stats CAN_health;
+extern CAN_sched_stats CAN_sched[CAN_SCHED_MAX];
+extern uint32_t CAN_sched_len;
 
 // Function definitions
 void CAN_send_message(uint32_t id, uint32_t dlc, CAN_data data);
-void CAN_recv_messages(void (*handler)(CAN_message msg));
+void CAN_recv_messages(CAN_handler handler);
+void CAN_recv_frames(CAN_frame_handler handler);
+void CAN_recv_batch(CAN_batch_handler handler);
+void CAN_subscribe(uint32_t id, uint32_t count, CAN_handler handler, uint8_t critical);
+void CAN_subscribe_ext(uint32_t id, uint32_t mask, CAN_handler handler, uint8_t critical);
+void CAN_dispatch_messages(void);
+void CAN_set_rx_log(CAN_handler log);
+uint32_t CAN_micros(void);
+uint32_t CAN_frame_timestamp(const CanRxMessageBuffer* frame);
+uint32_t CAN_frame_id(const CanRxMessageBuffer* frame);
+uint8_t CAN_dlc_to_len(uint8_t dlc);
+uint8_t CAN_len_to_dlc(uint8_t len);
+void CAN_tx_service(void);
+uint32_t CAN_tx_free(void);
+void CAN_health_init(uint32_t id);
+void CAN_health_service(void);
+void CAN_sched_add(uint32_t id, uint32_t period, uint32_t phase, CAN_packer pack);
+void CAN_sched_trigger(uint32_t id);
+void CAN_sched_service(void);
 void init_can(void);
 double CAN_extract_numeric(uint8_t * data, uint8_t position, uint8_t length, 
 		Endian endianness, uint8_t sgn, double scl, double off);
 double CAN_extract_bit(uint8_t * data, uint8_t bytePos, uint8_t length, 
 		Endian endianness, uint8_t bitPos);
 uint32_t CAN_parse_bytes(uint8_t * data, uint8_t pos, uint8_t length, Endian endianness);
+int32_t CAN_extract_raw(uint8_t * data, uint8_t pos, uint8_t length,
+		Endian endianness, uint8_t sgn);
+q16_t CAN_extract_q16(uint8_t * data, uint8_t pos, uint8_t length,
+		Endian endianness, uint8_t sgn, q16_t scl, int32_t off);
+int32_t CAN_extract_scaled(uint8_t * data, uint8_t pos, uint8_t length,
+		Endian endianness, uint8_t sgn, int32_t num, int32_t den, int32_t off);
 
 
 #endif /* FSAE_CAN_H */
@@ -18,6 +18,7 @@
 #define REFCLKO      0 // Determines whether SYSCLK / 10 is driven out on RF0
 #define COMP         1 // Determines whether we are at competition
 #define PBCLK2       100 // PBCLK is 100mhz, SYSCLK/2
+#define PBCLK5       100 // PBCLK5 is 100mhz, SYSCLK/2
 
 // TRIS Settings
 #define OUTPUT 0
@@ -39,8 +40,31 @@
 #define TERM_TRIS TRISAbits.TRISA2
 #define TERM_LAT  LATAbits.LATA2
 
+/**
+ * Interrupt control. The host build (see host/xc.h) runs interrupt handlers
+ * from a separate thread, so these map to the host backend there.
+ */
+#ifdef FSAE_HOST
+#define ISR(vec, ipl) __attribute__((used))
+#define CLI() host_cli()
+#define STI() host_sti()
+#define ERET() host_eret()
+#define CLI_SAVE(status) ((status) = host_cli_save())
+#define RAMFUNC
+#define COHERENT
+#else
+#define ISR(vec, ipl) __attribute__((vector(vec), interrupt(ipl)))
 #define CLI() asm volatile("di; ehb;")
 #define STI() asm volatile("ei;")
+#define ERET() asm volatile("eret;")
+#define CLI_SAVE(status) asm volatile("di %0; ehb;" : "=r"(status))
+#define RAMFUNC __attribute__((ramfunc, long_call)) // Runs from RAM, for flash panel swaps
+#define COHERENT __attribute__((coherent)) // Uncached, for memory DMA or the NVM controller reads
+#endif
+
+// Re-enables interrupts only if they were enabled when CLI_SAVE() ran, so code
+// that may run in an interrupt handler or with interrupts off can nest safely
+#define STI_RESTORE(status) do { if ((status) & 0x1) { STI(); } } while (0)
 
 // Function definitions
 void unlock_config(void);
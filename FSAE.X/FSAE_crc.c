@@ -0,0 +1,34 @@
+/**
+ * FSAE Library CRC
+ *
+ * Processor:   PIC32MZ2048EFM100
+ * Compiler:    Microchip XC32
+ * Created:     2026
+ */
+#include "FSAE_crc.h"
+
+// CRC-32 (IEEE 802.3, as zlib) of each nibble, reflected
+static const uint32_t crc32_table[16] = {
+  0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+  0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+  0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+  0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+/**
+ * uint32_t crc32(uint32_t crc, const uint8_t* data, uint32_t len)
+ *
+ * Continues a CRC-32 over <len> more bytes, starting from 0. Matches zlib's
+ * crc32() and the host flasher's.
+ *
+ * @returns The CRC-32 of everything passed so far
+ */
+uint32_t crc32(uint32_t crc, const uint8_t* data, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    crc = (crc >> 4) ^ crc32_table[crc & 0xF];
+    crc = (crc >> 4) ^ crc32_table[crc & 0xF];
+  }
+  return ~crc;
+}
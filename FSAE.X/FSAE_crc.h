@@ -0,0 +1,17 @@
+/**
+ * FSAE Library CRC Header
+ *
+ * Processor:   PIC32MZ2048EFM100
+ * Compiler:    Microchip XC32
+ * Created:     2026
+ */
+#ifndef FSAE_CRC_H
+#define FSAE_CRC_H
+
+#include <sys/types.h>
+#include <stdint.h>
+
+// Function definitions
+uint32_t crc32(uint32_t crc, const uint8_t* data, uint32_t len);
+
+#endif /* FSAE_CRC_H */
@@ -0,0 +1,381 @@
+/**
+ * FSAE Library ISO-TP
+ *
+ * Processor:   PIC32MZ2048EFM100
+ * Compiler:    Microchip XC32
+ * Created:     2026
+ */
+#include "FSAE_isotp.h"
+
+/**
+ * void ISOTP_init(ISOTP_link* link, uint32_t tx_id, uint32_t rx_id,
+ *     uint8_t* rx_buf, uint32_t rx_size, ISOTP_rx_handler on_rx,
+ *     ISOTP_tx_handler on_tx)
+ *
+ * Sets up a link, which asks senders for ISOTP_BLOCK_SIZE and an STmin of 0
+ * until <st_min> is changed.
+ *
+ * @param tx_id The ID to send on, including any CAN_EXT_FLAG
+ * @param rx_id The ID the node receives on and passes to ISOTP_receive()
+ * @param rx_buf Where received messages are put, up to <rx_size> bytes
+ * @param on_rx Called with each message received, may be NULL
+ * @param on_tx Called when each message sent has finished, may be NULL
+ */
+void ISOTP_init(ISOTP_link* link, uint32_t tx_id, uint32_t rx_id, uint8_t* rx_buf,
+    uint32_t rx_size, ISOTP_rx_handler on_rx, ISOTP_tx_handler on_tx) {
+  memset(link, 0, sizeof(ISOTP_link));
+  link->tx_id = tx_id;
+  link->rx_id = rx_id;
+  link->rx_buf = rx_buf;
+  link->rx_size = rx_size;
+  link->on_rx = on_rx;
+  link->on_tx = on_tx;
+}
+
+/**
+ * void ISOTP_receive(ISOTP_link* link, CAN_message msg)
+ *
+ * Buffers a frame received on the link's ID for ISOTP_service(). Call from
+ * the node's handler for that ID.
+ */
+void ISOTP_receive(ISOTP_link* link, CAN_message msg) {
+  uint8_t head = link->ring_head;
+  uint8_t next = (head + 1) % ISOTP_RX_RING;
+  if (msg.dlc == 0) {
+    return;
+  }
+  if (next == link->ring_tail) {
+    link->ring_drops++;
+    return;
+  }
+  link->ring[head].dlc = msg.dlc > CAN_MAX_DLEN ? CAN_MAX_DLEN : msg.dlc;
+  memcpy(link->ring[head].data, msg.data, CAN_MAX_DLEN);
+  link->ring_head = next;
+}
+
+/**
+ * void ISOTP_send_fc(ISOTP_link* link, uint8_t status)
+ *
+ * Sends a flow control frame with the link's block size and STmin.
+ */
+static void ISOTP_send_fc(ISOTP_link* link, uint8_t status) {
+  CAN_data data = {0};
+  data.byte0 = (ISOTP_PCI_FC << 4) | status;
+  data.byte1 = ISOTP_BLOCK_SIZE;
+  data.byte2 = link->st_min;
+  CAN_send_message(link->tx_id, 3, data);
+}
+
+/**
+ * uint32_t ISOTP_st_us(uint8_t st_min)
+ *
+ * @returns The separation time in microseconds encoded by <st_min>. Reserved
+ *     values are taken as the longest, 127 ms, as the standard requires.
+ */
+static uint32_t ISOTP_st_us(uint8_t st_min) {
+  if (st_min <= 0x7F) {
+    return st_min * 1000;
+  }
+  if (st_min >= 0xF1 && st_min <= 0xF9) {
+    return (st_min - 0xF0) * 100;
+  }
+  return 127000;
+}
+
+/**
+ * void ISOTP_rx_done(ISOTP_link* link, uint32_t len)
+ *
+ * Hands a complete message to the node.
+ */
+static void ISOTP_rx_done(ISOTP_link* link, uint32_t len) {
+  link->rx_state = ISOTP_IDLE;
+  link->rx_messages++;
+  if (link->on_rx != NULL) {
+    link->on_rx(link, link->rx_buf, len);
+  }
+}
+
+/**
+ * void ISOTP_tx_finish(ISOTP_link* link, uint8_t result)
+ *
+ * Ends the message being sent, reporting <result> from ISOTP_service().
+ */
+static void ISOTP_tx_finish(ISOTP_link* link, uint8_t result) {
+  link->tx_state = ISOTP_DONE;
+  link->tx_result = result;
+  if (result != ISOTP_SUCCESS) {
+    link->errors++;
+  }
+}
+
+/**
+ * void ISOTP_handle_frame(ISOTP_link* link, ISOTP_frame* frame)
+ *
+ * Runs one received frame through the link's state machines.
+ */
+static void ISOTP_handle_frame(ISOTP_link* link, ISOTP_frame* frame) {
+  uint8_t* data = frame->data;
+  uint32_t len;
+  uint32_t start;
+
+  switch (data[0] >> 4) {
+    case ISOTP_PCI_SF:
+      // A new message abandons any unfinished one
+      len = data[0] & 0xF;
+      if (len == 0 || len >= frame->dlc) {
+        return;
+      }
+      if (len > link->rx_size) {
+        link->errors++;
+        link->rx_state = ISOTP_IDLE;
+        return;
+      }
+      memcpy(link->rx_buf, &data[1], len);
+      ISOTP_rx_done(link, len);
+      break;
+
+    case ISOTP_PCI_FF:
+      len = ((data[0] & 0xF) << 8) | data[1];
+      start = 2;
+      if (len == 0) {
+        len = ((uint32_t) data[2] << 24) | ((uint32_t) data[3] << 16) |
+          ((uint32_t) data[4] << 8) | data[5];
+        start = 6;
+      }
+      if (len <= ISOTP_SF_MAX || frame->dlc < CAN_MAX_DLEN) {
+        return;
+      }
+      if (len > link->rx_size) {
+        link->errors++;
+        link->rx_state = ISOTP_IDLE;
+        ISOTP_send_fc(link, ISOTP_FS_OVFLW);
+        return;
+      }
+      memcpy(link->rx_buf, &data[start], CAN_MAX_DLEN - start);
+      link->rx_len = len;
+      link->rx_pos = CAN_MAX_DLEN - start;
+      link->rx_sn = 1;
+      link->rx_block = ISOTP_BLOCK_SIZE;
+      link->rx_tmr = millis;
+      link->rx_state = ISOTP_RECV;
+      ISOTP_send_fc(link, ISOTP_FS_CTS);
+      break;
+
+    case ISOTP_PCI_CF:
+      if (link->rx_state != ISOTP_RECV) {
+        return;
+      }
+      if ((data[0] & 0xF) != link->rx_sn) {
+        link->errors++;
+        link->rx_state = ISOTP_IDLE;
+        return;
+      }
+      len = link->rx_len - link->rx_pos;
+      if (len > (uint32_t) (frame->dlc - 1)) {
+        len = frame->dlc - 1;
+      }
+      memcpy(link->rx_buf + link->rx_pos, &data[1], len);
+      link->rx_pos += len;
+      link->rx_sn = (link->rx_sn + 1) & 0xF;
+      link->rx_tmr = millis;
+
+      if (link->rx_pos == link->rx_len) {
+        ISOTP_rx_done(link, link->rx_len);
+      } else if (--link->rx_block == 0) {
+        link->rx_block = ISOTP_BLOCK_SIZE;
+        ISOTP_send_fc(link, ISOTP_FS_CTS);
+      }
+      break;
+
+    case ISOTP_PCI_FC:
+      if (link->tx_state != ISOTP_WAIT_FC || frame->dlc < 3) {
+        return;
+      }
+      switch (data[0] & 0xF) {
+        case ISOTP_FS_CTS:
+          link->tx_bs = data[1];
+          link->tx_block = data[1];
+          link->tx_st_us = ISOTP_st_us(data[2]);
+          link->tx_last_us = CAN_micros() - link->tx_st_us;
+          link->tx_waits = 0;
+          link->tx_state = ISOTP_SENDING;
+          break;
+        case ISOTP_FS_WAIT:
+          link->tx_tmr = millis;
+          if (++link->tx_waits > ISOTP_MAX_WAIT) {
+            ISOTP_tx_finish(link, ISOTP_ERR_ABORTED);
+          }
+          break;
+        case ISOTP_FS_OVFLW:
+          ISOTP_tx_finish(link, ISOTP_ERR_OVERFLOW);
+          break;
+        default:
+          ISOTP_tx_finish(link, ISOTP_ERR_ABORTED);
+          break;
+      }
+      break;
+  }
+}
+
+/**
+ * void ISOTP_tx_copy(ISOTP_link* link, uint8_t* data, uint32_t len)
+ *
+ * Copies the next <len> bytes of the message being sent into <data>.
+ */
+static void ISOTP_tx_copy(ISOTP_link* link, uint8_t* data, uint32_t len) {
+  if (link->tx_source != NULL) {
+    link->tx_source(link, link->tx_pos, data, len);
+  } else {
+    memcpy(data, link->tx_data + link->tx_pos, len);
+  }
+  link->tx_pos += len;
+}
+
+/**
+ * uint8_t ISOTP_start(ISOTP_link* link, uint32_t len)
+ *
+ * Sends the single frame or first frame of the message set up on the link.
+ */
+static uint8_t ISOTP_start(ISOTP_link* link, uint32_t len) {
+  CAN_data data = {0};
+  uint8_t* bytes = (uint8_t*) &data;
+
+  link->tx_len = len;
+  link->tx_pos = 0;
+  if (len <= ISOTP_SF_MAX) {
+    bytes[0] = (ISOTP_PCI_SF << 4) | len;
+    ISOTP_tx_copy(link, &bytes[1], len);
+    CAN_send_message(link->tx_id, len + 1, data);
+    link->tx_messages++;
+    ISOTP_tx_finish(link, ISOTP_SUCCESS);
+    return ISOTP_SUCCESS;
+  }
+
+  if (len <= ISOTP_FF_MAX) {
+    bytes[0] = (ISOTP_PCI_FF << 4) | (len >> 8);
+    bytes[1] = len & 0xFF;
+    ISOTP_tx_copy(link, &bytes[2], CAN_MAX_DLEN - 2);
+  } else {
+    bytes[0] = ISOTP_PCI_FF << 4;
+    bytes[2] = len >> 24;
+    bytes[3] = (len >> 16) & 0xFF;
+    bytes[4] = (len >> 8) & 0xFF;
+    bytes[5] = len & 0xFF;
+    ISOTP_tx_copy(link, &bytes[6], CAN_MAX_DLEN - 6);
+  }
+  CAN_send_message(link->tx_id, CAN_MAX_DLEN, data);
+  link->tx_sn = 1;
+  link->tx_waits = 0;
+  link->tx_tmr = millis;
+  link->tx_state = ISOTP_WAIT_FC;
+  return ISOTP_SUCCESS;
+}
+
+/**
+ * uint8_t ISOTP_send(ISOTP_link* link, const uint8_t* data, uint32_t len)
+ *
+ * Starts sending a message from RAM. <data> must stay valid until the link's
+ * transmit handler is called.
+ *
+ * @returns ISOTP_SUCCESS, or ISOTP_ERR_BUSY if a message is being sent
+ */
+uint8_t ISOTP_send(ISOTP_link* link, const uint8_t* data, uint32_t len) {
+  if (link->tx_state != ISOTP_IDLE) {
+    return ISOTP_ERR_BUSY;
+  }
+  link->tx_data = data;
+  link->tx_source = NULL;
+  return ISOTP_start(link, len);
+}
+
+/**
+ * uint8_t ISOTP_send_from(ISOTP_link* link, ISOTP_source source, uint32_t len)
+ *
+ * Starts sending a message of <len> bytes read through <source> as each
+ * frame is sent.
+ *
+ * @returns ISOTP_SUCCESS, or ISOTP_ERR_BUSY if a message is being sent
+ */
+uint8_t ISOTP_send_from(ISOTP_link* link, ISOTP_source source, uint32_t len) {
+  if (link->tx_state != ISOTP_IDLE) {
+    return ISOTP_ERR_BUSY;
+  }
+  link->tx_data = NULL;
+  link->tx_source = source;
+  return ISOTP_start(link, len);
+}
+
+/**
+ * void ISOTP_send_cfs(ISOTP_link* link)
+ *
+ * Queues as many consecutive frames as the block, STmin and the room in the
+ * transmit queue allow.
+ */
+static void ISOTP_send_cfs(ISOTP_link* link) {
+  while (link->tx_pos < link->tx_len) {
+    CAN_data data = {0};
+    uint8_t* bytes = (uint8_t*) &data;
+    uint32_t len = link->tx_len - link->tx_pos;
+    uint32_t now = CAN_micros();
+
+    if (link->tx_st_us > 0 && now - link->tx_last_us < link->tx_st_us) {
+      return;
+    }
+    if (CAN_tx_free() <= ISOTP_TX_RESERVE) {
+      return;
+    }
+
+    if (len > CAN_MAX_DLEN - 1) {
+      len = CAN_MAX_DLEN - 1;
+    }
+    bytes[0] = (ISOTP_PCI_CF << 4) | link->tx_sn;
+    ISOTP_tx_copy(link, &bytes[1], len);
+    CAN_send_message(link->tx_id, len + 1, data);
+    link->tx_sn = (link->tx_sn + 1) & 0xF;
+    link->tx_last_us = now;
+
+    if (link->tx_pos == link->tx_len) {
+      link->tx_messages++;
+      ISOTP_tx_finish(link, ISOTP_SUCCESS);
+      return;
+    }
+    if (link->tx_bs > 0 && --link->tx_block == 0) {
+      link->tx_tmr = millis;
+      link->tx_state = ISOTP_WAIT_FC;
+      return;
+    }
+  }
+}
+
+/**
+ * void ISOTP_service(ISOTP_link* link)
+ *
+ * Handles the frames received since the last call, sends what flow control
+ * allows and reports finished transfers. Never blocks; call from the main
+ * loop as often as possible, since a sender waits for it between blocks.
+ */
+void ISOTP_service(ISOTP_link* link) {
+  while (link->ring_tail != link->ring_head) {
+    uint8_t tail = link->ring_tail;
+    ISOTP_handle_frame(link, &link->ring[tail]);
+    link->ring_tail = (tail + 1) % ISOTP_RX_RING;
+  }
+
+  if (link->rx_state == ISOTP_RECV && millis - link->rx_tmr >= ISOTP_TIMEOUT_MS) {
+    link->errors++;
+    link->rx_state = ISOTP_IDLE;
+  }
+
+  if (link->tx_state == ISOTP_WAIT_FC && millis - link->tx_tmr >= ISOTP_TIMEOUT_MS) {
+    ISOTP_tx_finish(link, ISOTP_ERR_TIMEOUT);
+  }
+  if (link->tx_state == ISOTP_SENDING) {
+    ISOTP_send_cfs(link);
+  }
+  if (link->tx_state == ISOTP_DONE) {
+    link->tx_state = ISOTP_IDLE;
+    if (link->on_tx != NULL) {
+      link->on_tx(link, link->tx_result);
+    }
+  }
+}
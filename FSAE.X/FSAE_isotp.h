@@ -0,0 +1,147 @@
+/**
+ * FSAE Library ISO-TP Header
+ *
+ * Processor:   PIC32MZ2048EFM100
+ * Compiler:    Microchip XC32
+ * Created:     2026
+ */
+#ifndef FSAE_ISOTP_H
+#define FSAE_ISOTP_H
+
+#include <xc.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include "FSAE_config.h"
+#include "FSAE_can.h"
+
+/**
+ * Segmented transport
+ *
+ * Carries messages longer than one frame over a pair of CAN IDs, following
+ * ISO 15765-2. A message of up to 7 bytes goes in a single frame. A longer
+ * one starts with a first frame carrying its length, and the sender then
+ * waits for a flow control frame from the receiver before sending the rest in
+ * consecutive frames of 7 bytes. The flow control frame gives the block size,
+ * the number of consecutive frames to send before waiting for the next flow
+ * control frame (0 for no limit), and STmin, the least time between them.
+ * Messages over 4095 bytes use the 32 bit length form of the first frame.
+ *
+ * Each ISOTP_link sends on one ID and receives on another. The node
+ * subscribes to the receive ID with a handler that passes each frame to
+ * ISOTP_receive(), which only buffers it, and calls ISOTP_service() from the
+ * main loop to run the transfer. A link sends and receives at the same time.
+ *
+ * Received frames wait in a ring of ISOTP_RX_RING frames until serviced, and
+ * the block size this end asks for is one less, so a sender that respects
+ * flow control never overflows it. Consecutive frames are queued only while
+ * more than ISOTP_TX_RESERVE frames are free in the CAN transmit queue, which
+ * keeps room for the node's other messages and never makes the queue drop
+ * them. With STmin 0 a transfer runs as fast as the bus takes the frames.
+ */
+#define ISOTP_RX_RING     128
+#define ISOTP_BLOCK_SIZE  (ISOTP_RX_RING - 1)
+#define ISOTP_TX_RESERVE  16
+#define ISOTP_TIMEOUT_MS  1000 // N_Bs and N_Cr, waiting for flow control or data
+#define ISOTP_MAX_WAIT    8    // Flow control WAIT frames accepted in a row
+#define ISOTP_SF_MAX      7
+#define ISOTP_FF_MAX      4095 // Longest message with a 12 bit length
+
+// Protocol control information, the high nibble of the first byte
+#define ISOTP_PCI_SF 0x0 // Single frame
+#define ISOTP_PCI_FF 0x1 // First frame
+#define ISOTP_PCI_CF 0x2 // Consecutive frame
+#define ISOTP_PCI_FC 0x3 // Flow control
+
+// Flow status of a flow control frame
+#define ISOTP_FS_CTS   0 // Continue to send
+#define ISOTP_FS_WAIT  1
+#define ISOTP_FS_OVFLW 2 // Message too long for the receiver
+
+// Transfer results
+#define ISOTP_SUCCESS      0
+#define ISOTP_ERR_BUSY     1 // A message is already being sent
+#define ISOTP_ERR_TIMEOUT  2 // No flow control in ISOTP_TIMEOUT_MS
+#define ISOTP_ERR_OVERFLOW 3 // Message too long for the receiver
+#define ISOTP_ERR_ABORTED  4 // Receiver kept waiting or sent a bad flow status
+
+// States of each direction of a link
+#define ISOTP_IDLE    0
+#define ISOTP_WAIT_FC 1 // Sent a first frame or a block, waiting for flow control
+#define ISOTP_SENDING 2 // Sending consecutive frames
+#define ISOTP_DONE    3 // Finished, result not yet reported
+#define ISOTP_RECV    4 // Receiving consecutive frames
+
+typedef struct ISOTP_link ISOTP_link;
+
+/**
+ * Fills <data> with <len> bytes of the message being sent, starting <offset>
+ * bytes in, so a message can be streamed from NVM rather than held in RAM.
+ */
+typedef void (*ISOTP_source)(ISOTP_link* link, uint32_t offset, uint8_t* data, uint32_t len);
+
+// Called from ISOTP_service() with each complete message received
+typedef void (*ISOTP_rx_handler)(ISOTP_link* link, uint8_t* data, uint32_t len);
+
+// Called from ISOTP_service() once a message is all queued to send, or has failed
+typedef void (*ISOTP_tx_handler)(ISOTP_link* link, uint8_t result);
+
+typedef struct {
+  uint8_t dlc;
+  uint8_t data[CAN_MAX_DLEN];
+} ISOTP_frame;
+
+struct ISOTP_link {
+  uint32_t tx_id;
+  uint32_t rx_id;
+  uint8_t st_min; // STmin this end asks for, encoded as in a flow control frame
+  void* context;  // For the node's use
+
+  // Receiving
+  uint8_t* rx_buf;
+  uint32_t rx_size;
+  ISOTP_rx_handler on_rx;
+  uint8_t rx_state;
+  uint8_t rx_sn;    // Sequence number of the next consecutive frame
+  uint8_t rx_block; // Consecutive frames left before the next flow control
+  uint32_t rx_len;
+  uint32_t rx_pos;
+  uint32_t rx_tmr;
+
+  // Frames between ISOTP_receive() and ISOTP_service()
+  ISOTP_frame ring[ISOTP_RX_RING];
+  volatile uint8_t ring_head;
+  volatile uint8_t ring_tail;
+
+  // Sending
+  const uint8_t* tx_data;
+  ISOTP_source tx_source;
+  ISOTP_tx_handler on_tx;
+  uint8_t tx_state;
+  uint8_t tx_result;
+  uint8_t tx_sn;
+  uint8_t tx_bs;    // Block size from the last flow control frame
+  uint8_t tx_block; // Consecutive frames left in this block
+  uint8_t tx_waits; // WAIT frames received in a row
+  uint32_t tx_len;
+  uint32_t tx_pos;
+  uint32_t tx_st_us; // STmin from the last flow control frame
+  uint32_t tx_last_us;
+  uint32_t tx_tmr;
+
+  // Counts since ISOTP_init()
+  uint32_t rx_messages;
+  uint32_t tx_messages;
+  uint32_t errors;     // Failed sends and abandoned receives
+  uint32_t ring_drops; // Frames lost to a sender ignoring flow control
+};
+
+// Function definitions
+void ISOTP_init(ISOTP_link* link, uint32_t tx_id, uint32_t rx_id, uint8_t* rx_buf,
+    uint32_t rx_size, ISOTP_rx_handler on_rx, ISOTP_tx_handler on_tx);
+void ISOTP_receive(ISOTP_link* link, CAN_message msg);
+uint8_t ISOTP_send(ISOTP_link* link, const uint8_t* data, uint32_t len);
+uint8_t ISOTP_send_from(ISOTP_link* link, ISOTP_source source, uint32_t len);
+void ISOTP_service(ISOTP_link* link);
+
+#endif /* FSAE_ISOTP_H */
@@ -9,6 +9,7 @@ SPIConn* init_max31855(uint8_t bus, uint32_t *cs_lat, uint8_t cs_num) {
   }
   SPIConn *currConn = &max31855Connections[max31855ConnIdx];
   currConn->send_fp = get_send_spi(bus);
+  currConn->bus = bus;
   currConn->cs_lat = cs_lat;
   currConn->cs_num = cs_num;
 
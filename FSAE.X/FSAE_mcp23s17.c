@@ -10,6 +10,7 @@ SPIConn* init_mcp23s17(uint8_t bus, uint32_t *cs_lat, uint8_t cs_num) {
 
   SPIConn *currConn = &mcp23s17Connections[mcp23s17ConnIdx];
   currConn->send_fp = get_send_spi(bus);
+  currConn->bus = bus;
   currConn->cs_lat = cs_lat;
   currConn->cs_num = cs_num;
 
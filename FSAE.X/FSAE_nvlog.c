@@ -0,0 +1,334 @@
+/**
+ * FSAE Library NVM Record Log
+ *
+ * Processor:   PIC32MZ2048EFM100
+ * Compiler:    Microchip XC32
+ * Created:     2026
+ */
+#include "FSAE_nvlog.h"
+#include "FSAE_crc.h"
+
+#define NVLOG_HDR sizeof(_NvlogRecord)
+
+static uint8_t nvlog_buf[_NVM_PAGE]; // One record, header and data
+
+/**
+ * uint32_t nvlog_seg_addr(NvLog* log, uint8_t seg)
+ *
+ * @returns The address of segment <seg>
+ */
+static uint32_t nvlog_seg_addr(NvLog* log, uint8_t seg) {
+  return log->addr + (uint32_t) seg * NVLOG_SEG_SIZE;
+}
+
+/**
+ * uint32_t nvlog_crc(_NvlogRecord* rec, const uint8_t* data)
+ *
+ * @returns The CRC32 of <rec> before its crc field and the data after it
+ */
+static uint32_t nvlog_crc(_NvlogRecord* rec, const uint8_t* data) {
+  uint32_t crc = crc32(0, (const uint8_t*) rec, NVLOG_HDR - sizeof(rec->crc));
+  return crc32(crc, data, rec->len);
+}
+
+/**
+ * uint32_t nvlog_capacity(NvLog* log)
+ *
+ * Records don't span segments, so each segment may end in a gap almost as
+ * long as a record. Two segments are kept back, one to copy live records into
+ * while the oldest is reclaimed and the oldest itself.
+ *
+ * @returns The most bytes of live records the log can hold
+ */
+static uint32_t nvlog_capacity(NvLog* log) {
+  return (uint32_t) (log->segs - 2) * (NVLOG_SEG_SIZE - sizeof(_NvlogSegment) - _NVM_PAGE);
+}
+
+/**
+ * void nvlog_apply(NvLog* log, _NvlogRecord* rec, uint32_t addr)
+ *
+ * Makes the record <rec> at <addr> its key's latest, unless the key has a
+ * later one. Copies keep their sequence number, so the later of two equal
+ * ones, the copy, wins.
+ */
+static void nvlog_apply(NvLog* log, _NvlogRecord* rec, uint32_t addr) {
+  _NvlogEntry* entry = &log->index[rec->key];
+
+  if (entry->addr != 0 && rec->seq < entry->seq) {
+    return;
+  }
+  if (entry->addr != 0 && entry->len != 0) {
+    log->live -= NVLOG_HDR + entry->len;
+  }
+  entry->addr = addr;
+  entry->seq = rec->seq;
+  entry->len = rec->len;
+  if (rec->len != 0) {
+    log->live += NVLOG_HDR + rec->len;
+  }
+  if (rec->seq >= log->seq) {
+    log->seq = rec->seq + 1;
+  }
+}
+
+/**
+ * uint8_t nvlog_append(NvLog* log, uint16_t key, uint32_t seq, uint16_t len)
+ *
+ * Writes a record for <key> with the <len> bytes of data already in
+ * nvlog_buf after the header, at the write address, and indexes it. The
+ * caller makes sure it fits in the head segment.
+ */
+static uint8_t nvlog_append(NvLog* log, uint16_t key, uint32_t seq, uint16_t len) {
+  _NvlogRecord* rec = (_NvlogRecord*) nvlog_buf;
+
+  rec->seq = seq;
+  rec->epoch = log->epoch;
+  rec->key = key;
+  rec->len = len;
+  rec->crc = nvlog_crc(rec, &nvlog_buf[NVLOG_HDR]);
+
+  uint8_t result = nvm_write_data(log->conn, log->write, NVLOG_HDR + len, nvlog_buf);
+  if (result != NVM_SUCCESS) { return result; }
+
+  nvlog_apply(log, rec, log->write);
+  log->write += NVLOG_HDR + len;
+  return NVLOG_SUCCESS;
+}
+
+/**
+ * uint8_t nvlog_fits(NvLog* log, uint16_t len)
+ *
+ * @returns Whether a record of <len> bytes of data fits in the head segment
+ */
+static uint8_t nvlog_fits(NvLog* log, uint16_t len) {
+  return log->write + NVLOG_HDR + len <= nvlog_seg_addr(log, log->head) + NVLOG_SEG_SIZE;
+}
+
+/**
+ * uint8_t nvlog_reclaim(NvLog* log, uint8_t seg)
+ *
+ * Copies the records holding a value in segment <seg> to the head segment,
+ * then clears <seg>'s header so it can be opened again. Deletions aren't
+ * copied, since every older segment has been reclaimed before this one.
+ */
+static uint8_t nvlog_reclaim(NvLog* log, uint8_t seg) {
+  uint32_t start = nvlog_seg_addr(log, seg);
+  uint16_t key;
+  uint8_t result;
+
+  for (key = 0; key < NVLOG_KEYS; key++) {
+    _NvlogEntry* entry = &log->index[key];
+    if (entry->len == 0 || entry->addr < start || entry->addr >= start + NVLOG_SEG_SIZE) {
+      continue;
+    }
+    if (!nvlog_fits(log, entry->len)) { return NVLOG_ERR_FULL; }
+
+    nvm_read_data(log->conn, entry->addr, NVLOG_HDR + entry->len, nvlog_buf);
+    _NvlogRecord* rec = (_NvlogRecord*) nvlog_buf;
+    if (rec->crc != nvlog_crc(rec, &nvlog_buf[NVLOG_HDR])) {
+      // Gone bad since it was written, so dropped rather than copied
+      log->live -= NVLOG_HDR + entry->len;
+      entry->len = 0;
+      continue;
+    }
+
+    result = nvlog_append(log, key, entry->seq, entry->len);
+    if (result != NVLOG_SUCCESS) { return result; }
+  }
+
+  // A header cut off while being cleared no longer matches its CRC
+  memset(nvlog_buf, 0, sizeof(_NvlogSegment));
+  result = nvm_write_data(log->conn, start, sizeof(_NvlogSegment), nvlog_buf);
+  if (result != NVM_SUCCESS) { return result; }
+  log->free |= 1UL << seg;
+  return NVLOG_SUCCESS;
+}
+
+/**
+ * uint8_t nvlog_advance(NvLog* log)
+ *
+ * Opens the segment after the head segment, which is always free, as the new
+ * head. Then reclaims the segment after that if it isn't free, so the next
+ * advance finds a free segment too.
+ */
+static uint8_t nvlog_advance(NvLog* log) {
+  uint8_t next = (log->head + 1) % log->segs;
+  _NvlogSegment* seg = (_NvlogSegment*) nvlog_buf;
+
+  memset(seg, 0, sizeof(_NvlogSegment));
+  seg->magic = _NVLOG_MAGIC;
+  seg->epoch = log->epoch + 1;
+  seg->crc = crc32(0, (const uint8_t*) seg, 2 * sizeof(uint32_t));
+  uint8_t result = nvm_write_data(log->conn, nvlog_seg_addr(log, next),
+      sizeof(_NvlogSegment), seg);
+  if (result != NVM_SUCCESS) { return result; }
+
+  log->head = next;
+  log->epoch++;
+  log->write = nvlog_seg_addr(log, next) + sizeof(_NvlogSegment);
+  log->free &= ~(1UL << next);
+
+  next = (next + 1) % log->segs;
+  return (log->free & (1UL << next)) ? NVLOG_SUCCESS : nvlog_reclaim(log, next);
+}
+
+/**
+ * uint32_t nvlog_scan(NvLog* log, uint8_t seg, uint32_t epoch)
+ *
+ * Indexes the records of segment <seg>, opened in <epoch>, reading only their
+ * headers up to the last one. A header belonging to another epoch, or that
+ * can't be one, ends the segment's records. The last record is checked
+ * against its CRC, since a power failure can have cut it off.
+ *
+ * @returns The address after the segment's last good record
+ */
+static uint32_t nvlog_scan(NvLog* log, uint8_t seg, uint32_t epoch) {
+  uint32_t end = nvlog_seg_addr(log, seg) + NVLOG_SEG_SIZE;
+  uint32_t addr = nvlog_seg_addr(log, seg) + sizeof(_NvlogSegment);
+  uint32_t last = 0;
+  _NvlogRecord rec, prev;
+
+  while (addr + NVLOG_HDR <= end) {
+    nvm_read_data(log->conn, addr, NVLOG_HDR, &rec);
+    if (rec.epoch != epoch || rec.key >= NVLOG_KEYS || rec.len > NVLOG_DATA_MAX ||
+        addr + NVLOG_HDR + rec.len > end) {
+      break;
+    }
+    if (last != 0) {
+      nvlog_apply(log, &prev, last); // Followed by another, so complete
+    }
+    prev = rec;
+    last = addr;
+    addr += NVLOG_HDR + rec.len;
+  }
+
+  if (last != 0) {
+    nvm_read_data(log->conn, last, NVLOG_HDR + prev.len, nvlog_buf);
+    if (prev.crc != nvlog_crc(&prev, &nvlog_buf[NVLOG_HDR])) {
+      return last; // Cut off, to be written over
+    }
+    nvlog_apply(log, &prev, last);
+  }
+  return addr;
+}
+
+/**
+ * Mounts the record log in the <size> bytes of NVM at <addr>, which must be
+ * a whole number of segments, at least 3. The region must not overlap the
+ * superblock or any allocated block, or it can be a block from nvm_alloc().
+ * A region that has never held a log starts empty.
+ *
+ * Finishes reclaiming a segment if a power failure cut that off.
+ *
+ * Returns 0 on success.
+ */
+uint8_t nvlog_mount(NvLog* log, SPIConn* conn, uint32_t addr, uint32_t size) {
+  uint32_t epochs[NVLOG_SEGS_MAX];
+  _NvlogSegment seg;
+  uint8_t i, s;
+
+  if (size % NVLOG_SEG_SIZE != 0 || size / NVLOG_SEG_SIZE < 3 ||
+      size / NVLOG_SEG_SIZE > NVLOG_SEGS_MAX || addr + size > _NVM_MAX_ADDR + 1) {
+    return NVLOG_ERR_SIZE;
+  }
+
+  memset(log, 0, sizeof(NvLog));
+  log->conn = conn;
+  log->addr = addr;
+  log->segs = size / NVLOG_SEG_SIZE;
+
+  // Segment headers, the head being the one opened last
+  for (s = 0; s < log->segs; s++) {
+    nvm_read_data(conn, nvlog_seg_addr(log, s), sizeof(_NvlogSegment), &seg);
+    if (seg.magic != _NVLOG_MAGIC ||
+        seg.crc != crc32(0, (const uint8_t*) &seg, 2 * sizeof(uint32_t))) {
+      log->free |= 1UL << s;
+      continue;
+    }
+    epochs[s] = seg.epoch;
+    if (seg.epoch > log->epoch) {
+      log->epoch = seg.epoch;
+      log->head = s;
+    }
+  }
+
+  if (log->epoch == 0) {
+    // Empty, open the first segment
+    log->head = log->segs - 1;
+    return nvlog_advance(log);
+  }
+
+  // Records oldest first, starting with the segment after the head
+  for (i = 1; i <= log->segs; i++) {
+    s = (log->head + i) % log->segs;
+    if (!(log->free & (1UL << s))) {
+      log->write = nvlog_scan(log, s, epochs[s]);
+    }
+  }
+
+  s = (log->head + 1) % log->segs;
+  return (log->free & (1UL << s)) ? NVLOG_SUCCESS : nvlog_reclaim(log, s);
+}
+
+/**
+ * Puts the <len> bytes at <data> as the value of <key>, at most
+ * NVLOG_DATA_MAX. Either the whole value is stored or, after a power
+ * failure, the key keeps the value it had before.
+ *
+ * Blocks while the record is written, and while the oldest segment is
+ * reclaimed if the head segment is full.
+ *
+ * Returns 0 on success, or NVLOG_ERR_FULL if the live records would not fit.
+ */
+uint8_t nvlog_put(NvLog* log, uint16_t key, const void* data, uint16_t len) {
+  uint8_t tries = 0;
+  uint8_t result;
+
+  if (key >= NVLOG_KEYS) { return NVLOG_ERR_KEY; }
+  if (len > NVLOG_DATA_MAX) { return NVLOG_ERR_SIZE; }
+
+  _NvlogEntry* entry = &log->index[key];
+  uint32_t replaced = entry->len != 0 ? NVLOG_HDR + entry->len : 0;
+  if (len != 0 && log->live - replaced + NVLOG_HDR + len > nvlog_capacity(log)) {
+    return NVLOG_ERR_FULL;
+  }
+
+  while (!nvlog_fits(log, len)) {
+    if (tries++ == log->segs) { return NVLOG_ERR_FULL; }
+    result = nvlog_advance(log);
+    if (result != NVLOG_SUCCESS) { return result; }
+  }
+
+  if (len != 0) {
+    memcpy(&nvlog_buf[NVLOG_HDR], data, len);
+  }
+  return nvlog_append(log, key, log->seq, len);
+}
+
+/**
+ * Reads the value of <key> into <buf>, up to <size> bytes, and sets <len> to
+ * its full length.
+ *
+ * Returns 0 on success, or NVLOG_ERR_KEY if the key has no value.
+ */
+uint8_t nvlog_get(NvLog* log, uint16_t key, void* buf, uint16_t size, uint16_t* len) {
+  if (key >= NVLOG_KEYS || log->index[key].len == 0) { return NVLOG_ERR_KEY; }
+
+  _NvlogEntry* entry = &log->index[key];
+  nvm_read_data(log->conn, entry->addr, NVLOG_HDR + entry->len, nvlog_buf);
+  _NvlogRecord* rec = (_NvlogRecord*) nvlog_buf;
+  if (rec->crc != nvlog_crc(rec, &nvlog_buf[NVLOG_HDR])) { return NVLOG_ERR_CRC; }
+
+  memcpy(buf, &nvlog_buf[NVLOG_HDR], min(size, entry->len));
+  if (len != NULL) { *len = entry->len; }
+  return NVLOG_SUCCESS;
+}
+
+/**
+ * Deletes the value of <key> by putting a record without data.
+ *
+ * Returns 0 on success.
+ */
+uint8_t nvlog_delete(NvLog* log, uint16_t key) {
+  return nvlog_put(log, key, NULL, 0);
+}
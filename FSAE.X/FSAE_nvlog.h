@@ -0,0 +1,94 @@
+/**
+ * FSAE Library NVM Record Log Header
+ *
+ * Processor:   PIC32MZ2048EFM100
+ * Compiler:    Microchip XC32
+ * Created:     2026
+ */
+#ifndef FSAE_NVLOG_H
+#define FSAE_NVLOG_H
+
+#include <xc.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include "FSAE_nvm.h"
+
+/**
+ * Power-fail safe records in the 25LC1024
+ *
+ * Each record holds the latest value of one key. Records are never rewritten
+ * in place. A new value is appended after the last record, with a sequence
+ * number and a CRC32 over the record, and takes over from the old one once
+ * it is complete. A put cut off by a power failure fails its CRC, so the key
+ * keeps its old value.
+ *
+ * The log's region is split into segments of NVLOG_SEG_SIZE, used in turn as
+ * a ring, which spreads the writes over the whole region. Each segment starts
+ * with a header giving the epoch it was opened in, and records carry the
+ * epoch of their segment, so data left over from an earlier pass is never
+ * taken for a record. When the segment after the one being appended to is
+ * the only one left, the next one round, the oldest, is reclaimed: its live
+ * records are copied forward and its header cleared.
+ *
+ * Mounting reads the segment headers and hops from record header to record
+ * header to rebuild the index, reading data only to check the CRC of the last
+ * record in each segment, the only one a power failure can have cut off.
+ */
+
+#define NVLOG_SUCCESS  0 // No error
+#define NVLOG_ERR_SIZE 1 // Bad region, or data too long
+#define NVLOG_ERR_KEY  2 // Key out of range, or without a value
+#define NVLOG_ERR_FULL 3 // Live records would not fit
+#define NVLOG_ERR_CRC  4 // Record read back with a bad CRC32
+
+#define NVLOG_SEG_SIZE 0x1000 // Segment size, 16 pages
+#define NVLOG_SEGS_MAX 32     // Most segments in a region, all of the chip
+#define NVLOG_KEYS     32     // Keys 0 to NVLOG_KEYS - 1
+#define NVLOG_DATA_MAX (_NVM_PAGE - sizeof(_NvlogRecord)) // Bytes per value
+
+#define _NVLOG_MAGIC 0x474F4C4E // "NLOG"
+
+// Header at the start of each segment, cleared when it is reclaimed
+typedef struct {
+  uint32_t magic; // _NVLOG_MAGIC
+  uint32_t epoch; // One more than the segment opened before it
+  uint32_t crc;   // CRC32 of magic and epoch
+  uint32_t unused;
+} _NvlogSegment;
+
+// Header before the data of each record
+typedef struct {
+  uint32_t seq;   // Order the value was put in, kept when it is copied
+  uint32_t epoch; // Epoch of the segment it is in
+  uint16_t key;
+  uint16_t len;   // Bytes of data, 0 once the key is deleted
+  uint32_t crc;   // CRC32 of the fields above and the data
+} _NvlogRecord;
+
+// Latest record of each key
+typedef struct {
+  uint32_t addr; // Address of its record, 0 if none
+  uint32_t seq;
+  uint16_t len;
+} _NvlogEntry;
+
+typedef struct {
+  SPIConn* conn;
+  uint32_t addr;  // Start of the region
+  uint8_t segs;   // Segments in the region
+  uint8_t head;   // Segment being appended to
+  uint32_t free;  // Segments without a valid header, one bit each
+  uint32_t epoch; // Epoch of the head segment
+  uint32_t write; // Address of the next record
+  uint32_t seq;   // Sequence number of the next record
+  uint32_t live;  // Bytes of records holding a value, headers included
+  _NvlogEntry index[NVLOG_KEYS];
+} NvLog;
+
+// Function definitions
+uint8_t nvlog_mount(NvLog* log, SPIConn* conn, uint32_t addr, uint32_t size);
+uint8_t nvlog_put(NvLog* log, uint16_t key, const void* data, uint16_t len);
+uint8_t nvlog_get(NvLog* log, uint16_t key, void* buf, uint16_t size, uint16_t* len);
+uint8_t nvlog_delete(NvLog* log, uint16_t key);
+
+#endif /* FSAE_NVLOG_H */
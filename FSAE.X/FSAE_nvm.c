@@ -14,9 +14,17 @@ SPIConn connections[NUM_CONN];
 uint8_t connIdx = 0;
 
 _NvmSuperblock superblocks[NUM_CONN];
+uint32_t sb_dirty[NUM_CONN];   // Superblock pages changed since the last sync
+uint8_t sb_deferred[NUM_CONN]; // Whether nvm_alloc() leaves the sync to the caller
+
+// Asynchronous writes, oldest first, the first one in progress
+_NvmAsyncWrite async_queue[_NVM_ASYNC_LEN];
+uint8_t async_head = 0;
+uint8_t async_count = 0;
+uint8_t async_handle = 0; // Handle of the next write queued
 
 uint8_t idx(SPIConn* conn) {
-  return ((conn - connections) / sizeof(SPIConn));
+  return conn - connections;
 }
 
 uint16_t num_pages(uint32_t size) {
@@ -47,6 +55,7 @@ SPIConn* init_nvm(uint8_t bus, uint32_t* cs_lat, uint8_t cs_num) {
 
   SPIConn* currConn = &connections[connIdx];
   currConn->send_fp = get_send_spi(bus);
+  currConn->bus = bus;
   currConn->cs_lat = cs_lat;
   currConn->cs_num = cs_num;
 
@@ -74,7 +83,8 @@ SPIConn* init_nvm(uint8_t bus, uint32_t* cs_lat, uint8_t cs_num) {
     for (i = 0; i < num_pages(sizeof(_NvmSuperblock)); i++) {
       superblocks[connIdx].pages[i] = 1;
     }
-    nvm_write_data(currConn, 0x0, sizeof(_NvmSuperblock), &(superblocks[connIdx]));
+    _nvm_sb_dirty(currConn, &(superblocks[connIdx]), sizeof(_NvmSuperblock));
+    nvm_sync(currConn);
   }
 
   connIdx++;
@@ -96,7 +106,9 @@ SPIConn* init_nvm(uint8_t bus, uint32_t* cs_lat, uint8_t cs_num) {
  *
  * If everything was successful, the node at <fd> will contain metadata for the
  * newly allocated block and NVM_SUCCESS will be returned. Otherwise, the
- * appropriate error will be returned.
+ * appropriate error will be returned. Only the superblock pages holding the
+ * new node and its page flags are written, and not until nvm_sync() if
+ * nvm_defer_sync() was called.
  */
 uint8_t nvm_alloc(SPIConn* conn, uint8_t* block_id, uint32_t vcode,
                   uint32_t size, uint8_t* fd) {
@@ -128,11 +140,12 @@ uint8_t nvm_alloc(SPIConn* conn, uint8_t* block_id, uint32_t vcode,
       // Clear data in allocated pages
       nvm_clear_data(conn, addr, size);
 
-      // Write new superblock (TODO: Only write changed memory)
-      nvm_write_data(conn, 0x0, sizeof(_NvmSuperblock), sb);
+      // Write the changed parts of the superblock
+      _nvm_sb_dirty(conn, node, sizeof(_NvmNode));
+      _nvm_sb_dirty(conn, &(sb->pages[addr / _NVM_PAGE]), num_pages(size));
 
       *fd = i;
-      return NVM_SUCCESS;
+      return sb_deferred[idx(conn)] ? NVM_SUCCESS : nvm_sync(conn);
     }
   }
 
@@ -168,6 +181,9 @@ uint8_t nvm_write(SPIConn* conn, uint8_t fd, uint8_t* buf) {
 /**
  * Reads <size> bytes from <addr> onwards into <buf>.
  *
+ * The data is clocked in with spi_burst(), by DMA unless disabled, so the
+ * bus runs at its full rate after the 4-byte command.
+ *
  * Returns 0 on success.
  */
 uint8_t nvm_read_data(SPIConn* conn, uint32_t addr, uint32_t size, void* buf) {
@@ -182,10 +198,7 @@ uint8_t nvm_read_data(SPIConn* conn, uint32_t addr, uint32_t size, void* buf) {
   conn->send_fp((addr >> 8) & 0xFF);
   conn->send_fp(addr & 0xFF);
 
-  uint32_t i;
-  for (i = 0; i < size; i++) {
-    ((uint8_t*) buf)[i] = conn->send_fp(0x00);
-  }
+  spi_burst(conn, NULL, (uint8_t*) buf, size);
   spi_deselect(conn);
 
   return NVM_SUCCESS;
@@ -197,6 +210,9 @@ uint8_t nvm_read_data(SPIConn* conn, uint32_t addr, uint32_t size, void* buf) {
  * On the 25LC1024, writes must happen on a page-by-page basis. Each page is 256
  * bytes. Writes must not cross page boundaries. Thus, this generic write
  * function calls the page write function as many times as needed.
+ *
+ * Blocks for up to 6ms per page while the previous page is written. Use
+ * nvm_write_async() from code that can't wait that long.
  */
 uint8_t nvm_write_data(SPIConn* conn, uint32_t addr, uint32_t size, void* buf) {
   if (addr > _NVM_MAX_ADDR) { return NVM_ERR_SEGV; }
@@ -228,6 +244,117 @@ uint8_t nvm_clear_data(SPIConn* conn, uint32_t addr, uint32_t size)
   return nvm_write_data(conn, addr, size, &clear);
 }
 
+/**
+ * Defers the superblock writes of nvm_alloc() until the next nvm_sync(), so a
+ * batch of allocations writes each changed superblock page once.
+ *
+ * Allocations made since are lost if the node resets before the sync.
+ */
+void nvm_defer_sync(SPIConn* conn) {
+  sb_deferred[idx(conn)] = 1;
+}
+
+/**
+ * Writes the superblock pages changed since the last sync to the NVM chip,
+ * one page write each, and ends any deferral from nvm_defer_sync().
+ *
+ * Returns 0 on success.
+ */
+uint8_t nvm_sync(SPIConn* conn) {
+  uint8_t i = idx(conn);
+  uint8_t* sb = (uint8_t*) &(superblocks[i]);
+  uint16_t page;
+
+  sb_deferred[i] = 0;
+  for (page = 0; page < _NVM_SB_PAGES; page++) {
+    if (sb_dirty[i] & ((uint32_t) 1 << page)) {
+      uint32_t addr = page * _NVM_PAGE;
+      uint8_t err = nvm_write_data(conn, addr,
+          min(_NVM_PAGE, sizeof(_NvmSuperblock) - addr), sb + addr);
+      if (err != NVM_SUCCESS) { return err; }
+      sb_dirty[i] &= ~((uint32_t) 1 << page);
+    }
+  }
+
+  return NVM_SUCCESS;
+}
+
+/**
+ * Queues a write of <size> bytes from <buf> to <addr> and returns without
+ * waiting for the chip. Writes are carried out in the order they were queued
+ * by nvm_service(), one page at a time.
+ *
+ * <buf> must stay unchanged until the write has finished. <done_fp>, if not
+ * NULL, is then called from nvm_service(). <handle>, if not NULL, is set to a
+ * handle for nvm_write_pending(). Blocking reads and writes may run between
+ * its pages, and see the range partly written until it has finished.
+ *
+ * Returns 0 on success, or NVM_ERR_BUSY if the queue is full.
+ */
+uint8_t nvm_write_async(SPIConn* conn, uint32_t addr, uint32_t size, void* buf,
+                        nvm_done_fp done_fp, uint8_t* handle) {
+  if (addr > _NVM_MAX_ADDR) { return NVM_ERR_SEGV; }
+  if ((addr + size) > (_NVM_MAX_ADDR + 1)) { return NVM_ERR_SEGV; }
+  if (async_count == _NVM_ASYNC_LEN) { return NVM_ERR_BUSY; }
+
+  _NvmAsyncWrite* write = &async_queue[(async_head + async_count) % _NVM_ASYNC_LEN];
+  write->conn = conn;
+  write->addr = addr;
+  write->size = size;
+  write->done = 0;
+  write->buf = (uint8_t*) buf;
+  write->done_fp = done_fp;
+  write->handle = async_handle++;
+  async_count++;
+
+  if (handle != NULL) { *handle = write->handle; }
+  return NVM_SUCCESS;
+}
+
+/**
+ * Returns whether the asynchronous write with <handle> is still queued or in
+ * progress.
+ */
+uint8_t nvm_write_pending(uint8_t handle) {
+  uint8_t i;
+  for (i = 0; i < async_count; i++) {
+    if (async_queue[(async_head + i) % _NVM_ASYNC_LEN].handle == handle) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Advances the asynchronous writes without blocking. Starts the next page
+ * write once the chip has finished the last one, and finishes a write once
+ * its last page has been written.
+ *
+ * Call from the main loop, not from an interrupt handler, since blocking NVM
+ * calls in the main loop would be interrupted mid-transfer.
+ */
+void nvm_service(void) {
+  if (async_count == 0) { return; }
+
+  _NvmAsyncWrite* write = &async_queue[async_head];
+  if (_nvm_wip(write->conn)) { return; } // Previous write cycle still running
+
+  if (write->done < write->size) {
+    write->done += _nvm_write_page(write->conn, write->addr + write->done,
+        write->size - write->done, write->buf + write->done);
+    return;
+  }
+
+  // Free the slot first, so the callback can queue another write
+  nvm_done_fp done_fp = write->done_fp;
+  uint8_t handle = write->handle;
+  async_head = (async_head + 1) % _NVM_ASYNC_LEN;
+  async_count--;
+  if (done_fp != NULL) {
+    done_fp(handle, NVM_SUCCESS);
+  }
+}
+
 //============================= IMPLEMENTATION =================================
 
 /**
@@ -253,13 +380,10 @@ uint16_t _nvm_write_page(SPIConn* conn, uint32_t addr, uint32_t size, uint8_t* b
   conn->send_fp((addr >> 8) & 0xFF);
   conn->send_fp(addr & 0xFF);
 
-  uint16_t i;
-  for (i = 0; i < num; i++) {
-    conn->send_fp(buf[i]);
-  }
+  spi_burst(conn, buf, NULL, num);
   spi_deselect(conn);
 
-  return i;
+  return num;
 }
 
 /**
@@ -343,3 +467,17 @@ uint32_t _nvm_alloc_addr(_NvmSuperblock* sb, uint32_t size) {
   }
   return ((uint32_t) s) * 256;
 }
+
+/**
+ * Marks the superblock pages holding <size> bytes from <field>, a member of
+ * <conn>'s cached superblock, as changed.
+ */
+void _nvm_sb_dirty(SPIConn* conn, void* field, uint32_t size) {
+  uint8_t i = idx(conn);
+  uint32_t offset = (uint8_t*) field - (uint8_t*) &(superblocks[i]);
+  uint16_t page;
+
+  for (page = offset / _NVM_PAGE; page <= (offset + size - 1) / _NVM_PAGE; page++) {
+    sb_dirty[i] |= (uint32_t) 1 << page;
+  }
+}
@@ -21,6 +21,7 @@
 #define NVM_SUCCESS  0 // No error
 #define NVM_ERR_SEGV 1 // Segfault! (Bad address)
 #define NVM_ERR_FULL 2 // No available blocks
+#define NVM_ERR_BUSY 3 // Asynchronous write queue full
 
 // NVM Chip Instruction Set
 #define _NVM_IN_READ  0b00000011
@@ -38,6 +39,8 @@
 // Misc Definitions
 #define _NVM_MAX_ADDR 0x1FFFF
 #define _NVM_SB_VER   0x1
+#define _NVM_PAGE     256
+#define _NVM_ASYNC_LEN 8 // Asynchronous writes that can be queued at once
 
 // Default NVM pin definitions
 #define _NVM_STD_BUS        6
@@ -72,6 +75,27 @@ typedef struct {
   uint8_t pages[512]; // Track which pages are alloc'd, 512 total
 } _NvmSuperblock;
 
+/**
+ * Called from nvm_service() when an asynchronous write has finished, with the
+ * handle nvm_write_async() gave for it and NVM_SUCCESS.
+ */
+typedef void (*nvm_done_fp) (uint8_t handle, uint8_t result);
+
+// Struct containing a queued asynchronous write
+typedef struct {
+  SPIConn* conn;
+  uint32_t addr;
+  uint32_t size;
+  uint32_t done; // Bytes sent to the chip so far
+  uint8_t* buf;
+  nvm_done_fp done_fp;
+  uint8_t handle;
+} _NvmAsyncWrite;
+
+// Pages the superblock occupies at the start of the chip. Each connection
+// tracks which of them have changed in RAM in one 32-bit mask.
+#define _NVM_SB_PAGES ((sizeof(_NvmSuperblock) + _NVM_PAGE - 1) / _NVM_PAGE)
+
 // Function definitions
 
 // Public Interface
@@ -84,6 +108,12 @@ uint8_t nvm_write(SPIConn* conn, uint8_t fd, uint8_t* buf);
 uint8_t nvm_read_data(SPIConn* conn, uint32_t addr, uint32_t size, void* buf);
 uint8_t nvm_write_data(SPIConn* conn, uint32_t addr, uint32_t size, void* buf);
 uint8_t nvm_clear_data(SPIConn* conn, uint32_t addr, uint32_t size);
+void nvm_defer_sync(SPIConn* conn);
+uint8_t nvm_sync(SPIConn* conn);
+uint8_t nvm_write_async(SPIConn* conn, uint32_t addr, uint32_t size, void* buf,
+                        nvm_done_fp done_fp, uint8_t* handle);
+uint8_t nvm_write_pending(uint8_t handle);
+void nvm_service(void);
 
 // Private Implementation
 uint16_t _nvm_write_page(SPIConn* conn, uint32_t addr, uint32_t size, uint8_t* buf);
@@ -94,6 +124,7 @@ void _nvm_write_status_reg(SPIConn* conn, _NvmStatusReg status);
 uint8_t _nvm_send_two(SPIConn* conn, uint8_t one, uint8_t two);
 
 uint32_t _nvm_alloc_addr(_NvmSuperblock* sb, uint32_t size);
+void _nvm_sb_dirty(SPIConn* conn, void* field, uint32_t size);
 //TODO: _nvm_fsck()
 
 #endif /* FSAE_nvm_H */
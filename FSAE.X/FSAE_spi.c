@@ -1,5 +1,23 @@
 #include "FSAE_spi.h"
 
+#ifdef FSAE_HOST
+// External definitions of the inline functions for the host's C99 inline
+// semantics, for calls that aren't inlined. XC32 keeps its own handling.
+extern inline void spi_select(SPIConn* conn);
+extern inline void spi_deselect(SPIConn* conn);
+#endif
+
+uint8_t spi_dma_enabled = 1; // Cleared to move every burst by PIO
+SPIBurstStats spi_dma_stats = {0};
+SPIBurstStats spi_pio_stats = {0};
+
+uint8_t spi_sizes[7] = {0}; // Word size of each bus, set by init_spi()
+
+// What the DMA channels move, a chunk of a burst at a time. Uncached, so the
+// DMA controller and the CPU see the same bytes without cache maintenance.
+uint8_t spi_dma_tx[SPI_DMA_CHUNK] COHERENT;
+uint8_t spi_dma_rx[SPI_DMA_CHUNK] COHERENT;
+
 /*
  * Generic initializaiton function for all SPI busses
  * The SPI pins used for each bus are the defaults for the FSAE Library:
@@ -26,6 +44,22 @@ void init_spi(uint8_t bus, double mhz, uint8_t size, uint8_t mode) {
     brg = 8191;
   }
 
+  if (bus < sizeof(spi_sizes)) {
+    spi_sizes[bus] = size;
+  }
+  if (size == 8) {
+    // Power the DMA controller back up, which init_peripheral_modules()
+    // disables. PMD7 is only writable with PMDLOCK clear, and the system is
+    // already unlocked above. Bursts use PIO if the controller won't turn on.
+    CFGCONbits.PMDLOCK = 0;
+    PMD7bits.DMAMD = 0;
+    CFGCONbits.PMDLOCK = 1;
+    DMACONbits.ON = 1;
+    if (!DMACONbits.ON) {
+      spi_dma_enabled = 0;
+    }
+  }
+
   uint8_t mode16 = (size & 0x10) >> 4;
   uint8_t mode32 = (size & 0x20) >> 5;
   uint8_t ckp, cke, smp;
@@ -292,8 +326,189 @@ uint32_t send_spi6(uint32_t value){
  *function pointer, return the buffer, and set CS back to high.
  */
 uint32_t send_spi(uint32_t value, SPIConn *conn){
-  *(conn->cs_lat) &= ~(1 << (conn->cs_num)); // Set CS Low
+  spi_select(conn); // Set CS Low
   uint32_t buff = conn->send_fp(value);
-  *(conn->cs_lat) |= 1 << conn->cs_num; // Set CS High
+  spi_deselect(conn); // Set CS High
   return buff;
 }
+
+/*
+ *Switches <bus> into or out of enhanced buffer mode. The FIFOs raise the
+ *interrupts that pace spi_burst()'s DMA transfers: receive while not empty
+ *and transmit while not full. The send_spi functions expect the standard
+ *buffer, so a burst switches back when it is done.
+ *
+ *Returns the physical address of the bus's SPIxBUF, and sets <rx_irq> and
+ *<tx_irq> to the interrupt sources that start its DMA cells. Returns 0 for
+ *an invalid bus.
+ */
+static uintptr_t spi_enhanced(uint8_t bus, uint8_t on, uint32_t* rx_irq, uint32_t* tx_irq) {
+  switch(bus) {
+    case 1:
+      SPI1CONbits.ON = 0;
+      SPI1CONbits.ENHBUF = on;
+      SPI1CONbits.SRXISEL = 0b01; // Receive interrupt while not empty
+      SPI1CONbits.STXISEL = 0b11; // Transmit interrupt while not full
+      SPI1CONbits.ON = 1;
+      *rx_irq = _SPI1_RX_VECTOR;
+      *tx_irq = _SPI1_TX_VECTOR;
+      return KVA_TO_PA(&SPI1BUF);
+    case 2:
+      SPI2CONbits.ON = 0;
+      SPI2CONbits.ENHBUF = on;
+      SPI2CONbits.SRXISEL = 0b01;
+      SPI2CONbits.STXISEL = 0b11;
+      SPI2CONbits.ON = 1;
+      *rx_irq = _SPI2_RX_VECTOR;
+      *tx_irq = _SPI2_TX_VECTOR;
+      return KVA_TO_PA(&SPI2BUF);
+    case 3:
+      SPI3CONbits.ON = 0;
+      SPI3CONbits.ENHBUF = on;
+      SPI3CONbits.SRXISEL = 0b01;
+      SPI3CONbits.STXISEL = 0b11;
+      SPI3CONbits.ON = 1;
+      *rx_irq = _SPI3_RX_VECTOR;
+      *tx_irq = _SPI3_TX_VECTOR;
+      return KVA_TO_PA(&SPI3BUF);
+    case 5:
+      SPI5CONbits.ON = 0;
+      SPI5CONbits.ENHBUF = on;
+      SPI5CONbits.SRXISEL = 0b01;
+      SPI5CONbits.STXISEL = 0b11;
+      SPI5CONbits.ON = 1;
+      *rx_irq = _SPI5_RX_VECTOR;
+      *tx_irq = _SPI5_TX_VECTOR;
+      return KVA_TO_PA(&SPI5BUF);
+    case 6:
+      SPI6CONbits.ON = 0;
+      SPI6CONbits.ENHBUF = on;
+      SPI6CONbits.SRXISEL = 0b01;
+      SPI6CONbits.STXISEL = 0b11;
+      SPI6CONbits.ON = 1;
+      *rx_irq = _SPI6_RX_VECTOR;
+      *tx_irq = _SPI6_TX_VECTOR;
+      return KVA_TO_PA(&SPI6BUF);
+    default:
+      return 0;
+  }
+}
+
+/*
+ *Moves <len> bytes of <tx> to <rx> over the DMA channel pair, at most
+ *SPI_DMA_CHUNK at a time. Channel 0 takes each received byte out of SPIxBUF
+ *and channel 1 puts the next byte to send into it. The receive channel has
+ *the higher priority so the receive FIFO never overflows. Each chunk goes
+ *through spi_dma_tx and spi_dma_rx, since <tx> and <rx> may be cached.
+ *
+ *If a chunk takes longer than SPI_DMA_TIMEOUT, the channels are stopped and
+ *spi_dma_enabled is cleared so every later burst uses PIO.
+ *
+ *Returns the number of bytes moved, which is less than <len> on a timeout.
+ */
+static uint32_t spi_burst_dma(uint8_t bus, const uint8_t* tx, uint8_t* rx, uint32_t len) {
+  uint32_t rx_irq, tx_irq;
+  uintptr_t buf = spi_enhanced(bus, 1, &rx_irq, &tx_irq);
+  uint32_t done = 0;
+
+  while (done < len) {
+    uint32_t num = min(len - done, SPI_DMA_CHUNK);
+    uint32_t start;
+
+    if (tx) {
+      memcpy(spi_dma_tx, &tx[done], num);
+    } else {
+      memset(spi_dma_tx, 0, num);
+    }
+
+    DCH0CON = 0;
+    DCH1CON = 0;
+    DCH0INT = 0;
+    DCH1INT = 0;
+
+    DCH0ECON = (rx_irq << _DCH0ECON_CHSIRQ_POSITION) | _DCH0ECON_SIRQEN_MASK;
+    DCH0SSA = buf;
+    DCH0DSA = KVA_TO_PA(spi_dma_rx);
+    DCH0SSIZ = 1;
+    DCH0DSIZ = num;
+    DCH0CSIZ = 1;
+
+    DCH1ECON = (tx_irq << _DCH1ECON_CHSIRQ_POSITION) | _DCH1ECON_SIRQEN_MASK;
+    DCH1SSA = KVA_TO_PA(spi_dma_tx);
+    DCH1DSA = buf;
+    DCH1SSIZ = num;
+    DCH1DSIZ = 1;
+    DCH1CSIZ = 1;
+
+    DCH0CON = _DCH0CON_CHEN_MASK | (3 << _DCH0CON_CHPRI_POSITION);
+    DCH1CON = _DCH1CON_CHEN_MASK | (2 << _DCH1CON_CHPRI_POSITION);
+
+    // Wait for the last byte in
+    start = _CP0_GET_COUNT();
+    while (!(DCH0INT & _DCH0INT_CHBCIF_MASK)) {
+      if (_CP0_GET_COUNT() - start > SPI_DMA_TIMEOUT * (SPI_CORE_HZ / 1000)) {
+        DCH0CON = 0;
+        DCH1CON = 0;
+        spi_dma_enabled = 0;
+        spi_enhanced(bus, 0, &rx_irq, &tx_irq);
+        return done;
+      }
+    }
+
+    if (rx) {
+      memcpy(&rx[done], spi_dma_rx, num);
+    }
+    done += num;
+  }
+
+  spi_enhanced(bus, 0, &rx_irq, &tx_irq);
+  return done;
+}
+
+/*
+ *Exchanges <len> bytes with the chip on <conn>, which the caller has
+ *selected. Sends <tx>, or zeros if NULL, and stores what comes back in <rx>
+ *unless it is NULL.
+ *
+ *Uses DMA for bursts of SPI_DMA_MIN bytes or more on an 8-bit bus, so the
+ *bus runs without a gap between bytes. Otherwise, or with spi_dma_enabled
+ *cleared, the bytes go one at a time through conn->send_fp. If the DMA times
+ *out, the rest of the burst, from the start of the unfinished chunk, also
+ *goes through conn->send_fp. The time spent on each path is added to
+ *spi_dma_stats or spi_pio_stats.
+ */
+void spi_burst(SPIConn* conn, const uint8_t* tx, uint8_t* rx, uint32_t len) {
+  uint32_t start = _CP0_GET_COUNT();
+  SPIBurstStats* stats = &spi_pio_stats;
+  uint32_t done = 0;
+
+  if (spi_dma_enabled && len >= SPI_DMA_MIN && conn->bus < sizeof(spi_sizes) &&
+      spi_sizes[conn->bus] == 8) {
+    done = spi_burst_dma(conn->bus, tx, rx, len);
+    stats = &spi_dma_stats;
+  }
+
+  if (done < len) {
+    uint32_t i;
+    for (i = done; i < len; i++) {
+      uint8_t in = conn->send_fp(tx ? tx[i] : 0x00);
+      if (rx) {
+        rx[i] = in;
+      }
+    }
+    stats = &spi_pio_stats;
+  }
+
+  stats->bytes += len;
+  stats->ticks += _CP0_GET_COUNT() - start;
+}
+
+/*
+ *Returns the bytes per second achieved over the bursts counted in <stats>.
+ */
+uint32_t spi_burst_rate(const SPIBurstStats* stats) {
+  if (stats->ticks == 0) {
+    return 0;
+  }
+  return (uint32_t) (((uint64_t) stats->bytes * SPI_CORE_HZ) / stats->ticks);
+}
@@ -9,6 +9,7 @@
 #ifndef FSAE_SPI_H
 #define FSAE_SPI_H
 
+#include <string.h>
 #include <sys/types.h>
 #include "FSAE_config.h"
 #include <math.h>
@@ -18,6 +19,13 @@
 #define SPI_MODE2 2
 #define SPI_MODE3 3
 
+// DMA transfers for spi_burst(), on channels 0 (receive) and 1 (transmit)
+#define SPI_DMA_CHUNK   256 // Most bytes moved per pair of DMA blocks
+#define SPI_DMA_MIN     16  // Shorter bursts are quicker without DMA setup
+#define SPI_DMA_TIMEOUT 10  // Most ms a chunk may take before bursts fall back to PIO
+
+#define SPI_CORE_HZ 100000000 // Core timer rate, SYSCLK/2
+
 typedef uint32_t (*send_spi_fp) (uint32_t);
 
 /*
@@ -30,8 +38,22 @@ typedef struct {
   send_spi_fp send_fp; // send_spi function pointer
   uint32_t *cs_lat; // pointer to CS lat bits
   uint8_t cs_num; // number of bit in lat register
+  uint8_t bus; // SPI bus number, or 0 if only send_fp is known
 } SPIConn;
 
+/*
+ *Bytes moved by spi_burst() along one path and the core timer ticks
+ *spent moving them, for spi_burst_rate().
+ */
+typedef struct {
+  uint32_t bytes;
+  uint64_t ticks;
+} SPIBurstStats;
+
+extern uint8_t spi_dma_enabled;
+extern SPIBurstStats spi_dma_stats;
+extern SPIBurstStats spi_pio_stats;
+
 void init_spi(uint8_t bus, double mhz, uint8_t size, uint8_t mode);
 
 send_spi_fp get_send_spi(uint8_t bus);
@@ -41,15 +63,26 @@ uint32_t send_spi3(uint32_t value);
 uint32_t send_spi5(uint32_t value);
 uint32_t send_spi6(uint32_t value);
 uint32_t send_spi(uint32_t value, SPIConn *conn);
+void spi_burst(SPIConn* conn, const uint8_t* tx, uint8_t* rx, uint32_t len);
+uint32_t spi_burst_rate(const SPIBurstStats* stats);
+
+// Lets simulated SPI devices see chip select changes in the host build
+#ifdef FSAE_HOST
+#define SPI_CS_SYNC(conn) host_sfr_sync((conn)->cs_lat)
+#else
+#define SPI_CS_SYNC(conn)
+#endif
 
 // Set !CS Low
 inline void spi_select(SPIConn* conn) {
   *(conn->cs_lat) &= ~(1 << (conn->cs_num));
+  SPI_CS_SYNC(conn);
 };
 
 // Set !CS High
 inline void spi_deselect(SPIConn* conn) {
   *(conn->cs_lat) |= 1 << conn->cs_num;
+  SPI_CS_SYNC(conn);
 }
 
 #endif /* FSAE_SPI_H */
@@ -0,0 +1,1248 @@
+/**
+ * FSAE Library Host Backend
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ */
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <linux/can.h>
+#include <net/if.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include <xc.h>
+#include "host_bus.h"
+
+// Number of CAN FIFOs the library configures
+#define HOST_CAN_FIFOS 4
+
+// Bytes per CAN message buffer, 4 words
+#define HOST_CAN_BUF_SIZE 16
+
+// Number of SPI modules on the 100-pin PIC32MZ (SPI4 is not bonded out)
+#define HOST_SPI_MODULES 6
+
+// Most chip selects that device models can watch
+#define HOST_SPI_SELECTS 4
+
+// DMA channels modelled, the ones spi_burst() uses
+#define HOST_DMA_CHANNELS 2
+
+// Program flash of the PIC32MZ2048EF, two panels with the lower one at
+// HOST_FLASH_BASE and the other above it, unless PFSWAP swaps them
+#define HOST_FLASH_BASE  0x1D000000
+#define HOST_FLASH_PANEL 0x100000
+#define HOST_FLASH_PAGE  0x4000
+#define HOST_FLASH_ROW   0x800
+
+// Second word of the NVMKEY unlock sequence
+#define HOST_NVMKEY 0x556699AA
+
+// Interrupt handlers provided by the node, if any
+extern void can_inthnd(void) __attribute__((weak));
+extern void timer1_inthnd(void) __attribute__((weak));
+extern void timer2_inthnd(void) __attribute__((weak));
+
+// Guards every register and the peripheral models
+static pthread_mutex_t sfr_lock;
+
+// Held while an interrupt handler runs, so CLI() waits for it to return
+static pthread_mutex_t irq_lock;
+static volatile int irq_enabled = 0;
+
+static struct timespec start_time;
+
+// Occupancy of each CAN FIFO. The message buffers themselves live in the
+// firmware's CAN_FIFO_Buffers at C1FIFOBA, as on the device.
+typedef struct {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t count;
+} host_can_fifo;
+
+static host_can_fifo can_fifo[HOST_CAN_FIFOS];
+static host_can_tx_handler can_tx_handler = NULL;
+
+// Connection to the canbus simulator, if FSAE_HOST_BUS is set. At most one
+// frame is offered to the bus at a time, from the head of <bus_fifo>.
+static int bus_fd = -1;
+static int bus_pending = 0;
+static int bus_cancelled = 0;
+static uint8_t bus_fifo = 0;
+
+// Connection to a SocketCAN interface, if FSAE_HOST_SOCKETCAN is set
+static int socketcan_fd = -1;
+
+// Transmit and receive error counters, reflected in C1TREC by can_trec_update()
+static uint32_t can_tec = 0;
+static uint32_t can_rec = 0;
+
+static volatile __C1FIFOCON0bits_t* const can_con[HOST_CAN_FIFOS] = {
+  (volatile __C1FIFOCON0bits_t*) &host_C1FIFOCON0bits,
+  (volatile __C1FIFOCON0bits_t*) &host_C1FIFOCON1bits,
+  (volatile __C1FIFOCON0bits_t*) &host_C1FIFOCON2bits,
+  (volatile __C1FIFOCON0bits_t*) &host_C1FIFOCON3bits
+};
+static volatile __C1FIFOINT0bits_t* const can_int[HOST_CAN_FIFOS] = {
+  (volatile __C1FIFOINT0bits_t*) &host_C1FIFOINT0bits,
+  (volatile __C1FIFOINT0bits_t*) &host_C1FIFOINT1bits,
+  (volatile __C1FIFOINT0bits_t*) &host_C1FIFOINT2bits,
+  (volatile __C1FIFOINT0bits_t*) &host_C1FIFOINT3bits
+};
+static volatile uintptr_t* const can_ua[HOST_CAN_FIFOS] = {
+  &host_C1FIFOUA0,
+  &host_C1FIFOUA1,
+  &host_C1FIFOUA2,
+  &host_C1FIFOUA3
+};
+static volatile uint32_t* const can_ci[HOST_CAN_FIFOS] = {
+  &host_C1FIFOCI0,
+  &host_C1FIFOCI1,
+  &host_C1FIFOCI2,
+  &host_C1FIFOCI3
+};
+
+// Acceptance filter registers, see can_filter_fifo()
+static volatile uint32_t* const can_fltcon[8] = {
+  &C1FLTCON0, &C1FLTCON1, &C1FLTCON2, &C1FLTCON3,
+  &C1FLTCON4, &C1FLTCON5, &C1FLTCON6, &C1FLTCON7
+};
+static volatile uint32_t* const can_rxf[32] = {
+  &C1RXF0, &C1RXF1, &C1RXF2, &C1RXF3, &C1RXF4, &C1RXF5, &C1RXF6, &C1RXF7,
+  &C1RXF8, &C1RXF9, &C1RXF10, &C1RXF11, &C1RXF12, &C1RXF13, &C1RXF14, &C1RXF15,
+  &C1RXF16, &C1RXF17, &C1RXF18, &C1RXF19, &C1RXF20, &C1RXF21, &C1RXF22, &C1RXF23,
+  &C1RXF24, &C1RXF25, &C1RXF26, &C1RXF27, &C1RXF28, &C1RXF29, &C1RXF30, &C1RXF31
+};
+static volatile uint32_t* const can_rxm[4] = {
+  &C1RXM0, &C1RXM1, &C1RXM2, &C1RXM3
+};
+
+static host_spi_device spi_device[HOST_SPI_MODULES + 1];
+static volatile uint64_t* const spi_buf[HOST_SPI_MODULES + 1] = {
+  NULL, &host_SPI1BUF, &host_SPI2BUF, &host_SPI3BUF, NULL, &host_SPI5BUF, &host_SPI6BUF
+};
+static volatile __SPI1STATbits_t* const spi_stat[HOST_SPI_MODULES + 1] = {
+  NULL,
+  (volatile __SPI1STATbits_t*) &host_SPI1STATbits,
+  (volatile __SPI1STATbits_t*) &host_SPI2STATbits,
+  (volatile __SPI1STATbits_t*) &host_SPI3STATbits,
+  NULL,
+  (volatile __SPI1STATbits_t*) &host_SPI5STATbits,
+  (volatile __SPI1STATbits_t*) &host_SPI6STATbits
+};
+
+// Interrupt sources that pace DMA transfers through each SPI module
+static const uint32_t spi_rx_irq[HOST_SPI_MODULES + 1] = {
+  0, _SPI1_RX_VECTOR, _SPI2_RX_VECTOR, _SPI3_RX_VECTOR, 0, _SPI5_RX_VECTOR, _SPI6_RX_VECTOR
+};
+static const uint32_t spi_tx_irq[HOST_SPI_MODULES + 1] = {
+  0, _SPI1_TX_VECTOR, _SPI2_TX_VECTOR, _SPI3_TX_VECTOR, 0, _SPI5_TX_VECTOR, _SPI6_TX_VECTOR
+};
+
+// Registers of each DMA channel
+typedef struct {
+  volatile uint32_t* con;
+  volatile uint32_t* econ;
+  volatile uint32_t* intr;
+  volatile uintptr_t* ssa;
+  volatile uintptr_t* dsa;
+  volatile uint32_t* ssiz;
+  volatile uint32_t* dsiz;
+} host_dma_channel;
+
+static const host_dma_channel dma_channel[HOST_DMA_CHANNELS] = {
+  {&host_DCH0CON, &DCH0ECON, &host_DCH0INT, &DCH0SSA, &DCH0DSA, &DCH0SSIZ, &DCH0DSIZ},
+  {&host_DCH1CON, &DCH1ECON, &host_DCH1INT, &DCH1SSA, &DCH1DSA, &DCH1SSIZ, &DCH1DSIZ}
+};
+
+// Chip selects watched for device models, with the level each was last seen at
+typedef struct {
+  volatile uint32_t* lat;
+  uint8_t num;
+  uint8_t high;
+  host_spi_select select;
+} host_spi_cs;
+
+static host_spi_cs spi_cs[HOST_SPI_SELECTS];
+static uint8_t spi_cs_count = 0;
+
+// Both flash panels, panel 1 first. Kept in a memory file that is handed
+// across a software reset, so a reset node finds the flash as it left it. A
+// reset clears PFSWAP, as NVMCON's reset value does on the device, and only
+// host_restart() keeps it. A fresh process starts erased, as at power-on.
+static uint8_t* flash = NULL;
+static int flash_fd = -1;
+static uint32_t flash_swap = 0;
+
+// The node's command line, to run it again on a software reset
+static char** host_argv = NULL;
+
+static volatile uint32_t* const adc_data[] = {
+  &ADCDATA0, &ADCDATA1, &ADCDATA2, &ADCDATA3, &ADCDATA4, &ADCDATA5, &ADCDATA6,
+  &ADCDATA7, &ADCDATA8, &ADCDATA9, &ADCDATA10, &ADCDATA11, &ADCDATA12,
+  &ADCDATA13, &ADCDATA14, &ADCDATA15, &ADCDATA16, &ADCDATA17, &ADCDATA18,
+  &ADCDATA19, &ADCDATA20, &ADCDATA21, &ADCDATA22, &ADCDATA23, &ADCDATA24,
+  &ADCDATA25, &ADCDATA26, &ADCDATA27, &ADCDATA28, &ADCDATA29, &ADCDATA30,
+  &ADCDATA31, &ADCDATA32, &ADCDATA33, &ADCDATA34, NULL, NULL, NULL, NULL, NULL,
+  NULL, NULL, NULL, &ADCDATA43, &ADCDATA44
+};
+
+/**
+ * uint32_t can_fifo_size(uint8_t fifo)
+ *
+ * @returns The number of message buffers in the FIFO.
+ */
+static uint32_t can_fifo_size(uint8_t fifo) {
+  return can_con[fifo]->FSIZE + 1;
+}
+
+/**
+ * volatile uint32_t* can_fifo_slot(uint8_t fifo, uint32_t index)
+ *
+ * @returns The message buffer at <index> in the FIFO. FIFOs are laid out back
+ *     to back from C1FIFOBA.
+ */
+static volatile uint32_t* can_fifo_slot(uint8_t fifo, uint32_t index) {
+  uintptr_t addr = C1FIFOBA;
+  uint8_t i;
+  for (i = 0; i < fifo; i++) {
+    addr += can_fifo_size(i) * HOST_CAN_BUF_SIZE;
+  }
+  return (volatile uint32_t*) (addr + index * HOST_CAN_BUF_SIZE);
+}
+
+/**
+ * uint32_t can_slot_id(const volatile uint32_t* slot)
+ *
+ * @returns The ID of the frame in a transmit message buffer, with the flags
+ *     in host_bus.h
+ */
+static uint32_t can_slot_id(const volatile uint32_t* slot) {
+  uint32_t id = slot[0] & 0x7FF;
+  if (slot[1] & (1u << 28)) {
+    id = HOST_BUS_EXT | (id << 18) | ((slot[1] >> 10) & 0x3FFFF);
+  }
+  if (slot[1] & (1u << 9)) {
+    id |= HOST_BUS_RTR;
+  }
+  return id;
+}
+
+/**
+ * uint16_t can_timestamp(void)
+ *
+ * @returns The count of the timestamp timer, which the CAN module clocks from
+ *     PBCLK5 through the CANTSPRE prescaler.
+ */
+static uint16_t can_timestamp(void) {
+  uint64_t pbclk5 = HOST_SYSCLK / (PB5DIVbits.PBDIV + 1);
+  return (uint16_t) (host_micros() * (pbclk5 / 1000000) / (host_C1TMRbits.CANTSPRE + 1));
+}
+
+/**
+ * void can_trec_update(void)
+ *
+ * Sets the C1TREC counts and error state bits from the error counters.
+ */
+static void can_trec_update(void) {
+  host_C1TRECbits.TERRCNT = can_tec > 255 ? 255 : can_tec;
+  host_C1TRECbits.RERRCNT = can_rec;
+  host_C1TRECbits.TXWARN = can_tec >= 96;
+  host_C1TRECbits.RXWARN = can_rec >= 96;
+  host_C1TRECbits.EWARN = can_tec >= 96 || can_rec >= 96;
+  host_C1TRECbits.TXBP = can_tec >= 128;
+  host_C1TRECbits.RXBP = can_rec >= 128;
+  host_C1TRECbits.TXBO = can_tec > 255;
+}
+
+/**
+ * int can_online(void)
+ *
+ * @returns Whether the module takes part in bus traffic: it is in normal
+ *     operation mode and not bus-off.
+ */
+static int can_online(void) {
+  return host_C1CONbits.OPMOD == 0 && !host_C1TRECbits.TXBO;
+}
+
+/**
+ * void bus_send(uint8_t type, uint32_t id, uint32_t dlc, const volatile void* data,
+ *     uint16_t queued)
+ *
+ * Sends one message to the canbus simulator.
+ */
+static void bus_send(uint8_t type, uint32_t id, uint32_t dlc, const volatile void* data,
+    uint16_t queued) {
+  host_bus_msg msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.type = type;
+  msg.queued = queued;
+  msg.id = id;
+  msg.dlc = (uint8_t) dlc;
+  if (data != NULL) {
+    memcpy(msg.data, (const void*) data, 8);
+  }
+  send(bus_fd, &msg, sizeof(msg), MSG_NOSIGNAL);
+}
+
+/**
+ * int can_tx_next(void)
+ *
+ * @returns The transmit FIFO the module sends from next: the one with the
+ *     highest TXPRI that has a frame waiting, the higher-numbered FIFO on a
+ *     tie, as on the device. -1 if nothing is waiting.
+ */
+static int can_tx_next(void) {
+  int next = -1;
+  uint8_t i;
+  for (i = 0; i < HOST_CAN_FIFOS; i++) {
+    if (can_con[i]->TXEN && can_con[i]->TXREQ && can_fifo[i].count > 0 &&
+        (next < 0 || can_con[i]->TXPRI >= can_con[next]->TXPRI)) {
+      next = i;
+    }
+  }
+  return next;
+}
+
+/**
+ * void can_sync(void)
+ *
+ * Applies writes to the CAN control bits, transmits any requested frames and
+ * updates the status bits and user addresses to match the FIFO occupancy.
+ */
+static void can_sync(void) {
+  uint8_t i;
+  int next;
+  int rxPending = 0;
+  int txPending = 0;
+
+  // Mode changes complete immediately, and configuration mode clears the
+  // error counters, which is how the library recovers from bus-off
+  host_C1CONbits.OPMOD = host_C1CONbits.REQOP;
+  host_C1TMRbits.CANTS = can_timestamp();
+  if (host_C1CONbits.OPMOD == 0b100 && (can_tec != 0 || can_rec != 0)) {
+    can_tec = 0;
+    can_rec = 0;
+    can_trec_update();
+  }
+
+  for (i = 0; i < HOST_CAN_FIFOS; i++) {
+    volatile __C1FIFOCON0bits_t* con = can_con[i];
+    host_can_fifo* fifo = &can_fifo[i];
+    uint32_t size = can_fifo_size(i);
+
+    if (con->FRESET) {
+      if (bus_fd >= 0 && con->TXEN && fifo->count > 0) {
+        bus_send(HOST_BUS_TX_DROP, 0, fifo->count, NULL, 0);
+        if (bus_pending && bus_fifo == i) {
+          bus_send(HOST_BUS_CANCEL, 0, 0, NULL, 0);
+          bus_cancelled = 1;
+        }
+      }
+      memset(fifo, 0, sizeof(host_can_fifo));
+      con->FRESET = 0;
+      con->TXREQ = 0;
+    }
+
+    if (con->UINC) {
+      con->UINC = 0;
+      if (con->TXEN && fifo->count < size) {
+        fifo->head = (fifo->head + 1) % size;
+        fifo->count++;
+      } else if (!con->TXEN && fifo->count > 0) {
+        fifo->tail = (fifo->tail + 1) % size;
+        fifo->count--;
+      }
+    }
+  }
+
+  if (!can_online()) {
+    // Nothing is sent while offline, and a bus-off node withdraws its frame
+    if (bus_pending && !bus_cancelled) {
+      bus_send(HOST_BUS_CANCEL, 0, 0, NULL, 0);
+      bus_cancelled = 1;
+    }
+  } else if (bus_fd >= 0) {
+    // On the virtual bus, frames stay in their FIFO until the bus sends them
+    next = can_tx_next();
+    if (next >= 0 && !bus_pending) {
+      volatile uint32_t* slot = can_fifo_slot(next, can_fifo[next].tail);
+      uint16_t queued = 0;
+      for (i = 0; i < HOST_CAN_FIFOS; i++) {
+        if (can_con[i]->TXEN && can_con[i]->TXREQ) {
+          queued += can_fifo[i].count;
+        }
+      }
+      bus_send(HOST_BUS_SUBMIT, can_slot_id(slot), slot[1] & 0xF, &slot[2], queued - 1);
+      bus_pending = 1;
+      bus_fifo = next;
+    }
+  } else {
+    // Otherwise frames leave as soon as transmission is requested
+    while ((next = can_tx_next()) >= 0) {
+      host_can_fifo* fifo = &can_fifo[next];
+      volatile uint32_t* slot = can_fifo_slot(next, fifo->tail);
+      uint8_t data[8];
+      memcpy(data, (const void*) &slot[2], 8);
+      if (can_tx_handler != NULL) {
+        can_tx_handler(can_slot_id(slot), slot[1] & 0xF, data);
+      }
+      fifo->tail = (fifo->tail + 1) % can_fifo_size(next);
+      fifo->count--;
+    }
+  }
+
+  for (i = 0; i < HOST_CAN_FIFOS; i++) {
+    volatile __C1FIFOCON0bits_t* con = can_con[i];
+    volatile __C1FIFOINT0bits_t* intr = can_int[i];
+    host_can_fifo* fifo = &can_fifo[i];
+    uint32_t size = can_fifo_size(i);
+
+    // TXREQ clears once every frame in the FIFO has been sent
+    if (con->TXEN && fifo->count == 0) {
+      con->TXREQ = 0;
+    }
+
+    *can_ua[i] = (uintptr_t) can_fifo_slot(i, con->TXEN ? fifo->head : fifo->tail);
+    *can_ci[i] = con->TXEN ? fifo->tail : fifo->head;
+    intr->RXNEMPTYIF = !con->TXEN && fifo->count > 0;
+    intr->RXHALFIF = !con->TXEN && fifo->count >= size / 2;
+    intr->RXFULLIF = !con->TXEN && fifo->count == size;
+    intr->TXNFULLIF = con->TXEN && fifo->count < size;
+    intr->TXHALFIF = con->TXEN && fifo->count <= size / 2;
+    intr->TXEMPTYIF = con->TXEN && fifo->count == 0;
+
+    rxPending |= (intr->RXNEMPTYIF && intr->RXNEMPTYIE) ||
+      (intr->RXHALFIF && intr->RXHALFIE) || (intr->RXFULLIF && intr->RXFULLIE);
+    txPending |= (intr->TXNFULLIF && intr->TXNFULLIE) ||
+      (intr->TXHALFIF && intr->TXHALFIE) || (intr->TXEMPTYIF && intr->TXEMPTYIE);
+  }
+
+  host_C1INTbits.RBIF = rxPending;
+  host_C1INTbits.TBIF = txPending;
+}
+
+/**
+ * void spi_sync(void)
+ *
+ * Exchanges any word the firmware wrote to an SPIxBUF with the attached
+ * device, or with zero if none is attached.
+ */
+static void spi_sync(void) {
+  uint8_t i;
+  for (i = 1; i <= HOST_SPI_MODULES; i++) {
+    if (spi_buf[i] == NULL || (*spi_buf[i] & HOST_SPI_FRESH)) {
+      continue;
+    }
+
+    uint32_t out = (uint32_t) *spi_buf[i];
+    uint32_t in = spi_device[i] != NULL ? spi_device[i](out) : 0;
+    *spi_buf[i] = in | HOST_SPI_FRESH;
+    spi_stat[i]->SPIRBF = 1;
+    spi_stat[i]->SPITBE = 1;
+  }
+}
+
+/**
+ * const host_dma_channel* dma_started(uint32_t irq)
+ *
+ * @returns The enabled DMA channel started by interrupt source <irq>, or NULL
+ */
+static const host_dma_channel* dma_started(uint32_t irq) {
+  uint8_t i;
+  for (i = 0; i < HOST_DMA_CHANNELS; i++) {
+    const host_dma_channel* chn = &dma_channel[i];
+    if ((*chn->con & _DCH0CON_CHEN_MASK) && (*chn->econ & _DCH0ECON_SIRQEN_MASK) &&
+        ((*chn->econ >> _DCH0ECON_CHSIRQ_POSITION) & 0xFF) == irq) {
+      return chn;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * void dma_done(const host_dma_channel* chn)
+ *
+ * Ends the block transfer of <chn>, which disables it as on the device.
+ */
+static void dma_done(const host_dma_channel* chn) {
+  *chn->con &= ~_DCH0CON_CHEN_MASK;
+  *chn->intr |= _DCH0INT_CHBCIF_MASK | _DCH0INT_CHDDIF_MASK | _DCH0INT_CHSDIF_MASK;
+}
+
+/**
+ * void dma_sync(void)
+ *
+ * Runs the DMA transfers paced by an SPI module's interrupts. A channel
+ * started by an SPI transmit interrupt feeds bytes to the attached device,
+ * one cell per byte, and a channel started by the same module's receive
+ * interrupt collects its replies. Each block runs to completion at once.
+ */
+static void dma_sync(void) {
+  uint8_t i;
+  uint32_t n;
+
+  if (!DMACONbits.ON) {
+    return;
+  }
+
+  for (i = 1; i <= HOST_SPI_MODULES; i++) {
+    const host_dma_channel* tx = spi_buf[i] != NULL ? dma_started(spi_tx_irq[i]) : NULL;
+    const host_dma_channel* rx = tx != NULL ? dma_started(spi_rx_irq[i]) : NULL;
+    if (tx == NULL || *tx->ssiz == 0 || *tx->dsiz == 0 || (rx != NULL && *rx->dsiz == 0)) {
+      continue;
+    }
+
+    // Sizes are in bytes, and a block moves the larger of the two
+    uint32_t tx_size = *tx->ssiz > *tx->dsiz ? *tx->ssiz : *tx->dsiz;
+    uint32_t rx_size = 0;
+    if (rx != NULL) {
+      rx_size = *rx->ssiz > *rx->dsiz ? *rx->ssiz : *rx->dsiz;
+    }
+    const uint8_t* src = (const uint8_t*) *tx->ssa;
+    uint8_t* dst = rx != NULL ? (uint8_t*) *rx->dsa : NULL;
+
+    for (n = 0; n < tx_size; n++) {
+      uint32_t out = src[n % *tx->ssiz];
+      uint32_t in = spi_device[i] != NULL ? spi_device[i](out) : 0;
+      if (n < rx_size) {
+        dst[n % *rx->dsiz] = (uint8_t) in;
+      }
+    }
+
+    dma_done(tx);
+    if (rx != NULL && tx_size >= rx_size) {
+      dma_done(rx);
+    }
+  }
+}
+
+/**
+ * void spi_cs_sync(void)
+ *
+ * Tells device models when the firmware has driven their chip select low or
+ * high since the last sync.
+ */
+static void spi_cs_sync(void) {
+  uint8_t i;
+  for (i = 0; i < spi_cs_count; i++) {
+    uint8_t high = (*spi_cs[i].lat >> spi_cs[i].num) & 0x1;
+    if (high != spi_cs[i].high) {
+      spi_cs[i].high = high;
+      spi_cs[i].select(!high);
+    }
+  }
+}
+
+/**
+ * void i2c_sync(void)
+ *
+ * No I2C devices are modelled, so every bus condition completes immediately.
+ */
+static void i2c_sync(void) {
+  host_I2C4CONbits.SEN = 0;
+  host_I2C4CONbits.PEN = 0;
+  host_I2C4CONbits.RSEN = 0;
+  host_I2C4CONbits.RCEN = 0;
+  host_I2C4CONbits.ACKEN = 0;
+}
+
+/**
+ * uint8_t* flash_map(void)
+ *
+ * @returns Both flash panels, mapped on first use
+ */
+static uint8_t* flash_map(void) {
+  const char* fd = getenv("FSAE_HOST_FLASH_FD");
+  const char* swap = getenv("FSAE_HOST_PFSWAP");
+  int fresh = fd == NULL;
+
+  if (flash != NULL) {
+    return flash;
+  }
+  flash_fd = fresh ? memfd_create("fsae_flash", 0) : atoi(fd);
+  if (flash_fd < 0 || (fresh && ftruncate(flash_fd, 2 * HOST_FLASH_PANEL) != 0) ||
+      (flash = mmap(NULL, 2 * HOST_FLASH_PANEL, PROT_READ | PROT_WRITE, MAP_SHARED,
+      flash_fd, 0)) == MAP_FAILED) {
+    fprintf(stderr, "fsae_host: cannot map flash: %m\n");
+    exit(1);
+  }
+  if (fresh) {
+    memset(flash, 0xFF, 2 * HOST_FLASH_PANEL);
+  }
+  flash_swap = swap != NULL && atoi(swap) != 0;
+  host_NVMCON |= flash_swap ? _NVMCON_PFSWAP_MASK : 0;
+  return flash;
+}
+
+void* host_pa_to_kva(uintptr_t pa) {
+  if (pa >= HOST_FLASH_BASE && pa < HOST_FLASH_BASE + 2 * HOST_FLASH_PANEL) {
+    uint32_t offset = pa - HOST_FLASH_BASE;
+    return flash_map() + (offset ^ (flash_swap ? HOST_FLASH_PANEL : 0));
+  }
+  return (void*) pa;
+}
+
+/**
+ * uint8_t flash_program(uint32_t addr, const void* data, uint32_t size)
+ *
+ * Programs <size> bytes at physical address <addr>. Each location may only be
+ * programmed once between erases, since the device keeps ECC for each quad
+ * word, so programming one that is not erased fails.
+ *
+ * @returns Whether the write failed
+ */
+static uint8_t flash_program(uint32_t addr, const void* data, uint32_t size) {
+  uint8_t* dst;
+  uint32_t i;
+
+  if (addr % size != 0 || addr < HOST_FLASH_BASE ||
+      addr + size > HOST_FLASH_BASE + 2 * HOST_FLASH_PANEL) {
+    return 1;
+  }
+  dst = host_pa_to_kva(addr);
+  for (i = 0; i < size; i++) {
+    if (dst[i] != 0xFF) {
+      return 1;
+    }
+  }
+  memcpy(dst, data, size);
+  return 0;
+}
+
+/**
+ * uint8_t flash_erase(uint32_t addr, uint32_t size)
+ *
+ * Erases the <size> bytes of flash aligned around physical address <addr>.
+ *
+ * @returns Whether the erase failed
+ */
+static uint8_t flash_erase(uint32_t addr, uint32_t size) {
+  addr -= (addr - HOST_FLASH_BASE) % size;
+  if (addr < HOST_FLASH_BASE || addr + size > HOST_FLASH_BASE + 2 * HOST_FLASH_PANEL) {
+    return 1;
+  }
+  memset(host_pa_to_kva(addr), 0xFF, size);
+  return 0;
+}
+
+/**
+ * void flash_sync(void)
+ *
+ * Carries out a flash operation once the firmware sets WR, and a panel swap
+ * once it changes PFSWAP. Both only take effect right after the NVMKEY unlock
+ * sequence, and an operation also needs WREN. Operations complete at once, so
+ * WR always reads as clear.
+ */
+static void flash_sync(void) {
+  uint32_t con = (host_NVMCON | host_NVMCONSET) & ~host_NVMCONCLR;
+  int unlocked = NVMKEY == HOST_NVMKEY;
+  uint32_t data[4] = {NVMDATA0, NVMDATA1, NVMDATA2, NVMDATA3};
+  uint8_t failed = 0;
+
+  host_NVMCONSET = 0;
+  host_NVMCONCLR = 0;
+
+  if (((con & _NVMCON_PFSWAP_MASK) != 0) != flash_swap) {
+    if (unlocked) {
+      flash_map();
+      flash_swap = !flash_swap;
+      NVMKEY = 0;
+    } else {
+      con ^= _NVMCON_PFSWAP_MASK;
+    }
+  }
+
+  if (con & _NVMCON_WR_MASK) {
+    con &= ~(_NVMCON_WR_MASK | _NVMCON_WRERR_MASK | _NVMCON_LVDERR_MASK);
+    if (!unlocked || !(con & _NVMCON_WREN_MASK)) {
+      failed = 1;
+    } else {
+      switch (con & _NVMCON_NVMOP_MASK) {
+        case 0x1: // Word program
+          failed = flash_program(NVMADDR, data, 4);
+          break;
+        case 0x2: // Quad word program
+          failed = flash_program(NVMADDR, data, 16);
+          break;
+        case 0x3: // Row program
+          failed = flash_program(NVMADDR, (const void*) NVMSRCADDR, HOST_FLASH_ROW);
+          break;
+        case 0x4: // Page erase
+          failed = flash_erase(NVMADDR, HOST_FLASH_PAGE);
+          break;
+        case 0x5: // Lower program flash erase
+          failed = flash_erase(HOST_FLASH_BASE, HOST_FLASH_PANEL);
+          break;
+        case 0x6: // Upper program flash erase
+          failed = flash_erase(HOST_FLASH_BASE + HOST_FLASH_PANEL, HOST_FLASH_PANEL);
+          break;
+        case 0x7: // Both panels
+          failed = flash_erase(HOST_FLASH_BASE, 2 * HOST_FLASH_PANEL);
+          break;
+        default:
+          failed = 1;
+          break;
+      }
+      NVMKEY = 0;
+    }
+  }
+  host_NVMCON = con | (failed ? _NVMCON_WRERR_MASK : 0);
+}
+
+/**
+ * void host_exec(uint32_t swap)
+ *
+ * Runs the node again in the same process, with the flash kept and PFSWAP
+ * set to <swap>. The node reconnects to the canbus simulator.
+ */
+static void host_exec(uint32_t swap) {
+  char value[16];
+
+  flash_map();
+  snprintf(value, sizeof(value), "%d", flash_fd);
+  setenv("FSAE_HOST_FLASH_FD", value, 1);
+  snprintf(value, sizeof(value), "%u", swap);
+  setenv("FSAE_HOST_PFSWAP", value, 1);
+  if (bus_fd >= 0) {
+    fcntl(bus_fd, F_SETFD, FD_CLOEXEC);
+  }
+  fflush(stdout);
+  fflush(stderr);
+  execv("/proc/self/exe", host_argv);
+  fprintf(stderr, "fsae_host: cannot reset: %m\n");
+  _exit(1);
+}
+
+/**
+ * void reset_sync(void)
+ *
+ * Carries out a software reset once the firmware sets RSWRSTSET. Flash is
+ * kept and PFSWAP cleared.
+ */
+static void reset_sync(void) {
+  if (!(RSWRSTSET & 0x1) || host_argv == NULL) {
+    return;
+  }
+  host_exec(0);
+}
+
+/**
+ * void host_restart(void)
+ *
+ * Jumps to the startup code without a reset, as BOOT_RESTART() does after a
+ * panel swap, so PFSWAP is kept.
+ */
+void host_restart(void) {
+  host_sfr_sync(&host_NVMCON); // Takes in the firmware's last PFSWAP change
+  host_exec(flash_swap);
+}
+
+void* host_sfr_sync(volatile void* sfr) {
+  pthread_mutex_lock(&sfr_lock);
+  can_sync();
+  spi_sync();
+  dma_sync();
+  spi_cs_sync();
+  i2c_sync();
+  flash_sync();
+  reset_sync();
+  pthread_mutex_unlock(&sfr_lock);
+  return (void*) sfr;
+}
+
+/**
+ * int can_filter_fifo(uint32_t id)
+ *
+ * Applies the acceptance filters to an ID with the flags in host_bus.h. As on
+ * the device, the lowest numbered enabled filter that matches wins. A mask
+ * with MIDE set only matches frames of the type given by the filter's EXID,
+ * and EID bits are only compared for extended frames.
+ *
+ * @returns The FIFO the matching filter selects, or -1 if no filter matches
+ */
+static int can_filter_fifo(uint32_t id) {
+  uint32_t ext = (id & HOST_BUS_EXT) != 0;
+  uint32_t fields = ext ? (((id >> 18) & 0x7FF) << 21) | (id & 0x3FFFF) : (id & 0x7FF) << 21;
+  uint8_t n;
+
+  for (n = 0; n < 32; n++) {
+    uint32_t con = (*can_fltcon[n / 4] >> (8 * (n % 4))) & 0xFF;
+    if (con & 0x80) {
+      uint32_t mask = *can_rxm[(con >> 5) & 0x3];
+      uint32_t filter = *can_rxf[n];
+      uint32_t compare = mask & (ext ? 0xFFE3FFFF : 0xFFE00000);
+      if ((mask & (1u << 19)) && ((filter >> 19) & 0x1) != ext) {
+        continue;
+      }
+      if ((fields & compare) == (filter & compare)) {
+        return con & 0x1F;
+      }
+    }
+  }
+  return -1;
+}
+
+/**
+ * int host_can_receive(uint32_t id, uint32_t dlc, const uint8_t * data)
+ *
+ * Places a frame in the receive FIFO selected by the acceptance filters, as if
+ * it had arrived on the bus. <id> may carry the flags in host_bus.h. Frames no
+ * filter accepts are discarded, as are all frames while the module is offline.
+ *
+ * @returns 0 on success or if the frame was filtered out, -1 if the FIFO was
+ *     full and the frame was dropped
+ */
+int host_can_receive(uint32_t id, uint32_t dlc, const uint8_t * data) {
+  int result = 0;
+  int i;
+
+  pthread_mutex_lock(&sfr_lock);
+  can_sync();
+
+  i = can_filter_fifo(id);
+  if (C1FIFOBA != 0 && can_online() && i >= 0 && i < HOST_CAN_FIFOS && !can_con[i]->TXEN) {
+    host_can_fifo* fifo = &can_fifo[i];
+    uint32_t size = can_fifo_size(i);
+
+    if (fifo->count == size) {
+      can_int[i]->RXOVLIF = 1;
+      host_C1INTbits.RBOVIF = 1;
+      result = -1;
+    } else {
+      volatile uint32_t* slot = can_fifo_slot(i, fifo->head);
+      uint16_t timestamp = host_C1CONbits.CANCAP ? can_timestamp() : 0;
+
+      // Remote requests are marked by SRR in standard frames and RTR in
+      // extended ones, where SRR is always set
+      if (id & HOST_BUS_EXT) {
+        slot[0] = ((id >> 18) & 0x7FF) | ((uint32_t) timestamp << 16);
+        slot[1] = (dlc & 0xF) | ((id & 0x3FFFF) << 10) | (0x3u << 28) |
+          ((id & HOST_BUS_RTR) ? (1u << 9) : 0);
+      } else {
+        slot[0] = (id & 0x7FF) | ((uint32_t) timestamp << 16);
+        slot[1] = (dlc & 0xF) | ((id & HOST_BUS_RTR) ? (1u << 29) : 0);
+      }
+      memset((void*) &slot[2], 0, 8);
+      if (!(id & HOST_BUS_RTR)) {
+        memcpy((void*) &slot[2], data, dlc > 8 ? 8 : dlc);
+      }
+      fifo->head = (fifo->head + 1) % size;
+      fifo->count++;
+    }
+  }
+
+  can_sync();
+  pthread_mutex_unlock(&sfr_lock);
+
+  return result;
+}
+
+void host_can_set_tx_handler(host_can_tx_handler handler) {
+  pthread_mutex_lock(&sfr_lock);
+  can_tx_handler = handler;
+  pthread_mutex_unlock(&sfr_lock);
+}
+
+void host_spi_attach(uint8_t module, host_spi_device device) {
+  if (module <= HOST_SPI_MODULES) {
+    pthread_mutex_lock(&sfr_lock);
+    spi_device[module] = device;
+    pthread_mutex_unlock(&sfr_lock);
+  }
+}
+
+void host_spi_attach_cs(volatile uint32_t* lat, uint8_t num, host_spi_select select) {
+  pthread_mutex_lock(&sfr_lock);
+  if (spi_cs_count < HOST_SPI_SELECTS) {
+    spi_cs[spi_cs_count].lat = lat;
+    spi_cs[spi_cs_count].num = num;
+    spi_cs[spi_cs_count].high = (*lat >> num) & 0x1;
+    spi_cs[spi_cs_count].select = select;
+    spi_cs_count++;
+  }
+  pthread_mutex_unlock(&sfr_lock);
+}
+
+void host_adc_set(uint8_t chn, uint32_t value) {
+  if (chn < sizeof(adc_data) / sizeof(adc_data[0]) && adc_data[chn] != NULL) {
+    *adc_data[chn] = value;
+  }
+}
+
+uint64_t host_micros(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t) (now.tv_sec - start_time.tv_sec) * 1000000ULL +
+    (now.tv_nsec - start_time.tv_nsec) / 1000;
+}
+
+void host_cli(void) {
+  pthread_mutex_lock(&irq_lock);
+  irq_enabled = 0;
+  pthread_mutex_unlock(&irq_lock);
+}
+
+uint32_t host_cli_save(void) {
+  uint32_t status;
+  pthread_mutex_lock(&irq_lock);
+  status = irq_enabled;
+  irq_enabled = 0;
+  pthread_mutex_unlock(&irq_lock);
+  return status;
+}
+
+void host_sti(void) {
+  pthread_mutex_lock(&irq_lock);
+  irq_enabled = 1;
+  pthread_mutex_unlock(&irq_lock);
+}
+
+void host_eret(void) {
+  fprintf(stderr, "fsae_host: exception handler returned\n");
+  abort();
+}
+
+/**
+ * uint64_t timer_period_us(uint32_t pr, uint32_t tckps, const uint16_t* prescales)
+ *
+ * @returns The period of a timer clocked from PBCLK3, in microseconds.
+ */
+static uint64_t timer_period_us(uint32_t pr, uint32_t tckps, const uint16_t* prescales) {
+  uint64_t pbclk3 = HOST_SYSCLK / (PB3DIVbits.PBDIV + 1);
+  return ((uint64_t) pr * prescales[tckps] * 1000000ULL) / pbclk3;
+}
+
+/**
+ * void timer_tick(uint64_t now, uint64_t period, uint64_t* next, void (*handler)(void))
+ *
+ * Calls <handler> once for every period that has elapsed. Falls behind by at
+ * most a few periods rather than replaying a long stall.
+ */
+static void timer_tick(uint64_t now, uint64_t period, uint64_t* next, void (*handler)(void)) {
+  if (period == 0 || handler == NULL) {
+    *next = 0;
+    return;
+  }
+  if (*next == 0 || now > *next + 4 * period) {
+    *next = now + period;
+  }
+  while (now >= *next) {
+    handler();
+    *next += period;
+  }
+}
+
+/**
+ * void* irq_thread(void* arg)
+ *
+ * Delivers timer and CAN interrupts while they are enabled.
+ */
+static void* irq_thread(void* arg) {
+  static const uint16_t t1_prescales[4] = {1, 8, 64, 256};
+  static const uint16_t t2_prescales[8] = {1, 2, 4, 8, 16, 32, 64, 256};
+  uint64_t t1_next = 0;
+  uint64_t t2_next = 0;
+  struct timespec tick = {0, HOST_TICK_US * 1000};
+  (void) arg;
+
+  for (;;) {
+    nanosleep(&tick, NULL);
+    uint64_t now = host_micros();
+
+    pthread_mutex_lock(&irq_lock);
+    if (irq_enabled) {
+      uint64_t t1 = T1CONbits.ON && IEC0bits.T1IE ?
+        timer_period_us(PR1, T1CONbits.TCKPS & 0x3, t1_prescales) : 0;
+      uint64_t t2 = T2CONbits.ON && IEC0bits.T2IE ?
+        timer_period_us(PR2, T2CONbits.TCKPS & 0x7, t2_prescales) : 0;
+      timer_tick(now, t1, &t1_next, timer1_inthnd);
+      timer_tick(now, t2, &t2_next, timer2_inthnd);
+
+      // The device keeps interrupting while RBOVIF is set; deliver it once
+      if (can_inthnd != NULL && IEC4bits.CAN1IE &&
+          ((C1INTbits.RBIF && C1INTbits.RBIE) ||
+           (C1INTbits.TBIF && C1INTbits.TBIE) ||
+           (C1INTbits.RBOVIF && C1INTbits.RBOVIE))) {
+        can_inthnd();
+        C1INTbits.RBOVIF = 0;
+      }
+    }
+    pthread_mutex_unlock(&irq_lock);
+  }
+
+  return NULL;
+}
+
+/**
+ * void trace_tx(uint32_t id, uint32_t dlc, const uint8_t * data)
+ *
+ * Prints each transmitted frame in candump format, enabled by setting
+ * FSAE_HOST_TRACE in the environment.
+ */
+static void trace_tx(uint32_t id, uint32_t dlc, const uint8_t * data) {
+  uint32_t i;
+  if (id & HOST_BUS_EXT) {
+    printf("(%.6f) host %08X#", host_micros() / 1000000.0, id & 0x1FFFFFFF);
+  } else {
+    printf("(%.6f) host %03X#", host_micros() / 1000000.0, id & 0x7FF);
+  }
+  if (id & HOST_BUS_RTR) {
+    printf("R");
+  }
+  for (i = 0; i < dlc && i < 8 && !(id & HOST_BUS_RTR); i++) {
+    printf("%02X", data[i]);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+/**
+ * void bus_done(void)
+ *
+ * Removes the submitted frame from its FIFO once the bus has sent it, then
+ * offers the next one.
+ */
+static void bus_done(void) {
+  pthread_mutex_lock(&sfr_lock);
+  if (bus_pending && !bus_cancelled) {
+    host_can_fifo* fifo = &can_fifo[bus_fifo];
+    uint32_t size = can_fifo_size(bus_fifo);
+    if (fifo->count > 0) {
+      volatile uint32_t* slot = can_fifo_slot(bus_fifo, fifo->tail);
+      uint8_t data[8];
+      memcpy(data, (const void*) &slot[2], 8);
+      if (can_tx_handler != NULL) {
+        can_tx_handler(can_slot_id(slot), slot[1] & 0xF, data);
+      }
+      fifo->tail = (fifo->tail + 1) % size;
+      fifo->count--;
+    }
+    if (can_tec > 0) {
+      can_tec--;
+      can_trec_update();
+    }
+  }
+  bus_pending = 0;
+  bus_cancelled = 0;
+  can_sync();
+  pthread_mutex_unlock(&sfr_lock);
+}
+
+/**
+ * void bus_frame(const host_bus_msg* msg)
+ *
+ * Counts a frame received from the bus as a success in the receive error
+ * counter, then places it in the receive FIFOs.
+ */
+static void bus_frame(const host_bus_msg* msg) {
+  pthread_mutex_lock(&sfr_lock);
+  if (can_online() && can_rec > 0) {
+    // An error passive receiver drops back to 127 on success
+    can_rec = can_rec > 127 ? 127 : can_rec - 1;
+    can_trec_update();
+  }
+  pthread_mutex_unlock(&sfr_lock);
+
+  if (host_can_receive(msg->id, msg->dlc, msg->data) != 0) {
+    pthread_mutex_lock(&sfr_lock);
+    bus_send(HOST_BUS_RX_DROP, msg->id, msg->dlc, NULL, 0);
+    pthread_mutex_unlock(&sfr_lock);
+  }
+}
+
+/**
+ * void bus_error(uint8_t transmitter)
+ *
+ * Counts an error frame in the error counters as the module does, 8 for the
+ * transmitter and 1 for each receiver. A transmitter whose count passes 255
+ * goes bus-off, and can_sync() withdraws its frame.
+ */
+static void bus_error(uint8_t transmitter) {
+  pthread_mutex_lock(&sfr_lock);
+  if (can_online()) {
+    if (transmitter) {
+      can_tec += 8;
+    } else if (can_rec < 255) {
+      can_rec++;
+    }
+    can_trec_update();
+    can_sync();
+  }
+  pthread_mutex_unlock(&sfr_lock);
+}
+
+/**
+ * void* bus_thread(void* arg)
+ *
+ * Receives frames and transmit confirmations from the canbus simulator. The
+ * node exits when the simulator closes the connection.
+ */
+static void* bus_thread(void* arg) {
+  host_bus_msg msg;
+  (void) arg;
+
+  while (recv(bus_fd, &msg, sizeof(msg), 0) == sizeof(msg)) {
+    if (msg.type == HOST_BUS_FRAME) {
+      bus_frame(&msg);
+    } else if (msg.type == HOST_BUS_DONE) {
+      bus_done();
+    } else if (msg.type == HOST_BUS_ERROR) {
+      bus_error(msg.dlc);
+    }
+  }
+
+  exit(0);
+  return NULL;
+}
+
+/**
+ * void bus_connect(const char* path)
+ *
+ * Connects to the canbus simulator listening at <path>.
+ */
+static void bus_connect(const char* path) {
+  struct sockaddr_un addr;
+  const char* node = getenv("FSAE_HOST_NODE");
+  pthread_t thread;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+
+  bus_fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  if (bus_fd < 0 || connect(bus_fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) {
+    fprintf(stderr, "fsae_host: cannot connect to bus at %s\n", path);
+    exit(1);
+  }
+
+  bus_send(HOST_BUS_HELLO, node != NULL ? (uint32_t) atoi(node) : 0, 0, NULL, 0);
+
+  pthread_create(&thread, NULL, bus_thread, NULL);
+  pthread_detach(thread);
+}
+
+/**
+ * void socketcan_tx(uint32_t id, uint32_t dlc, const uint8_t * data)
+ *
+ * Writes a transmitted frame to the SocketCAN interface, waiting up to a
+ * second while the interface's queue is full.
+ */
+static void socketcan_tx(uint32_t id, uint32_t dlc, const uint8_t * data) {
+  struct can_frame frame;
+  uint32_t tries = 0;
+
+  memset(&frame, 0, sizeof(frame));
+  frame.can_id = id & 0x1FFFFFFF;
+  frame.can_id |= (id & HOST_BUS_EXT) ? CAN_EFF_FLAG : 0;
+  frame.can_id |= (id & HOST_BUS_RTR) ? CAN_RTR_FLAG : 0;
+  frame.can_dlc = dlc > 8 ? 8 : dlc;
+  memcpy(frame.data, data, frame.can_dlc);
+  while (write(socketcan_fd, &frame, sizeof(frame)) < 0 && ++tries < 10000) {
+    usleep(100);
+  }
+  if (getenv("FSAE_HOST_TRACE") != NULL) {
+    trace_tx(id, dlc, data);
+  }
+}
+
+/**
+ * void* socketcan_thread(void* arg)
+ *
+ * Receives frames from the SocketCAN interface.
+ */
+static void* socketcan_thread(void* arg) {
+  struct can_frame frame;
+  (void) arg;
+
+  while (read(socketcan_fd, &frame, sizeof(frame)) == sizeof(frame)) {
+    uint32_t id = frame.can_id & ((frame.can_id & CAN_EFF_FLAG) ? CAN_EFF_MASK : CAN_SFF_MASK);
+    id |= (frame.can_id & CAN_EFF_FLAG) ? HOST_BUS_EXT : 0;
+    id |= (frame.can_id & CAN_RTR_FLAG) ? HOST_BUS_RTR : 0;
+    host_can_receive(id, frame.can_dlc, frame.data);
+  }
+
+  fprintf(stderr, "fsae_host: SocketCAN interface closed\n");
+  exit(1);
+  return NULL;
+}
+
+/**
+ * void socketcan_open(const char* name)
+ *
+ * Sends and receives the node's frames on the SocketCAN interface <name>, so
+ * host tools can run against the car through a USB adapter.
+ */
+static void socketcan_open(const char* name) {
+  struct sockaddr_can addr;
+  struct ifreq ifr;
+  pthread_t thread;
+
+  memset(&addr, 0, sizeof(addr));
+  memset(&ifr, 0, sizeof(ifr));
+  strncpy(ifr.ifr_name, name, sizeof(ifr.ifr_name) - 1);
+  socketcan_fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+  if (socketcan_fd < 0 || ioctl(socketcan_fd, SIOCGIFINDEX, &ifr) != 0) {
+    fprintf(stderr, "fsae_host: no SocketCAN interface %s\n", name);
+    exit(1);
+  }
+  addr.can_family = AF_CAN;
+  addr.can_ifindex = ifr.ifr_ifindex;
+  if (bind(socketcan_fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) {
+    fprintf(stderr, "fsae_host: cannot bind to %s: %m\n", name);
+    exit(1);
+  }
+  can_tx_handler = socketcan_tx;
+
+  pthread_create(&thread, NULL, socketcan_thread, NULL);
+  pthread_detach(thread);
+}
+
+/**
+ * void host_init(int argc, char* argv[])
+ *
+ * Runs before the node's main() and starts the interrupt thread. Connects to
+ * the canbus simulator if FSAE_HOST_BUS is set, or else to the SocketCAN
+ * interface named by FSAE_HOST_SOCKETCAN.
+ */
+__attribute__((constructor)) static void host_init(int argc, char* argv[]) {
+  pthread_mutexattr_t attr;
+  pthread_t thread;
+
+  (void) argc;
+  host_argv = argv;
+  clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+  pthread_mutex_init(&sfr_lock, &attr);
+  pthread_mutex_init(&irq_lock, &attr);
+  pthread_mutexattr_destroy(&attr);
+
+  // NVM chip on SPI6 with its chip select on RD14, see init_nvm_std()
+  host_nvm_attach(6, (volatile uint32_t*) &LATDbits, 14);
+
+  if (getenv("FSAE_HOST_TRACE") != NULL) {
+    can_tx_handler = trace_tx;
+  }
+  if (getenv("FSAE_HOST_BUS") != NULL) {
+    bus_connect(getenv("FSAE_HOST_BUS"));
+  } else if (getenv("FSAE_HOST_SOCKETCAN") != NULL) {
+    socketcan_open(getenv("FSAE_HOST_SOCKETCAN"));
+  }
+  if (getenv("FSAE_HOST_FLASH_FD") != NULL) {
+    flash_map(); // Back from a software reset
+  }
+
+  pthread_create(&thread, NULL, irq_thread, NULL);
+  pthread_detach(thread);
+}
@@ -0,0 +1,92 @@
+/**
+ * FSAE Library Host Backend Header
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Peripheral models used when the library and nodes are built for the host.
+ * The CAN module, SPI modules and ADC are simulated at the register level, so
+ * the firmware runs unchanged. Timer 1, Timer 2 and CAN1 interrupt handlers
+ * run from a separate thread in real time; CLI() and STI() keep them out of
+ * critical sections.
+ *
+ * Run on its own, a node's frames are handed to the transmit handler as soon
+ * as they are queued. Run under the canbus simulator (see can-sim), frames are
+ * exchanged with the other nodes over a virtual bus instead; see host_bus.h.
+ * With FSAE_HOST_SOCKETCAN set to an interface name, they go to that
+ * SocketCAN interface.
+ *
+ * DMA channels 0 and 1 can move bytes through the SPI modules, paced by their
+ * interrupts, as spi_burst() sets them up.
+ *
+ * Program flash is modelled through the NVM controller registers, and a
+ * software reset runs the node again with its flash intact. A 25LC1024 NVM
+ * chip is attached on the standard NVM pins, see host_nvm.c.
+ */
+#ifndef FSAE_HOST_H
+#define FSAE_HOST_H
+
+#include <stdint.h>
+
+// SYSCLK the firmware configures the oscillator for
+#define HOST_SYSCLK 200000000ULL
+
+// Resolution of the interrupt thread in microseconds
+#define HOST_TICK_US 50
+
+// Marks an SPIxBUF value the host placed there. A firmware write clears it,
+// so writes are seen even when the same word is written twice. Reads narrow
+// the register to 32 bits or less and never see it.
+#define HOST_SPI_FRESH (1ULL << 40)
+
+/**
+ * Simulated SPI device. Called with each word the firmware writes to SPIxBUF
+ * and returns the word shifted back in.
+ */
+typedef uint32_t (*host_spi_device)(uint32_t out);
+
+/**
+ * Chip select of a simulated SPI device. Called with 1 when the firmware
+ * drives the pin low and 0 when it drives it high again. Firmware must sync
+ * after changing the pin, as spi_select() and spi_deselect() do.
+ */
+typedef void (*host_spi_select)(int selected);
+
+/**
+ * Called with each frame the firmware transmits. Extended and remote frames
+ * are marked in <id> with the flags in host_bus.h.
+ */
+typedef void (*host_can_tx_handler)(uint32_t id, uint32_t dlc, const uint8_t * data);
+
+// Register access, see host_sfr.h
+void* host_sfr_sync(volatile void* sfr);
+
+// Interrupt control, see CLI() and STI() in FSAE_config.h
+void host_cli(void);
+uint32_t host_cli_save(void);
+void host_sti(void);
+void host_eret(void);
+
+// Peripheral models
+int host_can_receive(uint32_t id, uint32_t dlc, const uint8_t * data);
+void host_can_set_tx_handler(host_can_tx_handler handler);
+void host_spi_attach(uint8_t module, host_spi_device device);
+void host_spi_attach_cs(volatile uint32_t* lat, uint8_t num, host_spi_select select);
+void host_adc_set(uint8_t chn, uint32_t value);
+void host_nvm_attach(uint8_t module, volatile uint32_t* cs_lat, uint8_t cs_num);
+uint32_t host_nvm_write_cycles(void);
+uint32_t host_nvm_page_writes(uint32_t addr);
+void host_nvm_fast(int fast);
+void host_nvm_cut_power(uint32_t cycles);
+int host_nvm_powered(void);
+void host_nvm_power_on(void);
+uint64_t host_micros(void);
+
+// Jump to the startup code, see BOOT_RESTART() in FSAE_boot.h
+void host_restart(void);
+
+// Address translation, see sys/kmem.h
+void* host_pa_to_kva(uintptr_t pa);
+
+#endif /* FSAE_HOST_H */
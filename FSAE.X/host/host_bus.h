@@ -0,0 +1,52 @@
+/**
+ * FSAE Library Host Virtual Bus Protocol
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Messages exchanged between a node built for the host and the canbus
+ * simulator over a SOCK_SEQPACKET Unix socket. A node connects when
+ * FSAE_HOST_BUS names the socket, and identifies itself with the index in
+ * FSAE_HOST_NODE.
+ *
+ * A node offers the frame at the head of its transmit FIFO with SUBMIT and
+ * leaves it in the FIFO until the bus answers with DONE, so the FIFO fills up
+ * when the bus is busy just as it does on the car. Every SUBMIT is answered
+ * by exactly one DONE, including submissions withdrawn with CANCEL. When a
+ * node still has frames waiting, the bus holds arbitration for its next
+ * SUBMIT so the node can send back to back as the module does.
+ *
+ * When the bus destroys a frame with an error it sends ERROR to every node,
+ * so each can count it in its error counters, and leaves the frame submitted
+ * to be sent again as the module would retransmit it.
+ */
+#ifndef HOST_BUS_H
+#define HOST_BUS_H
+
+#include <stdint.h>
+
+// Message types
+#define HOST_BUS_HELLO   0 // Node to bus, <id> is the node index
+#define HOST_BUS_SUBMIT  1 // Node to bus, frame at the head of the TX FIFO
+#define HOST_BUS_CANCEL  2 // Node to bus, the submitted frame was discarded
+#define HOST_BUS_DONE    3 // Bus to node, the submitted frame left the node
+#define HOST_BUS_FRAME   4 // Bus to node, frame received from the bus
+#define HOST_BUS_RX_DROP 5 // Node to bus, <id> was lost to a full RX FIFO
+#define HOST_BUS_TX_DROP 6 // Node to bus, <dlc> frames lost to a TX FIFO reset
+#define HOST_BUS_ERROR   7 // Bus to node, error frame, <dlc> is 1 for the transmitter
+
+// Flags in <id> of frames, as in FSAE_can.h. Without them <id> is a standard
+// 11 bit data frame.
+#define HOST_BUS_EXT 0x80000000u // Extended identifier in the low 29 bits
+#define HOST_BUS_RTR 0x40000000u // Remote request, no data
+
+typedef struct {
+  uint8_t type;
+  uint8_t dlc;
+  uint16_t queued; // SUBMIT only, frames still waiting behind this one
+  uint32_t id;
+  uint8_t data[8];
+} host_bus_msg;
+
+#endif /* HOST_BUS_H */
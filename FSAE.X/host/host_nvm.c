@@ -0,0 +1,331 @@
+/**
+ * FSAE Library Host NVM Model
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Simulated Microchip 25LC1024 SPI EEPROM, for the NVM library in the host
+ * build. Commands take effect when the chip select goes high, as on the chip.
+ * Writes and erases then keep WIP set for their worst-case cycle time, during
+ * which every command but RDSR is ignored.
+ * The memory starts erased and is kept in a memory file that is inherited
+ * across a software reset, as the chip keeps it while the PIC32 resets.
+ *
+ * Tests can cut the chip's power during a chosen write cycle. The page being
+ * written is left torn: a random number of its bytes programmed, the next one
+ * garbled and the rest as they were. The chip then ignores the bus until its
+ * power is restored.
+ */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "fsae_host.h"
+
+#define NVM_SIZE   0x20000
+#define NVM_PAGE   256
+#define NVM_SECTOR 0x8000
+#define NVM_ID     0x29 // Electronic signature read by RDID
+
+// Worst-case cycle times in microseconds
+#define NVM_T_WC 6000  // Page write and WRSR
+#define NVM_T_PE 6000  // Page erase
+#define NVM_T_SE 10000 // Sector erase
+#define NVM_T_CE 10000 // Chip erase
+
+// Instructions
+#define NVM_READ  0x03
+#define NVM_WRITE 0x02
+#define NVM_WREN  0x06
+#define NVM_WRDI  0x04
+#define NVM_RDSR  0x05
+#define NVM_WRSR  0x01
+#define NVM_PE    0x42
+#define NVM_SE    0xD8
+#define NVM_CE    0xC7
+#define NVM_RDID  0xAB
+#define NVM_DPD   0xB9
+
+// Status register bits
+#define NVM_WIP  0x01
+#define NVM_WEL  0x02
+#define NVM_BP   0x0C
+#define NVM_WPEN 0x80
+
+static uint8_t* nvm = NULL;
+static uint8_t nvm_status = 0;
+static uint8_t nvm_asleep = 0; // In deep power-down
+static uint64_t nvm_busy_until = 0; // End of the write cycle in progress
+
+// Command in progress while selected
+static uint8_t nvm_selected = 0;
+static uint32_t nvm_count = 0; // Bytes clocked since select
+static uint8_t nvm_cmd = 0;
+static uint32_t nvm_addr = 0;
+static uint8_t nvm_wrsr = 0;
+
+// Bytes clocked in by a write, programmed when the chip is deselected, and
+// the order each was clocked in, from 1, or 0 if it wasn't
+static uint8_t nvm_page[NVM_PAGE];
+static uint16_t nvm_page_set[NVM_PAGE];
+static uint32_t nvm_page_addr = 0;
+
+static uint32_t nvm_cycles = 0;
+static uint32_t nvm_page_cycles[NVM_SIZE / NVM_PAGE]; // Write cycles of each page
+static uint8_t nvm_fast = 0; // Write cycles take no time
+
+// Power cut during write cycle nvm_cut_cycle, if armed
+static uint8_t nvm_cut_armed = 0;
+static uint32_t nvm_cut_cycle = 0;
+static uint8_t nvm_off = 0;
+
+/**
+ * uint32_t protected_from(void)
+ *
+ * @returns The lowest address the block protect bits guard from writes
+ */
+static uint32_t protected_from(void) {
+  switch ((nvm_status & NVM_BP) >> 2) {
+    case 1: return NVM_SIZE - NVM_SIZE / 4;
+    case 2: return NVM_SIZE / 2;
+    case 3: return 0;
+  }
+  return NVM_SIZE;
+}
+
+/**
+ * void start_cycle(uint32_t time)
+ *
+ * Starts a write cycle of <time> microseconds.
+ */
+static void start_cycle(uint32_t time) {
+  nvm_busy_until = host_micros() + (nvm_fast ? 0 : time);
+  nvm_cycles++;
+}
+
+/**
+ * uint8_t cut_now(void)
+ *
+ * @returns Whether the power fails during the write cycle about to start
+ */
+static uint8_t cut_now(void) {
+  if (nvm_cut_armed && nvm_cycles + 1 == nvm_cut_cycle) {
+    nvm_cut_armed = 0;
+    nvm_off = 1;
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * void erase(uint32_t addr, uint32_t size, uint32_t time)
+ *
+ * Erases the <size> bytes aligned around <addr>, unless they are protected,
+ * in a cycle of <time> microseconds.
+ */
+static void erase(uint32_t addr, uint32_t size, uint32_t time) {
+  uint32_t i;
+
+  addr &= ~(size - 1);
+  if (addr + size <= protected_from()) {
+    // Cut short, a random prefix is erased
+    memset(nvm + addr, 0xFF, cut_now() ? (uint32_t) rand() % size : size);
+    for (i = addr / NVM_PAGE; i < (addr + size) / NVM_PAGE; i++) {
+      nvm_page_cycles[i]++;
+    }
+    start_cycle(time);
+  }
+}
+
+/**
+ * void finish(void)
+ *
+ * Carries out the command that was just deselected.
+ */
+static void finish(void) {
+  uint32_t i, torn;
+
+  if (nvm_asleep) {
+    return;
+  }
+
+  switch (nvm_cmd) {
+    case NVM_WREN:
+      nvm_status |= NVM_WEL;
+      return;
+    case NVM_WRDI:
+      nvm_status &= ~NVM_WEL;
+      return;
+    case NVM_DPD:
+      nvm_asleep = 1;
+      return;
+    case NVM_WRITE:
+      if (!(nvm_status & NVM_WEL) || nvm_count <= 4) {
+        break;
+      }
+      if (nvm_page_addr < protected_from()) {
+        // Cut short, the bytes clocked in after the first <torn> are not
+        // programmed, but for one left garbled
+        torn = cut_now() ? (uint32_t) rand() % (nvm_count - 4) : nvm_count;
+        for (i = 0; i < NVM_PAGE; i++) {
+          if (nvm_page_set[i] != 0 && nvm_page_set[i] <= torn) {
+            nvm[nvm_page_addr + i] = nvm_page[i];
+          } else if (nvm_page_set[i] == torn + 1) {
+            nvm[nvm_page_addr + i] = (uint8_t) rand();
+          }
+        }
+        nvm_page_cycles[nvm_page_addr / NVM_PAGE]++;
+        start_cycle(NVM_T_WC);
+      }
+      break;
+    case NVM_WRSR:
+      if (!(nvm_status & NVM_WEL) || nvm_count < 2) {
+        break;
+      }
+      if (!cut_now()) {
+        nvm_status = (nvm_status & NVM_WEL) | (nvm_wrsr & (NVM_BP | NVM_WPEN));
+      }
+      start_cycle(NVM_T_WC);
+      break;
+    case NVM_PE:
+    case NVM_SE:
+    case NVM_CE:
+      if (!(nvm_status & NVM_WEL) || (nvm_cmd != NVM_CE && nvm_count < 4)) {
+        break;
+      }
+      if (nvm_cmd == NVM_PE) {
+        erase(nvm_addr, NVM_PAGE, NVM_T_PE);
+      } else if (nvm_cmd == NVM_SE) {
+        erase(nvm_addr, NVM_SECTOR, NVM_T_SE);
+      } else {
+        erase(nvm_addr, NVM_SIZE, NVM_T_CE);
+      }
+      break;
+    default:
+      return;
+  }
+
+  // Every write command clears the write enable latch, done or not
+  nvm_status &= ~NVM_WEL;
+}
+
+/**
+ * void nvm_select(int selected)
+ *
+ * Starts a command when the chip is selected and finishes it when it is
+ * deselected.
+ */
+static void nvm_select(int selected) {
+  if (nvm_off) {
+    return;
+  }
+  if (selected) {
+    nvm_count = 0;
+    nvm_addr = 0;
+    memset(nvm_page_set, 0, sizeof(nvm_page_set));
+  } else if (nvm_selected && nvm_count > 0) {
+    finish();
+  }
+  nvm_selected = selected;
+}
+
+/**
+ * uint32_t nvm_exchange(uint32_t out)
+ *
+ * Clocks one byte through the chip while it is selected.
+ */
+static uint32_t nvm_exchange(uint32_t out) {
+  uint8_t byte = out & 0xFF;
+  uint8_t in = 0;
+
+  if (!nvm_selected || nvm_off) {
+    return 0;
+  }
+
+  if (nvm_count == 0) {
+    // Only the status register can be read during a write cycle
+    nvm_cmd = host_micros() < nvm_busy_until && byte != NVM_RDSR ? 0 : byte;
+  } else if (nvm_count <= 3 && nvm_cmd != NVM_RDSR && nvm_cmd != NVM_WRSR) {
+    nvm_addr = ((nvm_addr << 8) | byte) & (NVM_SIZE - 1);
+    nvm_page_addr = nvm_addr & ~(NVM_PAGE - 1);
+  } else if (nvm_cmd == NVM_RDID) {
+    in = NVM_ID; // Also wakes the chip from deep power-down
+    nvm_asleep = 0;
+  } else if (!nvm_asleep) {
+    switch (nvm_cmd) {
+      case NVM_READ:
+        in = nvm[nvm_addr];
+        nvm_addr = (nvm_addr + 1) & (NVM_SIZE - 1);
+        break;
+      case NVM_WRITE:
+        // Wraps within the page, as on the chip
+        nvm_page[nvm_addr & (NVM_PAGE - 1)] = byte;
+        nvm_page_set[nvm_addr & (NVM_PAGE - 1)] = (uint16_t) (nvm_count - 3);
+        nvm_addr = nvm_page_addr | ((nvm_addr + 1) & (NVM_PAGE - 1));
+        break;
+      case NVM_RDSR:
+        in = nvm_status | (host_micros() < nvm_busy_until ? NVM_WIP : 0);
+        break;
+      case NVM_WRSR:
+        nvm_wrsr = byte;
+        break;
+    }
+  }
+
+  nvm_count++;
+  return in;
+}
+
+void host_nvm_attach(uint8_t module, volatile uint32_t* cs_lat, uint8_t cs_num) {
+  const char* fd = getenv("FSAE_HOST_NVM_FD");
+  char value[16];
+  int nvm_fd;
+
+  nvm_fd = fd != NULL ? atoi(fd) : memfd_create("fsae_nvm", 0);
+  if (nvm_fd < 0 || (fd == NULL && ftruncate(nvm_fd, NVM_SIZE) != 0) ||
+      (nvm = mmap(NULL, NVM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, nvm_fd, 0)) == MAP_FAILED) {
+    fprintf(stderr, "fsae_host: cannot map NVM: %m\n");
+    exit(1);
+  }
+  if (fd == NULL) {
+    memset(nvm, 0xFF, NVM_SIZE);
+    snprintf(value, sizeof(value), "%d", nvm_fd);
+    setenv("FSAE_HOST_NVM_FD", value, 1); // Kept across a software reset
+  }
+
+  host_spi_attach(module, nvm_exchange);
+  host_spi_attach_cs(cs_lat, cs_num, nvm_select);
+}
+
+uint32_t host_nvm_write_cycles(void) {
+  return nvm_cycles;
+}
+
+uint32_t host_nvm_page_writes(uint32_t addr) {
+  return nvm_page_cycles[(addr & (NVM_SIZE - 1)) / NVM_PAGE];
+}
+
+void host_nvm_fast(int fast) {
+  nvm_fast = fast != 0;
+}
+
+void host_nvm_cut_power(uint32_t cycles) {
+  nvm_cut_armed = cycles > 0;
+  nvm_cut_cycle = nvm_cycles + cycles;
+}
+
+int host_nvm_powered(void) {
+  return !nvm_off;
+}
+
+void host_nvm_power_on(void) {
+  nvm_off = 0;
+  nvm_cut_armed = 0;
+  nvm_selected = 0;
+  nvm_asleep = 0;
+  nvm_status &= ~NVM_WEL; // Cleared at power-up, the protect bits are kept
+  nvm_busy_until = 0;
+}
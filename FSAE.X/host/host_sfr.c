@@ -0,0 +1,347 @@
+/**
+ * FSAE Library Host Special Function Registers
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Register storage. Status bits that the firmware waits on and that have no
+ * model in fsae_host.c start out in their ready state.
+ */
+#include <xc.h>
+
+volatile __ADCANCONbits_t ADCANCONbits = {.WKRDY1 = 1, .WKRDY2 = 1, .WKRDY7 = 1};
+volatile __ADCCON1bits_t ADCCON1bits;
+volatile __ADCCON2bits_t ADCCON2bits = {.BGVRRDY = 1, .EOSRDY = 1};
+volatile __ADCCON3bits_t ADCCON3bits;
+volatile __ADCCSS1bits_t ADCCSS1bits;
+volatile __ADCCSS2bits_t ADCCSS2bits;
+volatile __ADCTRG1bits_t ADCTRG1bits;
+volatile __ADCTRG2bits_t ADCTRG2bits;
+volatile __ADCTRG3bits_t ADCTRG3bits;
+volatile __ADCTRGMODEbits_t ADCTRGMODEbits;
+volatile __ANSELAbits_t ANSELAbits;
+volatile __ANSELBbits_t ANSELBbits;
+volatile __ANSELCbits_t ANSELCbits;
+volatile __ANSELEbits_t ANSELEbits;
+volatile __ANSELFbits_t ANSELFbits;
+volatile __ANSELGbits_t ANSELGbits;
+volatile __C1CFGbits_t C1CFGbits;
+volatile __C1CONbits_t host_C1CONbits;
+volatile __C1TMRbits_t host_C1TMRbits;
+volatile __C1TRECbits_t host_C1TRECbits;
+volatile __C1FIFOCON0bits_t host_C1FIFOCON0bits;
+volatile __C1FIFOCON1bits_t host_C1FIFOCON1bits;
+volatile __C1FIFOCON2bits_t host_C1FIFOCON2bits;
+volatile __C1FIFOCON3bits_t host_C1FIFOCON3bits;
+volatile __C1FIFOINT0bits_t host_C1FIFOINT0bits;
+volatile __C1FIFOINT1bits_t host_C1FIFOINT1bits;
+volatile __C1FIFOINT2bits_t host_C1FIFOINT2bits;
+volatile __C1FIFOINT3bits_t host_C1FIFOINT3bits;
+volatile __C1INTbits_t host_C1INTbits;
+volatile __C2CONbits_t C2CONbits;
+volatile __CECONbits_t CECONbits;
+volatile __CFGCONbits_t CFGCONbits;
+volatile __CFGPGbits_t CFGPGbits;
+volatile __CM1CONbits_t CM1CONbits;
+volatile __CM2CONbits_t CM2CONbits;
+volatile __CNCONEbits_t CNCONEbits;
+volatile __CNENEbits_t CNENEbits;
+volatile __CNPUGbits_t CNPUGbits;
+volatile __CVRCONbits_t CVRCONbits;
+volatile __DMACONbits_t DMACONbits;
+volatile __ETHCON1bits_t ETHCON1bits;
+volatile __I2C1CONbits_t I2C1CONbits;
+volatile __I2C3CONbits_t I2C3CONbits;
+volatile __I2C4CONbits_t host_I2C4CONbits;
+volatile __I2C4STATbits_t I2C4STATbits = {.RBF = 1};
+volatile __I2C5CONbits_t I2C5CONbits;
+volatile __IC1CONbits_t IC1CONbits;
+volatile __IC2CONbits_t IC2CONbits;
+volatile __IC3CONbits_t IC3CONbits;
+volatile __IC4CONbits_t IC4CONbits;
+volatile __IC5CONbits_t IC5CONbits;
+volatile __IC6CONbits_t IC6CONbits;
+volatile __IC7CONbits_t IC7CONbits;
+volatile __IC8CONbits_t IC8CONbits;
+volatile __IC9CONbits_t IC9CONbits;
+volatile __IEC0bits_t IEC0bits;
+volatile __IEC3bits_t IEC3bits;
+volatile __IEC4bits_t IEC4bits;
+volatile __IEC5bits_t IEC5bits;
+volatile __IFS0bits_t IFS0bits;
+volatile __IFS4bits_t IFS4bits;
+volatile __INTCONbits_t INTCONbits;
+volatile __IPC1bits_t IPC1bits;
+volatile __IPC2bits_t IPC2bits;
+volatile __IPC30bits_t IPC30bits;
+volatile __IPC37bits_t IPC37bits;
+volatile __LATAbits_t LATAbits;
+volatile __LATBbits_t LATBbits;
+volatile __LATCbits_t LATCbits;
+volatile __LATDbits_t LATDbits;
+volatile __LATEbits_t LATEbits;
+volatile __LATFbits_t LATFbits;
+volatile __LATGbits_t LATGbits;
+volatile __OC1CONbits_t OC1CONbits;
+volatile __OC2CONbits_t OC2CONbits;
+volatile __OC3CONbits_t OC3CONbits;
+volatile __OC4CONbits_t OC4CONbits;
+volatile __OC5CONbits_t OC5CONbits;
+volatile __OC6CONbits_t OC6CONbits;
+volatile __OC7CONbits_t OC7CONbits;
+volatile __OC8CONbits_t OC8CONbits;
+volatile __OC9CONbits_t OC9CONbits;
+volatile __OSCCONbits_t OSCCONbits;
+volatile __OSCTUNbits_t OSCTUNbits;
+volatile __PB1DIVbits_t PB1DIVbits = {.PBDIVRDY = 1};
+volatile __PB2DIVbits_t PB2DIVbits = {.PBDIVRDY = 1};
+volatile __PB3DIVbits_t PB3DIVbits = {.PBDIV = 1, .PBDIVRDY = 1};
+volatile __PB4DIVbits_t PB4DIVbits = {.PBDIVRDY = 1};
+volatile __PB5DIVbits_t PB5DIVbits = {.PBDIV = 1, .PBDIVRDY = 1};
+volatile __PB7DIVbits_t PB7DIVbits = {.PBDIVRDY = 1};
+volatile __PB8DIVbits_t PB8DIVbits = {.PBDIVRDY = 1};
+volatile __PMCONbits_t PMCONbits;
+volatile __PMD1bits_t PMD1bits;
+volatile __PMD2bits_t PMD2bits;
+volatile __PMD3bits_t PMD3bits;
+volatile __PMD4bits_t PMD4bits;
+volatile __PMD5bits_t PMD5bits;
+volatile __PMD6bits_t PMD6bits;
+volatile __PMD7bits_t PMD7bits;
+volatile __PORTAbits_t PORTAbits;
+volatile __PORTBbits_t PORTBbits;
+volatile __PORTCbits_t PORTCbits;
+volatile __PORTDbits_t PORTDbits;
+volatile __PORTEbits_t PORTEbits;
+volatile __PORTFbits_t PORTFbits;
+volatile __PORTGbits_t PORTGbits;
+volatile __PRECONbits_t PRECONbits;
+volatile __PRISSbits_t PRISSbits;
+volatile __REFO1CONbits_t REFO1CONbits;
+volatile __REFO1TRIMbits_t REFO1TRIMbits;
+volatile __REFO2CONbits_t REFO2CONbits;
+volatile __REFO3CONbits_t REFO3CONbits;
+volatile __REFO4CONbits_t REFO4CONbits;
+volatile __REFO4TRIMbits_t REFO4TRIMbits;
+volatile __RNGCONbits_t RNGCONbits;
+volatile __RPA14Rbits_t RPA14Rbits;
+volatile __RPB3Rbits_t RPB3Rbits;
+volatile __RPB10Rbits_t RPB10Rbits;
+volatile __RPC1Rbits_t RPC1Rbits;
+volatile __RPF8Rbits_t RPF8Rbits;
+volatile __RPG7Rbits_t RPG7Rbits;
+volatile __RTCCONbits_t RTCCONbits;
+volatile __SDI1Rbits_t SDI1Rbits;
+volatile __SDI2Rbits_t SDI2Rbits;
+volatile __SDI3Rbits_t SDI3Rbits;
+volatile __SDI5Rbits_t SDI5Rbits;
+volatile __SDI6Rbits_t SDI6Rbits;
+volatile __SPI1CONbits_t SPI1CONbits;
+volatile __SPI1STATbits_t host_SPI1STATbits = {.SPITBE = 1};
+volatile __SPI2CONbits_t SPI2CONbits;
+volatile __SPI2STATbits_t host_SPI2STATbits = {.SPITBE = 1};
+volatile __SPI3CONbits_t SPI3CONbits;
+volatile __SPI3STATbits_t host_SPI3STATbits = {.SPITBE = 1};
+volatile __SPI4CONbits_t SPI4CONbits;
+volatile __SPI5CONbits_t SPI5CONbits;
+volatile __SPI5STATbits_t host_SPI5STATbits = {.SPITBE = 1};
+volatile __SPI6CONbits_t SPI6CONbits;
+volatile __SPI6STATbits_t host_SPI6STATbits = {.SPITBE = 1};
+volatile __SQI1CFGbits_t SQI1CFGbits;
+volatile __T1CONbits_t T1CONbits;
+volatile __T2CONbits_t T2CONbits;
+volatile __T3CONbits_t T3CONbits;
+volatile __T4CONbits_t T4CONbits;
+volatile __T5CONbits_t T5CONbits;
+volatile __T6CONbits_t T6CONbits;
+volatile __T7CONbits_t T7CONbits;
+volatile __T8CONbits_t T8CONbits;
+volatile __T9CONbits_t T9CONbits;
+volatile __TRISAbits_t TRISAbits;
+volatile __TRISBbits_t TRISBbits;
+volatile __TRISCbits_t TRISCbits;
+volatile __TRISDbits_t TRISDbits;
+volatile __TRISEbits_t TRISEbits;
+volatile __TRISFbits_t TRISFbits;
+volatile __TRISGbits_t TRISGbits;
+volatile __U1MODEbits_t U1MODEbits;
+volatile __U2MODEbits_t U2MODEbits;
+volatile __U3MODEbits_t U3MODEbits;
+volatile __U4MODEbits_t U4MODEbits;
+volatile __U5MODEbits_t U5MODEbits;
+volatile __U6MODEbits_t U6MODEbits;
+volatile uint32_t ADCANCON;
+volatile uint32_t ADCCMPCON1;
+volatile uint32_t ADCCMPCON2;
+volatile uint32_t ADCCMPCON3;
+volatile uint32_t ADCCMPCON4;
+volatile uint32_t ADCCMPCON5;
+volatile uint32_t ADCCMPCON6;
+volatile uint32_t ADCCON1;
+volatile uint32_t ADCCON2;
+volatile uint32_t ADCCON3;
+volatile uint32_t ADCDATA0;
+volatile uint32_t ADCDATA1;
+volatile uint32_t ADCDATA2;
+volatile uint32_t ADCDATA3;
+volatile uint32_t ADCDATA4;
+volatile uint32_t ADCDATA5;
+volatile uint32_t ADCDATA6;
+volatile uint32_t ADCDATA7;
+volatile uint32_t ADCDATA8;
+volatile uint32_t ADCDATA9;
+volatile uint32_t ADCDATA10;
+volatile uint32_t ADCDATA11;
+volatile uint32_t ADCDATA12;
+volatile uint32_t ADCDATA13;
+volatile uint32_t ADCDATA14;
+volatile uint32_t ADCDATA15;
+volatile uint32_t ADCDATA16;
+volatile uint32_t ADCDATA17;
+volatile uint32_t ADCDATA18;
+volatile uint32_t ADCDATA19;
+volatile uint32_t ADCDATA20;
+volatile uint32_t ADCDATA21;
+volatile uint32_t ADCDATA22;
+volatile uint32_t ADCDATA23;
+volatile uint32_t ADCDATA24;
+volatile uint32_t ADCDATA25;
+volatile uint32_t ADCDATA26;
+volatile uint32_t ADCDATA27;
+volatile uint32_t ADCDATA28;
+volatile uint32_t ADCDATA29;
+volatile uint32_t ADCDATA30;
+volatile uint32_t ADCDATA31;
+volatile uint32_t ADCDATA32;
+volatile uint32_t ADCDATA33;
+volatile uint32_t ADCDATA34;
+volatile uint32_t ADCDATA43;
+volatile uint32_t ADCDATA44;
+volatile uint32_t ADCEIEN1;
+volatile uint32_t ADCEIEN2;
+volatile uint32_t ADCFLTR1;
+volatile uint32_t ADCFLTR2;
+volatile uint32_t ADCFLTR3;
+volatile uint32_t ADCFLTR4;
+volatile uint32_t ADCFLTR5;
+volatile uint32_t ADCFLTR6;
+volatile uint32_t ADCGIRQEN1;
+volatile uint32_t ADCGIRQEN2;
+volatile uint32_t ADCIMCON1;
+volatile uint32_t ADCIMCON2;
+volatile uint32_t ADCIMCON3;
+volatile uint32_t ADCTRGSNS;
+volatile uintptr_t C1FIFOBA;
+volatile uintptr_t host_C1FIFOUA0;
+volatile uintptr_t host_C1FIFOUA1;
+volatile uintptr_t host_C1FIFOUA2;
+volatile uintptr_t host_C1FIFOUA3;
+volatile uint32_t host_C1FIFOCI0;
+volatile uint32_t host_C1FIFOCI1;
+volatile uint32_t host_C1FIFOCI2;
+volatile uint32_t host_C1FIFOCI3;
+volatile uint32_t C1RXR;
+volatile uint32_t C1FLTCON0;
+volatile uint32_t C1FLTCON1;
+volatile uint32_t C1FLTCON2;
+volatile uint32_t C1FLTCON3;
+volatile uint32_t C1FLTCON4;
+volatile uint32_t C1FLTCON5;
+volatile uint32_t C1FLTCON6;
+volatile uint32_t C1FLTCON7;
+volatile uint32_t C1RXF0;
+volatile uint32_t C1RXF1;
+volatile uint32_t C1RXF2;
+volatile uint32_t C1RXF3;
+volatile uint32_t C1RXF4;
+volatile uint32_t C1RXF5;
+volatile uint32_t C1RXF6;
+volatile uint32_t C1RXF7;
+volatile uint32_t C1RXF8;
+volatile uint32_t C1RXF9;
+volatile uint32_t C1RXF10;
+volatile uint32_t C1RXF11;
+volatile uint32_t C1RXF12;
+volatile uint32_t C1RXF13;
+volatile uint32_t C1RXF14;
+volatile uint32_t C1RXF15;
+volatile uint32_t C1RXF16;
+volatile uint32_t C1RXF17;
+volatile uint32_t C1RXF18;
+volatile uint32_t C1RXF19;
+volatile uint32_t C1RXF20;
+volatile uint32_t C1RXF21;
+volatile uint32_t C1RXF22;
+volatile uint32_t C1RXF23;
+volatile uint32_t C1RXF24;
+volatile uint32_t C1RXF25;
+volatile uint32_t C1RXF26;
+volatile uint32_t C1RXF27;
+volatile uint32_t C1RXF28;
+volatile uint32_t C1RXF29;
+volatile uint32_t C1RXF30;
+volatile uint32_t C1RXF31;
+volatile uint32_t C1RXM0;
+volatile uint32_t C1RXM1;
+volatile uint32_t C1RXM2;
+volatile uint32_t C1RXM3;
+volatile uint32_t host_DCH0CON;
+volatile uint32_t DCH0CSIZ;
+volatile uintptr_t DCH0DSA;
+volatile uint32_t DCH0DSIZ;
+volatile uint32_t DCH0ECON;
+volatile uint32_t host_DCH0INT;
+volatile uintptr_t DCH0SSA;
+volatile uint32_t DCH0SSIZ;
+volatile uint32_t host_DCH1CON;
+volatile uint32_t DCH1CSIZ;
+volatile uintptr_t DCH1DSA;
+volatile uint32_t DCH1DSIZ;
+volatile uint32_t DCH1ECON;
+volatile uint32_t host_DCH1INT;
+volatile uintptr_t DCH1SSA;
+volatile uint32_t DCH1SSIZ;
+volatile uint32_t I2C4ADD;
+volatile uint32_t I2C4BRG;
+volatile uint32_t I2C4CON;
+volatile uint32_t I2C4RCV;
+volatile uint32_t I2C4STATCLR;
+volatile uint32_t I2C4TRN;
+volatile uint32_t IEC3SET;
+volatile uint32_t IEC5CLR;
+volatile uint32_t IFS0CLR;
+volatile uint32_t IFS3CLR;
+volatile uint32_t IFS4CLR;
+volatile uint32_t IFS5CLR;
+volatile uint32_t host_NVMCON;
+volatile uint32_t host_NVMCONCLR;
+volatile uint32_t host_NVMCONSET;
+volatile uint32_t NVMADDR;
+volatile uint32_t NVMDATA0;
+volatile uint32_t NVMDATA1;
+volatile uint32_t NVMDATA2;
+volatile uint32_t NVMDATA3;
+volatile uint32_t NVMKEY;
+volatile uintptr_t NVMSRCADDR;
+volatile uint32_t PORTE;
+volatile uint32_t PR1;
+volatile uint32_t PR2;
+volatile uint32_t RPD2R;
+volatile uint32_t RPF0R;
+volatile uint32_t RPG8R;
+volatile uint32_t host_RSWRST;
+volatile uint32_t RSWRSTSET;
+volatile uint32_t SPI1BRG;
+volatile uint64_t host_SPI1BUF = HOST_SPI_FRESH;
+volatile uint32_t SPI2BRG;
+volatile uint64_t host_SPI2BUF = HOST_SPI_FRESH;
+volatile uint32_t SPI3BRG;
+volatile uint64_t host_SPI3BUF = HOST_SPI_FRESH;
+volatile uint32_t SPI5BRG;
+volatile uint64_t host_SPI5BUF = HOST_SPI_FRESH;
+volatile uint32_t SPI6BRG;
+volatile uint64_t host_SPI6BUF = HOST_SPI_FRESH;
+volatile uint32_t SYSKEY;
+volatile uint32_t TMR1;
+volatile uint32_t TMR2;
@@ -0,0 +1,1124 @@
+/**
+ * FSAE Library Host Special Function Registers
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Stands in for the register declarations of the XC32 device header. Every
+ * register the library and nodes use is plain memory. The CAN, SPI, I2C and
+ * DMA registers that the firmware polls are routed through host_sfr_sync()
+ * so the peripheral models in fsae_host.c can react before each access.
+ */
+#ifndef HOST_SFR_H
+#define HOST_SFR_H
+
+#include <stdint.h>
+
+void* host_sfr_sync(volatile void* sfr);
+
+// Registers with a bit field view. Fields are whole words on the host, so
+// the bit view and the word view of a register do not alias.
+typedef struct {
+  uint32_t ANEN1, ANEN2, ANEN7, WKRDY1, WKRDY2, WKRDY7, WKUPCLKCNT;
+} __ADCANCONbits_t;
+extern volatile __ADCANCONbits_t ADCANCONbits;
+
+typedef struct {
+  uint32_t FRACT, ON, SELRES, STRGSRC;
+} __ADCCON1bits_t;
+extern volatile __ADCCON1bits_t ADCCON1bits;
+
+typedef struct {
+  uint32_t ADCDIV, BGVRRDY, EOSRDY, REFFLT, SAMC;
+} __ADCCON2bits_t;
+extern volatile __ADCCON2bits_t ADCCON2bits;
+
+typedef struct {
+  uint32_t ADCSEL, CONCLKDIV, DIGEN1, DIGEN2, DIGEN7, GSWTRG, VREFSEL;
+} __ADCCON3bits_t;
+extern volatile __ADCCON3bits_t ADCCON3bits;
+
+typedef struct {
+  uint32_t CSS1, CSS2, CSS6, CSS8, CSS9, CSS10, CSS14, CSS25, CSS27, CSS28,
+    CSS30, CSS31;
+} __ADCCSS1bits_t;
+extern volatile __ADCCSS1bits_t ADCCSS1bits;
+
+typedef struct {
+  uint32_t CSS44;
+} __ADCCSS2bits_t;
+extern volatile __ADCCSS2bits_t ADCCSS2bits;
+
+typedef struct {
+  uint32_t TRGSRC1, TRGSRC2;
+} __ADCTRG1bits_t;
+extern volatile __ADCTRG1bits_t ADCTRG1bits;
+
+typedef struct {
+  uint32_t TRGSRC6;
+} __ADCTRG2bits_t;
+extern volatile __ADCTRG2bits_t ADCTRG2bits;
+
+typedef struct {
+  uint32_t TRGSRC8, TRGSRC9, TRGSRC10;
+} __ADCTRG3bits_t;
+extern volatile __ADCTRG3bits_t ADCTRG3bits;
+
+typedef struct {
+  uint32_t SH1ALT, SH2ALT;
+} __ADCTRGMODEbits_t;
+extern volatile __ADCTRGMODEbits_t ADCTRGMODEbits;
+
+typedef struct {
+  uint32_t ANSA0, ANSA5, ANSA9, ANSA10;
+} __ANSELAbits_t;
+extern volatile __ANSELAbits_t ANSELAbits;
+
+typedef struct {
+  uint32_t ANSB2, ANSB3, ANSB4, ANSB5, ANSB6, ANSB7, ANSB9, ANSB11, ANSB14,
+    ANSB15;
+} __ANSELBbits_t;
+extern volatile __ANSELBbits_t ANSELBbits;
+
+typedef struct {
+  uint32_t ANSC2, ANSC3, ANSC4;
+} __ANSELCbits_t;
+extern volatile __ANSELCbits_t ANSELCbits;
+
+typedef struct {
+  uint32_t ANSE4, ANSE5, ANSE6, ANSE8, ANSE9;
+} __ANSELEbits_t;
+extern volatile __ANSELEbits_t ANSELEbits;
+
+typedef struct {
+  uint32_t ANSF12, ANSF13;
+} __ANSELFbits_t;
+extern volatile __ANSELFbits_t ANSELFbits;
+
+typedef struct {
+  uint32_t ANSG6, ANSG7, ANSG8, ANSG9;
+} __ANSELGbits_t;
+extern volatile __ANSELGbits_t ANSELGbits;
+
+typedef struct {
+  uint32_t BRP, PRSEG, SAM, SEG1PH, SEG2PH, SEG2PHTS, SJW, WAKFIL;
+} __C1CFGbits_t;
+extern volatile __C1CFGbits_t C1CFGbits;
+
+typedef struct {
+  uint32_t CANCAP, ON, OPMOD, REQOP, SIDL;
+} __C1CONbits_t;
+extern volatile __C1CONbits_t host_C1CONbits;
+#define C1CONbits (*(volatile __C1CONbits_t*) host_sfr_sync(&host_C1CONbits))
+
+typedef struct {
+  uint32_t CANTS, CANTSPRE;
+} __C1TMRbits_t;
+extern volatile __C1TMRbits_t host_C1TMRbits;
+#define C1TMRbits (*(volatile __C1TMRbits_t*) host_sfr_sync(&host_C1TMRbits))
+
+typedef struct {
+  uint32_t EWARN, RERRCNT, RXBP, RXWARN, TERRCNT, TXBO, TXBP, TXWARN;
+} __C1TRECbits_t;
+extern volatile __C1TRECbits_t host_C1TRECbits;
+#define C1TRECbits (*(volatile __C1TRECbits_t*) host_sfr_sync(&host_C1TRECbits))
+
+typedef struct {
+  uint32_t DONLY, FRESET, FSIZE, TXEN, TXPRI, TXREQ, UINC;
+} __C1FIFOCON0bits_t;
+extern volatile __C1FIFOCON0bits_t host_C1FIFOCON0bits;
+#define C1FIFOCON0bits (*(volatile __C1FIFOCON0bits_t*) host_sfr_sync(&host_C1FIFOCON0bits))
+
+typedef struct {
+  uint32_t DONLY, FRESET, FSIZE, TXEN, TXPRI, TXREQ, UINC;
+} __C1FIFOCON1bits_t;
+extern volatile __C1FIFOCON1bits_t host_C1FIFOCON1bits;
+#define C1FIFOCON1bits (*(volatile __C1FIFOCON1bits_t*) host_sfr_sync(&host_C1FIFOCON1bits))
+
+typedef struct {
+  uint32_t DONLY, FRESET, FSIZE, TXEN, TXPRI, TXREQ, UINC;
+} __C1FIFOCON2bits_t;
+extern volatile __C1FIFOCON2bits_t host_C1FIFOCON2bits;
+#define C1FIFOCON2bits (*(volatile __C1FIFOCON2bits_t*) host_sfr_sync(&host_C1FIFOCON2bits))
+
+typedef struct {
+  uint32_t DONLY, FRESET, FSIZE, TXEN, TXPRI, TXREQ, UINC;
+} __C1FIFOCON3bits_t;
+extern volatile __C1FIFOCON3bits_t host_C1FIFOCON3bits;
+#define C1FIFOCON3bits (*(volatile __C1FIFOCON3bits_t*) host_sfr_sync(&host_C1FIFOCON3bits))
+
+typedef struct {
+  uint32_t RXFULLIE, RXFULLIF, RXHALFIE, RXHALFIF, RXNEMPTYIE, RXNEMPTYIF,
+    RXOVFLIE, RXOVLIF, TXEMPTYIE, TXEMPTYIF, TXHALFIE, TXHALFIF, TXNFULLIE,
+    TXNFULLIF;
+} __C1FIFOINT0bits_t;
+extern volatile __C1FIFOINT0bits_t host_C1FIFOINT0bits;
+#define C1FIFOINT0bits (*(volatile __C1FIFOINT0bits_t*) host_sfr_sync(&host_C1FIFOINT0bits))
+
+typedef struct {
+  uint32_t RXFULLIE, RXFULLIF, RXHALFIE, RXHALFIF, RXNEMPTYIE, RXNEMPTYIF,
+    RXOVFLIE, RXOVLIF, TXEMPTYIE, TXEMPTYIF, TXHALFIE, TXHALFIF, TXNFULLIE,
+    TXNFULLIF;
+} __C1FIFOINT1bits_t;
+extern volatile __C1FIFOINT1bits_t host_C1FIFOINT1bits;
+#define C1FIFOINT1bits (*(volatile __C1FIFOINT1bits_t*) host_sfr_sync(&host_C1FIFOINT1bits))
+
+typedef struct {
+  uint32_t RXFULLIE, RXFULLIF, RXHALFIE, RXHALFIF, RXNEMPTYIE, RXNEMPTYIF,
+    RXOVFLIE, RXOVLIF, TXEMPTYIE, TXEMPTYIF, TXHALFIE, TXHALFIF, TXNFULLIE,
+    TXNFULLIF;
+} __C1FIFOINT2bits_t;
+extern volatile __C1FIFOINT2bits_t host_C1FIFOINT2bits;
+#define C1FIFOINT2bits (*(volatile __C1FIFOINT2bits_t*) host_sfr_sync(&host_C1FIFOINT2bits))
+
+typedef struct {
+  uint32_t RXFULLIE, RXFULLIF, RXHALFIE, RXHALFIF, RXNEMPTYIE, RXNEMPTYIF,
+    RXOVFLIE, RXOVLIF, TXEMPTYIE, TXEMPTYIF, TXHALFIE, TXHALFIF, TXNFULLIE,
+    TXNFULLIF;
+} __C1FIFOINT3bits_t;
+extern volatile __C1FIFOINT3bits_t host_C1FIFOINT3bits;
+#define C1FIFOINT3bits (*(volatile __C1FIFOINT3bits_t*) host_sfr_sync(&host_C1FIFOINT3bits))
+
+typedef struct {
+  uint32_t RBIE, RBIF, RBOVIE, RBOVIF, TBIE, TBIF;
+} __C1INTbits_t;
+extern volatile __C1INTbits_t host_C1INTbits;
+#define C1INTbits (*(volatile __C1INTbits_t*) host_sfr_sync(&host_C1INTbits))
+
+typedef struct {
+  uint32_t ON;
+} __C2CONbits_t;
+extern volatile __C2CONbits_t C2CONbits;
+
+typedef struct {
+  uint32_t DMAEN;
+} __CECONbits_t;
+extern volatile __CECONbits_t CECONbits;
+
+typedef struct {
+  uint32_t CPUPRI, DMAPRI, ECCCON, ICACLK, IOANCPN, IOLOCK, JTAGEN, OCACLK,
+    PGLOCK, PMDLOCK, TDOEN, TROEN, USBSSEN;
+} __CFGCONbits_t;
+extern volatile __CFGCONbits_t CFGCONbits;
+
+typedef struct {
+  uint32_t CAN1PG, CAN2PG, CPUPG, CRYPTPG, DMAPG, ETHPG, FCPG, SQI1PG, USBPG;
+} __CFGPGbits_t;
+extern volatile __CFGPGbits_t CFGPGbits;
+
+typedef struct {
+  uint32_t ON;
+} __CM1CONbits_t;
+extern volatile __CM1CONbits_t CM1CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __CM2CONbits_t;
+extern volatile __CM2CONbits_t CM2CONbits;
+
+typedef struct {
+  uint32_t EDGEDETECT, ON;
+} __CNCONEbits_t;
+extern volatile __CNCONEbits_t CNCONEbits;
+
+typedef struct {
+  uint32_t CNIEE6;
+} __CNENEbits_t;
+extern volatile __CNENEbits_t CNENEbits;
+
+typedef struct {
+  uint32_t CNPUG7, CNPUG8;
+} __CNPUGbits_t;
+extern volatile __CNPUGbits_t CNPUGbits;
+
+typedef struct {
+  uint32_t ON;
+} __CVRCONbits_t;
+extern volatile __CVRCONbits_t CVRCONbits;
+
+typedef struct {
+  uint32_t ON;
+} __DMACONbits_t;
+extern volatile __DMACONbits_t DMACONbits;
+
+typedef struct {
+  uint32_t ON;
+} __ETHCON1bits_t;
+extern volatile __ETHCON1bits_t ETHCON1bits;
+
+typedef struct {
+  uint32_t ON;
+} __I2C1CONbits_t;
+extern volatile __I2C1CONbits_t I2C1CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __I2C3CONbits_t;
+extern volatile __I2C3CONbits_t I2C3CONbits;
+
+typedef struct {
+  uint32_t A10M, ACKDT, ACKEN, ON, PEN, RCEN, RSEN, SEN, SMEN;
+} __I2C4CONbits_t;
+extern volatile __I2C4CONbits_t host_I2C4CONbits;
+#define I2C4CONbits (*(volatile __I2C4CONbits_t*) host_sfr_sync(&host_I2C4CONbits))
+
+typedef struct {
+  uint32_t ACKSTAT, BCL, P, RBF, S, TBF, TRSTAT;
+} __I2C4STATbits_t;
+extern volatile __I2C4STATbits_t I2C4STATbits;
+
+typedef struct {
+  uint32_t ON;
+} __I2C5CONbits_t;
+extern volatile __I2C5CONbits_t I2C5CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __IC1CONbits_t;
+extern volatile __IC1CONbits_t IC1CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __IC2CONbits_t;
+extern volatile __IC2CONbits_t IC2CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __IC3CONbits_t;
+extern volatile __IC3CONbits_t IC3CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __IC4CONbits_t;
+extern volatile __IC4CONbits_t IC4CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __IC5CONbits_t;
+extern volatile __IC5CONbits_t IC5CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __IC6CONbits_t;
+extern volatile __IC6CONbits_t IC6CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __IC7CONbits_t;
+extern volatile __IC7CONbits_t IC7CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __IC8CONbits_t;
+extern volatile __IC8CONbits_t IC8CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __IC9CONbits_t;
+extern volatile __IC9CONbits_t IC9CONbits;
+
+typedef struct {
+  uint32_t T1IE, T2IE;
+} __IEC0bits_t;
+extern volatile __IEC0bits_t IEC0bits;
+
+typedef struct {
+  uint32_t SPI1EIE, SPI1RXIE, SPI1TXIE;
+} __IEC3bits_t;
+extern volatile __IEC3bits_t IEC3bits;
+
+typedef struct {
+  uint32_t CAN1IE, SPI2EIE, SPI2RXIE, SPI2TXIE, SPI3EIE, SPI3RXIE, SPI3TXIE;
+} __IEC4bits_t;
+extern volatile __IEC4bits_t IEC4bits;
+
+typedef struct {
+  uint32_t SPI5EIE, SPI5RXIE, SPI5TXIE, SPI6IE, SPI6RXIE, SPI6TXIE;
+} __IEC5bits_t;
+extern volatile __IEC5bits_t IEC5bits;
+
+typedef struct {
+  uint32_t T1IF, T2IF;
+} __IFS0bits_t;
+extern volatile __IFS0bits_t IFS0bits;
+
+typedef struct {
+  uint32_t CAN1IF;
+} __IFS4bits_t;
+extern volatile __IFS4bits_t IFS4bits;
+
+typedef struct {
+  uint32_t MVEC;
+} __INTCONbits_t;
+extern volatile __INTCONbits_t INTCONbits;
+
+typedef struct {
+  uint32_t T1IP, T1IS;
+} __IPC1bits_t;
+extern volatile __IPC1bits_t IPC1bits;
+
+typedef struct {
+  uint32_t T2IP, T2IS;
+} __IPC2bits_t;
+extern volatile __IPC2bits_t IPC2bits;
+
+typedef struct {
+  uint32_t CNEIP, CNEIS;
+} __IPC30bits_t;
+extern volatile __IPC30bits_t IPC30bits;
+
+typedef struct {
+  uint32_t CAN1IP, CAN1IS;
+} __IPC37bits_t;
+extern volatile __IPC37bits_t IPC37bits;
+
+typedef struct {
+  uint32_t LATA0, LATA1, LATA2, LATA3, LATA4, LATA5, LATA6, LATA7, LATA9,
+    LATA10, LATA14, LATA15;
+} __LATAbits_t;
+extern volatile __LATAbits_t LATAbits;
+
+typedef struct {
+  uint32_t LATB0, LATB1, LATB2, LATB3, LATB4, LATB5, LATB6, LATB7, LATB8, LATB9,
+    LATB10, LATB11, LATB12, LATB13, LATB14, LATB15;
+} __LATBbits_t;
+extern volatile __LATBbits_t LATBbits;
+
+typedef struct {
+  uint32_t LATC1, LATC2, LATC3, LATC4, LATC12, LATC13, LATC14, LATC15;
+} __LATCbits_t;
+extern volatile __LATCbits_t LATCbits;
+
+typedef struct {
+  uint32_t LATD0, LATD1, LATD2, LATD3, LATD4, LATD5, LATD9, LATD10, LATD11,
+    LATD12, LATD13, LATD14, LATD15;
+} __LATDbits_t;
+extern volatile __LATDbits_t LATDbits;
+
+typedef struct {
+  uint32_t LATE0, LATE1, LATE2, LATE3, LATE4, LATE5, LATE6, LATE7, LATE8, LATE9;
+} __LATEbits_t;
+extern volatile __LATEbits_t LATEbits;
+
+typedef struct {
+  uint32_t LATF0, LATF1, LATF2, LATF3, LATF4, LATF5, LATF8, LATF12, LATF13;
+} __LATFbits_t;
+extern volatile __LATFbits_t LATFbits;
+
+typedef struct {
+  uint32_t LATG0, LATG1, LATG6, LATG7, LATG8, LATG9, LATG12, LATG13, LATG14,
+    LATG15;
+} __LATGbits_t;
+extern volatile __LATGbits_t LATGbits;
+
+typedef struct {
+  uint32_t ON;
+} __OC1CONbits_t;
+extern volatile __OC1CONbits_t OC1CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __OC2CONbits_t;
+extern volatile __OC2CONbits_t OC2CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __OC3CONbits_t;
+extern volatile __OC3CONbits_t OC3CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __OC4CONbits_t;
+extern volatile __OC4CONbits_t OC4CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __OC5CONbits_t;
+extern volatile __OC5CONbits_t OC5CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __OC6CONbits_t;
+extern volatile __OC6CONbits_t OC6CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __OC7CONbits_t;
+extern volatile __OC7CONbits_t OC7CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __OC8CONbits_t;
+extern volatile __OC8CONbits_t OC8CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __OC9CONbits_t;
+extern volatile __OC9CONbits_t OC9CONbits;
+
+typedef struct {
+  uint32_t CLKLOCK, DRMEN, FRCDIV, SLP2SPD, SLPEN, SOSCEN;
+} __OSCCONbits_t;
+extern volatile __OSCCONbits_t OSCCONbits;
+
+typedef struct {
+  uint32_t TUN;
+} __OSCTUNbits_t;
+extern volatile __OSCTUNbits_t OSCTUNbits;
+
+typedef struct {
+  uint32_t PBDIV, PBDIVRDY;
+} __PB1DIVbits_t;
+extern volatile __PB1DIVbits_t PB1DIVbits;
+
+typedef struct {
+  uint32_t ON, PBDIV, PBDIVRDY;
+} __PB2DIVbits_t;
+extern volatile __PB2DIVbits_t PB2DIVbits;
+
+typedef struct {
+  uint32_t ON, PBDIV, PBDIVRDY;
+} __PB3DIVbits_t;
+extern volatile __PB3DIVbits_t PB3DIVbits;
+
+typedef struct {
+  uint32_t ON, PBDIV, PBDIVRDY;
+} __PB4DIVbits_t;
+extern volatile __PB4DIVbits_t PB4DIVbits;
+
+typedef struct {
+  uint32_t ON, PBDIV, PBDIVRDY;
+} __PB5DIVbits_t;
+extern volatile __PB5DIVbits_t PB5DIVbits;
+
+typedef struct {
+  uint32_t ON, PBDIV, PBDIVRDY;
+} __PB7DIVbits_t;
+extern volatile __PB7DIVbits_t PB7DIVbits;
+
+typedef struct {
+  uint32_t ON, PBDIV, PBDIVRDY;
+} __PB8DIVbits_t;
+extern volatile __PB8DIVbits_t PB8DIVbits;
+
+typedef struct {
+  uint32_t ON;
+} __PMCONbits_t;
+extern volatile __PMCONbits_t PMCONbits;
+
+typedef struct {
+  uint32_t CVRMD;
+} __PMD1bits_t;
+extern volatile __PMD1bits_t PMD1bits;
+
+typedef struct {
+  uint32_t CMP1MD, CMP2MD;
+} __PMD2bits_t;
+extern volatile __PMD2bits_t PMD2bits;
+
+typedef struct {
+  uint32_t IC1MD, IC2MD, IC3MD, IC4MD, IC5MD, IC6MD, IC7MD, IC8MD, IC9MD, OC1MD,
+    OC2MD, OC3MD, OC4MD, OC5MD, OC6MD, OC7MD, OC8MD, OC9MD;
+} __PMD3bits_t;
+extern volatile __PMD3bits_t PMD3bits;
+
+typedef struct {
+  uint32_t T3MD, T4MD, T5MD, T6MD, T7MD, T8MD, T9MD;
+} __PMD4bits_t;
+extern volatile __PMD4bits_t PMD4bits;
+
+typedef struct {
+  uint32_t CAN2MD, I2C1MD, I2C3MD, I2C4MD, I2C5MD, SPI2MD, SPI3MD, SPI4MD,
+    SPI5MD, SPI6MD, U1MD, U2MD, U3MD, U4MD, U5MD, U6MD;
+} __PMD5bits_t;
+extern volatile __PMD5bits_t PMD5bits;
+
+typedef struct {
+  uint32_t ETHMD, PMPMD, RTCCMD, SQI1MD;
+} __PMD6bits_t;
+extern volatile __PMD6bits_t PMD6bits;
+
+typedef struct {
+  uint32_t CRYPTMD, DMAMD, RNGMD;
+} __PMD7bits_t;
+extern volatile __PMD7bits_t PMD7bits;
+
+typedef struct {
+  uint32_t RA0, RA3, RA5, RA7, RA9, RA15;
+} __PORTAbits_t;
+extern volatile __PORTAbits_t PORTAbits;
+
+typedef struct {
+  uint32_t RB2, RB3, RB4, RB5, RB7, RB14;
+} __PORTBbits_t;
+extern volatile __PORTBbits_t PORTBbits;
+
+typedef struct {
+  uint32_t RC2, RC3, RC4, RC14;
+} __PORTCbits_t;
+extern volatile __PORTCbits_t PORTCbits;
+
+typedef struct {
+  uint32_t RD5, RD13;
+} __PORTDbits_t;
+extern volatile __PORTDbits_t PORTDbits;
+
+typedef struct {
+  uint32_t RE0, RE1, RE2, RE4, RE5, RE6, RE8, RE9;
+} __PORTEbits_t;
+extern volatile __PORTEbits_t PORTEbits;
+
+typedef struct {
+  uint32_t RF12;
+} __PORTFbits_t;
+extern volatile __PORTFbits_t PORTFbits;
+
+typedef struct {
+  uint32_t RG7, RG8, RG9, RG12, RG14;
+} __PORTGbits_t;
+extern volatile __PORTGbits_t PORTGbits;
+
+typedef struct {
+  uint32_t PFMSECEN, PFMWS, PREFEN;
+} __PRECONbits_t;
+extern volatile __PRECONbits_t PRECONbits;
+
+typedef struct {
+  uint32_t PRI1SS, PRI2SS, PRI3SS, PRI4SS, PRI5SS, PRI6SS, PRI7SS, SS0;
+} __PRISSbits_t;
+extern volatile __PRISSbits_t PRISSbits;
+
+typedef struct {
+  uint32_t ACTIVE, DIVSWEN, OE, ON, RODIV, ROSEL, SIDL;
+} __REFO1CONbits_t;
+extern volatile __REFO1CONbits_t REFO1CONbits;
+
+typedef struct {
+  uint32_t ROTRIM;
+} __REFO1TRIMbits_t;
+extern volatile __REFO1TRIMbits_t REFO1TRIMbits;
+
+typedef struct {
+  uint32_t ACTIVE, OE, ON;
+} __REFO2CONbits_t;
+extern volatile __REFO2CONbits_t REFO2CONbits;
+
+typedef struct {
+  uint32_t ACTIVE, OE, ON;
+} __REFO3CONbits_t;
+extern volatile __REFO3CONbits_t REFO3CONbits;
+
+typedef struct {
+  uint32_t ACTIVE, DIVSWEN, OE, ON, RODIV, ROSEL, SIDL;
+} __REFO4CONbits_t;
+extern volatile __REFO4CONbits_t REFO4CONbits;
+
+typedef struct {
+  uint32_t ROTRIM;
+} __REFO4TRIMbits_t;
+extern volatile __REFO4TRIMbits_t REFO4TRIMbits;
+
+typedef struct {
+  uint32_t PRNGEN, TRNGEN;
+} __RNGCONbits_t;
+extern volatile __RNGCONbits_t RNGCONbits;
+
+typedef struct {
+  uint32_t RPA14R;
+} __RPA14Rbits_t;
+extern volatile __RPA14Rbits_t RPA14Rbits;
+
+typedef struct {
+  uint32_t RPB3R;
+} __RPB3Rbits_t;
+extern volatile __RPB3Rbits_t RPB3Rbits;
+
+typedef struct {
+  uint32_t RPB10R;
+} __RPB10Rbits_t;
+extern volatile __RPB10Rbits_t RPB10Rbits;
+
+typedef struct {
+  uint32_t RPC1R;
+} __RPC1Rbits_t;
+extern volatile __RPC1Rbits_t RPC1Rbits;
+
+typedef struct {
+  uint32_t RPF8R;
+} __RPF8Rbits_t;
+extern volatile __RPF8Rbits_t RPF8Rbits;
+
+typedef struct {
+  uint32_t RPG7R;
+} __RPG7Rbits_t;
+extern volatile __RPG7Rbits_t RPG7Rbits;
+
+typedef struct {
+  uint32_t ON;
+} __RTCCONbits_t;
+extern volatile __RTCCONbits_t RTCCONbits;
+
+typedef struct {
+  uint32_t SDI1R;
+} __SDI1Rbits_t;
+extern volatile __SDI1Rbits_t SDI1Rbits;
+
+typedef struct {
+  uint32_t SDI2R;
+} __SDI2Rbits_t;
+extern volatile __SDI2Rbits_t SDI2Rbits;
+
+typedef struct {
+  uint32_t SDI3R;
+} __SDI3Rbits_t;
+extern volatile __SDI3Rbits_t SDI3Rbits;
+
+typedef struct {
+  uint32_t SDI5R;
+} __SDI5Rbits_t;
+extern volatile __SDI5Rbits_t SDI5Rbits;
+
+typedef struct {
+  uint32_t SDI6R;
+} __SDI6Rbits_t;
+extern volatile __SDI6Rbits_t SDI6Rbits;
+
+typedef struct {
+  uint32_t CKE, CKP, DISSDI, DISSDO, ENHBUF, MCLKSEL, MODE16, MODE32, MSTEN, ON,
+    SIDL, SMP, SRXISEL, STXISEL;
+} __SPI1CONbits_t;
+extern volatile __SPI1CONbits_t SPI1CONbits;
+
+typedef struct {
+  uint32_t SPIBUSY, SPIRBF, SPIROV, SPITBE;
+} __SPI1STATbits_t;
+extern volatile __SPI1STATbits_t host_SPI1STATbits;
+#define SPI1STATbits (*(volatile __SPI1STATbits_t*) host_sfr_sync(&host_SPI1STATbits))
+
+typedef struct {
+  uint32_t CKE, CKP, DISSDI, DISSDO, ENHBUF, MCLKSEL, MODE16, MODE32, MSTEN, ON,
+    SIDL, SMP, SRXISEL, STXISEL;
+} __SPI2CONbits_t;
+extern volatile __SPI2CONbits_t SPI2CONbits;
+
+typedef struct {
+  uint32_t SPIBUSY, SPIRBF, SPIROV, SPITBE;
+} __SPI2STATbits_t;
+extern volatile __SPI2STATbits_t host_SPI2STATbits;
+#define SPI2STATbits (*(volatile __SPI2STATbits_t*) host_sfr_sync(&host_SPI2STATbits))
+
+typedef struct {
+  uint32_t CKE, CKP, DISSDI, DISSDO, ENHBUF, MCLKSEL, MODE16, MODE32, MSTEN, ON,
+    SIDL, SMP, SRXISEL, STXISEL;
+} __SPI3CONbits_t;
+extern volatile __SPI3CONbits_t SPI3CONbits;
+
+typedef struct {
+  uint32_t SPIBUSY, SPIRBF, SPIROV, SPITBE;
+} __SPI3STATbits_t;
+extern volatile __SPI3STATbits_t host_SPI3STATbits;
+#define SPI3STATbits (*(volatile __SPI3STATbits_t*) host_sfr_sync(&host_SPI3STATbits))
+
+typedef struct {
+  uint32_t ON;
+} __SPI4CONbits_t;
+extern volatile __SPI4CONbits_t SPI4CONbits;
+
+typedef struct {
+  uint32_t CKE, CKP, DISSDI, DISSDO, ENHBUF, MCLKSEL, MODE16, MODE32, MSTEN, ON,
+    SIDL, SMP, SRXISEL, STXISEL;
+} __SPI5CONbits_t;
+extern volatile __SPI5CONbits_t SPI5CONbits;
+
+typedef struct {
+  uint32_t SPIBUSY, SPIRBF, SPIROV, SPITBE;
+} __SPI5STATbits_t;
+extern volatile __SPI5STATbits_t host_SPI5STATbits;
+#define SPI5STATbits (*(volatile __SPI5STATbits_t*) host_sfr_sync(&host_SPI5STATbits))
+
+typedef struct {
+  uint32_t CKE, CKP, DISSDI, DISSDO, ENHBUF, MCLKSEL, MODE16, MODE32, MSTEN, ON,
+    SIDL, SMP, SRXISEL, STXISEL;
+} __SPI6CONbits_t;
+extern volatile __SPI6CONbits_t SPI6CONbits;
+
+typedef struct {
+  uint32_t SPIBUSY, SPIRBF, SPIROV, SPITBE;
+} __SPI6STATbits_t;
+extern volatile __SPI6STATbits_t host_SPI6STATbits;
+#define SPI6STATbits (*(volatile __SPI6STATbits_t*) host_sfr_sync(&host_SPI6STATbits))
+
+typedef struct {
+  uint32_t SQIEN;
+} __SQI1CFGbits_t;
+extern volatile __SQI1CFGbits_t SQI1CFGbits;
+
+typedef struct {
+  uint32_t ON, SIDL, TCKPS, TCS, TGATE, TWDIS;
+} __T1CONbits_t;
+extern volatile __T1CONbits_t T1CONbits;
+
+typedef struct {
+  uint32_t ON, SIDL, TCKPS, TCS, TGATE;
+} __T2CONbits_t;
+extern volatile __T2CONbits_t T2CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __T3CONbits_t;
+extern volatile __T3CONbits_t T3CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __T4CONbits_t;
+extern volatile __T4CONbits_t T4CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __T5CONbits_t;
+extern volatile __T5CONbits_t T5CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __T6CONbits_t;
+extern volatile __T6CONbits_t T6CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __T7CONbits_t;
+extern volatile __T7CONbits_t T7CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __T8CONbits_t;
+extern volatile __T8CONbits_t T8CONbits;
+
+typedef struct {
+  uint32_t ON;
+} __T9CONbits_t;
+extern volatile __T9CONbits_t T9CONbits;
+
+typedef struct {
+  uint32_t TRISA0, TRISA1, TRISA2, TRISA3, TRISA4, TRISA5, TRISA6, TRISA7,
+    TRISA9, TRISA10, TRISA14, TRISA15;
+} __TRISAbits_t;
+extern volatile __TRISAbits_t TRISAbits;
+
+typedef struct {
+  uint32_t TRISB0, TRISB1, TRISB2, TRISB3, TRISB4, TRISB5, TRISB6, TRISB7,
+    TRISB8, TRISB9, TRISB10, TRISB11, TRISB12, TRISB13, TRISB14, TRISB15;
+} __TRISBbits_t;
+extern volatile __TRISBbits_t TRISBbits;
+
+typedef struct {
+  uint32_t TRISC1, TRISC2, TRISC3, TRISC4, TRISC12, TRISC13, TRISC14, TRISC15;
+} __TRISCbits_t;
+extern volatile __TRISCbits_t TRISCbits;
+
+typedef struct {
+  uint32_t TRISD0, TRISD1, TRISD2, TRISD3, TRISD4, TRISD5, TRISD9, TRISD10,
+    TRISD11, TRISD12, TRISD13, TRISD14, TRISD15;
+} __TRISDbits_t;
+extern volatile __TRISDbits_t TRISDbits;
+
+typedef struct {
+  uint32_t TRISE0, TRISE1, TRISE2, TRISE3, TRISE4, TRISE5, TRISE6, TRISE7,
+    TRISE8, TRISE9;
+} __TRISEbits_t;
+extern volatile __TRISEbits_t TRISEbits;
+
+typedef struct {
+  uint32_t TRISF0, TRISF1, TRISF2, TRISF3, TRISF4, TRISF5, TRISF8, TRISF12,
+    TRISF13;
+} __TRISFbits_t;
+extern volatile __TRISFbits_t TRISFbits;
+
+typedef struct {
+  uint32_t TRISG0, TRISG1, TRISG6, TRISG7, TRISG8, TRISG9, TRISG12, TRISG13,
+    TRISG14, TRISG15;
+} __TRISGbits_t;
+extern volatile __TRISGbits_t TRISGbits;
+
+typedef struct {
+  uint32_t ON;
+} __U1MODEbits_t;
+extern volatile __U1MODEbits_t U1MODEbits;
+
+typedef struct {
+  uint32_t ON;
+} __U2MODEbits_t;
+extern volatile __U2MODEbits_t U2MODEbits;
+
+typedef struct {
+  uint32_t ON;
+} __U3MODEbits_t;
+extern volatile __U3MODEbits_t U3MODEbits;
+
+typedef struct {
+  uint32_t ON;
+} __U4MODEbits_t;
+extern volatile __U4MODEbits_t U4MODEbits;
+
+typedef struct {
+  uint32_t ON;
+} __U5MODEbits_t;
+extern volatile __U5MODEbits_t U5MODEbits;
+
+typedef struct {
+  uint32_t ON;
+} __U6MODEbits_t;
+extern volatile __U6MODEbits_t U6MODEbits;
+
+// Registers accessed as whole words
+extern volatile uint32_t ADCANCON;
+extern volatile uint32_t ADCCMPCON1;
+extern volatile uint32_t ADCCMPCON2;
+extern volatile uint32_t ADCCMPCON3;
+extern volatile uint32_t ADCCMPCON4;
+extern volatile uint32_t ADCCMPCON5;
+extern volatile uint32_t ADCCMPCON6;
+extern volatile uint32_t ADCCON1;
+extern volatile uint32_t ADCCON2;
+extern volatile uint32_t ADCCON3;
+extern volatile uint32_t ADCDATA0;
+extern volatile uint32_t ADCDATA1;
+extern volatile uint32_t ADCDATA2;
+extern volatile uint32_t ADCDATA3;
+extern volatile uint32_t ADCDATA4;
+extern volatile uint32_t ADCDATA5;
+extern volatile uint32_t ADCDATA6;
+extern volatile uint32_t ADCDATA7;
+extern volatile uint32_t ADCDATA8;
+extern volatile uint32_t ADCDATA9;
+extern volatile uint32_t ADCDATA10;
+extern volatile uint32_t ADCDATA11;
+extern volatile uint32_t ADCDATA12;
+extern volatile uint32_t ADCDATA13;
+extern volatile uint32_t ADCDATA14;
+extern volatile uint32_t ADCDATA15;
+extern volatile uint32_t ADCDATA16;
+extern volatile uint32_t ADCDATA17;
+extern volatile uint32_t ADCDATA18;
+extern volatile uint32_t ADCDATA19;
+extern volatile uint32_t ADCDATA20;
+extern volatile uint32_t ADCDATA21;
+extern volatile uint32_t ADCDATA22;
+extern volatile uint32_t ADCDATA23;
+extern volatile uint32_t ADCDATA24;
+extern volatile uint32_t ADCDATA25;
+extern volatile uint32_t ADCDATA26;
+extern volatile uint32_t ADCDATA27;
+extern volatile uint32_t ADCDATA28;
+extern volatile uint32_t ADCDATA29;
+extern volatile uint32_t ADCDATA30;
+extern volatile uint32_t ADCDATA31;
+extern volatile uint32_t ADCDATA32;
+extern volatile uint32_t ADCDATA33;
+extern volatile uint32_t ADCDATA34;
+extern volatile uint32_t ADCDATA43;
+extern volatile uint32_t ADCDATA44;
+extern volatile uint32_t ADCEIEN1;
+extern volatile uint32_t ADCEIEN2;
+extern volatile uint32_t ADCFLTR1;
+extern volatile uint32_t ADCFLTR2;
+extern volatile uint32_t ADCFLTR3;
+extern volatile uint32_t ADCFLTR4;
+extern volatile uint32_t ADCFLTR5;
+extern volatile uint32_t ADCFLTR6;
+extern volatile uint32_t ADCGIRQEN1;
+extern volatile uint32_t ADCGIRQEN2;
+extern volatile uint32_t ADCIMCON1;
+extern volatile uint32_t ADCIMCON2;
+extern volatile uint32_t ADCIMCON3;
+extern volatile uint32_t ADCTRGSNS;
+extern volatile uintptr_t C1FIFOBA;
+extern volatile uintptr_t host_C1FIFOUA0;
+#define C1FIFOUA0 (*(volatile uintptr_t*) host_sfr_sync(&host_C1FIFOUA0))
+extern volatile uintptr_t host_C1FIFOUA1;
+#define C1FIFOUA1 (*(volatile uintptr_t*) host_sfr_sync(&host_C1FIFOUA1))
+extern volatile uintptr_t host_C1FIFOUA2;
+#define C1FIFOUA2 (*(volatile uintptr_t*) host_sfr_sync(&host_C1FIFOUA2))
+extern volatile uintptr_t host_C1FIFOUA3;
+#define C1FIFOUA3 (*(volatile uintptr_t*) host_sfr_sync(&host_C1FIFOUA3))
+extern volatile uint32_t host_C1FIFOCI0;
+#define C1FIFOCI0 (*(volatile uint32_t*) host_sfr_sync(&host_C1FIFOCI0))
+extern volatile uint32_t host_C1FIFOCI1;
+#define C1FIFOCI1 (*(volatile uint32_t*) host_sfr_sync(&host_C1FIFOCI1))
+extern volatile uint32_t host_C1FIFOCI2;
+#define C1FIFOCI2 (*(volatile uint32_t*) host_sfr_sync(&host_C1FIFOCI2))
+extern volatile uint32_t host_C1FIFOCI3;
+#define C1FIFOCI3 (*(volatile uint32_t*) host_sfr_sync(&host_C1FIFOCI3))
+extern volatile uint32_t C1RXR;
+extern volatile uint32_t C1FLTCON0;
+extern volatile uint32_t C1FLTCON1;
+extern volatile uint32_t C1FLTCON2;
+extern volatile uint32_t C1FLTCON3;
+extern volatile uint32_t C1FLTCON4;
+extern volatile uint32_t C1FLTCON5;
+extern volatile uint32_t C1FLTCON6;
+extern volatile uint32_t C1FLTCON7;
+extern volatile uint32_t C1RXF0;
+extern volatile uint32_t C1RXF1;
+extern volatile uint32_t C1RXF2;
+extern volatile uint32_t C1RXF3;
+extern volatile uint32_t C1RXF4;
+extern volatile uint32_t C1RXF5;
+extern volatile uint32_t C1RXF6;
+extern volatile uint32_t C1RXF7;
+extern volatile uint32_t C1RXF8;
+extern volatile uint32_t C1RXF9;
+extern volatile uint32_t C1RXF10;
+extern volatile uint32_t C1RXF11;
+extern volatile uint32_t C1RXF12;
+extern volatile uint32_t C1RXF13;
+extern volatile uint32_t C1RXF14;
+extern volatile uint32_t C1RXF15;
+extern volatile uint32_t C1RXF16;
+extern volatile uint32_t C1RXF17;
+extern volatile uint32_t C1RXF18;
+extern volatile uint32_t C1RXF19;
+extern volatile uint32_t C1RXF20;
+extern volatile uint32_t C1RXF21;
+extern volatile uint32_t C1RXF22;
+extern volatile uint32_t C1RXF23;
+extern volatile uint32_t C1RXF24;
+extern volatile uint32_t C1RXF25;
+extern volatile uint32_t C1RXF26;
+extern volatile uint32_t C1RXF27;
+extern volatile uint32_t C1RXF28;
+extern volatile uint32_t C1RXF29;
+extern volatile uint32_t C1RXF30;
+extern volatile uint32_t C1RXF31;
+extern volatile uint32_t C1RXM0;
+extern volatile uint32_t C1RXM1;
+extern volatile uint32_t C1RXM2;
+extern volatile uint32_t C1RXM3;
+extern volatile uint32_t host_DCH0CON;
+#define DCH0CON (*(volatile uint32_t*) host_sfr_sync(&host_DCH0CON))
+extern volatile uint32_t DCH0CSIZ;
+extern volatile uintptr_t DCH0DSA;
+extern volatile uint32_t DCH0DSIZ;
+extern volatile uint32_t DCH0ECON;
+extern volatile uint32_t host_DCH0INT;
+#define DCH0INT (*(volatile uint32_t*) host_sfr_sync(&host_DCH0INT))
+extern volatile uintptr_t DCH0SSA;
+extern volatile uint32_t DCH0SSIZ;
+extern volatile uint32_t host_DCH1CON;
+#define DCH1CON (*(volatile uint32_t*) host_sfr_sync(&host_DCH1CON))
+extern volatile uint32_t DCH1CSIZ;
+extern volatile uintptr_t DCH1DSA;
+extern volatile uint32_t DCH1DSIZ;
+extern volatile uint32_t DCH1ECON;
+extern volatile uint32_t host_DCH1INT;
+#define DCH1INT (*(volatile uint32_t*) host_sfr_sync(&host_DCH1INT))
+extern volatile uintptr_t DCH1SSA;
+extern volatile uint32_t DCH1SSIZ;
+extern volatile uint32_t I2C4ADD;
+extern volatile uint32_t I2C4BRG;
+extern volatile uint32_t I2C4CON;
+extern volatile uint32_t I2C4RCV;
+extern volatile uint32_t I2C4STATCLR;
+extern volatile uint32_t I2C4TRN;
+extern volatile uint32_t IEC3SET;
+extern volatile uint32_t IEC5CLR;
+extern volatile uint32_t IFS0CLR;
+extern volatile uint32_t IFS3CLR;
+extern volatile uint32_t IFS4CLR;
+extern volatile uint32_t IFS5CLR;
+extern volatile uint32_t host_NVMCON;
+#define NVMCON (*(volatile uint32_t*) host_sfr_sync(&host_NVMCON))
+extern volatile uint32_t host_NVMCONCLR;
+#define NVMCONCLR (*(volatile uint32_t*) host_sfr_sync(&host_NVMCONCLR))
+extern volatile uint32_t host_NVMCONSET;
+#define NVMCONSET (*(volatile uint32_t*) host_sfr_sync(&host_NVMCONSET))
+extern volatile uint32_t NVMADDR;
+extern volatile uint32_t NVMDATA0;
+extern volatile uint32_t NVMDATA1;
+extern volatile uint32_t NVMDATA2;
+extern volatile uint32_t NVMDATA3;
+extern volatile uint32_t NVMKEY;
+extern volatile uintptr_t NVMSRCADDR;
+extern volatile uint32_t PORTE;
+extern volatile uint32_t PR1;
+extern volatile uint32_t PR2;
+extern volatile uint32_t RPD2R;
+extern volatile uint32_t RPF0R;
+extern volatile uint32_t RPG8R;
+extern volatile uint32_t host_RSWRST;
+#define RSWRST (*(volatile uint32_t*) host_sfr_sync(&host_RSWRST))
+extern volatile uint32_t RSWRSTSET;
+extern volatile uint32_t SPI1BRG;
+extern volatile uint64_t host_SPI1BUF;
+#define SPI1BUF (*(volatile uint64_t*) host_sfr_sync(&host_SPI1BUF))
+extern volatile uint32_t SPI2BRG;
+extern volatile uint64_t host_SPI2BUF;
+#define SPI2BUF (*(volatile uint64_t*) host_sfr_sync(&host_SPI2BUF))
+extern volatile uint32_t SPI3BRG;
+extern volatile uint64_t host_SPI3BUF;
+#define SPI3BUF (*(volatile uint64_t*) host_sfr_sync(&host_SPI3BUF))
+extern volatile uint32_t SPI5BRG;
+extern volatile uint64_t host_SPI5BUF;
+#define SPI5BUF (*(volatile uint64_t*) host_sfr_sync(&host_SPI5BUF))
+extern volatile uint32_t SPI6BRG;
+extern volatile uint64_t host_SPI6BUF;
+#define SPI6BUF (*(volatile uint64_t*) host_sfr_sync(&host_SPI6BUF))
+extern volatile uint32_t SYSKEY;
+extern volatile uint32_t TMR1;
+extern volatile uint32_t TMR2;
+
+// Interrupt flag masks. These are distinct bits but not the device positions.
+#define _I2C4STAT_BCL_MASK (1u << 0)
+#define _IEC3_CNAIE_MASK (1u << 1)
+#define _IEC5_I2C4BIE_MASK (1u << 2)
+#define _IEC5_I2C4MIE_MASK (1u << 3)
+#define _IEC5_I2C4SIE_MASK (1u << 4)
+#define _IFS0_T1IF_MASK (1u << 5)
+#define _IFS0_T2IF_MASK (1u << 6)
+#define _IFS3_CNEIF_MASK (1u << 7)
+#define _IFS4_CAN1IF_MASK (1u << 8)
+#define _IFS5_I2C4BIF_MASK (1u << 9)
+#define _IFS5_I2C4MIF_MASK (1u << 10)
+#define _IFS5_I2C4SIF_MASK (1u << 11)
+
+// Interrupt sources that can start a DMA transfer. These are distinct but
+// not the device numbers.
+#define _SPI1_RX_VECTOR 1
+#define _SPI1_TX_VECTOR 2
+#define _SPI2_RX_VECTOR 3
+#define _SPI2_TX_VECTOR 4
+#define _SPI3_RX_VECTOR 5
+#define _SPI3_TX_VECTOR 6
+#define _SPI5_RX_VECTOR 7
+#define _SPI5_TX_VECTOR 8
+#define _SPI6_RX_VECTOR 9
+#define _SPI6_TX_VECTOR 10
+
+// DMA channel bits, at their device positions
+#define _DCH0CON_CHPRI_POSITION   0
+#define _DCH0CON_CHEN_MASK        0x00000080
+#define _DCH0ECON_SIRQEN_MASK     0x00000010
+#define _DCH0ECON_CHSIRQ_POSITION 8
+#define _DCH0INT_CHERIF_MASK      0x00000001
+#define _DCH0INT_CHBCIF_MASK      0x00000008
+#define _DCH0INT_CHDDIF_MASK      0x00000020
+#define _DCH0INT_CHSDIF_MASK      0x00000080
+#define _DCH1CON_CHPRI_POSITION   0
+#define _DCH1CON_CHEN_MASK        0x00000080
+#define _DCH1ECON_SIRQEN_MASK     0x00000010
+#define _DCH1ECON_CHSIRQ_POSITION 8
+#define _DCH1INT_CHERIF_MASK      0x00000001
+#define _DCH1INT_CHBCIF_MASK      0x00000008
+#define _DCH1INT_CHDDIF_MASK      0x00000020
+#define _DCH1INT_CHSDIF_MASK      0x00000080
+
+// NVM controller bits, at their device positions
+#define _NVMCON_NVMOP_MASK  0x0000000F
+#define _NVMCON_BFSWAP_MASK 0x00000040
+#define _NVMCON_PFSWAP_MASK 0x00000080
+#define _NVMCON_LVDERR_MASK 0x00001000
+#define _NVMCON_WRERR_MASK  0x00002000
+#define _NVMCON_WREN_MASK   0x00004000
+#define _NVMCON_WR_MASK     0x00008000
+
+#endif /* HOST_SFR_H */
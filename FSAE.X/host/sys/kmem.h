@@ -0,0 +1,23 @@
+/**
+ * FSAE Library Host Address Translation
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * The host has no physical/virtual split, so the CAN module is handed
+ * ordinary pointers. Physical program flash addresses map to the flash model
+ * in fsae_host.c.
+ */
+#ifndef HOST_KMEM_H
+#define HOST_KMEM_H
+
+#include <stdint.h>
+
+void* host_pa_to_kva(uintptr_t pa);
+
+#define KVA_TO_PA(v)  ((uintptr_t) (v))
+#define PA_TO_KVA0(v) host_pa_to_kva((uintptr_t) (v))
+#define PA_TO_KVA1(v) host_pa_to_kva((uintptr_t) (v))
+
+#endif /* HOST_KMEM_H */
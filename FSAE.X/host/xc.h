@@ -0,0 +1,28 @@
+/**
+ * FSAE Library Host Device Header
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Replaces <xc.h> when the library and nodes are built for the host. The
+ * host build puts this directory ahead of the system include path and defines
+ * FSAE_HOST.
+ */
+#ifndef HOST_XC_H
+#define HOST_XC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "host_sfr.h"
+#include "fsae_host.h"
+
+// Provided by the XC32 headers but not by glibc
+#ifndef min
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
+// Core timer, counting at SYSCLK / 2 as on the device
+#define _CP0_GET_COUNT() ((uint32_t) (host_micros() * (HOST_SYSCLK / 2000000)))
+
+#endif /* HOST_XC_H */
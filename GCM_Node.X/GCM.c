@@ -58,10 +58,14 @@ uint16_t shift_force_spoof = 0; // Holds desired value of gear shift force
 
 volatile uint8_t gear_fail_nt_shift = SHIFT_ENUM_NT; // Stores direction of neutral shift while in gear failure mode
 
+// Firmware updates over CAN
+ISOTP_link boot_link;
+uint8_t boot_req[BOOT_REQ_HDR + BOOT_BLOCK_MAX];
+
 // Timing interval variables
 volatile uint32_t CAN_recv_tmr = 0;
+volatile uint32_t motec0_recv_tmr = 0;
 uint32_t temp_samp_tmr, sensor_samp_tmr = 0;
-uint32_t diag_send_tmr, state_send_tmr = 0;
 uint32_t switch_debounce_tmr = 0;
 volatile uint32_t lockout_tmr = 0; // Holds millis value of last lockout set
 uint32_t act_tmr = 0;              // Records the time the actuator was fired
@@ -72,6 +76,7 @@ uint32_t pwr_cut_retry_tmr = 0;    // Records when the ADL power cut message was
  * Main function
  */
 void main(void) {
+  BOOT_select(); // Start a newly updated image if there is one
   init_general(); // Set general runtime configuration bits
   init_gpio_pins(); // Set all I/O pins to low outputs
   //init_peripheral_modules(); // Disable unused peripheral modules
@@ -80,7 +85,21 @@ void main(void) {
   init_timer2(); // Initialize timer2 (millis)
   init_adc(NULL); // Initialize ADC module
   init_termination(NOT_TERMINATING); // Initialize programmable CAN termination
+
+  // Subscribe to received CAN messages, the kill switch is critical
+  CAN_subscribe(MOTEC_ID + 0x0, 1, process_motec0_msg, CAN_NORMAL);
+  CAN_subscribe(MOTEC_ID + 0x3, 1, process_motec3_msg, CAN_NORMAL);
+  CAN_subscribe(MOTEC_ID + 0x7, 1, process_motec7_msg, CAN_NORMAL);
+  CAN_subscribe(PDM_ID + 0x1, 1, process_pdm1_msg, CAN_CRITICAL);
+  CAN_subscribe(WHEEL_ID + 0x1, 1, process_wheel1_msg, CAN_NORMAL);
+  CAN_subscribe(GCM_ID + ISOTP_REQ_OFFSET, 1, process_isotp_msg, CAN_NORMAL);
+  ISOTP_init(&boot_link, GCM_ID + ISOTP_RESP_OFFSET, GCM_ID + ISOTP_REQ_OFFSET,
+      boot_req, sizeof(boot_req), BOOT_request, NULL);
+  BOOT_set_guard(boot_parked);
   init_can(); // Initialize CAN
+  CAN_health_init(GCM_ID + HEALTH_ID_OFFSET); // Publish CAN health
+  CAN_sched_add(GCM_ID + 0, DIAG_MSG_SEND, CAN_SCHED_AUTO, pack_diag_can);
+  CAN_sched_add(GCM_ID + 2, STATE_MSG_SEND, CAN_SCHED_AUTO, pack_state_can);
 
   //TODO: USB
   //TODO: NVM
@@ -139,9 +158,15 @@ void main(void) {
         send_power_cut(CUT_RESEND);
     }
 
-    // CAN message sending functions
-    send_diag_can();
-    send_state_can(NO_OVERRIDE);
+    // Send periodic CAN messages that are due
+    CAN_sched_service();
+
+    // CAN error monitoring and bus-off recovery
+    CAN_health_service();
+
+    // Firmware updates requested over CAN
+    ISOTP_service(&boot_link);
+    BOOT_service(&boot_link);
   }
 }
 
@@ -150,9 +175,13 @@ void main(void) {
 /**
  * CAN1 Interrupt Handler
  */
-void __attribute__((vector(_CAN1_VECTOR), interrupt(IPL4SRS))) can_inthnd(void) {
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
   if (C1INTbits.RBIF) {
-    CAN_recv_messages(process_CAN_msg); // Process all available CAN messages
+    CAN_dispatch_messages(); // Process all available CAN messages
+  }
+
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
   }
 
   if (C1INTbits.RBOVIF) {
@@ -167,7 +196,7 @@ void __attribute__((vector(_CAN1_VECTOR), interrupt(IPL4SRS))) can_inthnd(void)
  *
  * Fires once every second.
  */
-void __attribute__((vector(_TIMER_1_VECTOR), interrupt(IPL5SRS))) timer1_inthnd(void) {
+void ISR(_TIMER_1_VECTOR, IPL5SRS) timer1_inthnd(void) {
   seconds++; // Increment seconds count
   IFS0CLR = _IFS0_T1IF_MASK; // Clear TMR1 Interrupt Flag
 }
@@ -177,7 +206,7 @@ void __attribute__((vector(_TIMER_1_VECTOR), interrupt(IPL5SRS))) timer1_inthnd(
  *
  * Fires once every millisecond.
  */
-void __attribute__((vector(_TIMER_2_VECTOR), interrupt(IPL6SRS))) timer2_inthnd(void) {
+void ISR(_TIMER_2_VECTOR, IPL6SRS) timer2_inthnd(void) {
   millis++; // Increment millis count
 
   //TODO: Move this?
@@ -187,7 +216,7 @@ void __attribute__((vector(_TIMER_2_VECTOR), interrupt(IPL6SRS))) timer2_inthnd(
 
   if (SHIFT_UP_SW != prev_switch_up ||
       SHIFT_DN_SW != prev_switch_dn) {
-    send_state_can(OVERRIDE);
+    CAN_sched_trigger(GCM_ID + 2);
   }
 
   // Check to see if GCM mode should change
@@ -224,7 +253,7 @@ void _nmi_handler(void) {
   RSWRSTSET = 1;
   uint16_t dummy = RSWRST;
   while (1);
-  asm volatile("eret;"); // Should never be called
+  ERET(); // Should never be called
 }
 
 //============================= ADC FUNCTIONS ==================================
@@ -321,98 +350,136 @@ void sample_sensors(uint8_t is_shifting) {
 //============================= CAN FUNCTIONS ==================================
 
 /**
- * Handler function for each received CAN message.
+ * void process_motec0_msg(CAN_message msg)
+ *
+ * Handler for engine speed, throttle position and battery voltage.
  *
  * @param msg The received CAN message
  */
-void process_CAN_msg(CAN_message msg) { // Add brake pressure #CHECK
-  uint8_t switch_bitmap;
-  uint8_t button_bitmap;
-
-  switch (msg.id) {
-    case MOTEC_ID + 0x0:
-      eng_rpm = ((double) ((msg.data[ENG_RPM_BYTE] << 8) |
-          msg.data[ENG_RPM_BYTE + 1])) * ENG_RPM_SCL;
-      throttle_pos = ((double) ((msg.data[THROTTLE_POS_BYTE] << 8) |
-          msg.data[THROTTLE_POS_BYTE + 1])) * THROTTLE_POS_SCL;
-      bat_volt = ((double) ((msg.data[VOLT_ECU_BYTE] << 8) |
-          msg.data[VOLT_ECU_BYTE + 1])) * VOLT_ECU_SCL;
-      CAN_recv_tmr = millis;
-      break;
-
-    case MOTEC_ID + 0x3:
-      wheel_fl_speed = ((double) ((msg.data[WHEELSPEED_FL_BYTE] << 8) |
-          msg.data[WHEELSPEED_FL_BYTE + 1])) * WHEELSPEED_FL_SCL;
-      wheel_fr_speed = ((double) ((msg.data[WHEELSPEED_FR_BYTE] << 8) |
-          msg.data[WHEELSPEED_FR_BYTE + 1])) * WHEELSPEED_FR_SCL;
-      wheel_rl_speed = ((double) ((msg.data[WHEELSPEED_RL_BYTE] << 8) |
-          msg.data[WHEELSPEED_RL_BYTE + 1])) * WHEELSPEED_RL_SCL;
-      wheel_rr_speed = ((double) ((msg.data[WHEELSPEED_RR_BYTE] << 8) |
-          msg.data[WHEELSPEED_RR_BYTE + 1])) * WHEELSPEED_RR_SCL;
-      CAN_recv_tmr = millis;
-      break;
-
-    case MOTEC_ID + 0x7:
-      shift_force_ecu = (uint16_t) ((msg.data[SHIFT_FORCE_BYTE] << 8) |
-          msg.data[SHIFT_FORCE_BYTE + 1]);
-      break;
-
-    case PDM_ID + 0x1:
-      switch_bitmap = msg.data[PDM_SWITCH_BYTE];
-      kill_sw = switch_bitmap & KILL_PDM_SW_MASK;
-      CAN_recv_tmr = millis;
-      break;
-
-      case WHEEL_ID + 0x1:
-        button_bitmap = msg.data[0];
-        radio_button = button_bitmap & 0x01;
-        acknowledge_button = (uint8_t) ((button_bitmap & 0x02) >> 1);
-        auxiliary_button = ((uint8_t) (button_bitmap & 0x04) >> 2);
-        night_day_switch = ((uint8_t) (button_bitmap & 0x80) >> 7);
-        CAN_recv_tmr = millis;
-        break;
+void process_motec0_msg(CAN_message msg) {
+  eng_rpm = ((double) ((msg.data[ENG_RPM_BYTE] << 8) |
+      msg.data[ENG_RPM_BYTE + 1])) * ENG_RPM_SCL;
+  throttle_pos = ((double) ((msg.data[THROTTLE_POS_BYTE] << 8) |
+      msg.data[THROTTLE_POS_BYTE + 1])) * THROTTLE_POS_SCL;
+  bat_volt = ((double) ((msg.data[VOLT_ECU_BYTE] << 8) |
+      msg.data[VOLT_ECU_BYTE + 1])) * VOLT_ECU_SCL;
+  CAN_recv_tmr = millis;
+  motec0_recv_tmr = millis;
+}
 
-  }
+/**
+ * void process_motec3_msg(CAN_message msg)
+ *
+ * Handler for wheel speeds. Add brake pressure #CHECK
+ *
+ * @param msg The received CAN message
+ */
+void process_motec3_msg(CAN_message msg) {
+  wheel_fl_speed = ((double) ((msg.data[WHEELSPEED_FL_BYTE] << 8) |
+      msg.data[WHEELSPEED_FL_BYTE + 1])) * WHEELSPEED_FL_SCL;
+  wheel_fr_speed = ((double) ((msg.data[WHEELSPEED_FR_BYTE] << 8) |
+      msg.data[WHEELSPEED_FR_BYTE + 1])) * WHEELSPEED_FR_SCL;
+  wheel_rl_speed = ((double) ((msg.data[WHEELSPEED_RL_BYTE] << 8) |
+      msg.data[WHEELSPEED_RL_BYTE + 1])) * WHEELSPEED_RL_SCL;
+  wheel_rr_speed = ((double) ((msg.data[WHEELSPEED_RR_BYTE] << 8) |
+      msg.data[WHEELSPEED_RR_BYTE + 1])) * WHEELSPEED_RR_SCL;
+  CAN_recv_tmr = millis;
 }
 
 /**
- * void send_diag_can(void)
+ * void process_motec7_msg(CAN_message msg)
  *
- * Sends the diagnostic CAN message if the interval has passed.
+ * Handler for the shift force the ECU requests.
+ *
+ * @param msg The received CAN message
  */
-void send_diag_can(void) {
-  if (millis - diag_send_tmr >= DIAG_MSG_SEND) {
-    CAN_data data = {0};
-    data.halfword0 = (uint16_t) seconds;
-    data.halfword1 = pcb_temp;
-    data.halfword2 = junc_temp;
+void process_motec7_msg(CAN_message msg) {
+  shift_force_ecu = (uint16_t) ((msg.data[SHIFT_FORCE_BYTE] << 8) |
+      msg.data[SHIFT_FORCE_BYTE + 1]);
+}
 
-    CAN_send_message(GCM_ID + 0, 6, data);
-    diag_send_tmr = millis;
-  }
+/**
+ * void process_pdm1_msg(CAN_message msg)
+ *
+ * Handler for the PDM switch states, including the kill switch.
+ *
+ * @param msg The received CAN message
+ */
+void process_pdm1_msg(CAN_message msg) {
+  uint8_t switch_bitmap = msg.data[PDM_SWITCH_BYTE];
+  kill_sw = switch_bitmap & KILL_PDM_SW_MASK;
+  CAN_recv_tmr = millis;
 }
 
 /**
- * void send_state_can(uint8_t override)
+ * void process_wheel1_msg(CAN_message msg)
  *
- * Sends the switch/queue state CAN message if the interval has passed.
+ * Handler for the steering wheel buttons.
  *
- * @param override - Whether to override the interval
+ * @param msg The received CAN message
  */
-void send_state_can(uint8_t override) {
-  if ((millis - state_send_tmr >= STATE_MSG_SEND) || override) {
-    CAN_data data = {0};
-    data.byte0 = 0x0 |
-      (SHIFT_NT_SW << 2) |
-      (SHIFT_DN_SW << 1) |
-      SHIFT_UP_SW;
-    data.byte1 = queue_up;
-    data.byte2 = queue_dn;
-    data.byte3 = queue_nt;
-
-    CAN_send_message(GCM_ID + 2, 4, data);
-    state_send_tmr = millis;
-  }
+void process_wheel1_msg(CAN_message msg) {
+  uint8_t button_bitmap = msg.data[0];
+  radio_button = button_bitmap & 0x01;
+  acknowledge_button = (uint8_t) ((button_bitmap & 0x02) >> 1);
+  auxiliary_button = ((uint8_t) (button_bitmap & 0x04) >> 2);
+  night_day_switch = ((uint8_t) (button_bitmap & 0x80) >> 7);
+  CAN_recv_tmr = millis;
+}
+
+/**
+ * void process_isotp_msg(CAN_message msg)
+ *
+ * Handler for frames of firmware update requests, which are run by
+ * ISOTP_service().
+ *
+ * @param msg The received CAN message
+ */
+void process_isotp_msg(CAN_message msg) {
+  ISOTP_receive(&boot_link, msg);
+}
+
+/**
+ * uint8_t boot_parked(void)
+ *
+ * Guard for firmware updates, see BOOT_set_guard(). The car counts as parked
+ * when the engine is stopped or the ECU has gone quiet.
+ *
+ * @returns Whether a firmware update may begin or restart the node
+ */
+uint8_t boot_parked(void) {
+  return eng_rpm == 0 || millis - motec0_recv_tmr > PARKED_WAIT;
+}
+
+/**
+ * uint32_t pack_diag_can(uint32_t id, CAN_data* data)
+ *
+ * Packs the diagnostic CAN message for the scheduler.
+ */
+uint32_t pack_diag_can(uint32_t id, CAN_data* data) {
+  (void) id;
+  data->halfword0 = (uint16_t) seconds;
+  data->halfword1 = pcb_temp;
+  data->halfword2 = junc_temp;
+  return 6;
+}
+
+/**
+ * uint32_t pack_state_can(uint32_t id, CAN_data* data)
+ *
+ * Packs the switch/queue state CAN message for the scheduler. Sent early with
+ * CAN_sched_trigger() whenever the queues change.
+ */
+uint32_t pack_state_can(uint32_t id, CAN_data* data) {
+  (void) id;
+  data->byte0 = 0x0 |
+    (SHIFT_NT_SW << 2) |
+    (SHIFT_DN_SW << 1) |
+    SHIFT_UP_SW;
+  data->byte1 = queue_up;
+  data->byte2 = queue_dn;
+  data->byte3 = queue_nt;
+  return 4;
 }
 
 //=========================== LOGIC FUNCTIONS ==================================
@@ -491,26 +558,26 @@ void process_upshift_press(void) {
       queue_dn = 1;
     }
     lockout_tmr = millis;
-    send_state_can(OVERRIDE); // Send new queue values on CAN
+    CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
   } else { // Pressed while not holding the neutral button
     if (gear == GEAR_NEUT) {
       queue_up = 1;
       queue_dn = queue_nt = 0;
       lockout_tmr = millis;
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
       return;
     }
 
     if (queue_dn > 0 || queue_nt > 0) {
       queue_dn = queue_up = queue_nt = 0;
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
       return;
     }
 
     if (gear == GEAR_FAIL || queue_up < 6 - gear) {
       queue_up++;
       lockout_tmr = millis;
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
     }
   }
 }
@@ -550,18 +617,18 @@ void process_downshift_press(void) {
       queue_up = queue_nt = 0;
     }
     lockout_tmr = millis;
-    send_state_can(OVERRIDE); // Send new queue values on CAN
+    CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
   } else { // Pressed while not holding the neutral button
     if (queue_up > 0 || queue_nt > 0) {
       queue_dn = queue_up = queue_nt = 0;
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
       return;
     }
 
     if (gear == GEAR_FAIL || gear == GEAR_NEUT || queue_dn + 1 < gear) {
       queue_dn++;
       lockout_tmr = millis;
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
     }
   }
 }
@@ -708,7 +775,7 @@ void do_shift(uint8_t shift_enum) {
           retry_dn = 0;
           break;
       }
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
       return;
     }
 
@@ -749,7 +816,7 @@ void do_shift(uint8_t shift_enum) {
         } else if (SHIFT_DN){
           queue_dn--;
         }
-        send_state_can(OVERRIDE); // Send new queue values on CAN
+        CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
 
         return;
       }
@@ -774,12 +841,12 @@ void do_shift(uint8_t shift_enum) {
           queue_up = 0;
           retry_up = 0;
           send_errno_CAN_msg(GCM_ID, ERR_GCM_MAXRETRY);
-          send_state_can(OVERRIDE); // Send new queue values on CAN
+          CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
         } else if (SHIFT_DN && retry_dn > MAX_RETRY) {
           queue_dn = 0;
           retry_dn = 0;
           send_errno_CAN_msg(GCM_ID, ERR_GCM_MAXRETRY);
-          send_state_can(OVERRIDE); // Send new queue values on CAN
+          CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
         }
 
         return;
@@ -796,7 +863,7 @@ void do_shift(uint8_t shift_enum) {
     if (!check_shift_conditions(shift_enum)) {
       queue_nt = 0;
       retry_nt = 0;
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
       return;
     }
 
@@ -819,7 +886,7 @@ void do_shift(uint8_t shift_enum) {
 
         retry_nt = 0;
         queue_nt = 0;
-        send_state_can(OVERRIDE); // Send new queue values on CAN
+        CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
         return;
       } else if (gear == GEAR_FAIL || gear == orig_gear) {
         if (millis - act_tmr >= MAX_SHIFT_DUR) {
@@ -853,7 +920,7 @@ void do_shift(uint8_t shift_enum) {
       queue_nt = 0;
       retry_nt = 0;
       send_errno_CAN_msg(GCM_ID, ERR_GCM_MAXRETRY);
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
     }
   }
 }
@@ -889,7 +956,7 @@ void do_shift_gear_fail(uint8_t shift_enum) {
           retry_dn = 0;
           break;
       }
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
       return;
     }
 
@@ -929,7 +996,7 @@ void do_shift_gear_fail(uint8_t shift_enum) {
         } else if (SHIFT_DN){
           queue_dn--;
         }
-        send_state_can(OVERRIDE); // Send new queue values on CAN
+        CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
 
         return;
       }
@@ -945,7 +1012,7 @@ void do_shift_gear_fail(uint8_t shift_enum) {
     if (!check_shift_conditions(shift_enum)) {
       queue_nt = 0;
       retry_nt = 0;
-      send_state_can(OVERRIDE); // Send new queue values on CAN
+      CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
       return;
     }
 
@@ -966,7 +1033,7 @@ void do_shift_gear_fail(uint8_t shift_enum) {
 
         retry_nt = 0;
         queue_nt = 0;
-        send_state_can(OVERRIDE); // Send new queue values on CAN
+        CAN_sched_trigger(GCM_ID + 2); // Send new queue values on CAN
         return;
       }
 
@@ -1008,8 +1075,7 @@ void main_loop_misc(void) {
     send_power_cut(CUT_RESEND);
   }
 
-  send_diag_can();
-  send_state_can(NO_OVERRIDE);
+  CAN_sched_service();
 }
 
 /**
@@ -13,6 +13,7 @@
 #include "../FSAE.X/FSAE_config.h"
 #include "../FSAE.X/FSAE_can.h"
 #include "../FSAE.X/FSAE_adc.h"
+#include "../FSAE.X/FSAE_boot.h"
 #include "../FSAE.X/CAN.h"
 #include "../FSAE.X/errno.h"
 
@@ -51,6 +52,7 @@
 #define NT_SHIFT_DUR   50  //TODO: Tune this value
 
 #define CAN_STATE_WAIT 1000
+#define PARKED_WAIT    1000 // ECU silence before updates are allowed
 #define CUT_RETRY_WAIT 2
 
 // Raw (bouncy) switch state definitions
@@ -146,9 +148,15 @@ void sample_temp(void);
 void sample_sensors(uint8_t is_shifting);
 
 // CAN functions
-void process_CAN_msg(CAN_message msg);
-void send_diag_can(void);
-void send_state_can(uint8_t override);
+void process_motec0_msg(CAN_message msg);
+void process_motec3_msg(CAN_message msg);
+void process_motec7_msg(CAN_message msg);
+void process_pdm1_msg(CAN_message msg);
+void process_wheel1_msg(CAN_message msg);
+void process_isotp_msg(CAN_message msg);
+uint8_t boot_parked(void);
+uint32_t pack_diag_can(uint32_t id, CAN_data* data);
+uint32_t pack_state_can(uint32_t id, CAN_data* data);
 
 // Logic functions
 void process_auto_upshift(void);
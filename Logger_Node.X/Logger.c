@@ -20,16 +20,24 @@ double rail_vbat, rail_vbak, rail_vsup, rail_5v, rail_3v3 = 0.0;
 
 // Timing interval variables
 volatile uint32_t CAN_recv_tmr = 0;
-uint32_t diag_send_tmr, rail_send_tmr = 0;
 uint32_t temp_samp_tmr, rail_samp_tmr = 0;
 
 // SPI Connections
 SPIConn* spi_nvm = NULL;
 
+// NVM access over CAN
+ISOTP_link nvm_link;
+uint8_t nvm_req[NVM_REQ_HDR + NVM_WRITE_MAX];
+uint8_t nvm_status = 0;
+uint32_t nvm_read_addr = 0;
+uint8_t nvm_write_buf[NVM_WRITE_MAX]; // Data of the queued write request
+uint8_t nvm_write_handle = 0;
+
 /**
  * Main function
  */
 void main(void) {
+  BOOT_select(); // Start a newly updated image if there is one
   init_general(); // Set general runtime configuration bits
   init_gpio_pins(); // Set all I/O pins to low outputs
   //init_peripheral_modules(); // Disable unused peripheral modules
@@ -38,7 +46,15 @@ void main(void) {
   init_timer2(); // Initialize timer2 (millis)
   init_adc(init_adc_logger); // Initialize ADC module
   init_termination(TERMINATING); // Initialize programmable CAN termination
+  CAN_subscribe(MOTEC_ID + 0, 1, process_motec0_msg, CAN_NORMAL);
+  CAN_subscribe(LOGGER_ID + ISOTP_REQ_OFFSET, 1, process_isotp_msg, CAN_NORMAL);
+  ISOTP_init(&nvm_link, LOGGER_ID + ISOTP_RESP_OFFSET, LOGGER_ID + ISOTP_REQ_OFFSET,
+      nvm_req, sizeof(nvm_req), process_nvm_req, NULL);
   init_can(); // Initialize CAN
+  CAN_health_init(LOGGER_ID + HEALTH_ID_OFFSET); // Publish CAN health
+  CAN_sched_add(LOGGER_ID + 0, DIAG_SEND, CAN_SCHED_AUTO, pack_diag_can);
+  CAN_sched_add(LOGGER_ID + 1, RAIL_SEND, CAN_SCHED_AUTO, pack_rail_can);
+  CAN_sched_add(LOGGER_ID + 2, RAIL_SEND, CAN_SCHED_AUTO, pack_rail_can);
 
   spi_nvm = init_nvm_std(); // Initialize NVM module
   //TODO: USB
@@ -73,9 +89,16 @@ void main(void) {
     sample_temp();
     sample_rail();
 
-    // CAN message sending functions
-    send_diag_can();
-    send_rail_can();
+    // NVM reads and writes and firmware updates requested over CAN
+    ISOTP_service(&nvm_link);
+    nvm_service();
+    BOOT_service(&nvm_link);
+
+    // Send periodic CAN messages that are due
+    CAN_sched_service();
+
+    // CAN error monitoring and bus-off recovery
+    CAN_health_service();
   }
 }
 
@@ -84,9 +107,13 @@ void main(void) {
 /**
  * CAN1 Interrupt Handler
  */
-void __attribute__((vector(_CAN1_VECTOR), interrupt(IPL4SRS))) can_inthnd(void) {
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
   if (C1INTbits.RBIF) {
-    CAN_recv_messages(process_CAN_msg); // Process all available CAN messages
+    CAN_dispatch_messages(); // Process all available CAN messages
+  }
+
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
   }
 
   if (C1INTbits.RBOVIF) {
@@ -101,7 +128,7 @@ void __attribute__((vector(_CAN1_VECTOR), interrupt(IPL4SRS))) can_inthnd(void)
  *
  * Fires once every second.
  */
-void __attribute__((vector(_TIMER_1_VECTOR), interrupt(IPL5SRS))) timer1_inthnd(void) {
+void ISR(_TIMER_1_VECTOR, IPL5SRS) timer1_inthnd(void) {
   seconds++; // Increment seconds count
   IFS0CLR = _IFS0_T1IF_MASK; // Clear TMR1 Interrupt Flag
 }
@@ -111,7 +138,7 @@ void __attribute__((vector(_TIMER_1_VECTOR), interrupt(IPL5SRS))) timer1_inthnd(
  *
  * Fires once every millisecond.
  */
-void __attribute__((vector(_TIMER_2_VECTOR), interrupt(IPL6SRS))) timer2_inthnd(void) {
+void ISR(_TIMER_2_VECTOR, IPL6SRS) timer2_inthnd(void) {
   millis++; // Increment millis count
 
   //TODO: Move this?
@@ -133,24 +160,109 @@ void _nmi_handler(void) {
   RSWRSTSET = 1;
   uint16_t dummy = RSWRST;
   while (1);
-  asm volatile("eret;"); // Should never be called
+  ERET(); // Should never be called
 }
 
 //============================ LOGIC FUNCTIONS =================================
 
 /**
- * Handler function for each received CAN message.
+ * void process_motec0_msg(CAN_message msg)
+ *
+ * Handler for engine speed.
  *
  * @param msg The received CAN message
  */
-void process_CAN_msg(CAN_message msg) {
+void process_motec0_msg(CAN_message msg) {
   CAN_recv_tmr = millis; // Record time of latest received CAN message
 
-  switch (msg.id) {
-    case MOTEC_ID + 0:
-      eng_rpm = ((double) ((msg.data[ENG_RPM_BYTE] << 8) |
-          msg.data[ENG_RPM_BYTE + 1])) * ENG_RPM_SCL;
-      break;
+  eng_rpm = ((double) ((msg.data[ENG_RPM_BYTE] << 8) |
+      msg.data[ENG_RPM_BYTE + 1])) * ENG_RPM_SCL;
+}
+
+/**
+ * void process_isotp_msg(CAN_message msg)
+ *
+ * Handler for frames of ISO-TP requests, which are run by ISOTP_service().
+ *
+ * @param msg The received CAN message
+ */
+void process_isotp_msg(CAN_message msg) {
+  ISOTP_receive(&nvm_link, msg);
+}
+
+/**
+ * void process_nvm_req(ISOTP_link* link, uint8_t* data, uint32_t len)
+ *
+ * Runs an NVM read or write requested over ISO-TP and starts the reply. A read
+ * is streamed from NVM as the reply is sent, so it can cover the whole chip. A
+ * write is copied out of the request buffer, which the link reuses for the
+ * next request, and queued, and replied to once it has finished. A write
+ * requested while one is still queued gets NVM_ERR_BUSY.
+ * Other requests are firmware updates, passed on to BOOT_request().
+ *
+ * @param data The request, see NVM_READ_REQ, NVM_WRITE_REQ and BOOT_BEGIN_REQ
+ */
+void process_nvm_req(ISOTP_link* link, uint8_t* data, uint32_t len) {
+  uint32_t addr = 0;
+  uint32_t size = 0;
+
+  if (len >= NVM_REQ_HDR) {
+    addr = ((uint32_t) data[1] << 24) | ((uint32_t) data[2] << 16) |
+      ((uint32_t) data[3] << 8) | data[4];
+  }
+
+  if (len == NVM_REQ_HDR + 4 && data[0] == NVM_READ_REQ) {
+    size = ((uint32_t) data[5] << 24) | ((uint32_t) data[6] << 16) |
+      ((uint32_t) data[7] << 8) | data[8];
+    if (size == 0 || addr > _NVM_MAX_ADDR || size > _NVM_MAX_ADDR + 1 - addr) {
+      nvm_status = NVM_ERR_SEGV;
+      ISOTP_send(link, &nvm_status, 1);
+    } else {
+      nvm_read_addr = addr;
+      ISOTP_send_from(link, read_nvm_reply, size + 1);
+    }
+  } else if (len > NVM_REQ_HDR && data[0] == NVM_WRITE_REQ) {
+    if (nvm_write_pending(nvm_write_handle)) {
+      nvm_status = NVM_ERR_BUSY;
+    } else {
+      memcpy(nvm_write_buf, &data[NVM_REQ_HDR], len - NVM_REQ_HDR);
+      nvm_status = nvm_write_async(spi_nvm, addr, len - NVM_REQ_HDR, nvm_write_buf,
+          write_nvm_done, &nvm_write_handle);
+    }
+    if (nvm_status != NVM_SUCCESS) {
+      ISOTP_send(link, &nvm_status, 1);
+    }
+  } else {
+    BOOT_request(link, data, len); // Firmware update, or a bad request
+  }
+}
+
+/**
+ * void write_nvm_done(uint8_t handle, uint8_t result)
+ *
+ * Replies to an NVM write once it has finished.
+ */
+void write_nvm_done(uint8_t handle, uint8_t result) {
+  (void) handle;
+  nvm_status = result;
+  ISOTP_send(&nvm_link, &nvm_status, 1);
+}
+
+/**
+ * void read_nvm_reply(ISOTP_link* link, uint32_t offset, uint8_t* data, uint32_t len)
+ *
+ * Fills the reply to an NVM read, a status byte followed by the data.
+ */
+void read_nvm_reply(ISOTP_link* link, uint32_t offset, uint8_t* data, uint32_t len) {
+  (void) link;
+  if (offset == 0) {
+    *data++ = NVM_SUCCESS;
+    len--;
+  } else {
+    offset--;
+  }
+  if (len > 0) {
+    nvm_read_data(spi_nvm, nvm_read_addr + offset, len, data);
   }
 }
 
@@ -221,41 +333,34 @@ void sample_rail(void) {
 //============================= CAN FUNCTIONS ==================================
 
 /**
- * void send_diag_can(void)
+ * uint32_t pack_diag_can(uint32_t id, CAN_data* data)
  *
- * Sends the diagnostic CAN message if the interval has passed.
+ * Packs the diagnostic CAN message for the scheduler.
  */
-void send_diag_can(void) {
-  if (millis - diag_send_tmr >= DIAG_SEND) {
-    CAN_data data = {0};
-    data.halfword0 = (uint16_t) seconds;
-    data.halfword1 = pcb_temp;
-    data.halfword2 = junc_temp;
-
-    CAN_send_message(LOGGER_ID + 0, 6, data);
-    diag_send_tmr = millis;
-  }
+uint32_t pack_diag_can(uint32_t id, CAN_data* data) {
+  (void) id;
+  data->halfword0 = (uint16_t) seconds;
+  data->halfword1 = pcb_temp;
+  data->halfword2 = junc_temp;
+  return 6;
 }
 
 /**
- * void send_rail_can(void)
+ * uint32_t pack_rail_can(uint32_t id, CAN_data* data)
  *
- * Sends the rail voltage CAN message if the interval has passed.
+ * Packs one of the rail voltage CAN messages for the scheduler.
  */
-void send_rail_can(void) {
-  if (millis - rail_send_tmr >= RAIL_SEND) {
-    CAN_data data = {0};
-    data.halfword0 = (uint16_t) (rail_vbat * 1000.0);
-    data.halfword1 = (uint16_t) (rail_vbak * 1000.0);
-    data.halfword2 = (uint16_t) (rail_vsup * 1000.0);
-    data.halfword3 = (uint16_t) (rail_5v * 1000.0);
-    CAN_send_message(LOGGER_ID + 1, 8, data);
-
-    data.halfword0 = (uint16_t) (rail_3v3 * 1000.0);
-    CAN_send_message(LOGGER_ID + 2, 2, data);
-
-    rail_send_tmr = millis;
+uint32_t pack_rail_can(uint32_t id, CAN_data* data) {
+  if (id == LOGGER_ID + 1) {
+    data->halfword0 = (uint16_t) (rail_vbat * 1000.0);
+    data->halfword1 = (uint16_t) (rail_vbak * 1000.0);
+    data->halfword2 = (uint16_t) (rail_vsup * 1000.0);
+    data->halfword3 = (uint16_t) (rail_5v * 1000.0);
+    return 8;
   }
+
+  data->halfword0 = (uint16_t) (rail_3v3 * 1000.0);
+  return 2;
 }
 
 //========================== UTILITY FUNCTIONS =================================
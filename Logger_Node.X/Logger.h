@@ -13,8 +13,10 @@
 #include "../FSAE.X/CAN.h"
 #include "../FSAE.X/errno.h"
 #include "../FSAE.X/FSAE_adc.h"
+#include "../FSAE.X/FSAE_boot.h"
 #include "../FSAE.X/FSAE_can.h"
 #include "../FSAE.X/FSAE_config.h"
+#include "../FSAE.X/FSAE_isotp.h"
 #include "../FSAE.X/FSAE_ltc3350.h"
 #include "../FSAE.X/FSAE_nvm.h"
 #include "../FSAE.X/FSAE_spi.h"
@@ -64,15 +66,19 @@
 void main(void);
 
 // Logic functions
-void process_CAN_msg(CAN_message msg);
+void process_motec0_msg(CAN_message msg);
+void process_isotp_msg(CAN_message msg);
+void process_nvm_req(ISOTP_link* link, uint8_t* data, uint32_t len);
+void write_nvm_done(uint8_t handle, uint8_t result);
+void read_nvm_reply(ISOTP_link* link, uint32_t offset, uint8_t* data, uint32_t len);
 
 // ADC sample functions
 void sample_temp(void);
 void sample_rail(void);
 
-// CAN message sending functions
-void send_diag_can(void);
-void send_rail_can(void);
+// CAN message packing functions
+uint32_t pack_diag_can(uint32_t id, CAN_data* data);
+uint32_t pack_rail_can(uint32_t id, CAN_data* data);
 
 // Utility functions
 void init_adc_logger(void);
@@ -41,12 +41,14 @@ uint8_t overcurrent_count[NUM_LOADS] = {0};
 uint32_t overcurrent_tmr[NUM_LOADS] = {0};
 uint32_t load_tmr[NUM_LOADS] = {0};       // Millis timestamp of when load was last enabled
 
+// Firmware updates over CAN
+ISOTP_link boot_link;
+uint8_t boot_req[BOOT_REQ_HDR + BOOT_BLOCK_MAX];
+
 // Timing interval variables
 volatile uint32_t CAN_recv_tmr, motec0_recv_tmr, motec1_recv_tmr,
          motec2_recv_tmr, override_sw_tmr = 0;
 uint32_t fuel_prime_tmr = 0;
-uint32_t diag_send_tmr, diag_state_send_tmr, rail_volt_send_tmr,
-         load_current_send_tmr, cutoff_send_tmr, overcrt_count_send_tmr = 0;
 uint32_t temp_samp_tmr, ext_adc_samp_tmr = 0;
 uint32_t switch_debounce_tmr, overcrt_chk_tmr = 0;
 uint32_t crit_volt_tmr, crit_oilpres_tmr, crit_oiltemp_tmr, crit_engtemp_tmr, crit_idle_tmr = 0;
@@ -55,6 +57,7 @@ uint32_t crit_volt_tmr, crit_oilpres_tmr, crit_oiltemp_tmr, crit_engtemp_tmr, cr
  * Main function
  */
 void main(void) {
+  BOOT_select(); // Start a newly updated image if there is one
   init_general(); // Set general runtime configuration bits
   init_gpio_pins(); // Set all I/O pins to low outputs
   //init_peripheral_modules(); // Disable unused peripheral modules
@@ -63,7 +66,32 @@ void main(void) {
   init_timer2(); // Initialize timer2 (millis)
   init_adc(NULL); // Initialize ADC module
   init_termination(TERMINATING); // Initialize programmable CAN termination
+
+  // Subscribe to received CAN messages
+  CAN_subscribe(MOTEC_ID + 0, 1, process_motec0_msg, CAN_NORMAL);
+  CAN_subscribe(MOTEC_ID + 1, 1, process_motec1_msg, CAN_NORMAL);
+  CAN_subscribe(MOTEC_ID + 2, 1, process_motec2_msg, CAN_NORMAL);
+  CAN_subscribe(WHEEL_ID + 0x1, 1, process_wheel1_msg, CAN_NORMAL);
+  CAN_subscribe(PDM_ID + ISOTP_REQ_OFFSET, 1, process_isotp_msg, CAN_NORMAL);
+  ISOTP_init(&boot_link, PDM_ID + ISOTP_RESP_OFFSET, PDM_ID + ISOTP_REQ_OFFSET,
+      boot_req, sizeof(boot_req), BOOT_request, NULL);
+  BOOT_set_guard(boot_parked);
   init_can(); // Initialize CAN
+  CAN_health_init(PDM_ID + HEALTH_ID_OFFSET); // Publish CAN health
+
+  // Send periodic CAN messages with their phases spread by the scheduler
+  CAN_sched_add(PDM_ID + 0x0, DIAG_SEND, CAN_SCHED_AUTO, pack_diag_can);
+  CAN_sched_add(PDM_ID + 0x1, DIAG_STATE_SEND, CAN_SCHED_AUTO, pack_diag_state_can);
+  CAN_sched_add(PDM_ID + 0x2, RAIL_VOLT_SEND, CAN_SCHED_AUTO, pack_rail_volt_can);
+  CAN_sched_add(PDM_ID + 0x3, LOAD_CUR_SEND, CAN_SCHED_AUTO, pack_load_current_can);
+  CAN_sched_add(PDM_ID + 0x4, LOAD_CUR_SEND, CAN_SCHED_AUTO, pack_load_current_can);
+  CAN_sched_add(PDM_ID + 0x5, LOAD_CUR_SEND, CAN_SCHED_AUTO, pack_load_current_can);
+  CAN_sched_add(PDM_ID + 0x6, CUTOFF_VAL_SEND, CAN_SCHED_AUTO, pack_cutoff_values_can);
+  CAN_sched_add(PDM_ID + 0x7, CUTOFF_VAL_SEND, CAN_SCHED_AUTO, pack_cutoff_values_can);
+  CAN_sched_add(PDM_ID + 0x8, CUTOFF_VAL_SEND, CAN_SCHED_AUTO, pack_cutoff_values_can);
+  CAN_sched_add(PDM_ID + 0x9, CUTOFF_VAL_SEND, CAN_SCHED_AUTO, pack_cutoff_values_can);
+  CAN_sched_add(PDM_ID + 0xA, OVERCRT_COUNT_SEND, CAN_SCHED_AUTO, pack_overcrt_count_can);
+  CAN_sched_add(PDM_ID + 0xB, OVERCRT_COUNT_SEND, CAN_SCHED_AUTO, pack_overcrt_count_can);
   init_rheostats(); // Initialize SPI interface for digital rheostats
 
   // Initialize AD7490 external ADC chip
@@ -344,12 +372,17 @@ void main(void) {
     sample_ext_adc();
 
     // CAN message sending functions
-    send_diag_can();
-    send_diag_state_can(load_state_changed ? OVERRIDE : NO_OVERRIDE);
-    send_rail_volt_can();
-    send_load_current_can();
-    send_cutoff_values_can(NO_OVERRIDE);
-    send_overcrt_count_can(NO_OVERRIDE);
+    if (load_state_changed) {
+      CAN_sched_trigger(PDM_ID + 0x1);
+    }
+    CAN_sched_service();
+
+    // CAN error monitoring and bus-off recovery
+    CAN_health_service();
+
+    // Firmware updates requested over CAN
+    ISOTP_service(&boot_link);
+    BOOT_service(&boot_link);
   }
 }
 
@@ -358,9 +391,13 @@ void main(void) {
 /**
  * CAN1 Interrupt Handler
  */
-void __attribute__((vector(_CAN1_VECTOR), interrupt(IPL4SRS))) can_inthnd(void) {
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
   if (C1INTbits.RBIF) {
-    CAN_recv_messages(process_CAN_msg); // Process all available CAN messages
+    CAN_dispatch_messages(); // Process all available CAN messages
+  }
+
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
   }
 
   if (C1INTbits.RBOVIF) {
@@ -375,7 +412,7 @@ void __attribute__((vector(_CAN1_VECTOR), interrupt(IPL4SRS))) can_inthnd(void)
  *
  * Fires once every second.
  */
-void __attribute__((vector(_TIMER_1_VECTOR), interrupt(IPL5SRS))) timer1_inthnd(void) {
+void ISR(_TIMER_1_VECTOR, IPL5SRS) timer1_inthnd(void) {
   seconds++; // Increment seconds count
   IFS0CLR = _IFS0_T1IF_MASK; // Clear TMR1 Interrupt Flag
 }
@@ -385,7 +422,7 @@ void __attribute__((vector(_TIMER_1_VECTOR), interrupt(IPL5SRS))) timer1_inthnd(
  *
  * Fires once every millisecond.
  */
-void __attribute__((vector(_TIMER_2_VECTOR), interrupt(IPL6SRS))) timer2_inthnd(void) {
+void ISR(_TIMER_2_VECTOR, IPL6SRS) timer2_inthnd(void) {
   millis++; // Increment millis count
 
   //TODO: Move this?
@@ -407,55 +444,103 @@ void _nmi_handler(void) {
   RSWRSTSET = 1;
   uint16_t dummy = RSWRST;
   while (1);
-  asm volatile("eret;"); // Should never be called
+  ERET(); // Should never be called
 }
 
 //============================ LOGIC FUNCTIONS =================================
 
 /**
- * Handler function for each received CAN message.
+ * void process_motec0_msg(CAN_message msg)
+ *
+ * Handler for engine speed and ECU battery voltage.
  *
  * @param msg The received CAN message
  */
-void process_CAN_msg(CAN_message msg) {
-  // Declare local variables
-  uint8_t load_idx, peak_mode, switch_bitmap = 0;
-  double cutoff = 0;
+void process_motec0_msg(CAN_message msg) {
+  CAN_recv_tmr = millis; // Record time of latest received CAN message
 
+  eng_rpm = ((double) ((msg.data[ENG_RPM_BYTE] << 8) |
+        msg.data[ENG_RPM_BYTE + 1])) * ENG_RPM_SCL;
+  bat_volt_ecu = ((double) ((msg.data[VOLT_ECU_BYTE] << 8) |
+        msg.data[VOLT_ECU_BYTE + 1])) * VOLT_ECU_SCL;
+
+  motec0_recv_tmr = millis;
+}
+
+/**
+ * void process_motec1_msg(CAN_message msg)
+ *
+ * Handler for engine and oil temperature.
+ *
+ * @param msg The received CAN message
+ */
+void process_motec1_msg(CAN_message msg) {
   CAN_recv_tmr = millis; // Record time of latest received CAN message
 
-  switch (msg.id) {
-    case MOTEC_ID + 0:
-      eng_rpm = ((double) ((msg.data[ENG_RPM_BYTE] << 8) |
-            msg.data[ENG_RPM_BYTE + 1])) * ENG_RPM_SCL;
-      bat_volt_ecu = ((double) ((msg.data[VOLT_ECU_BYTE] << 8) |
-            msg.data[VOLT_ECU_BYTE + 1])) * VOLT_ECU_SCL;
+  eng_temp = ((double) ((msg.data[ENG_TEMP_BYTE] << 8) |
+        msg.data[ENG_TEMP_BYTE + 1])) * ENG_TEMP_SCL;
+  oil_temp = ((double) ((msg.data[OIL_TEMP_BYTE] << 8) |
+        msg.data[OIL_TEMP_BYTE + 1])) * OIL_TEMP_SCL;
 
-      motec0_recv_tmr = millis;
-      break;
-    case MOTEC_ID + 1:
-      eng_temp = ((double) ((msg.data[ENG_TEMP_BYTE] << 8) |
-            msg.data[ENG_TEMP_BYTE + 1])) * ENG_TEMP_SCL;
-      oil_temp = ((double) ((msg.data[OIL_TEMP_BYTE] << 8) |
-            msg.data[OIL_TEMP_BYTE + 1])) * OIL_TEMP_SCL;
+  motec1_recv_tmr = millis;
+}
 
-      motec1_recv_tmr = millis;
-      break;
-    case MOTEC_ID + 2:
-      oil_pres = ((double) ((msg.data[OIL_PRES_BYTE] << 8) |
-            msg.data[OIL_PRES_BYTE + 1])) * OIL_PRES_SCL;
+/**
+ * void process_motec2_msg(CAN_message msg)
+ *
+ * Handler for oil pressure.
+ *
+ * @param msg The received CAN message
+ */
+void process_motec2_msg(CAN_message msg) {
+  CAN_recv_tmr = millis; // Record time of latest received CAN message
 
-      motec2_recv_tmr = millis;
-      break;
+  oil_pres = ((double) ((msg.data[OIL_PRES_BYTE] << 8) |
+        msg.data[OIL_PRES_BYTE + 1])) * OIL_PRES_SCL;
 
-    case WHEEL_ID + 0x1:
-      switch_bitmap = msg.data[SWITCH_BITS_BYTE];
-      fan_override_sw = switch_bitmap & (1 << (FAN_OVR_BITPOS - 1));
-      wtr_override_sw = switch_bitmap & (1 << (WTR_OVR_BITPOS - 1));
-      fuel_override_sw = switch_bitmap & (1 << (FUEL_OVR_BITPOS - 1));
-      override_sw_tmr = millis;
-      break;
-  }
+  motec2_recv_tmr = millis;
+}
+
+/**
+ * void process_wheel1_msg(CAN_message msg)
+ *
+ * Handler for the steering wheel override switches.
+ *
+ * @param msg The received CAN message
+ */
+void process_wheel1_msg(CAN_message msg) {
+  uint8_t switch_bitmap = msg.data[SWITCH_BITS_BYTE];
+
+  CAN_recv_tmr = millis; // Record time of latest received CAN message
+
+  fan_override_sw = switch_bitmap & (1 << (FAN_OVR_BITPOS - 1));
+  wtr_override_sw = switch_bitmap & (1 << (WTR_OVR_BITPOS - 1));
+  fuel_override_sw = switch_bitmap & (1 << (FUEL_OVR_BITPOS - 1));
+  override_sw_tmr = millis;
+}
+
+/**
+ * void process_isotp_msg(CAN_message msg)
+ *
+ * Handler for frames of firmware update requests, which are run by
+ * ISOTP_service().
+ *
+ * @param msg The received CAN message
+ */
+void process_isotp_msg(CAN_message msg) {
+  ISOTP_receive(&boot_link, msg);
+}
+
+/**
+ * uint8_t boot_parked(void)
+ *
+ * Guard for firmware updates, see BOOT_set_guard(). The car counts as parked
+ * when the engine is stopped or the ECU has gone quiet.
+ *
+ * @returns Whether a firmware update may begin or restart the node
+ */
+uint8_t boot_parked(void) {
+  return eng_rpm == 0 || millis - motec0_recv_tmr > PARKED_WAIT;
 }
 
 /**
@@ -534,8 +619,9 @@ void check_load_overcurrent(void) {
               overcurrent_flag[load_idx] = OVERCRT_RESET;
               overcurrent_tmr[load_idx] = millis;
               overcurrent_count[load_idx]++;
-              send_overcrt_count_can(OVERRIDE);
-              send_diag_state_can(OVERRIDE);
+              CAN_sched_trigger(PDM_ID + 0xA);
+              CAN_sched_trigger(PDM_ID + 0xB);
+              CAN_sched_trigger(PDM_ID + 0x1);
             }
           } else {
             overcurrent_flag[load_idx] = NO_OVERCRT;
@@ -546,7 +632,7 @@ void check_load_overcurrent(void) {
           if (millis != overcurrent_tmr[load_idx]) {
             enable_load(load_idx);
             overcurrent_flag[load_idx] = NO_OVERCRT;
-            send_diag_state_can(OVERRIDE);
+            CAN_sched_trigger(PDM_ID + 0x1);
           }
           break;
       }
@@ -716,252 +802,193 @@ void sample_ext_adc(void) {
 //============================= CAN FUNCTIONS ==================================
 
 /**
- * void send_diag_can(void)
+ * uint32_t pack_diag_can(uint32_t id, CAN_data* data)
  *
- * Sends the diagnostic CAN message if the interval has passed.
+ * Packs the diagnostic CAN message for the scheduler.
  */
-void send_diag_can(void) {
-  if (millis - diag_send_tmr >= DIAG_SEND) {
-    CAN_data data = {0};
-    data.halfword0 = (uint16_t) seconds;
-    data.halfword1 = pcb_temp;
-    data.halfword2 = junc_temp;
-
-    CAN_send_message(PDM_ID + 0, 6, data);
-    diag_send_tmr = millis;
-  }
+uint32_t pack_diag_can(uint32_t id, CAN_data* data) {
+  (void) id;
+  data->halfword0 = (uint16_t) seconds;
+  data->halfword1 = pcb_temp;
+  data->halfword2 = junc_temp;
+  return 6;
 }
 
 /**
- * void send_diag_state_can(void)
- *
- * If the interval has passed or the caller overrode the check, send out the
- * enablity and peak mode state of all loads on CAN. Also send total current
- * draw, switch state, and flag state.
+ * uint32_t pack_diag_state_can(uint32_t id, CAN_data* data)
  *
- * TODO: Restrict to a certain rate, even with override
- *
- * @param override - Whether to override the interval
+ * Packs the enablity and peak mode state of all loads for the scheduler,
+ * along with total current draw, switch state, and flag state. Sent early
+ * with CAN_sched_trigger() whenever a load changes state.
  */
-void send_diag_state_can(uint8_t override) {
-  if ((millis - diag_state_send_tmr >= DIAG_STATE_SEND) || override) {
-    CAN_data data = {0};
-
-    // Create load enablity bitmap
-    data.halfword0 = 0x0 |
-      FUEL_EN << (15 - FUEL_IDX) |
-      IGN_EN << (15 - IGN_IDX) |
-      INJ_EN << (15 - INJ_IDX) |
-      ABS_EN << (15 - ABS_IDX) |
-      PDLU_EN << (15 - PDLU_IDX) |
-      PDLD_EN << (15 - PDLD_IDX) |
-      FAN_EN << (15 - FAN_IDX) |
-      WTR_EN << (15 - WTR_IDX) |
-      ECU_EN << (15 - ECU_IDX) |
-      AUX_EN << (15 - AUX_IDX) |
-      BVBAT_EN << (15 - BVBAT_IDX) |
-      STR_EN << (15 - STR_IDX);
-
-    // Create load peak mode bitmap
-    data.halfword1 = 0x0 |
-      peak_state[FUEL_IDX] << (15 - FUEL_IDX) |
-      peak_state[IGN_IDX] << (15 - IGN_IDX) |
-      peak_state[INJ_IDX] << (15 - INJ_IDX) |
-      peak_state[ABS_IDX] << (15 - ABS_IDX) |
-      peak_state[PDLU_IDX] << (15 - PDLU_IDX) |
-      peak_state[PDLD_IDX] << (15 - PDLD_IDX) |
-      peak_state[FAN_IDX] << (15 - FAN_IDX) |
-      peak_state[WTR_IDX] << (15 - WTR_IDX) |
-      peak_state[ECU_IDX] << (15 - ECU_IDX) |
-      peak_state[AUX_IDX] << (15 - AUX_IDX) |
-      peak_state[BVBAT_IDX] << (15 - BVBAT_IDX) |
-      peak_state[STR_IDX] << (15 - STR_IDX);
-
-    data.halfword2 = total_current_draw;
-
-    // Create switch state bitmap
-    data.byte6 = 0x0 |
-      STR_SW << 7 |
-      ON_SW << 6 |
-      ACT_UP_SW << 5 |
-      ACT_DN_SW << 4 |
-      KILL_SW << 3 |
-      ABS_SW << 2 |
-      AUX1_SW << 1 |
-      AUX2_SW << 0;
-
-    // Create flag bitmap
-    data.byte7 = 0x0 |
-      fuel_prime_flag << 7 |
-      over_temp_flag << 6 |
-      kill_car_flag << 5 |
-      kill_engine_flag << 4;
-
-    CAN_send_message(PDM_ID + 0x1, 8, data);
-    diag_state_send_tmr = millis;
-  }
+uint32_t pack_diag_state_can(uint32_t id, CAN_data* data) {
+  (void) id;
+  // Create load enablity bitmap
+  data->halfword0 = 0x0 |
+    FUEL_EN << (15 - FUEL_IDX) |
+    IGN_EN << (15 - IGN_IDX) |
+    INJ_EN << (15 - INJ_IDX) |
+    ABS_EN << (15 - ABS_IDX) |
+    PDLU_EN << (15 - PDLU_IDX) |
+    PDLD_EN << (15 - PDLD_IDX) |
+    FAN_EN << (15 - FAN_IDX) |
+    WTR_EN << (15 - WTR_IDX) |
+    ECU_EN << (15 - ECU_IDX) |
+    AUX_EN << (15 - AUX_IDX) |
+    BVBAT_EN << (15 - BVBAT_IDX) |
+    STR_EN << (15 - STR_IDX);
+
+  // Create load peak mode bitmap
+  data->halfword1 = 0x0 |
+    peak_state[FUEL_IDX] << (15 - FUEL_IDX) |
+    peak_state[IGN_IDX] << (15 - IGN_IDX) |
+    peak_state[INJ_IDX] << (15 - INJ_IDX) |
+    peak_state[ABS_IDX] << (15 - ABS_IDX) |
+    peak_state[PDLU_IDX] << (15 - PDLU_IDX) |
+    peak_state[PDLD_IDX] << (15 - PDLD_IDX) |
+    peak_state[FAN_IDX] << (15 - FAN_IDX) |
+    peak_state[WTR_IDX] << (15 - WTR_IDX) |
+    peak_state[ECU_IDX] << (15 - ECU_IDX) |
+    peak_state[AUX_IDX] << (15 - AUX_IDX) |
+    peak_state[BVBAT_IDX] << (15 - BVBAT_IDX) |
+    peak_state[STR_IDX] << (15 - STR_IDX);
+
+  data->halfword2 = total_current_draw;
+
+  // Create switch state bitmap
+  data->byte6 = 0x0 |
+    STR_SW << 7 |
+    ON_SW << 6 |
+    ACT_UP_SW << 5 |
+    ACT_DN_SW << 4 |
+    KILL_SW << 3 |
+    ABS_SW << 2 |
+    AUX1_SW << 1 |
+    AUX2_SW << 0;
+
+  // Create flag bitmap
+  data->byte7 = 0x0 |
+    fuel_prime_flag << 7 |
+    over_temp_flag << 6 |
+    kill_car_flag << 5 |
+    kill_engine_flag << 4;
+
+  return 8;
 }
 
 /**
- * void send_rail_volt_can(void)
+ * uint32_t pack_rail_volt_can(uint32_t id, CAN_data* data)
  *
- * If the interval has passed, samples rail voltages and sends related CAN
- * messages.
+ * Packs the sampled rail voltages for the scheduler.
  */
-void send_rail_volt_can(void) {
-  if(millis - rail_volt_send_tmr >= RAIL_VOLT_SEND) {
-    CAN_data rail_voltage_data = {0};
-    rail_voltage_data.halfword0 = rail_vbat;
-    rail_voltage_data.halfword1 = rail_12v;
-    rail_voltage_data.halfword2 = rail_5v;
-    rail_voltage_data.halfword3 = rail_3v3;
-    CAN_send_message(PDM_ID + 2, 8, rail_voltage_data);
-
-    rail_volt_send_tmr = millis;
-  }
+uint32_t pack_rail_volt_can(uint32_t id, CAN_data* data) {
+  (void) id;
+  data->halfword0 = rail_vbat;
+  data->halfword1 = rail_12v;
+  data->halfword2 = rail_5v;
+  data->halfword3 = rail_3v3;
+  return 8;
 }
 
 /**
- * void send_load_current_can(void)
+ * uint32_t pack_load_current_can(uint32_t id, CAN_data* data)
  *
- * If the interval has passed, samples current draw for each load and sends
- * related CAN messages.
+ * Packs the current draw of four of the loads for the scheduler, which four
+ * depending on <id>.
  */
-void send_load_current_can(void) {
-  if(millis - load_current_send_tmr >= LOAD_CUR_SEND) {
-    CAN_data load_current_data = {0};
-
-    load_current_data.halfword0 = load_current[FUEL_IDX];
-    load_current_data.halfword1 = load_current[IGN_IDX];
-    load_current_data.halfword2 = load_current[INJ_IDX];
-    load_current_data.halfword3 = load_current[ABS_IDX];
-    CAN_send_message(PDM_ID + 3, 8, load_current_data);
-
-    load_current_data.doubleword = 0;
-    load_current_data.halfword0 = load_current[PDLU_IDX];
-    load_current_data.halfword1 = load_current[PDLD_IDX];
-    load_current_data.halfword2 = load_current[FAN_IDX];
-    load_current_data.halfword3 = load_current[WTR_IDX];
-    CAN_send_message(PDM_ID + 4, 8, load_current_data);
-
-    load_current_data.doubleword = 0;
-    load_current_data.halfword0 = load_current[ECU_IDX];
-    load_current_data.halfword1 = load_current[AUX_IDX];
-    load_current_data.halfword2 = load_current[BVBAT_IDX];
-    load_current_data.halfword3 = load_current[STR_IDX];
-    CAN_send_message(PDM_ID + 5, 8, load_current_data);
-
-    load_current_send_tmr = millis;
+uint32_t pack_load_current_can(uint32_t id, CAN_data* data) {
+  switch (id - PDM_ID) {
+    case 0x3:
+      data->halfword0 = load_current[FUEL_IDX];
+      data->halfword1 = load_current[IGN_IDX];
+      data->halfword2 = load_current[INJ_IDX];
+      data->halfword3 = load_current[ABS_IDX];
+      break;
+    case 0x4:
+      data->halfword0 = load_current[PDLU_IDX];
+      data->halfword1 = load_current[PDLD_IDX];
+      data->halfword2 = load_current[FAN_IDX];
+      data->halfword3 = load_current[WTR_IDX];
+      break;
+    default:
+      data->halfword0 = load_current[ECU_IDX];
+      data->halfword1 = load_current[AUX_IDX];
+      data->halfword2 = load_current[BVBAT_IDX];
+      data->halfword3 = load_current[STR_IDX];
+      break;
   }
+  return 8;
 }
 
 /**
- * void send_cutoff_values_can(void)
+ * uint16_t cutoff_can_scl(uint8_t wiper)
  *
- * If the interval has passed, send current values of peak and normal mode
- *  current cutoff.
+ * @returns The current cutoff set by rheostat wiper value <wiper>, scaled for
+ *     CAN
+ */
+uint16_t cutoff_can_scl(uint8_t wiper) {
+  double cutoff = (4.7 / wpr_to_res(wiper)) * CUR_RATIO;
+  return (uint16_t) (cutoff * SCL_INV_CUT);
+}
+
+/**
+ * uint32_t pack_cutoff_values_can(uint32_t id, CAN_data* data)
  *
- * @param override - Whether to override the interval
+ * Packs current values of peak and normal mode current cutoff for the
+ * scheduler, which loads depending on <id>.
  */
-void send_cutoff_values_can(uint8_t override) {
-  if ((millis - cutoff_send_tmr >= CUTOFF_VAL_SEND) || override) {
-    CAN_data cutoff_value_data = {0};
-
-    double fuel_cutoff = (4.7 / wpr_to_res(wiper_values[FUEL_IDX])) * CUR_RATIO;
-    uint16_t fuel_cutoff_scl = (uint16_t) (fuel_cutoff * SCL_INV_CUT);
-    double ign_cutoff = (4.7 / wpr_to_res(wiper_values[IGN_IDX])) * CUR_RATIO;
-    uint16_t ign_cutoff_scl = (uint16_t) (ign_cutoff * SCL_INV_CUT);
-    double inj_cutoff = (4.7 / wpr_to_res(wiper_values[INJ_IDX])) * CUR_RATIO;
-    uint16_t inj_cutoff_scl = (uint16_t) (inj_cutoff * SCL_INV_CUT);
-    double abs_cutoff = (4.7 / wpr_to_res(wiper_values[ABS_IDX])) * CUR_RATIO;
-    uint16_t abs_cutoff_scl = (uint16_t) (abs_cutoff * SCL_INV_CUT);
-
-    cutoff_value_data.doubleword = 0;
-    cutoff_value_data.halfword0 = fuel_cutoff_scl;
-    cutoff_value_data.halfword1 = ign_cutoff_scl;
-    cutoff_value_data.halfword2 = inj_cutoff_scl;
-    cutoff_value_data.halfword3 = abs_cutoff_scl;
-    CAN_send_message(PDM_ID + 0x6, 8, cutoff_value_data);
-
-    double pdlu_cutoff = (4.7 / wpr_to_res(wiper_values[PDLU_IDX])) * CUR_RATIO;
-    uint16_t pdlu_cutoff_scl = (uint16_t) (pdlu_cutoff * SCL_INV_CUT);
-    double pdld_cutoff = (4.7 / wpr_to_res(wiper_values[PDLD_IDX])) * CUR_RATIO;
-    uint16_t pdld_cutoff_scl = (uint16_t) (pdld_cutoff * SCL_INV_CUT);
-    double fan_cutoff = (4.7 / wpr_to_res(wiper_values[FAN_IDX])) * CUR_RATIO;
-    uint16_t fan_cutoff_scl = (uint16_t) (fan_cutoff * SCL_INV_CUT);
-    double wtr_cutoff = (4.7 / wpr_to_res(wiper_values[WTR_IDX])) * CUR_RATIO;
-    uint16_t wtr_cutoff_scl = (uint16_t) (wtr_cutoff * SCL_INV_CUT);
-
-    cutoff_value_data.doubleword = 0;
-    cutoff_value_data.halfword0 = pdlu_cutoff_scl;
-    cutoff_value_data.halfword1 = pdld_cutoff_scl;
-    cutoff_value_data.halfword2 = fan_cutoff_scl;
-    cutoff_value_data.halfword3 = wtr_cutoff_scl;
-    CAN_send_message(PDM_ID + 0x7, 8, cutoff_value_data);
-
-    double ecu_cutoff = (4.7 / wpr_to_res(wiper_values[ECU_IDX])) * CUR_RATIO;
-    uint16_t ecu_cutoff_scl = (uint16_t) (ecu_cutoff * SCL_INV_CUT);
-    double aux_cutoff = (4.7 / wpr_to_res(wiper_values[AUX_IDX])) * CUR_RATIO;
-    uint16_t aux_cutoff_scl = (uint16_t) (aux_cutoff * SCL_INV_CUT);
-    double bvbat_cutoff = (4.7 / wpr_to_res(wiper_values[BVBAT_IDX])) * CUR_RATIO;
-    uint16_t bvbat_cutoff_scl = (uint16_t) (bvbat_cutoff * SCL_INV_CUT);
-
-    cutoff_value_data.doubleword = 0;
-    cutoff_value_data.halfword0 = ecu_cutoff_scl;
-    cutoff_value_data.halfword1 = aux_cutoff_scl;
-    cutoff_value_data.halfword2 = bvbat_cutoff_scl;
-    CAN_send_message(PDM_ID + 0x8, 6, cutoff_value_data);
-
-    double fuel_peak_cutoff = (4.7 / wpr_to_res(peak_wiper_values[FUEL_IDX])) * CUR_RATIO;
-    uint16_t fuel_peak_cutoff_scl = (uint16_t) (fuel_peak_cutoff * SCL_INV_CUT);
-    double fan_peak_cutoff = (4.7 / wpr_to_res(peak_wiper_values[FAN_IDX])) * CUR_RATIO;
-    uint16_t fan_peak_cutoff_scl = (uint16_t) (fan_peak_cutoff * SCL_INV_CUT);
-    double wtr_peak_cutoff = (4.7 / wpr_to_res(peak_wiper_values[WTR_IDX])) * CUR_RATIO;
-    uint16_t wtr_peak_cutoff_scl = (uint16_t) (wtr_peak_cutoff * SCL_INV_CUT);
-    double ecu_peak_cutoff = (4.7 / wpr_to_res(peak_wiper_values[ECU_IDX])) * CUR_RATIO;
-    uint16_t ecu_peak_cutoff_scl = (uint16_t) (ecu_peak_cutoff * SCL_INV_CUT);
-
-    cutoff_value_data.doubleword = 0;
-    cutoff_value_data.halfword0 = fuel_peak_cutoff_scl;
-    cutoff_value_data.halfword1 = fan_peak_cutoff_scl;
-    cutoff_value_data.halfword2 = wtr_peak_cutoff_scl;
-    cutoff_value_data.halfword3 = ecu_peak_cutoff_scl;
-    CAN_send_message(PDM_ID + 0x9, 8, cutoff_value_data);
-
-    cutoff_send_tmr = millis;
+uint32_t pack_cutoff_values_can(uint32_t id, CAN_data* data) {
+  switch (id - PDM_ID) {
+    case 0x6:
+      data->halfword0 = cutoff_can_scl(wiper_values[FUEL_IDX]);
+      data->halfword1 = cutoff_can_scl(wiper_values[IGN_IDX]);
+      data->halfword2 = cutoff_can_scl(wiper_values[INJ_IDX]);
+      data->halfword3 = cutoff_can_scl(wiper_values[ABS_IDX]);
+      return 8;
+    case 0x7:
+      data->halfword0 = cutoff_can_scl(wiper_values[PDLU_IDX]);
+      data->halfword1 = cutoff_can_scl(wiper_values[PDLD_IDX]);
+      data->halfword2 = cutoff_can_scl(wiper_values[FAN_IDX]);
+      data->halfword3 = cutoff_can_scl(wiper_values[WTR_IDX]);
+      return 8;
+    case 0x8:
+      data->halfword0 = cutoff_can_scl(wiper_values[ECU_IDX]);
+      data->halfword1 = cutoff_can_scl(wiper_values[AUX_IDX]);
+      data->halfword2 = cutoff_can_scl(wiper_values[BVBAT_IDX]);
+      return 6;
+    default:
+      data->halfword0 = cutoff_can_scl(peak_wiper_values[FUEL_IDX]);
+      data->halfword1 = cutoff_can_scl(peak_wiper_values[FAN_IDX]);
+      data->halfword2 = cutoff_can_scl(peak_wiper_values[WTR_IDX]);
+      data->halfword3 = cutoff_can_scl(peak_wiper_values[ECU_IDX]);
+      return 8;
   }
 }
 
 /**
- * void send_overcrt_count_can(void)
+ * uint32_t pack_overcrt_count_can(uint32_t id, CAN_data* data)
  *
- * If the interval has passed or the caller overrode the check, send out the
- * overcurrent count of all loads on CAN.
- *
- * @param override - Whether to override the interval
+ * Packs the overcurrent count of the loads for the scheduler, which loads
+ * depending on <id>. Sent early with CAN_sched_trigger() on an overcurrent.
  */
-void send_overcrt_count_can(uint8_t override) {
-  if ((millis - overcrt_count_send_tmr >= OVERCRT_COUNT_SEND) || override) {
-    CAN_data data = {0};
-
-    data.byte0 = overcurrent_count[FUEL_IDX];
-    data.byte1 = overcurrent_count[IGN_IDX];
-    data.byte2 = overcurrent_count[INJ_IDX];
-    data.byte3 = overcurrent_count[ABS_IDX];
-    data.byte4 = overcurrent_count[PDLU_IDX];
-    data.byte5 = overcurrent_count[PDLD_IDX];
-    data.byte6 = overcurrent_count[FAN_IDX];
-    data.byte7 = overcurrent_count[WTR_IDX];
-    CAN_send_message(PDM_ID + 0xA, 8, data);
-
-    data.byte0 = overcurrent_count[ECU_IDX];
-    data.byte1 = overcurrent_count[AUX_IDX];
-    data.byte2 = overcurrent_count[BVBAT_IDX];
-    data.byte3 = overcurrent_count[STR_IDX];
-    CAN_send_message(PDM_ID + 0xB, 4, data);
-
-    overcrt_count_send_tmr = millis;
+uint32_t pack_overcrt_count_can(uint32_t id, CAN_data* data) {
+  if (id == PDM_ID + 0xA) {
+    data->byte0 = overcurrent_count[FUEL_IDX];
+    data->byte1 = overcurrent_count[IGN_IDX];
+    data->byte2 = overcurrent_count[INJ_IDX];
+    data->byte3 = overcurrent_count[ABS_IDX];
+    data->byte4 = overcurrent_count[PDLU_IDX];
+    data->byte5 = overcurrent_count[PDLD_IDX];
+    data->byte6 = overcurrent_count[FAN_IDX];
+    data->byte7 = overcurrent_count[WTR_IDX];
+    return 8;
   }
+
+  data->byte0 = overcurrent_count[ECU_IDX];
+  data->byte1 = overcurrent_count[AUX_IDX];
+  data->byte2 = overcurrent_count[BVBAT_IDX];
+  data->byte3 = overcurrent_count[STR_IDX];
+  return 4;
 }
 
 //========================== UTILITY FUNCTIONS =================================
@@ -13,6 +13,7 @@
 #include "../FSAE.X/FSAE_config.h"
 #include "../FSAE.X/FSAE_can.h"
 #include "../FSAE.X/FSAE_adc.h"
+#include "../FSAE.X/FSAE_boot.h"
 #include "../FSAE.X/FSAE_spi.h"
 #include "../FSAE.X/FSAE_ad7490.h"
 #include "../FSAE.X/FSAE_rheo.h"
@@ -66,6 +67,7 @@
 #define PDL_MAX_DUR        500
 #define OVERRIDE_SW_WAIT   5000
 #define BASIC_CONTROL_WAIT 1000
+#define PARKED_WAIT        1000 // ECU silence before updates are allowed
 #define MAX_IDLE_TIME      300000 // 5 mins
 
 #define TEMP_SAMP_INTV     333
@@ -328,7 +330,12 @@ const uint8_t ADC_CHN[NUM_LOADS] = {
 void main(void);
 
 // Logic functions
-void process_CAN_msg(CAN_message msg);
+void process_motec0_msg(CAN_message msg);
+void process_motec1_msg(CAN_message msg);
+void process_motec2_msg(CAN_message msg);
+void process_wheel1_msg(CAN_message msg);
+void process_isotp_msg(CAN_message msg);
+uint8_t boot_parked(void);
 void debounce_switches(void);
 void check_peak_timer(void);
 void check_load_overcurrent(void);
@@ -338,13 +345,14 @@ void prevent_engine_blowup(void);
 void sample_temp(void);
 void sample_ext_adc(void);
 
-// CAN message sending functions
-void send_diag_can(void);
-void send_diag_state_can(uint8_t override);
-void send_rail_volt_can(void);
-void send_load_current_can(void);
-void send_cutoff_values_can(uint8_t override);
-void send_overcrt_count_can(uint8_t override);
+// CAN message packing functions
+uint32_t pack_diag_can(uint32_t id, CAN_data* data);
+uint32_t pack_diag_state_can(uint32_t id, CAN_data* data);
+uint32_t pack_rail_volt_can(uint32_t id, CAN_data* data);
+uint32_t pack_load_current_can(uint32_t id, CAN_data* data);
+uint16_t cutoff_can_scl(uint8_t wiper);
+uint32_t pack_cutoff_values_can(uint32_t id, CAN_data* data);
+uint32_t pack_overcrt_count_can(uint32_t id, CAN_data* data);
 
 // Utility functions
 void enable_load(uint8_t load_idx);
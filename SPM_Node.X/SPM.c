@@ -9,8 +9,6 @@ uint8_t thermocouple_fault = 0;
 uint16_t digital_channels = 0;
 SPIConn *digital_connections[3] = {0};
 volatile uint32_t millis = 0;
-uint32_t canAnalogMillis = 0;
-uint32_t canThermocoupleMillis = 0;
 
 void main(void){
   init_general();// Set general runtime configuration bits
@@ -20,44 +18,43 @@ void main(void){
   init_adcs();// Initialize all of the ADC's
   init_tcouples(); // Initialize all max31855 thermocouple readers
 
+  // Spread the channel messages over the send interval instead of a burst
+  int i;
+  for(i = 0;i<9;i++){
+    CAN_sched_add(SPM_ID + i + 1, CAN_SEND_INTV, CAN_SCHED_AUTO, packAnalogChannels);
+  }
+  CAN_sched_add(SPM_ID + 10, CAN_SEND_INTV, CAN_SCHED_AUTO, packThermocouples);
+  CAN_sched_add(SPM_ID + 11, CAN_SEND_INTV, CAN_SCHED_AUTO, packThermocouples);
+
   while(1){
     update_analog_channels();
     update_thermocouples();
     update_digital_channels();
 
-    if(millis-canAnalogMillis > 50){
-      CANAnalogChannels();
-      CANThermocouples();
-      canAnalogMillis = millis;
-      canThermocoupleMillis = millis;
-    }
+    CAN_sched_service();
   }
 }
 
-void CANAnalogChannels(void){
-  CAN_data data = {0};
-  int i;
-  for(i = 0;i<9;i++){
-    data.halfword0 = (uint16_t) (analog_channels[i*4]*ANALOG_CAN_SCL);
-    data.halfword1 = (uint16_t) (analog_channels[(i*4)+1]*ANALOG_CAN_SCL);
-    data.halfword2 = (uint16_t) (analog_channels[(i*4)+2]*ANALOG_CAN_SCL);
-    data.halfword3 = (uint16_t) (analog_channels[(i*4)+3]*ANALOG_CAN_SCL);
-    CAN_send_message(SPM_ID + i + 1, 8, data);
-  }
+uint32_t packAnalogChannels(uint32_t id, CAN_data * data){
+  int i = id - SPM_ID - 1;
+  data->halfword0 = (uint16_t) (analog_channels[i*4]*ANALOG_CAN_SCL);
+  data->halfword1 = (uint16_t) (analog_channels[(i*4)+1]*ANALOG_CAN_SCL);
+  data->halfword2 = (uint16_t) (analog_channels[(i*4)+2]*ANALOG_CAN_SCL);
+  data->halfword3 = (uint16_t) (analog_channels[(i*4)+3]*ANALOG_CAN_SCL);
+  return 8;
 }
 
-void CANThermocouples(void){
-  CAN_data data = {};
-
-  data.halfword0 = (int16_t) (thermocouple_channels[0]*THERMOCOUPLE_CAN_SCL);
-  data.halfword1 = (int16_t) (thermocouple_channels[1]*THERMOCOUPLE_CAN_SCL);
-  data.halfword2 = (int16_t) (thermocouple_channels[2]*THERMOCOUPLE_CAN_SCL);
-  data.halfword3 = (int16_t) (thermocouple_channels[3]*THERMOCOUPLE_CAN_SCL);
-
-  CAN_send_message(SPM_ID + 10, 8, data);
+uint32_t packThermocouples(uint32_t id, CAN_data * data){
+  if(id == SPM_ID + 10){
+    data->halfword0 = (int16_t) (thermocouple_channels[0]*THERMOCOUPLE_CAN_SCL);
+    data->halfword1 = (int16_t) (thermocouple_channels[1]*THERMOCOUPLE_CAN_SCL);
+    data->halfword2 = (int16_t) (thermocouple_channels[2]*THERMOCOUPLE_CAN_SCL);
+    data->halfword3 = (int16_t) (thermocouple_channels[3]*THERMOCOUPLE_CAN_SCL);
+    return 8;
+  }
 
-  data.halfword0 = (int16_t) (thermocouple_channels[0]*THERMOCOUPLE_CAN_SCL);
-  data.halfword1 = (int16_t) (thermocouple_channels[1]*THERMOCOUPLE_CAN_SCL);
+  data->halfword0 = (int16_t) (thermocouple_channels[0]*THERMOCOUPLE_CAN_SCL);
+  data->halfword1 = (int16_t) (thermocouple_channels[1]*THERMOCOUPLE_CAN_SCL);
 
   double acc = 0;
   int i;
@@ -65,13 +62,12 @@ void CANThermocouples(void){
     acc += thermocouple_junctions[i];
   }
 
-  data.halfword2 = (int16_t) ((acc/6.0)*JUNCTION_CAN_SCL);
-  data.halfword3 = thermocouple_fault;
-
-  CAN_send_message(SPM_ID + 11, 8, data);
+  data->halfword2 = (int16_t) ((acc/6.0)*JUNCTION_CAN_SCL);
+  data->halfword3 = thermocouple_fault;
+  return 8;
 }
 
-void __attribute__((vector(_TIMER_2_VECTOR), interrupt(IPL6SRS))) timer2_inthnd(void) {
+void ISR(_TIMER_2_VECTOR, IPL6SRS) timer2_inthnd(void) {
   millis++;// Increment millis count
 
   IFS0CLR = _IFS0_T2IF_MASK;// Clear TMR2 Interrupt Flag
@@ -66,6 +66,8 @@
 #define THERMOCOUPLE_CAN_SCL  4
 #define JUNCTION_CAN_SCL      16
 
+#define CAN_SEND_INTV         50
+
 #define MCP23S17_0_CS_TRIS      TRISAbits.TRISA15
 #define MCP23S17_1_CS_TRIS      TRISAbits.TRISA4
 #define MCP23S17_2_CS_TRIS      TRISAbits.TRISA3
@@ -126,8 +128,8 @@ void set_pga(uint8_t chan, uint8_t level);
 void set_freq_div(uint8_t chan, uint8_t div);
 uint16_t ad7680_read_spi();
 
-void CANAnalogChannels(void);
-void CANThermocouples(void);
+uint32_t packAnalogChannels(uint32_t id, CAN_data * data);
+uint32_t packThermocouples(uint32_t id, CAN_data * data);
 
 uint16_t set_bit_val(uint16_t current, uint8_t pos, uint8_t val);
 
@@ -9,7 +9,7 @@
 #include "Wheel.h"
 
 // Count number of milliseconds since start of code execution
-volatile uint32_t CANswStateMillis, CANswADLMillis, CANdiagMillis, checkDisplayMillis;
+volatile uint32_t checkDisplayMillis;
 volatile uint8_t nightModeState;
 volatile uint8_t auxState;
 uint32_t temp_samp_tmr = 0;
@@ -17,7 +17,12 @@ uint32_t temp_samp_tmr = 0;
 int16_t pcb_temp = 0; // PCB temperature reading in units of [C/0.005]
 int16_t junc_temp = 0; // Junction temperature reading in units of [C/0.005]
 
+// Firmware updates over CAN
+ISOTP_link boot_link;
+uint8_t boot_req[BOOT_REQ_HDR + BOOT_BLOCK_MAX];
+
 void main(void) {
+  BOOT_select(); // Start a newly updated image if there is one
   init_general();// Set general runtime configuration bits
   init_gpio_pins();// Set all I/O pins to low outputs
   init_oscillator(1);// Initialize oscillator configuration bits
@@ -30,7 +35,7 @@ void main(void) {
   STI();// Enable interrupts
 
   millis = 0;
-  CANswStateMillis = CANswADLMillis = CANdiagMillis = checkDisplayMillis = 0;
+  checkDisplayMillis = 0;
   auxState = 0;
   auxNumber = 0;
   warnCount = 0;
@@ -84,7 +89,20 @@ void main(void) {
   // Initialize All the data streams
   initDataItems();
   updateSwVals();
+
+  // Subscribe to every message shown on the display
+  CAN_subscribe(MOTEC_ID, 8, process_motec_msg, CAN_NORMAL);
+  CAN_subscribe(GCM_ID, 3, process_gcm_msg, CAN_NORMAL);
+  CAN_subscribe(PDM_ID, 12, process_pdm_msg, CAN_NORMAL);
+  CAN_subscribe(TIRE_TEMP_FL_ID, 4, process_tire_temp_msg, CAN_NORMAL);
+  CAN_subscribe(SPM_ID, 14, process_spm_msg, CAN_NORMAL);
+  CAN_subscribe(WHEEL_ID + ISOTP_REQ_OFFSET, 1, process_isotp_msg, CAN_NORMAL);
+  ISOTP_init(&boot_link, WHEEL_ID + ISOTP_RESP_OFFSET, WHEEL_ID + ISOTP_REQ_OFFSET,
+      boot_req, sizeof(boot_req), BOOT_request, NULL);
   init_can();
+  CAN_health_init(WHEEL_ID + HEALTH_ID_OFFSET);
+  CAN_sched_add(WHEEL_ID + 0x0, CAN_DIAG_FREQ, CAN_SCHED_AUTO, packDiag);
+  CAN_sched_add(ADL_ID, CAN_SW_ADL_FREQ, CAN_SCHED_AUTO, packSwitchADL);
   initAllScreens();
   nightModeState = wheelDataItems[SW_ND_IDX].value;
   initNightMode(nightModeState);
@@ -94,19 +112,10 @@ void main(void) {
   tlc5955_startup();
 
   while(1) {
-    // Send CAN messages with the correct frequency
-    if(millis - CANswStateMillis >= CAN_SW_STATE_FREQ){
-      CANswitchStates();
-      CANswStateMillis = millis;
-    }
-    if(millis - CANswADLMillis >= CAN_SW_ADL_FREQ){
-      CANswitchADL();
-      CANswADLMillis = millis;
-    }
-    if(millis - CANdiagMillis >= CAN_DIAG_FREQ){
-      CANdiag();
-      CANdiagMillis = millis;
-    }
+    CAN_sched_service(); // Send CAN messages with the correct frequency
+    CAN_health_service(); // Watch for CAN errors and recover from bus-off
+    ISOTP_service(&boot_link); // Firmware updates requested over CAN
+    BOOT_service(&boot_link);
 
     // check if display is frozen every second
     if(millis - checkDisplayMillis >= CHECK_DISPLAY_INTV){
@@ -130,7 +139,7 @@ void main(void) {
  *
  * Fires once every millisecond.
  */
-void __attribute__((vector(_TIMER_2_VECTOR), interrupt(IPL6SRS))) timer2_inthnd(void) {
+void ISR(_TIMER_2_VECTOR, IPL6SRS) timer2_inthnd(void) {
   millis++;// Increment millis count
 
   if (!(millis%25)){
@@ -138,7 +147,7 @@ void __attribute__((vector(_TIMER_2_VECTOR), interrupt(IPL6SRS))) timer2_inthnd(
       ADCCON3bits.GSWTRG = 1; // Trigger an ADC conversion
     }
     updateSwVals();
-    CANswitchStates();
+    CANswitchStates(); // Sent from here to keep to time while the display redraws
     tlc5955_check_timers();
   }
 
@@ -153,9 +162,12 @@ void delay(uint32_t num) {
 /**
  * CAN1 Interrupt Handler
  */
-void __attribute__((vector(_CAN1_VECTOR), interrupt(IPL4SRS))) can_inthnd(void) {
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
   if (C1INTbits.RBIF) {
-    CAN_recv_messages(process_CAN_msg); // Process all available CAN messages
+    CAN_dispatch_messages(); // Process all available CAN messages
+  }
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
   }
   if (C1INTbits.RBOVIF) {
     CAN_rx_ovf++;
@@ -163,11 +175,15 @@ void __attribute__((vector(_CAN1_VECTOR), interrupt(IPL4SRS))) can_inthnd(void)
   IFS4CLR = _IFS4_CAN1IF_MASK; // Clear CAN1 Interrupt Flag
 }
 
-void process_CAN_msg(CAN_message msg){
-  uint16_t * lsbArray = (uint16_t *) msg.data;
+/**
+ * void process_motec_msg(CAN_message msg)
+ *
+ * Handler for every message from the MoTeC ECU.
+ *
+ * @param msg The received CAN message
+ */
+void process_motec_msg(CAN_message msg) {
   switch (msg.id) {
-
-    /*Motec*/
     case MOTEC_ID + 0:
       updateDataItem(&motecDataItems[ENG_RPM_IDX], parseMsgMotec(&msg, ENG_RPM_BYTE, ENG_RPM_SCL));
       updateDataItem(&motecDataItems[THROTTLE_POS_IDX], parseMsgMotec(&msg, THROTTLE_POS_BYTE, THROTTLE_POS_SCL));
@@ -213,8 +229,19 @@ void process_CAN_msg(CAN_message msg){
       updateDataItem(&motecDataItems[SHIFT_FORCE_IDX], parseMsgMotec(&msg, SHIFT_FORCE_BYTE, SHIFT_FORCE_SCL));
       updateDataItem(&motecDataItems[AIR_TEMP_IDX], parseMsgMotec(&msg, AIR_TEMP_BYTE, AIR_TEMP_SCL));
       break;
+  }
+}
 
-      /*GCM*/
+/**
+ * void process_gcm_msg(CAN_message msg)
+ *
+ * Handler for every message from the GCM.
+ *
+ * @param msg The received CAN message
+ */
+void process_gcm_msg(CAN_message msg) {
+  uint16_t * lsbArray = (uint16_t *) msg.data;
+  switch (msg.id) {
     case GCM_ID:
       updateDataItem(&gcmDataItems[UPTIME_IDX], (uint16_t) (lsbArray[UPTIME_BYTE/2]) * UPTIME_SCL);
       updateDataItem(&gcmDataItems[PCB_TEMP_IDX], (int16_t) (lsbArray[PCB_TEMP_BYTE/2]) * PCB_TEMP_SCL);
@@ -234,8 +261,19 @@ void process_CAN_msg(CAN_message msg){
       updateDataItem(&gcmDataItems[QUEUE_DN_IDX], (uint8_t) (msg.data[QUEUE_DN_BYTE]) * QUEUE_DN_SCL);
       updateDataItem(&gcmDataItems[QUEUE_NT_IDX], (uint8_t) (msg.data[QUEUE_NT_BYTE]) * QUEUE_NT_SCL);
       break;
+  }
+}
 
-      /*PDM*/
+/**
+ * void process_pdm_msg(CAN_message msg)
+ *
+ * Handler for every message from the PDM.
+ *
+ * @param msg The received CAN message
+ */
+void process_pdm_msg(CAN_message msg) {
+  uint16_t * lsbArray = (uint16_t *) msg.data;
+  switch (msg.id) {
     case PDM_ID:
       updateDataItem(&pdmDataItems[UPTIME_IDX], (uint16_t) (lsbArray[UPTIME_BYTE/2]) * UPTIME_SCL);
       updateDataItem(&pdmDataItems[PCB_TEMP_IDX], (int16_t) (lsbArray[PCB_TEMP_BYTE/2]) * PCB_TEMP_SCL);
@@ -353,8 +391,19 @@ void process_CAN_msg(CAN_message msg){
       updateDataItem(&pdmDataItems[BVBAT_OC_COUNT_IDX], (uint16_t) (msg.data[BVBAT_OC_COUNT_BYTE]));
       updateDataItem(&pdmDataItems[STR_OC_COUNT_IDX], (uint16_t) (msg.data[STR_OC_COUNT_BYTE]));
       break;
+  }
+}
 
-      /*Tire Temps*/
+/**
+ * void process_tire_temp_msg(CAN_message msg)
+ *
+ * Handler for every message from the tire temperature sensors.
+ *
+ * @param msg The received CAN message
+ */
+void process_tire_temp_msg(CAN_message msg) {
+  uint16_t * lsbArray = (uint16_t *) msg.data;
+  switch (msg.id) {
     case TIRE_TEMP_FL_ID:
       updateDataItem(&tireTempDataItems[FL0_IDX], (double) (lsbArray[TIRE_TEMP_1_BYTE/2]*TIRE_TEMP_SCL));
       updateDataItem(&tireTempDataItems[FL1_IDX], (double) (lsbArray[TIRE_TEMP_2_BYTE/2]*TIRE_TEMP_SCL));
@@ -383,8 +432,19 @@ void process_CAN_msg(CAN_message msg){
       updateDataItem(&tireTempDataItems[RR3_IDX], (double) (lsbArray[TIRE_TEMP_4_BYTE/2]*TIRE_TEMP_SCL));
       updateDataItem(&tireTempDataItems[RR_IDX], (tireTempDataItems[RR0_IDX].value + tireTempDataItems[RR1_IDX].value + tireTempDataItems[RR2_IDX].value + tireTempDataItems[RR3_IDX].value)/4.0);
       break;
+  }
+}
 
-      // SPM
+/**
+ * void process_spm_msg(CAN_message msg)
+ *
+ * Handler for every message from the SPM.
+ *
+ * @param msg The received CAN message
+ */
+void process_spm_msg(CAN_message msg) {
+  uint16_t * lsbArray = (uint16_t *) msg.data;
+  switch (msg.id) {
     case SPM_ID:
       updateDataItem(&spmDataItems[UPTIME_IDX], (uint16_t) (lsbArray[UPTIME_BYTE/2]) * UPTIME_SCL);
       updateDataItem(&spmDataItems[PCB_TEMP_IDX], (int16_t) (lsbArray[PCB_TEMP_BYTE/2]) * PCB_TEMP_SCL);
@@ -494,6 +554,18 @@ void process_CAN_msg(CAN_message msg){
   }
 }
 
+/**
+ * void process_isotp_msg(CAN_message msg)
+ *
+ * Handler for frames of firmware update requests, which are run by
+ * ISOTP_service().
+ *
+ * @param msg The received CAN message
+ */
+void process_isotp_msg(CAN_message msg) {
+  ISOTP_receive(&boot_link, msg);
+}
+
 void updateDataItem(volatile dataItem * data, double value) {
   data->value = value;
   data->refreshTime = millis;
@@ -521,21 +593,21 @@ void CANswitchStates(void){
   CAN_send_message(WHEEL_ID + 0x1, 4, switchData);
 }
 
-void CANswitchADL(void){
-  CAN_data rotaries = {0};
-  rotaries.halfword0 = ADL_IDX_1_3;
-  rotaries.halfword1 = (uint16_t) wheelDataItems[ROTARY_0_IDX].value;
-  rotaries.halfword2 = (uint16_t) wheelDataItems[ROTARY_1_IDX].value;
-  rotaries.halfword3 = (uint16_t) wheelDataItems[ROTARY_2_IDX].value;
-  CAN_send_message(ADL_ID, 8, rotaries);
+uint32_t packSwitchADL(uint32_t id, CAN_data * rotaries){
+  (void) id;
+  rotaries->halfword0 = ADL_IDX_1_3;
+  rotaries->halfword1 = (uint16_t) wheelDataItems[ROTARY_0_IDX].value;
+  rotaries->halfword2 = (uint16_t) wheelDataItems[ROTARY_1_IDX].value;
+  rotaries->halfword3 = (uint16_t) wheelDataItems[ROTARY_2_IDX].value;
+  return 8;
 }
 
-void CANdiag(void){
-  CAN_data data = {0};
-  data.halfword0 = (uint16_t) (millis / 1000);
-  data.halfword1 = pcb_temp;
-  data.halfword2 = junc_temp;
-  CAN_send_message(WHEEL_ID + 0, 6, data);
+uint32_t packDiag(uint32_t id, CAN_data * data){
+  (void) id;
+  data->halfword0 = (uint16_t) (millis / 1000);
+  data->halfword1 = pcb_temp;
+  data->halfword2 = junc_temp;
+  return 6;
 }
 
 double parseMsgMotec(CAN_message * msg, uint8_t byte, double scl){
@@ -13,6 +13,7 @@
 #include "../FSAE.X/FSAE_config.h"
 #include "../FSAE.X/FSAE_can.h"
 #include "../FSAE.X/FSAE_adc.h"
+#include "../FSAE.X/FSAE_boot.h"
 #include "../FSAE.X/FSAE_tlc5955.h"
 #include "../FSAE.X/CAN.h"
 #include "RA8875_driver.h"
@@ -73,7 +74,6 @@
 #define MOM3_PORT       PORTBbits.RB5
 #define MOM3_ANSEL      ANSELBbits.ANSB5
 
-#define CAN_SW_STATE_FREQ 100
 #define CAN_SW_ADL_FREQ   500
 #define CAN_DIAG_FREQ     1000
 #define TEMP_SAMP_INTV    333
@@ -84,11 +84,16 @@ uint8_t warnCount;
 
 void main(void);
 void delay(uint32_t num);
-void process_CAN_msg(CAN_message msg);
+void process_motec_msg(CAN_message msg);
+void process_gcm_msg(CAN_message msg);
+void process_pdm_msg(CAN_message msg);
+void process_tire_temp_msg(CAN_message msg);
+void process_spm_msg(CAN_message msg);
+void process_isotp_msg(CAN_message msg);
 double parseMsgMotec(CAN_message * msg, uint8_t byte, double scl);
 void CANswitchStates(void);
-void CANswitchADL(void);
-void CANdiag(void);
+uint32_t packSwitchADL(uint32_t id, CAN_data * rotaries);
+uint32_t packDiag(uint32_t id, CAN_data * data);
 void updateSwVals(void);
 uint8_t getRotaryPosition(uint32_t adcValue);
 void checkChangeScreen(void);
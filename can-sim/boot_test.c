@@ -0,0 +1,79 @@
+/**
+ * Firmware Update Test Node
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs as a node under canbus with the base ID given in hex and takes
+ * firmware updates over ISO-TP, restarting into each new image as a real node
+ * does. Its simulated flash is kept across those restarts. Exits once it is
+ * running an updated image and the bus has been quiet for IDLE_MS. Run with
+ * canflash to test both ends of an update.
+ *
+ * Usage: boot_test BASE
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "CAN.h"
+#include "FSAE_boot.h"
+#include "FSAE_can.h"
+#include "FSAE_isotp.h"
+
+#define IDLE_MS 2000
+
+// Defined for FSAE_can, driven from the main loop here
+volatile uint32_t millis = 0;
+
+static ISOTP_link tp;
+static uint8_t buf[BOOT_REQ_HDR + BOOT_BLOCK_MAX];
+static volatile uint32_t last_frame = 0;
+
+static void on_frame(CAN_message msg) {
+  last_frame = millis;
+  ISOTP_receive(&tp, msg);
+}
+
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
+  if (C1INTbits.RBIF) {
+    CAN_dispatch_messages();
+  }
+
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
+  }
+
+  IFS4CLR = _IFS4_CAN1IF_MASK; // Clear CAN1 Interrupt Flag
+}
+
+int main(int argc, char* argv[]) {
+  const BOOT_trailer* running;
+  uint32_t base;
+
+  BOOT_select();
+
+  if (argc != 2) {
+    fprintf(stderr, "Usage: boot_test BASE\n");
+    return 2;
+  }
+  base = (uint32_t) strtoul(argv[1], NULL, 16);
+  running = (const BOOT_trailer*) PA_TO_KVA1(BOOT_LOWER + BOOT_IMAGE_MAX);
+
+  ISOTP_init(&tp, base + ISOTP_RESP_OFFSET, base + ISOTP_REQ_OFFSET, buf,
+      sizeof(buf), BOOT_request, NULL);
+  CAN_subscribe(base + ISOTP_REQ_OFFSET, 1, on_frame, CAN_NORMAL);
+  init_can();
+  STI();
+
+  millis = (uint32_t) (host_micros() / 1000);
+  last_frame = millis;
+  while (running->magic != BOOT_MAGIC || millis - last_frame < IDLE_MS) {
+    millis = (uint32_t) (host_micros() / 1000);
+    ISOTP_service(&tp);
+    BOOT_service(&tp);
+  }
+
+  printf("%03X running image %u of %u bytes, CRC32 %08X, %u errors\n", base,
+      running->seq, running->size, running->crc, tp.errors);
+  return 0;
+}
@@ -0,0 +1,215 @@
+/**
+ * Fixed Point CAN Extraction Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs on its own. Decodes every 1 and 2 byte raw value, in both byte orders
+ * and signed and unsigned, with the scalars and offsets the nodes use, and
+ * random and edge 4 byte values, through CAN_extract_q16() and
+ * CAN_extract_scaled() as well as the double CAN_extract_numeric(). Passes if
+ * the Q16.16 results are within the rounding of their scalar, the scaled ones
+ * truncate the same value, both saturate where the double leaves their range,
+ * and random full range scalars and offsets, which can overflow a 64 bit
+ * product, saturate instead of wrapping.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "FSAE_can.h"
+#include "CAN.h"
+
+#define RANDOM_4_BYTE 1000000
+#define RANDOM_FULL   1000000
+#define SEED          2016
+
+// Required by FSAE_can for receive timestamps, which are unused here
+volatile uint32_t millis = 0;
+
+// A scalar, its offset and the num / den that gives the value in 1 / mult
+typedef struct {
+  const char* name;
+  double scl;
+  int32_t off;
+  int32_t num;
+  int32_t den;
+  int32_t mult;
+} Scale;
+
+static const Scale scales[] = {
+  {"ENG_RPM", ENG_RPM_SCL, 0, 1, 1, 1},
+  {"THROTTLE_POS", THROTTLE_POS_SCL, 0, 1, 1, 10},
+  {"LAMBDA", LAMBDA_SCL, 0, 1, 1, 1000},
+  {"PCB_TEMP", PCB_TEMP_SCL, 0, 1, 2, 100},
+  {"TEMP", TEMP_SCL, -4000, 1, 1, 100},
+  {"CPSP", CPSP_SCL, 100, 1, 10, 100},
+  {"PTDP", PTDP_SCL, 0, 1, 2, 1000},
+  {"UPTIME", UPTIME_SCL, 32768, 1, 1, 1},
+};
+#define SCALES (sizeof(scales) / sizeof(scales[0]))
+
+static uint32_t checked = 0;
+static uint32_t failures = 0;
+
+/**
+ * void put_field(uint8_t* data, uint8_t length, Endian endianness, uint32_t raw)
+ *
+ * Stores the low <length> bytes of <raw> at the start of <data>.
+ */
+static void put_field(uint8_t* data, uint8_t length, Endian endianness, uint32_t raw) {
+  uint8_t i;
+  for (i = 0; i < length; i++) {
+    uint8_t byte = (uint8_t) (raw >> (8 * i));
+    data[endianness == BIG ? length - 1 - i : i] = byte;
+  }
+}
+
+static void fail(const Scale* scale, uint8_t length, Endian endianness, uint8_t sgn,
+    uint32_t raw, const char* what, double got, double expected) {
+  if (failures++ < 10) {
+    printf("%s %u byte %s %s raw 0x%X: %s %f, double %f\n", scale->name, length,
+        endianness == BIG ? "big" : "little", sgn ? "signed" : "unsigned", raw, what,
+        got, expected);
+  }
+}
+
+/**
+ * void check(const Scale* scale, uint8_t length, Endian endianness, uint8_t sgn,
+ *     uint32_t raw)
+ *
+ * Decodes <raw> each way with <scale> and compares them against the double.
+ */
+static void check(const Scale* scale, uint8_t length, Endian endianness, uint8_t sgn,
+    uint32_t raw) {
+  uint8_t data[8] = {0};
+  put_field(data, length, endianness, raw);
+  checked++;
+
+  double expected = CAN_extract_numeric(data, 0, length, endianness, sgn, scale->scl,
+      scale->off);
+  int64_t field = sgn ? (int64_t) CAN_extract_raw(data, 0, length, endianness, sgn) :
+    (int64_t) CAN_parse_bytes(data, 0, length, endianness);
+  double diff = fabs((double) (field - scale->off));
+
+  // Q16.16, off by at most the rounding of scl, or saturated
+  q16_t q16 = CAN_extract_q16(data, 0, length, endianness, sgn, Q16(scale->scl),
+      scale->off);
+  double bound = diff / 131072.0 + 1e-9;
+  double got = (double) q16 / Q16_ONE;
+  if (q16 == INT32_MAX || q16 == INT32_MIN) {
+    if ((q16 == INT32_MAX ? expected : -expected) < 32768.0 - bound - 1.0 / Q16_ONE) {
+      fail(scale, length, endianness, sgn, raw, "q16 saturated at", got, expected);
+    }
+  } else if (fabs(got - expected) > bound) {
+    fail(scale, length, endianness, sgn, raw, "q16", got, expected);
+  }
+
+  // Scaled, the same value truncated toward zero in 1 / mult, or saturated
+  int32_t scaled = CAN_extract_scaled(data, 0, length, endianness, sgn, scale->num,
+      scale->den, scale->off);
+  double want = expected * scale->mult;
+  if (fabs(want) >= 2147483648.0) {
+    if (scaled != (want > 0 ? INT32_MAX : INT32_MIN)) {
+      fail(scale, length, endianness, sgn, raw, "scaled", scaled, want);
+    }
+  } else if (fabs(scaled - trunc(want)) > (fabs(want - round(want)) < 1e-6 ? 1 : 0)) {
+    // A value within rounding of a whole number may truncate either way
+    fail(scale, length, endianness, sgn, raw, "scaled", scaled, want);
+  }
+}
+
+/**
+ * int32_t random_int32(void)
+ *
+ * @returns Any int32_t, with the extremes as likely as anything else
+ */
+static int32_t random_int32(void) {
+  switch (rand() % 8) {
+    case 0:
+      return INT32_MAX;
+    case 1:
+      return INT32_MIN;
+    case 2:
+      return rand() % 2001 - 1000;
+    default:
+      return (int32_t) (((uint32_t) rand() << 16) ^ (uint32_t) rand());
+  }
+}
+
+/**
+ * void check_full(void)
+ *
+ * Decodes a random 4 byte field with a random full range scalar, offset and
+ * num / den, against the same sums in long double, which holds the 64 bit
+ * products exactly.
+ */
+static void check_full(void) {
+  static const Scale full = {"full range", 0, 0, 1, 1, 1};
+  uint8_t data[8] = {0};
+  uint32_t raw = (uint32_t) random_int32();
+  uint8_t sgn = rand() % 2;
+  int32_t scl = random_int32();
+  int32_t off = random_int32();
+  int32_t num = random_int32();
+  int32_t den = random_int32();
+  den = den == 0 ? 1 : den;
+
+  put_field(data, 4, LITTLE, raw);
+  long double diff = (long double) (sgn ? (int64_t) (int32_t) raw : (int64_t) raw) - off;
+  checked++;
+
+  long double product = diff * scl;
+  q16_t want = product > INT32_MAX ? INT32_MAX : product < INT32_MIN ? INT32_MIN :
+    (q16_t) product;
+  q16_t q16 = CAN_extract_q16(data, 0, 4, LITTLE, sgn, scl, off);
+  if (q16 != want) {
+    fail(&full, 4, LITTLE, sgn, raw, "q16", q16, want);
+  }
+
+  long double quotient = truncl(diff * num / den);
+  int32_t wanted = quotient > INT32_MAX ? INT32_MAX : quotient < INT32_MIN ? INT32_MIN :
+    (int32_t) quotient;
+  int32_t scaled = CAN_extract_scaled(data, 0, 4, LITTLE, sgn, num, den, off);
+  if (scaled != wanted) {
+    fail(&full, 4, LITTLE, sgn, raw, "scaled", scaled, wanted);
+  }
+}
+
+int main(void) {
+  static const uint32_t edges[] = {0, 1, 0x7FFFFFFF, 0x80000000, 0x80000001, 0xFFFFFFFF};
+  uint32_t s, raw, i;
+  uint8_t length, sgn;
+  Endian endianness;
+
+  srand(SEED);
+
+  for (s = 0; s < SCALES; s++) {
+    for (endianness = BIG; endianness <= LITTLE; endianness++) {
+      for (sgn = 0; sgn <= 1; sgn++) {
+        // Every 1 and 2 byte value
+        for (length = 1; length <= 2; length++) {
+          for (raw = 0; raw < (1U << (8 * length)); raw++) {
+            check(&scales[s], length, endianness, sgn, raw);
+          }
+        }
+
+        // 4 byte values, at the edges and at random
+        for (i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+          check(&scales[s], 4, endianness, sgn, edges[i]);
+        }
+        for (i = 0; i < RANDOM_4_BYTE / SCALES; i++) {
+          check(&scales[s], 4, endianness, sgn, (uint32_t) random_int32());
+        }
+      }
+    }
+  }
+
+  for (i = 0; i < RANDOM_FULL; i++) {
+    check_full();
+  }
+
+  printf("%u fields decoded each way, %u differed\n", checked, failures);
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
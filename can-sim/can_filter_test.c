@@ -0,0 +1,212 @@
+/**
+ * CAN Receive Filter Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs on its own against the host register model. Subscribes the Wheel's IDs
+ * and ranges, the other nodes' health messages and a spread of single IDs, so
+ * that covering them exactly would take more filters and block sizes than the
+ * module has. After init_can() has programmed the filters, feeds in every
+ * standard ID and dispatches it with CAN_dispatch_messages(). Passes if the
+ * filters and masks in use are within CAN_FILTERS and CAN_MASKS, every
+ * subscribed ID reaches its own handler exactly once, and no unsubscribed ID
+ * reaches a handler. Unsubscribed IDs that get through the widened filters
+ * are counted through the receive log.
+ */
+#include <stdio.h>
+#include "FSAE_can.h"
+#include "CAN.h"
+
+#define EXTRA_BASE  0x700 // Single IDs subscribed on top of the Wheel's
+#define EXTRA_COUNT 20
+#define EXTRA_STEP  9
+
+#define NUM_HANDLERS 3
+
+volatile uint32_t millis = 0;
+
+static volatile uint32_t* const fltcon[CAN_FILTERS / 4] = {
+  &C1FLTCON0, &C1FLTCON1, &C1FLTCON2, &C1FLTCON3,
+  &C1FLTCON4, &C1FLTCON5, &C1FLTCON6, &C1FLTCON7
+};
+
+static uint8_t expected[CAN_SID_COUNT]; // Handler number + 1, or 0 if unsubscribed
+static uint8_t handled_by[CAN_SID_COUNT];
+static uint32_t hits[CAN_SID_COUNT];
+static uint32_t logged[CAN_SID_COUNT];
+
+static void on_message(uint8_t handler, CAN_message msg) {
+  uint32_t id = msg.id & CAN_SID_MASK;
+  handled_by[id] = handler + 1;
+  hits[id]++;
+}
+
+static void on_message_0(CAN_message msg) {
+  on_message(0, msg);
+}
+
+static void on_message_1(CAN_message msg) {
+  on_message(1, msg);
+}
+
+static void on_message_2(CAN_message msg) {
+  on_message(2, msg);
+}
+
+static void on_log(CAN_message msg) {
+  logged[msg.id & CAN_SID_MASK]++;
+}
+
+static const CAN_handler handlers[NUM_HANDLERS] = {on_message_0, on_message_1, on_message_2};
+static uint32_t subscriptions = 0;
+
+/**
+ * void subscribe(uint32_t id, uint32_t count, uint8_t critical)
+ *
+ * Subscribes <count> IDs from <id> to the next handler in turn, and records
+ * which handler each ID should reach.
+ */
+static void subscribe(uint32_t id, uint32_t count, uint8_t critical) {
+  uint8_t handler = subscriptions++ % NUM_HANDLERS;
+  uint32_t i;
+
+  CAN_subscribe(id, count, handlers[handler], critical);
+  for (i = id; i < id + count; i++) {
+    expected[i] = handler + 1;
+  }
+}
+
+/**
+ * uint32_t exact_blocks(uint32_t* sizes)
+ *
+ * Covers the subscribed IDs with the largest aligned power of two blocks that
+ * hold only subscribed IDs, as the filters would without any widening.
+ *
+ * @param sizes Set to a bitmap of the block sizes used, bit k for 2^k IDs
+ * @returns The number of blocks
+ */
+static uint32_t exact_blocks(uint32_t* sizes) {
+  uint32_t blocks = 0;
+  uint32_t id = 0;
+
+  *sizes = 0;
+  while (id < CAN_SID_COUNT) {
+    uint8_t k = 0;
+    uint32_t i;
+
+    if (!expected[id]) {
+      id++;
+      continue;
+    }
+
+    while (k < 11 && (id & ((2u << k) - 1)) == 0) {
+      for (i = id; i < id + (2u << k) && expected[i]; i++);
+      if (i < id + (2u << k)) {
+        break;
+      }
+      k++;
+    }
+
+    *sizes |= 1u << k;
+    blocks++;
+    id += 1u << k;
+  }
+  return blocks;
+}
+
+int main(void) {
+  uint8_t data[8] = {0};
+  uint32_t exact, exact_sizes, masks_used = 0;
+  uint32_t filters = 0, masks = 0, failures = 0;
+  uint32_t delivered = 0, leaked = 0, filtered = 0;
+  uint32_t i;
+  int passed;
+
+  // The Wheel's subscriptions, see Wheel.c
+  subscribe(MOTEC_ID, 8, CAN_NORMAL);
+  subscribe(GCM_ID, 3, CAN_NORMAL);
+  subscribe(PDM_ID, 12, CAN_NORMAL);
+  subscribe(TIRE_TEMP_FL_ID, 4, CAN_NORMAL);
+  subscribe(SPM_ID, 14, CAN_NORMAL);
+  subscribe(WHEEL_ID + ISOTP_REQ_OFFSET, 1, CAN_CRITICAL);
+
+  // The other nodes' health messages, errors, and single IDs with gaps
+  subscribe(ERROR_ID, 1, CAN_CRITICAL);
+  subscribe(BEACON_ID, 1, CAN_NORMAL);
+  subscribe(GCM_ID + HEALTH_ID_OFFSET, 1, CAN_NORMAL);
+  subscribe(LOGGER_ID + HEALTH_ID_OFFSET, 1, CAN_NORMAL);
+  subscribe(PDM_ID + HEALTH_ID_OFFSET, 1, CAN_NORMAL);
+  subscribe(SPM_ID + HEALTH_ID_OFFSET, 1, CAN_NORMAL);
+  for (i = 0; i < EXTRA_COUNT; i++) {
+    subscribe(EXTRA_BASE + i * EXTRA_STEP, 1, CAN_NORMAL);
+  }
+
+  exact = exact_blocks(&exact_sizes);
+  for (i = 0; i < 12; i++) {
+    masks += (exact_sizes >> i) & 0x1;
+  }
+  printf("Exact cover takes %u filters and %u masks\n", exact, masks);
+  if (exact <= CAN_FILTERS && masks <= CAN_MASKS) {
+    printf("Subscriptions fit the module without merging\n");
+    failures++;
+  }
+
+  CAN_set_rx_log(on_log);
+  init_can();
+
+  // Filters enabled and masks they select
+  for (i = 0; i < CAN_FILTERS; i++) {
+    uint32_t con = (*fltcon[i / 4] >> (8 * (i % 4))) & 0xFF;
+    if (con & 0x80) {
+      filters++;
+      masks_used |= 1u << ((con >> 5) & 0x3);
+    }
+  }
+  masks = 0;
+  for (i = 0; i < CAN_MASKS; i++) {
+    masks += (masks_used >> i) & 0x1;
+  }
+  printf("Programmed %u filters and %u masks\n", filters, masks);
+  if (filters == 0 || filters > CAN_FILTERS || masks > CAN_MASKS) {
+    failures++;
+  }
+
+  for (i = 0; i < CAN_SID_COUNT; i++) {
+    data[0] = i & 0xFF;
+    data[1] = i >> 8;
+    host_can_receive(i, 8, data);
+    CAN_dispatch_messages();
+
+    if (expected[i]) {
+      if (hits[i] != 1 || handled_by[i] != expected[i]) {
+        if (failures++ < 10) {
+          printf("ID 0x%03X handled %u times by handler %u, expected once by %u\n", i,
+              hits[i], handled_by[i], expected[i]);
+        }
+      } else {
+        delivered++;
+      }
+    } else if (hits[i] != 0) {
+      if (failures++ < 10) {
+        printf("Unsubscribed ID 0x%03X reached handler %u\n", i, handled_by[i]);
+      }
+    } else if (logged[i] != 0) {
+      leaked++;
+    } else {
+      filtered++;
+    }
+  }
+
+  printf("%u subscribed IDs delivered, %u unsubscribed IDs filtered, %u passed the "
+      "filters without a handler\n", delivered, filtered, leaked);
+  if (filtered == 0) {
+    printf("No ID was filtered out\n");
+    failures++;
+  }
+
+  passed = failures == 0;
+  printf("%s\n", passed ? "PASS" : "FAIL");
+  return passed ? 0 : 1;
+}
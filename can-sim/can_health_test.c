@@ -0,0 +1,97 @@
+/**
+ * CAN Health Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs as a node under canbus with every frame it sends destroyed by errors
+ * between ERROR_START_MS and ERROR_END_MS (see the -e option in
+ * CMakeLists.txt). It sends one frame every millisecond and services the
+ * health subsystem from its main loop. Passes if the node went bus-off
+ * repeatedly with a growing backoff, then recovered and sent frames again
+ * once the errors stopped, and published health messages reporting it.
+ */
+#include <stdio.h>
+#include "FSAE_can.h"
+#include "CAN.h"
+
+#define TEST_ID        0x700
+#define HEALTH_ID      (GCM_ID + HEALTH_ID_OFFSET)
+#define ERROR_START_MS 500
+#define ERROR_END_MS   1000
+#define RUN_MS         3000
+
+// Defined for FSAE_can, driven from the main loop here
+volatile uint32_t millis = 0;
+
+static volatile uint32_t sent_late = 0;
+static volatile uint32_t health_sent = 0;
+static volatile uint32_t health_errors = 0;
+static volatile uint8_t health_bus_offs = 0;
+static volatile uint8_t health_state = CAN_ACTIVE;
+
+/**
+ * void on_tx(uint32_t id, uint32_t dlc, const uint8_t * data)
+ *
+ * Called by the host backend as each frame leaves for the bus.
+ */
+static void on_tx(uint32_t id, uint32_t dlc, const uint8_t * data) {
+  (void) dlc;
+  if (id == TEST_ID && millis >= ERROR_END_MS + CAN_BACKOFF_MAX_MS) {
+    sent_late++;
+  } else if (id == HEALTH_ID) {
+    health_sent++;
+    health_errors += data[CAN_ERRORS_BYTE];
+    health_state = data[CAN_STATE_BYTE] & 0x3;
+    health_bus_offs = data[CAN_STATE_BYTE] >> 2;
+  }
+}
+
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
+  }
+
+  IFS4CLR = _IFS4_CAN1IF_MASK; // Clear CAN1 Interrupt Flag
+}
+
+int main(void) {
+  uint32_t last = 0;
+  uint8_t maxState = CAN_ACTIVE;
+  int passed;
+
+  init_can();
+  CAN_health_init(HEALTH_ID);
+  host_can_set_tx_handler(on_tx);
+  STI();
+
+  while (millis < RUN_MS) {
+    millis = (uint32_t) (host_micros() / 1000);
+    if (millis != last) {
+      CAN_data data = {0};
+      data.word0 = millis;
+      CAN_send_message(TEST_ID, 8, data);
+      last = millis;
+    }
+
+    CAN_health_service();
+    if (CAN_health.state > maxState) {
+      maxState = CAN_health.state;
+    }
+  }
+
+  printf("Bus-offs: %u, last backoff %u ms, worst state %u, final state %u, TEC %u\n",
+      CAN_health.bus_offs, CAN_health.backoff, maxState, CAN_health.state, CAN_health.tec);
+  printf("Health messages: %u, %u errors reported, last reports %u bus-offs in state %u\n",
+      health_sent, health_errors, health_bus_offs, health_state);
+  printf("Frames sent after recovery: %u\n", sent_late);
+
+  passed = CAN_health.bus_offs >= 2 && CAN_health.backoff > CAN_BACKOFF_MIN_MS &&
+    maxState == CAN_BUS_OFF && CAN_health.state == CAN_ACTIVE && sent_late > 0 &&
+    health_sent > 0 && health_errors > 0 && health_bus_offs == CAN_health.bus_offs &&
+    health_state == CAN_ACTIVE;
+  printf("%s\n", passed ? "PASS" : "FAIL");
+
+  return passed ? 0 : 1;
+}
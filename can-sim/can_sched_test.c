@@ -0,0 +1,152 @@
+/**
+ * CAN Scheduler Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs as a node under canbus. Registers a set of periodic messages with
+ * automatic phases, as a node with many fast messages would, plus one that
+ * is also sent on events, and triggers that one in a burst partway through.
+ * Passes if the phases spread the messages so no more than MAX_PER_MS fall
+ * due in any millisecond, every periodic send that fell due was made, and the
+ * burst of triggers was merged into a single frame.
+ */
+#include <stdio.h>
+#include "FSAE_can.h"
+
+#define FAST_ID      0x600
+#define FAST_COUNT   8
+#define FAST_PERIOD  10
+#define SLOW_ID      0x610
+#define SLOW_COUNT   4
+#define SLOW_PERIOD  100
+#define EVENT_ID     0x620
+#define EVENT_PERIOD 250
+
+#define BURST_MS     1500
+#define BURST_LEN    5
+#define SINGLE_MS    1600
+#define RUN_MS       (2 * CAN_SCHED_INTV + 100)
+#define MAX_PER_MS   1
+
+// Least common multiple of the periods, after which the pattern of sends repeats
+#define HYPERPERIOD  500
+
+// Defined for FSAE_can, driven from the main loop here
+volatile uint32_t millis = 0;
+
+static uint32_t packed_ms = UINT32_MAX;
+static uint32_t packed_now = 0;
+static uint32_t packed_max = 0;
+
+/**
+ * uint32_t pack(uint32_t id, CAN_data* data)
+ *
+ * Counts the messages packed in the current millisecond and sends the time.
+ * A late pass of the main loop on a busy host packs more than were due.
+ */
+static uint32_t pack(uint32_t id, CAN_data* data) {
+  if (millis != packed_ms) {
+    packed_ms = millis;
+    packed_now = 0;
+  }
+  packed_now++;
+  if (packed_now > packed_max) {
+    packed_max = packed_now;
+  }
+
+  data->word0 = millis;
+  data->word1 = id;
+  return 8;
+}
+
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
+  }
+
+  IFS4CLR = _IFS4_CAN1IF_MASK; // Clear CAN1 Interrupt Flag
+}
+
+/**
+ * uint32_t most_due(void)
+ *
+ * @returns The most periodic messages due in one millisecond with the phases
+ *     the scheduler chose
+ */
+static uint32_t most_due(void) {
+  uint32_t most = 0;
+  uint32_t t;
+  for (t = 0; t < HYPERPERIOD; t++) {
+    uint32_t due = 0;
+    uint32_t i;
+    for (i = 0; i < CAN_sched_len; i++) {
+      if (t % CAN_sched[i].period == CAN_sched[i].phase) {
+        due++;
+      }
+    }
+    if (due > most) {
+      most = due;
+    }
+  }
+  return most;
+}
+
+int main(void) {
+  uint32_t due = 0;
+  uint32_t phases = 0;
+  uint32_t complete = 1;
+  uint32_t i;
+  int passed;
+
+  init_can();
+  for (i = 0; i < FAST_COUNT; i++) {
+    CAN_sched_add(FAST_ID + i, FAST_PERIOD, CAN_SCHED_AUTO, pack);
+  }
+  for (i = 0; i < SLOW_COUNT; i++) {
+    CAN_sched_add(SLOW_ID + i, SLOW_PERIOD, CAN_SCHED_AUTO, pack);
+  }
+  CAN_sched_add(EVENT_ID, EVENT_PERIOD, CAN_SCHED_AUTO, pack);
+  STI();
+
+  while (millis < RUN_MS) {
+    uint32_t last = millis;
+    millis = (uint32_t) (host_micros() / 1000);
+    if (last < BURST_MS && millis >= BURST_MS) {
+      for (i = 0; i < BURST_LEN; i++) {
+        CAN_sched_trigger(EVENT_ID);
+      }
+    }
+    if (last < SINGLE_MS && millis >= SINGLE_MS) {
+      CAN_sched_trigger(EVENT_ID);
+    }
+    CAN_sched_service();
+  }
+
+  printf("%-6s %6s %5s %9s %5s %9s %9s %6s\n", "ID", "Period", "Phase",
+      "Requested", "Sent", "Triggered", "Coalesced", "Missed");
+  for (i = 0; i < CAN_sched_len; i++) {
+    CAN_sched_stats* stats = &CAN_sched[i];
+    printf("0x%03X  %6u %5u %9u %5u %9u %9u %6u\n", stats->id, stats->period,
+        stats->phase, stats->requested, stats->sent, stats->triggered,
+        stats->coalesced, stats->missed);
+    if (stats->id != EVENT_ID && stats->requested !=
+        stats->sent + stats->coalesced + stats->missed) {
+      complete = 0;
+    }
+    if (stats->id < FAST_ID + FAST_COUNT) {
+      phases |= 1 << stats->phase;
+    }
+  }
+  due = most_due();
+  printf("Most messages due in one millisecond: %u, packed: %u\n", due, packed_max);
+
+  passed = due <= MAX_PER_MS && complete &&
+    phases == (1 << FAST_COUNT) - 1 &&
+    CAN_sched[FAST_COUNT + SLOW_COUNT].triggered == 2 &&
+    CAN_sched[FAST_COUNT + SLOW_COUNT].coalesced >= BURST_LEN - 1;
+  printf("%s\n", passed ? "PASS" : "FAIL");
+
+  return passed ? 0 : 1;
+}
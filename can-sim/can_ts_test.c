@@ -0,0 +1,96 @@
+/**
+ * CAN Receive Timestamp Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs on its own against the host register model, with millis following the
+ * host clock as the nodes' timer interrupt keeps it. Feeds in frames and
+ * leaves them in the receive FIFO for 0 to 60 ms, across many wraps of the 16
+ * bit timestamp timer, before taking them out with CAN_recv_frames(). Passes
+ * if every frame's CAN_frame_timestamp() lies between CAN_micros() just
+ * before and just after it arrived.
+ */
+#include <stdio.h>
+#include "FSAE_can.h"
+
+#define TEST_ID  0x100
+#define MAX_WAIT 60000 // Longest a frame waits in the FIFO, in microseconds
+#define STEP     2500
+#define ROUNDS   4
+
+// Microseconds within which a timestamp must fall of the time it arrived
+#define SLACK_US 2
+
+volatile uint32_t millis = 0;
+
+static uint32_t before = 0;
+static uint32_t after = 0;
+static uint32_t received = 0;
+static uint32_t failures = 0;
+static int32_t worst = 0;
+
+/**
+ * uint32_t tick(void)
+ *
+ * Brings millis up to date with the host clock.
+ *
+ * @returns CAN_micros() after the update
+ */
+static uint32_t tick(void) {
+  millis = (uint32_t) (host_micros() / 1000);
+  return CAN_micros();
+}
+
+static void on_frame(const CanRxMessageBuffer* frame) {
+  uint32_t timestamp = CAN_frame_timestamp(frame);
+  int32_t early = (int32_t) (before - timestamp);
+  int32_t late = (int32_t) (timestamp - after);
+
+  if (early > SLACK_US || late > SLACK_US) {
+    if (failures++ < 10) {
+      printf("Frame %u stamped %u, arrived between %u and %u\n", received, timestamp,
+          before, after);
+    }
+  }
+  worst = early > worst ? early : worst;
+  worst = late > worst ? late : worst;
+  received++;
+}
+
+static void on_message(CAN_message msg) {
+  (void) msg;
+}
+
+int main(void) {
+  uint8_t data[8] = {0};
+  uint32_t wait, round, fed = 0;
+  int passed;
+
+  tick();
+  CAN_subscribe(TEST_ID, 1, on_message, CAN_NORMAL);
+  init_can();
+
+  for (round = 0; round < ROUNDS; round++) {
+    for (wait = 0; wait <= MAX_WAIT; wait += STEP) {
+      uint32_t start;
+
+      before = tick();
+      host_can_receive(TEST_ID, 8, data);
+      after = tick();
+      fed++;
+
+      start = after;
+      while (tick() - start < wait);
+      CAN_recv_frames(on_frame);
+    }
+  }
+
+  printf("%u of %u frames received, worst error %d us\n", received, fed,
+      worst > 0 ? worst : 0);
+
+  passed = received == fed && failures == 0;
+  printf("%s\n", passed ? "PASS" : "FAIL");
+  return passed ? 0 : 1;
+}
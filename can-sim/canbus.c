@@ -0,0 +1,819 @@
+/**
+ * Virtual CAN Bus Simulator
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs several host-built nodes as separate processes on one simulated CAN
+ * bus. Frames are arbitrated by ID whenever the bus goes idle and occupy the
+ * bus for their worst-case bit-stuffed length at the configured bitrate. Each
+ * node keeps its frames in its own 32-deep TX FIFO until they win arbitration
+ * and drops received frames when its RX FIFO is full, as on the car.
+ *
+ * Usage: canbus [-t seconds] [-b bitrate] [-r replay.log] [-l trigger:response]...
+ *     [-e [node:]probability[@start-end]]... [-v] node...
+ *
+ *   -t  Length of the run, default 10 seconds
+ *   -b  Bus bitrate, default 1000000
+ *   -r  Replays a candump log onto the bus from a virtual node, for stimulus
+ *       or extra load
+ *   -l  Measures the time from each frame with the trigger ID to the next
+ *       frame with the response ID, both in hex
+ *   -e  Destroys each frame sent by the named node, or by any node, with an
+ *       error frame with the given probability, optionally only between
+ *       <start> and <end> seconds into the run. Destroyed frames are sent
+ *       again, and every node counts the error in its error counters
+ *   -v  Prints every frame in candump format as it completes
+ *
+ * A node given with arguments, quoted as one word, is run through the shell
+ * and named after its program.
+ *
+ * The run ends early once every node has exited on its own. canbus exits with
+ * status 1 if any node exited with a failure, so a node built as a test can
+ * be run under it by ctest.
+ */
+#define _GNU_SOURCE
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "host_bus.h"
+
+#define MAX_NODES 16
+#define MAX_PAIRS 8
+#define MAX_FAULTS 8
+#define MAX_IDS 2048
+#define DEFAULT_BITRATE 1000000
+#define DEFAULT_SECONDS 10
+
+// Longest wait between checks of the replay log and the run length
+#define MAX_WAIT_US 10000
+
+// Longest the bus holds arbitration for a node's next queued frame
+#define MAX_HOLD_US 2000
+
+// Longest error frame: a superposed error flag, delimiter and intermission
+#define ERROR_FRAME_BITS 23
+
+// Seed for error injection, so runs with -e are repeatable
+#define FAULT_SEED 1
+
+typedef struct {
+  const char* name;
+  pid_t pid;
+  int exited;
+  int failed;
+  int fd;
+  int pending; // <frame> is waiting for arbitration or on the wire
+  int withdrawn; // CANCEL arrived while <frame> was on the wire
+  host_bus_msg frame;
+  uint16_t queued; // Frames the node has waiting behind <frame>
+  uint64_t submitted;
+  uint32_t tx;
+  uint32_t tx_drop;
+  uint32_t rx_drop;
+  uint32_t errors; // Frames from this node destroyed by an error frame
+} bus_node;
+
+typedef struct {
+  uint32_t count;
+  uint32_t rx_drop;
+  uint64_t delay_total;
+  uint64_t delay_min;
+  uint64_t delay_max;
+} id_stats;
+
+typedef struct {
+  uint32_t trigger;
+  uint32_t response;
+  uint64_t armed; // Completion time of the unanswered trigger, 0 if none
+  uint32_t count;
+  uint64_t total;
+  uint64_t min;
+  uint64_t max;
+} latency_pair;
+
+typedef struct {
+  uint64_t time;
+  host_bus_msg frame;
+} replay_frame;
+
+typedef struct {
+  const char* name; // Node whose frames are destroyed, NULL for every node
+  double probability;
+  uint64_t start;
+  uint64_t end; // 0 for the rest of the run
+} bus_fault;
+
+static bus_node nodes[MAX_NODES + 1];
+static int num_nodes = 0;
+static int replay_node = -1;
+
+static replay_frame* replay = NULL;
+static size_t replay_len = 0;
+static size_t replay_pos = 0;
+
+static id_stats ids[MAX_IDS];
+static latency_pair pairs[MAX_PAIRS];
+static int num_pairs = 0;
+
+static bus_fault faults[MAX_FAULTS];
+static int num_faults = 0;
+
+static uint32_t bitrate = DEFAULT_BITRATE;
+static int verbose = 0;
+static volatile sig_atomic_t stop = 0;
+static struct timespec start_time;
+
+/**
+ * uint64_t now_us(void)
+ *
+ * @returns Microseconds since the simulation started.
+ */
+static uint64_t now_us(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t) (now.tv_sec - start_time.tv_sec) * 1000000ULL +
+    (now.tv_nsec - start_time.tv_nsec) / 1000;
+}
+
+/**
+ * uint64_t frame_time_us(const host_bus_msg* frame)
+ *
+ * @returns The time a frame occupies the bus, including worst-case stuff bits
+ *     and interframe space.
+ */
+static uint64_t frame_time_us(const host_bus_msg* frame) {
+  uint32_t data = (frame->id & HOST_BUS_RTR) ? 0 : 8 * (frame->dlc > 8 ? 8 : frame->dlc);
+  uint32_t bits = (frame->id & HOST_BUS_EXT) ? 67 + data + (54 + data - 1) / 4 :
+    47 + data + (34 + data - 1) / 4;
+  return ((uint64_t) bits * 1000000ULL + bitrate - 1) / bitrate;
+}
+
+/**
+ * uint32_t arbitration_key(uint32_t id)
+ *
+ * @returns A key that is lower for the frame that wins arbitration, laid out
+ *     as in CAN_tx_key() in FSAE_can.c. The top 11 bits are the base ID.
+ */
+static uint32_t arbitration_key(uint32_t id) {
+  if (id & HOST_BUS_EXT) {
+    return ((id & 0x1FFFFFFF) >> 18 << 21) | (0x3u << 19) | ((id & 0x3FFFF) << 1) |
+      ((id & HOST_BUS_RTR) ? 1 : 0);
+  }
+  return ((id & 0x7FF) << 21) | ((id & HOST_BUS_RTR) ? (1u << 20) : 0);
+}
+
+/**
+ * void print_frame(uint64_t time, const char* name, const host_bus_msg* frame)
+ *
+ * Prints a frame in candump format.
+ */
+static void print_frame(uint64_t time, const char* name, const host_bus_msg* frame) {
+  int i;
+  if (frame->id & HOST_BUS_EXT) {
+    printf("(%.6f) %s %08X#", time / 1000000.0, name, frame->id & 0x1FFFFFFF);
+  } else {
+    printf("(%.6f) %s %03X#", time / 1000000.0, name, frame->id & 0x7FF);
+  }
+  if (frame->id & HOST_BUS_RTR) {
+    printf("R");
+  }
+  for (i = 0; i < frame->dlc && i < 8 && !(frame->id & HOST_BUS_RTR); i++) {
+    printf("%02X", frame->data[i]);
+  }
+  printf("\n");
+}
+
+/**
+ * void send_msg(int fd, uint8_t type, const host_bus_msg* frame)
+ *
+ * Sends a message to a node, if it is still connected.
+ */
+static void send_msg(int fd, uint8_t type, const host_bus_msg* frame) {
+  host_bus_msg msg;
+  if (fd < 0) {
+    return;
+  }
+  memset(&msg, 0, sizeof(msg));
+  if (frame != NULL) {
+    msg = *frame;
+  }
+  msg.type = type;
+  send(fd, &msg, sizeof(msg), MSG_NOSIGNAL);
+}
+
+/**
+ * void complete(int n, uint64_t now)
+ *
+ * Delivers the frame node <n> had on the wire to every other node.
+ */
+static void complete(int n, uint64_t now) {
+  bus_node* node = &nodes[n];
+  uint32_t id = node->frame.id;
+  int i;
+
+  for (i = 0; i < num_nodes; i++) {
+    if (i != n) {
+      send_msg(nodes[i].fd, HOST_BUS_FRAME, &node->frame);
+    }
+  }
+  send_msg(node->fd, HOST_BUS_DONE, NULL);
+
+  node->pending = 0;
+  node->withdrawn = 0;
+  node->tx++;
+
+  for (i = 0; i < num_pairs; i++) {
+    latency_pair* pair = &pairs[i];
+    if (id == pair->response && pair->armed != 0) {
+      uint64_t sample = now - pair->armed;
+      if (pair->count == 0 || sample < pair->min) {
+        pair->min = sample;
+      }
+      if (sample > pair->max) {
+        pair->max = sample;
+      }
+      pair->total += sample;
+      pair->count++;
+      pair->armed = 0;
+    }
+    if (id == pair->trigger && pair->armed == 0) {
+      pair->armed = now;
+    }
+  }
+
+  if (verbose) {
+    print_frame(now, node->name, &node->frame);
+  }
+}
+
+/**
+ * int corrupted(int n, uint64_t now)
+ *
+ * @returns Whether the frame node <n> starts sending at <now> is destroyed by
+ *     an error, as decided by the -e options.
+ */
+static int corrupted(int n, uint64_t now) {
+  int i;
+  for (i = 0; i < num_faults; i++) {
+    bus_fault* fault = &faults[i];
+    if ((fault->name == NULL || strcmp(fault->name, nodes[n].name) == 0) &&
+        now >= fault->start && (fault->end == 0 || now < fault->end) &&
+        drand48() < fault->probability) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * void destroy(int n)
+ *
+ * Ends the frame node <n> had on the wire with an error frame. Every node
+ * is told, and the frame stays pending so it is sent again.
+ */
+static void destroy(int n) {
+  host_bus_msg msg;
+  int i;
+
+  memset(&msg, 0, sizeof(msg));
+  for (i = 0; i < num_nodes; i++) {
+    msg.dlc = i == n;
+    send_msg(nodes[i].fd, HOST_BUS_ERROR, &msg);
+  }
+  nodes[n].errors++;
+
+  // Unless the node withdrew it or has gone in the meantime
+  if (nodes[n].withdrawn) {
+    nodes[n].pending = 0;
+    nodes[n].withdrawn = 0;
+    send_msg(nodes[n].fd, HOST_BUS_DONE, NULL);
+  } else if (nodes[n].fd < 0 && n != replay_node) {
+    nodes[n].pending = 0;
+  }
+}
+
+/**
+ * int arbitrate(uint64_t now)
+ *
+ * Starts the pending frame with the lowest ID on the wire at <now>.
+ *
+ * @returns The index of the node that won, or -1 if none is pending
+ */
+static int arbitrate(uint64_t now) {
+  int winner = -1;
+  int i;
+
+  for (i = 0; i < num_nodes; i++) {
+    if (nodes[i].pending && (winner < 0 ||
+        arbitration_key(nodes[i].frame.id) < arbitration_key(nodes[winner].frame.id))) {
+      winner = i;
+    }
+  }
+
+  // Extended frames are counted under their base ID
+  if (winner >= 0) {
+    id_stats* stats = &ids[arbitration_key(nodes[winner].frame.id) >> 21];
+    uint64_t delay = now > nodes[winner].submitted ? now - nodes[winner].submitted : 0;
+    if (stats->count == 0 || delay < stats->delay_min) {
+      stats->delay_min = delay;
+    }
+    if (delay > stats->delay_max) {
+      stats->delay_max = delay;
+    }
+    stats->delay_total += delay;
+    stats->count++;
+  }
+
+  return winner;
+}
+
+/**
+ * void handle_node(int n, uint64_t now, int on_wire)
+ *
+ * Reads one message from node <n>. <on_wire> is set while the node's frame is
+ * being transmitted.
+ */
+static void handle_node(int n, uint64_t now, int on_wire) {
+  bus_node* node = &nodes[n];
+  host_bus_msg msg;
+
+  if (recv(node->fd, &msg, sizeof(msg), 0) != sizeof(msg)) {
+    close(node->fd);
+    node->fd = -1;
+    if (!on_wire) {
+      node->pending = 0;
+    }
+    return;
+  }
+
+  switch (msg.type) {
+    case HOST_BUS_SUBMIT:
+      node->frame = msg;
+      node->queued = msg.queued;
+      node->submitted = now;
+      node->pending = 1;
+      break;
+    case HOST_BUS_CANCEL:
+      // A frame already on the wire still completes, unless it is destroyed
+      if (node->pending && !on_wire) {
+        node->pending = 0;
+        send_msg(node->fd, HOST_BUS_DONE, NULL);
+      } else if (on_wire) {
+        node->withdrawn = 1;
+      }
+      break;
+    case HOST_BUS_RX_DROP:
+      node->rx_drop++;
+      ids[arbitration_key(msg.id) >> 21].rx_drop++;
+      break;
+    case HOST_BUS_TX_DROP:
+      node->tx_drop += msg.dlc;
+      break;
+  }
+}
+
+/**
+ * void accept_node(int listen_fd)
+ *
+ * Accepts a node's connection and matches it to the process that was
+ * started for it. A node that connects again, as after a software reset,
+ * replaces its old connection and any frame it had waiting.
+ */
+static void accept_node(int listen_fd) {
+  host_bus_msg msg;
+  int fd = accept(listen_fd, NULL, NULL);
+
+  if (fd < 0) {
+    return;
+  }
+  if (recv(fd, &msg, sizeof(msg), 0) != sizeof(msg) || msg.type != HOST_BUS_HELLO ||
+      msg.id >= (uint32_t) num_nodes || msg.id == (uint32_t) replay_node) {
+    close(fd);
+    return;
+  }
+  if (nodes[msg.id].fd >= 0) {
+    close(nodes[msg.id].fd);
+    nodes[msg.id].pending = 0;
+  }
+  nodes[msg.id].fd = fd;
+}
+
+/**
+ * int load_replay(const char* filename)
+ *
+ * Reads a candump log, as written by -v or FSAE_HOST_TRACE. IDs written with
+ * 8 digits are extended, and data of "R" marks a remote request.
+ *
+ * @returns 0 on success, -1 if the file could not be read
+ */
+static int load_replay(const char* filename) {
+  FILE* file = fopen(filename, "r");
+  char line[256];
+  size_t capacity = 0;
+  double first = -1;
+
+  if (file == NULL) {
+    return -1;
+  }
+
+  while (fgets(line, sizeof(line), file) != NULL) {
+    double time;
+    char id[16];
+    char data[64];
+    replay_frame frame;
+    size_t i;
+
+    data[0] = '\0';
+    if (sscanf(line, " (%lf) %*s %15[0-9A-Fa-f]#%63s", &time, id, data) < 2) {
+      continue;
+    }
+    if (first < 0) {
+      first = time;
+    }
+
+    memset(&frame, 0, sizeof(frame));
+    frame.time = (uint64_t) ((time - first) * 1000000.0);
+    if (strlen(id) > 3) {
+      frame.frame.id = HOST_BUS_EXT | (strtoul(id, NULL, 16) & 0x1FFFFFFF);
+    } else {
+      frame.frame.id = strtoul(id, NULL, 16) & 0x7FF;
+    }
+    if (data[0] == 'R') {
+      frame.frame.id |= HOST_BUS_RTR;
+      data[0] = '\0';
+    }
+    for (i = 0; i < 8 && data[2 * i] != '\0' && data[2 * i + 1] != '\0'; i++) {
+      unsigned int byte;
+      sscanf(&data[2 * i], "%2x", &byte);
+      frame.frame.data[i] = (uint8_t) byte;
+    }
+    frame.frame.dlc = (uint8_t) i;
+
+    if (replay_len == capacity) {
+      capacity = capacity ? capacity * 2 : 256;
+      replay = realloc(replay, capacity * sizeof(replay_frame));
+    }
+    replay[replay_len++] = frame;
+  }
+
+  fclose(file);
+  return 0;
+}
+
+/**
+ * void print_report(uint64_t elapsed, uint64_t busy)
+ *
+ * Prints per-node, per-ID and latency statistics for the run.
+ */
+static void print_report(uint64_t elapsed, uint64_t busy) {
+  int i;
+
+  printf("\nSimulated %.3f s at %u bit/s, bus load %.1f%%\n\n",
+      elapsed / 1000000.0, bitrate, elapsed ? 100.0 * busy / elapsed : 0.0);
+
+  printf("%-16s %10s %10s %10s %10s\n", "Node", "TX", "TX dropped", "RX dropped",
+      "TX errors");
+  for (i = 0; i < num_nodes; i++) {
+    printf("%-16s %10u %10u %10u %10u\n", nodes[i].name, nodes[i].tx, nodes[i].tx_drop,
+        nodes[i].rx_drop, nodes[i].errors);
+  }
+
+  printf("\n%-6s %10s %24s %10s\n", "ID", "Frames", "Queued min/avg/max (us)",
+      "RX dropped");
+  for (i = 0; i < MAX_IDS; i++) {
+    id_stats* stats = &ids[i];
+    if (stats->count > 0 || stats->rx_drop > 0) {
+      char delay[32];
+      snprintf(delay, sizeof(delay), "%llu/%llu/%llu",
+          (unsigned long long) stats->delay_min,
+          (unsigned long long) (stats->count ? stats->delay_total / stats->count : 0),
+          (unsigned long long) stats->delay_max);
+      printf("0x%03X  %10u %24s %10u\n", i, stats->count, delay, stats->rx_drop);
+    }
+  }
+
+  for (i = 0; i < num_pairs; i++) {
+    latency_pair* pair = &pairs[i];
+    printf("\nLatency 0x%03X -> 0x%03X: ", pair->trigger, pair->response);
+    if (pair->count == 0) {
+      printf("no responses\n");
+    } else {
+      printf("%u samples, min/avg/max %llu/%llu/%llu us\n", pair->count,
+          (unsigned long long) pair->min,
+          (unsigned long long) (pair->total / pair->count),
+          (unsigned long long) pair->max);
+    }
+  }
+}
+
+/**
+ * int reap_nodes(void)
+ *
+ * Records the status of nodes that have exited.
+ *
+ * @returns Whether nodes were started and every one has exited
+ */
+static int reap_nodes(void) {
+  int status;
+  pid_t pid;
+  int spawned = 0;
+  int running = 0;
+  int i;
+
+  while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+    for (i = 0; i < num_nodes; i++) {
+      if (nodes[i].pid == pid) {
+        nodes[i].exited = 1;
+        nodes[i].failed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+        if (nodes[i].failed) {
+          fprintf(stderr, "canbus: %s failed\n", nodes[i].name);
+        }
+      }
+    }
+  }
+
+  for (i = 0; i < num_nodes; i++) {
+    spawned |= nodes[i].pid > 0;
+    running |= nodes[i].pid > 0 && !nodes[i].exited;
+  }
+  return spawned && !running;
+}
+
+static void on_signal(int sig) {
+  (void) sig;
+  stop = 1;
+}
+
+static void usage(const char* name) {
+  fprintf(stderr, "Usage: %s [-t seconds] [-b bitrate] [-r replay.log] "
+      "[-l trigger:response]... [-e [node:]probability[@start-end]]... [-v] node...\n",
+      name);
+  exit(2);
+}
+
+/**
+ * int parse_fault(char* spec)
+ *
+ * Adds the error injection described by a -e argument.
+ *
+ * @returns 0 on success, -1 if <spec> is malformed
+ */
+static int parse_fault(char* spec) {
+  bus_fault* fault = &faults[num_faults];
+  char* colon = strchr(spec, ':');
+  char* at = strchr(spec, '@');
+  double start = 0;
+  double end = 0;
+
+  if (num_faults == MAX_FAULTS) {
+    return -1;
+  }
+  memset(fault, 0, sizeof(bus_fault));
+  if (colon != NULL) {
+    *colon = '\0';
+    fault->name = spec;
+    spec = colon + 1;
+  }
+  if (at != NULL && sscanf(at + 1, "%lf-%lf", &start, &end) != 2) {
+    return -1;
+  }
+  fault->probability = atof(spec);
+  fault->start = (uint64_t) (start * 1000000.0);
+  fault->end = (uint64_t) (end * 1000000.0);
+  num_faults++;
+  return 0;
+}
+
+int main(int argc, char* argv[]) {
+  double seconds = DEFAULT_SECONDS;
+  const char* replay_file = NULL;
+  struct sockaddr_un addr;
+  struct pollfd fds[MAX_NODES + 1];
+  int listen_fd;
+  int wire = -1;
+  int wire_error = 0;
+  uint64_t wire_end = 0;
+  int hold = -1;
+  uint64_t hold_end = 0;
+  uint64_t resume = 0;
+  uint64_t busy = 0;
+  uint64_t end;
+  uint64_t now;
+  int result = 0;
+  int opt;
+  int i;
+
+  while ((opt = getopt(argc, argv, "t:b:r:l:e:v")) != -1) {
+    switch (opt) {
+      case 't':
+        seconds = atof(optarg);
+        break;
+      case 'b':
+        bitrate = (uint32_t) strtoul(optarg, NULL, 10);
+        break;
+      case 'r':
+        replay_file = optarg;
+        break;
+      case 'l':
+        if (num_pairs == MAX_PAIRS ||
+            sscanf(optarg, "%x:%x", &pairs[num_pairs].trigger, &pairs[num_pairs].response) != 2) {
+          usage(argv[0]);
+        }
+        num_pairs++;
+        break;
+      case 'e':
+        if (parse_fault(optarg) != 0) {
+          usage(argv[0]);
+        }
+        break;
+      case 'v':
+        verbose = 1;
+        break;
+      default:
+        usage(argv[0]);
+    }
+  }
+  if (bitrate == 0 || (optind == argc && replay_file == NULL) ||
+      argc - optind > MAX_NODES) {
+    usage(argv[0]);
+  }
+
+  for (i = optind; i < argc; i++) {
+    char* name = strndup(argv[i], strcspn(argv[i], " "));
+    const char* slash = strrchr(name, '/');
+    nodes[num_nodes].name = slash ? slash + 1 : name;
+    nodes[num_nodes].fd = -1;
+    num_nodes++;
+  }
+  if (replay_file != NULL) {
+    if (load_replay(replay_file) != 0) {
+      fprintf(stderr, "canbus: cannot read %s\n", replay_file);
+      return 1;
+    }
+    replay_node = num_nodes;
+    nodes[num_nodes].name = "replay";
+    nodes[num_nodes].fd = -1;
+    num_nodes++;
+  }
+
+  // Listen before starting the nodes so none of them miss the bus
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  snprintf(addr.sun_path, sizeof(addr.sun_path), "/tmp/canbus.%d.sock", (int) getpid());
+  unlink(addr.sun_path);
+  listen_fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+  if (listen_fd < 0 || bind(listen_fd, (struct sockaddr*) &addr, sizeof(addr)) != 0 ||
+      listen(listen_fd, MAX_NODES) != 0) {
+    fprintf(stderr, "canbus: cannot listen at %s: %s\n", addr.sun_path, strerror(errno));
+    return 1;
+  }
+
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  signal(SIGPIPE, SIG_IGN);
+  srand48(FAULT_SEED);
+  clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+  for (i = 0; i < num_nodes; i++) {
+    if (i == replay_node) {
+      continue;
+    }
+    nodes[i].pid = fork();
+    if (nodes[i].pid == 0) {
+      char index[12]; // Fits any int
+      snprintf(index, sizeof(index), "%d", i);
+      setenv("FSAE_HOST_BUS", addr.sun_path, 1);
+      setenv("FSAE_HOST_NODE", index, 1);
+      if (strchr(argv[optind + i], ' ') != NULL) {
+        char* command;
+        if (asprintf(&command, "exec %s", argv[optind + i]) > 0) {
+          execl("/bin/sh", "sh", "-c", command, (char*) NULL);
+        }
+      } else {
+        execl(argv[optind + i], argv[optind + i], (char*) NULL);
+      }
+      fprintf(stderr, "canbus: cannot run %s: %s\n", argv[optind + i], strerror(errno));
+      _exit(127);
+    }
+  }
+
+  end = (uint64_t) (seconds * 1000000.0);
+  while (!stop && (now = now_us()) < end) {
+    uint64_t wait = MAX_WAIT_US;
+    struct timespec timeout;
+    int n;
+
+    if (reap_nodes()) {
+      break;
+    }
+
+    if (wire >= 0 && now >= wire_end && wire_error) {
+      // The frame stays pending and arbitrates again with the others
+      destroy(wire);
+      wire = -1;
+    } else if (wire >= 0 && now >= wire_end) {
+      complete(wire, wire_end);
+
+      // The module sends queued frames back to back, so wait for the node to
+      // offer its next one and arbitrate as if it had been there all along
+      if (nodes[wire].queued > 0 && nodes[wire].fd >= 0) {
+        hold = wire;
+        hold_end = now + MAX_HOLD_US;
+      }
+      wire = -1;
+    }
+    if (hold >= 0 && (nodes[hold].pending || nodes[hold].fd < 0 || now >= hold_end)) {
+      resume = nodes[hold].pending ? wire_end : 0;
+      hold = -1;
+    }
+
+    if (replay_node >= 0 && !nodes[replay_node].pending && replay_pos < replay_len &&
+        now >= replay[replay_pos].time) {
+      nodes[replay_node].frame = replay[replay_pos].frame;
+      nodes[replay_node].submitted = replay[replay_pos].time;
+      nodes[replay_node].pending = 1;
+      replay_pos++;
+    }
+
+    if (wire < 0 && hold < 0) {
+      // Back to back with the previous frame if the bus was held for it
+      uint64_t start = resume != 0 ? resume : now;
+      resume = 0;
+      wire = arbitrate(start);
+      if (wire >= 0) {
+        uint64_t duration = frame_time_us(&nodes[wire].frame);
+
+        // A destroyed frame is charged its full length, then the error frame
+        wire_error = corrupted(wire, start);
+        if (wire_error) {
+          duration += (ERROR_FRAME_BITS * 1000000ULL + bitrate - 1) / bitrate;
+        }
+        wire_end = start + duration;
+        busy += duration;
+      }
+    }
+
+    if (hold >= 0) {
+      wait = hold_end - now;
+    } else if (wire >= 0) {
+      wait = wire_end > now ? wire_end - now : 0;
+    } else if (replay_node >= 0 && !nodes[replay_node].pending && replay_pos < replay_len) {
+      wait = replay[replay_pos].time > now ? replay[replay_pos].time - now : 0;
+    }
+    if (wait > MAX_WAIT_US) {
+      wait = MAX_WAIT_US;
+    }
+
+    fds[0].fd = listen_fd;
+    fds[0].events = POLLIN;
+    for (i = 0; i < num_nodes; i++) {
+      fds[i + 1].fd = nodes[i].fd;
+      fds[i + 1].events = POLLIN;
+    }
+    timeout.tv_sec = wait / 1000000;
+    timeout.tv_nsec = (wait % 1000000) * 1000;
+    n = ppoll(fds, num_nodes + 1, &timeout, NULL);
+    if (n <= 0) {
+      continue;
+    }
+
+    now = now_us();
+    if (fds[0].revents & POLLIN) {
+      accept_node(listen_fd);
+    }
+    for (i = 0; i < num_nodes; i++) {
+      // Skips a connection accept_node() just replaced
+      if (fds[i + 1].fd >= 0 && fds[i + 1].fd == nodes[i].fd &&
+          (fds[i + 1].revents & (POLLIN | POLLHUP))) {
+        handle_node(i, now, i == wire);
+      }
+    }
+  }
+
+  print_report(now_us() < end ? now_us() : end, busy);
+
+  reap_nodes();
+  for (i = 0; i < num_nodes; i++) {
+    if (nodes[i].pid > 0 && !nodes[i].exited) {
+      kill(nodes[i].pid, SIGTERM);
+      waitpid(nodes[i].pid, NULL, 0);
+    }
+    result |= nodes[i].failed;
+  }
+  close(listen_fd);
+  unlink(addr.sun_path);
+  free(replay);
+
+  return result;
+}
@@ -0,0 +1,387 @@
+/**
+ * CAN Firmware Flasher
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs as a node under canbus, or on a SocketCAN interface named by
+ * FSAE_HOST_SOCKETCAN, and updates the firmware of one or more nodes over
+ * ISO-TP at the same time, see FSAE_boot.h. Each block is retried when the
+ * node reports a CRC error or doesn't reply, and each node is checked to be
+ * running the new image after it restarts. Quote it with its arguments as one
+ * node argument to canbus.
+ *
+ * Usage: canflash [-t seconds] [-c N] IMAGE BASE...
+ *
+ *   IMAGE  Raw program flash contents, linked at BOOT_LOWER
+ *   BASE   Base ID of each node to update, in hex
+ *
+ *   -t  Longest wait for each reply, default 2 seconds
+ *   -c  Corrupts every Nth block the first time it is sent, to test retries
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "CAN.h"
+#include "FSAE_boot.h"
+#include "FSAE_can.h"
+#include "FSAE_isotp.h"
+
+#define MAX_TARGETS 8
+#define RETRIES     3
+#define POLL_MS     100  // Between status requests while a node restarts
+#define RESTART_MS  5000 // Longest wait for a node to run the new image
+
+// Time left before exiting for the last frames queued to reach the bus
+#define LINGER_MS 100
+
+enum {
+  STATE_STATUS,  // Reading the sequence number of the running image
+  STATE_BEGIN,
+  STATE_BLOCK,
+  STATE_COMMIT,
+  STATE_RESTART, // Waiting for the node to run the new image
+  STATE_DONE,
+  STATE_FAILED
+};
+
+typedef struct {
+  ISOTP_link tp; // First, so a link's handlers can find its target
+  uint32_t base;
+  uint8_t state;
+  uint8_t req[BOOT_REQ_HDR + BOOT_BLOCK_MAX];
+  uint8_t reply[16];
+  volatile uint32_t reply_len; // Set once a reply has been received
+  uint32_t offset;             // Of the block being sent
+  uint32_t tries;              // Attempts at the current request
+  uint32_t retries;            // Retries over the whole update
+  uint32_t old_seq;
+  uint64_t sent;               // When the current request was sent, 0 if not yet
+  uint64_t start;
+  uint64_t restart;
+} target;
+
+// Defined for FSAE_can, driven from the main loop here
+volatile uint32_t millis = 0;
+
+static target targets[MAX_TARGETS];
+static uint32_t num_targets = 0;
+static uint8_t* image;
+static uint32_t image_len = 0;
+static uint32_t image_crc;
+static uint32_t timeout_ms = 2000;
+static uint32_t corrupt_every = 0;
+
+static void on_rx(ISOTP_link* l, uint8_t* data, uint32_t len) {
+  ((target*) l)->reply_len = len;
+}
+
+static void on_frame(CAN_message msg) {
+  uint32_t i;
+  for (i = 0; i < num_targets; i++) {
+    if (msg.id == targets[i].base + ISOTP_RESP_OFFSET) {
+      ISOTP_receive(&targets[i].tp, msg);
+    }
+  }
+}
+
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
+  if (C1INTbits.RBIF) {
+    CAN_dispatch_messages();
+  }
+
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
+  }
+
+  IFS4CLR = _IFS4_CAN1IF_MASK; // Clear CAN1 Interrupt Flag
+}
+
+/**
+ * void put_be32(uint8_t* data, uint32_t value)
+ *
+ * Stores <value> big-endian, as the boot requests carry it.
+ */
+static void put_be32(uint8_t* data, uint32_t value) {
+  data[0] = value >> 24;
+  data[1] = (value >> 16) & 0xFF;
+  data[2] = (value >> 8) & 0xFF;
+  data[3] = value & 0xFF;
+}
+
+/**
+ * uint32_t get_be32(const uint8_t* data)
+ *
+ * @returns The big-endian word at <data>
+ */
+static uint32_t get_be32(const uint8_t* data) {
+  return ((uint32_t) data[0] << 24) | ((uint32_t) data[1] << 16) |
+    ((uint32_t) data[2] << 8) | data[3];
+}
+
+/**
+ * uint32_t block_len(target* t)
+ *
+ * @returns The length of the block at <t>'s offset, short only at the end
+ */
+static uint32_t block_len(target* t) {
+  uint32_t left = image_len - t->offset;
+  return left < BOOT_BLOCK_MAX ? left : BOOT_BLOCK_MAX;
+}
+
+/**
+ * void fail(target* t, const char* why, uint8_t status)
+ *
+ * Gives up on updating <t>.
+ */
+static void fail(target* t, const char* why, uint8_t status) {
+  fprintf(stderr, "canflash: %03X %s, status %u%s\n", t->base, why, status,
+      status == BOOT_ERR_PARKED ? " (the car is not parked)" : "");
+  t->state = STATE_FAILED;
+}
+
+/**
+ * void send_request(target* t)
+ *
+ * Sends the request for <t>'s state, unless its link is still busy.
+ */
+static void send_request(target* t) {
+  uint32_t len = 1;
+  uint32_t size;
+
+  switch (t->state) {
+    case STATE_STATUS:
+    case STATE_RESTART:
+      t->req[0] = BOOT_STATUS_REQ;
+      break;
+    case STATE_BEGIN:
+      t->req[0] = BOOT_BEGIN_REQ;
+      put_be32(&t->req[1], image_len);
+      put_be32(&t->req[5], image_crc);
+      len = BOOT_REQ_HDR;
+      break;
+    case STATE_BLOCK:
+      size = block_len(t);
+      t->req[0] = BOOT_BLOCK_REQ;
+      put_be32(&t->req[1], t->offset);
+      put_be32(&t->req[5], crc32(0, image + t->offset, size));
+      memcpy(&t->req[BOOT_REQ_HDR], image + t->offset, size);
+      if (corrupt_every && t->tries == 0 && (t->offset / BOOT_BLOCK_MAX) % corrupt_every == 0) {
+        t->req[BOOT_REQ_HDR] ^= 0xFF;
+      }
+      len = BOOT_REQ_HDR + size;
+      break;
+    case STATE_COMMIT:
+      t->req[0] = BOOT_COMMIT_REQ;
+      break;
+  }
+
+  if (ISOTP_send(&t->tp, t->req, len) == ISOTP_SUCCESS) {
+    t->reply_len = 0;
+    t->sent = host_micros();
+  }
+}
+
+/**
+ * void handle_reply(target* t)
+ *
+ * Moves <t> on according to the reply to its current request.
+ */
+static void handle_reply(target* t) {
+  uint8_t status = t->reply[0];
+  uint8_t is_status = t->reply_len == 13 && status == BOOT_SUCCESS;
+  double seconds;
+
+  switch (t->state) {
+    case STATE_STATUS:
+      if (!is_status) {
+        fail(t, "status request failed", status);
+        return;
+      }
+      t->old_seq = get_be32(&t->reply[1]);
+      printf("%03X running image %u, CRC32 %08X\n", t->base, t->old_seq,
+          get_be32(&t->reply[9]));
+      t->state = STATE_BEGIN;
+      t->start = host_micros();
+      t->retries = 0; // Nodes may still be starting up before this
+      break;
+    case STATE_BEGIN:
+      if (status != BOOT_SUCCESS) {
+        fail(t, "begin request failed", status);
+        return;
+      }
+      t->state = STATE_BLOCK;
+      t->offset = 0;
+      break;
+    case STATE_BLOCK:
+      if (status == BOOT_ERR_CRC && t->tries < RETRIES) {
+        t->tries++;
+        t->retries++;
+        return;
+      } else if (status != BOOT_SUCCESS) {
+        fprintf(stderr, "canflash: %03X block at 0x%X failed\n", t->base, t->offset);
+        fail(t, "block request failed", status);
+        return;
+      }
+      t->offset += block_len(t);
+      if (t->offset == image_len) {
+        t->state = STATE_COMMIT;
+      }
+      break;
+    case STATE_COMMIT:
+      if (status != BOOT_SUCCESS) {
+        fail(t, "commit request failed", status);
+        return;
+      }
+      seconds = (host_micros() - t->start) / 1000000.0;
+      printf("%03X sent %u bytes in %.3f s, %.0f bytes/s, %u retries\n", t->base,
+          image_len, seconds, seconds > 0 ? image_len / seconds : 0.0, t->retries);
+      t->state = STATE_RESTART;
+      t->restart = host_micros();
+      break;
+    case STATE_RESTART:
+      if (is_status && get_be32(&t->reply[1]) == t->old_seq + 1) {
+        if (get_be32(&t->reply[5]) != image_len || get_be32(&t->reply[9]) != image_crc) {
+          fail(t, "restarted with a different image", status);
+          return;
+        }
+        printf("%03X running image %u\n", t->base, t->old_seq + 1);
+        t->state = STATE_DONE;
+      }
+      return;
+  }
+  t->tries = 0;
+}
+
+/**
+ * void step(target* t)
+ *
+ * Advances the update of one node without blocking.
+ */
+static void step(target* t) {
+  uint64_t now = host_micros();
+
+  if (t->state == STATE_DONE || t->state == STATE_FAILED) {
+    return;
+  }
+
+  if (t->state == STATE_RESTART) {
+    // The node drops off the bus while it restarts, so replies go missing
+    if (now - t->restart > RESTART_MS * 1000ULL) {
+      fail(t, "did not restart with the new image", 0);
+    } else if (t->sent != 0 && t->reply_len != 0) {
+      handle_reply(t);
+      t->sent = 0;
+    } else if (t->sent == 0 || now - t->sent > POLL_MS * 1000ULL) {
+      send_request(t);
+    }
+    return;
+  }
+
+  if (t->sent == 0) {
+    send_request(t);
+  } else if (t->reply_len != 0) {
+    t->sent = 0;
+    handle_reply(t);
+  } else if (now - t->sent > timeout_ms * 1000ULL) {
+    t->sent = 0;
+    if (t->tries++ == RETRIES) {
+      fail(t, "stopped replying", 0);
+    }
+    t->retries++;
+  }
+}
+
+/**
+ * uint8_t* read_file(const char* path, uint32_t* len)
+ *
+ * @returns The contents of the file at <path>, or NULL if it can't be read
+ */
+static uint8_t* read_file(const char* path, uint32_t* len) {
+  FILE* file = fopen(path, "rb");
+  uint8_t* data;
+  long size;
+
+  if (file == NULL || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0) {
+    fprintf(stderr, "canflash: cannot read %s\n", path);
+    return NULL;
+  }
+  rewind(file);
+  data = malloc(size + 1);
+  *len = (uint32_t) fread(data, 1, size, file);
+  fclose(file);
+  return data;
+}
+
+static void usage(void) {
+  fprintf(stderr, "Usage: canflash [-t seconds] [-c N] IMAGE BASE...\n");
+  exit(2);
+}
+
+int main(int argc, char* argv[]) {
+  uint64_t linger;
+  uint32_t busy;
+  uint32_t i;
+  int result = 0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "t:c:")) != -1) {
+    switch (opt) {
+      case 't':
+        timeout_ms = (uint32_t) (atof(optarg) * 1000);
+        break;
+      case 'c':
+        corrupt_every = (uint32_t) strtoul(optarg, NULL, 0);
+        break;
+      default:
+        usage();
+    }
+  }
+  if (argc - optind < 2 || argc - optind - 1 > MAX_TARGETS) {
+    usage();
+  }
+  if ((image = read_file(argv[optind], &image_len)) == NULL) {
+    return 1;
+  }
+  if (image_len == 0 || image_len > BOOT_IMAGE_MAX) {
+    fprintf(stderr, "canflash: image must be 1 to %u bytes\n", BOOT_IMAGE_MAX);
+    return 1;
+  }
+  image_crc = crc32(0, image, image_len);
+
+  for (i = optind + 1; i < (uint32_t) argc; i++) {
+    target* t = &targets[num_targets++];
+    t->base = (uint32_t) strtoul(argv[i], NULL, 16);
+    t->state = STATE_STATUS;
+    ISOTP_init(&t->tp, t->base + ISOTP_REQ_OFFSET, t->base + ISOTP_RESP_OFFSET,
+        t->reply, sizeof(t->reply), on_rx, NULL);
+    CAN_subscribe(t->base + ISOTP_RESP_OFFSET, 1, on_frame, CAN_NORMAL);
+  }
+  init_can();
+  STI();
+
+  printf("Flashing %u bytes, CRC32 %08X\n", image_len, image_crc);
+  do {
+    millis = (uint32_t) (host_micros() / 1000);
+    busy = 0;
+    for (i = 0; i < num_targets; i++) {
+      ISOTP_service(&targets[i].tp);
+      step(&targets[i]);
+      busy |= targets[i].state != STATE_DONE && targets[i].state != STATE_FAILED;
+    }
+  } while (busy);
+
+  linger = host_micros() + LINGER_MS * 1000;
+  while (host_micros() < linger) {
+    for (i = 0; i < num_targets; i++) {
+      ISOTP_service(&targets[i].tp);
+    }
+  }
+
+  for (i = 0; i < num_targets; i++) {
+    result |= targets[i].state != STATE_DONE;
+  }
+  return result;
+}
@@ -0,0 +1,34 @@
+/**
+ * Generated CAN Header Writer
+ *
+ * Processor:   Linux host
+ * Compiler:    g++
+ * Created:     2026
+ *
+ * Runs can-translator's code generator, as can-translator --codegen does,
+ * without the rest of the translator and its Qt Widgets dependency. Reads the
+ * config.dbc next to the executable, for the codegen test.
+ *
+ * Usage: codegen_gen HEADER
+ */
+#include <stdio.h>
+#include "codegen.h"
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s HEADER\n", argv[0]);
+    return 1;
+  }
+
+  AppCodeGen codeGen;
+  bool successful = codeGen.generate(QString(argv[1]));
+
+  QTextStream out(stdout);
+  for (int i = 0; i < codeGen.report.size(); i++) {
+    out << codeGen.report[i] << "\n";
+  }
+  out.flush();
+
+  return successful ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/**
+ * Generated CAN Header Test
+ *
+ * Processor:   Linux host
+ * Compiler:    g++
+ * Created:     2026
+ *
+ * Built against the CAN_gen.h that can-translator --codegen writes from
+ * codegen_test.dbc, which covers big and little endian, signed and unsigned,
+ * odd widths and signals that straddle bytes. For random frames, every
+ * signal's unpack function converted with its Q16.16 constants must match
+ * the translator's own decoder to within the constants' rounding. Packing a
+ * random value must read back the same, keep the bits of every other signal,
+ * and each message's struct must pack back to the bits it was unpacked from.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include "config.h"
+#include "CAN_gen.h"
+
+#define TRIALS 100000
+#define SEED   2016
+
+static map<uint16_t, Message> messages;
+static int checked = 0;
+static int failures = 0;
+
+/**
+ * uint64_t frame_bits(const uint8_t* data)
+ *
+ * @returns The 8 bytes at <data> as Signal::decode() takes them, byte 0 low
+ */
+static uint64_t frame_bits(const uint8_t* data) {
+  uint64_t bits = 0;
+  for (int i = 0; i < 8; i++) {
+    bits |= ((uint64_t) data[i]) << (8 * i);
+  }
+  return bits;
+}
+
+static void random_frame(uint8_t* data) {
+  for (int i = 0; i < 8; i++) {
+    data[i] = (uint8_t) rand();
+  }
+}
+
+/**
+ * void check(...)
+ *
+ * Checks one signal's generated functions and constants against its
+ * definition in config.dbc, and ORs the bits it covers into <mask>.
+ */
+template <typename T>
+static void check(uint16_t id, const char* title, T (*unpack)(const uint8_t*),
+    void (*pack)(uint8_t*, T), long long scl, long long off, uint8_t* mask) {
+  const Signal* sig = NULL;
+  Message& msg = messages[id];
+  for (int i = 0; i < msg.sigs.size(); i++) {
+    if (msg.sigs[i].title == title) {
+      sig = &msg.sigs[i];
+    }
+  }
+  if (sig == NULL) {
+    printf("%s: not in config.dbc\n", title);
+    failures++;
+    return;
+  }
+  checked++;
+
+  // The bits the signal covers, from packing all ones into an empty frame
+  uint8_t bits[8] = {0};
+  pack(bits, (T) ~(T) 0);
+  for (int i = 0; i < 8; i++) {
+    mask[i] |= bits[i];
+  }
+
+  int decodeErrors = 0;
+  int packErrors = 0;
+  for (int t = 0; t < TRIALS; t++) {
+    uint8_t data[8], other[8], packed[8];
+    random_frame(data);
+    random_frame(other);
+
+    // Physical value in Q16.16, as CAN_GEN_Q16 converts it
+    T raw = unpack(data);
+    double actual = (double) (((long long) raw) * scl + off) / 65536.0;
+    double expected = sig->decode(frame_bits(data));
+    double tolerance = (fabs((double) raw) + 1.0) * 0.5 / 65536.0 + 1e-9 * fabs(expected);
+    if (fabs(actual - expected) > tolerance) {
+      if (decodeErrors++ == 0) {
+        printf("%s: raw %lld decodes to %f, translator %f\n", title, (long long) raw,
+            actual, expected);
+      }
+    }
+
+    // Any value the field holds, packed over a random frame
+    T value = unpack(other);
+    memcpy(packed, data, sizeof(packed));
+    pack(packed, value);
+    bool kept = true;
+    for (int i = 0; i < 8; i++) {
+      kept = kept && ((packed[i] ^ data[i]) & ~bits[i]) == 0;
+    }
+    if (unpack(packed) != value || !kept) {
+      if (packErrors++ == 0) {
+        printf("%s: packing %lld gave %lld%s\n", title, (long long) value,
+            (long long) unpack(packed), kept ? "" : ", other bits changed");
+      }
+    }
+  }
+
+  if (decodeErrors != 0 || packErrors != 0) {
+    printf("%s: %d decode and %d pack errors in %d frames\n", title, decodeErrors,
+        packErrors, TRIALS);
+    failures++;
+  }
+}
+
+/**
+ * void check_message(...)
+ *
+ * Checks that unpacking a message into its struct and packing it back gives
+ * the bits of its signals in <mask> and clears the rest of its <dlc> bytes.
+ */
+template <typename M>
+static void check_message(uint16_t id, uint8_t dlc, const char* name,
+    void (*unpack)(const uint8_t*, M*), void (*pack)(uint8_t*, const M*),
+    const uint8_t* mask) {
+  if (messages[id].name != name || messages[id].dlc != dlc) {
+    printf("%s: ID or DLC does not match config.dbc\n", name);
+    failures++;
+    return;
+  }
+
+  for (int t = 0; t < TRIALS; t++) {
+    uint8_t data[8], packed[8];
+    M msg;
+    random_frame(data);
+    memcpy(packed, data, sizeof(packed));
+
+    unpack(data, &msg);
+    pack(packed, &msg);
+    for (int i = 0; i < 8; i++) {
+      uint8_t expected = i < dlc ? data[i] & mask[i] : data[i];
+      if (packed[i] != expected) {
+        printf("%s: byte %d packed as 0x%02X, expected 0x%02X\n", name, i, packed[i],
+            expected);
+        failures++;
+        return;
+      }
+    }
+  }
+}
+
+#define CHECK_SIGNAL(msg, sig, mask) \
+  check(CAN_##msg##_ID, #sig, CAN_unpack_##msg##_##sig, CAN_pack_##msg##_##sig, \
+      CAN_##msg##_##sig##_SCL_Q16, CAN_##msg##_##sig##_OFF_Q16, mask)
+
+#define CHECK_MESSAGE(msg, mask) \
+  check_message<CAN_##msg##_t>(CAN_##msg##_ID, CAN_##msg##_DLC, #msg, CAN_unpack_##msg, \
+      CAN_pack_##msg, mask)
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+  AppConfig config;
+  messages = config.getMessages();
+  srand(SEED);
+
+  uint8_t engine[8] = {0};
+  CHECK_SIGNAL(Engine, RPM, engine);
+  CHECK_SIGNAL(Engine, Throttle, engine);
+  CHECK_SIGNAL(Engine, Lambda, engine);
+  CHECK_SIGNAL(Engine, Pressure, engine);
+  CHECK_MESSAGE(Engine, engine);
+
+  uint8_t gear[8] = {0};
+  CHECK_SIGNAL(Gear, Gear, gear);
+  CHECK_SIGNAL(Gear, Shift, gear);
+  CHECK_SIGNAL(Gear, Temp, gear);
+  CHECK_SIGNAL(Gear, Flag, gear);
+  CHECK_SIGNAL(Gear, Count, gear);
+  CHECK_SIGNAL(Gear, Odd, gear);
+  CHECK_MESSAGE(Gear, gear);
+
+  uint8_t logger[8] = {0};
+  CHECK_SIGNAL(Logger, Time, logger);
+  CHECK_SIGNAL(Logger, Delta, logger);
+  CHECK_MESSAGE(Logger, logger);
+
+  uint8_t hub[8] = {0};
+  CHECK_SIGNAL(Hub, Small, hub);
+  CHECK_SIGNAL(Hub, Wide, hub);
+  CHECK_SIGNAL(Hub, Tail, hub);
+  CHECK_MESSAGE(Hub, hub);
+
+  // Every signal in config.dbc must have been generated and checked
+  int total = 0;
+  typedef map<uint16_t, Message>::iterator it_msg;
+  for (it_msg msgIt = messages.begin(); msgIt != messages.end(); msgIt++) {
+    total += msgIt->second.sigs.size();
+  }
+  if (total == 0 || checked != total) {
+    printf("Checked %d of the %d signals in config.dbc\n", checked, total);
+    failures++;
+  }
+
+  printf("%d signals in %d frames each, %d failed\n", checked, TRIALS, failures);
+  printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,30 @@
+/**
+ * Firmware Cross-Check Runner
+ *
+ * Processor:   Linux host
+ * Compiler:    g++
+ * Created:     2026
+ *
+ * Runs can-translator's firmware cross-check, as can-translator --crosscheck
+ * does, without the rest of the translator and its Qt Widgets dependency.
+ * Reads crosscheck.cfg, CAN.h and config.dbc next to the executable, prints
+ * the report and exits with status 1 if any signal disagrees.
+ *
+ * Usage: crosscheck_run
+ */
+#include "crosscheck.h"
+
+int main(int argc, char* argv[]) {
+  QCoreApplication app(argc, argv);
+
+  AppCrossCheck crossCheck;
+  bool passed = crossCheck.run();
+
+  QTextStream out(stdout);
+  for (int i = 0; i < crossCheck.report.size(); i++) {
+    out << crossCheck.report[i] << "\n";
+  }
+  out.flush();
+
+  return passed ? 0 : 1;
+}
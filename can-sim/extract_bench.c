@@ -0,0 +1,93 @@
+/**
+ * Fixed Point Extraction Benchmark
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Times CAN_extract_numeric(), CAN_extract_q16() and CAN_extract_scaled()
+ * decoding 2 byte big endian fields with the TEMP scalar and offset, as the
+ * nodes do for MoTeC temperatures, and prints the cost per field of each. The
+ * host has a hardware FPU and the PIC32's double maths is in software, so the
+ * gap on the target is far wider; compare the functions against each other.
+ */
+#include <stdio.h>
+#include <time.h>
+#include "FSAE_can.h"
+#include "CAN.h"
+
+#define ROUNDS 2000
+#define FIELDS 4096
+
+// Required by FSAE_can for receive timestamps, which are unused here
+volatile uint32_t millis = 0;
+
+static volatile uint32_t sink = 0;
+static uint8_t frames[FIELDS][8];
+
+/**
+ * uint64_t bench_ns(void)
+ *
+ * @returns Monotonic time in nanoseconds
+ */
+static uint64_t bench_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * void bench(const char* name, uint8_t api)
+ *
+ * Decodes every field ROUNDS times with one function and prints the average
+ * cost per field, and that of the fastest round.
+ */
+static void bench(const char* name, uint8_t api) {
+  uint64_t ns = 0;
+  uint64_t best = UINT64_MAX;
+  uint32_t round, i;
+
+  for (round = 0; round < ROUNDS; round++) {
+    uint64_t start = bench_ns();
+    switch (api) {
+      case 0:
+        for (i = 0; i < FIELDS; i++) {
+          sink += (uint32_t) (int32_t) (CAN_extract_numeric(frames[i], 0, 2, BIG, 1,
+                TEMP_SCL, -4000) * 100);
+        }
+        break;
+      case 1:
+        for (i = 0; i < FIELDS; i++) {
+          sink += (uint32_t) CAN_extract_q16(frames[i], 0, 2, BIG, 1, Q16(TEMP_SCL), -4000);
+        }
+        break;
+      default:
+        for (i = 0; i < FIELDS; i++) {
+          sink += (uint32_t) CAN_extract_scaled(frames[i], 0, 2, BIG, 1, 1, 1, -4000);
+        }
+        break;
+    }
+    start = bench_ns() - start;
+    ns += start;
+    if (start < best) {
+      best = start;
+    }
+  }
+
+  printf("%-20s %8.2f ns/field (best %6.2f)\n", name, (double) ns / ROUNDS / FIELDS,
+      (double) best / FIELDS);
+}
+
+int main(void) {
+  uint32_t i;
+  for (i = 0; i < FIELDS; i++) {
+    frames[i][0] = (uint8_t) (i * 37);
+    frames[i][1] = (uint8_t) (i * 101 + 7);
+  }
+
+  bench("CAN_extract_numeric", 0);
+  bench("CAN_extract_q16", 1);
+  bench("CAN_extract_scaled", 2);
+
+  return 0;
+}
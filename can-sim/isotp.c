@@ -0,0 +1,335 @@
+/**
+ * ISO-TP Transfer Tool
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs as a node under canbus and moves bulk data to and from a node over
+ * ISO-TP, printing the throughput of each transfer. Quote it with its
+ * arguments as one node argument to canbus.
+ *
+ * Usage: isotp [-n id] [-s stmin] [-t seconds] [-e] command
+ *
+ *   send FILE            Sends FILE as one message
+ *   recv OUT             Waits for one message and writes it to OUT
+ *   xfer FILE [OUT]      Sends FILE and writes the reply to OUT
+ *   dump ADDR LEN OUT    Reads LEN bytes of the node's NVM from ADDR into OUT
+ *   load ADDR FILE       Writes FILE to the node's NVM at ADDR
+ *
+ *   -n  Base ID of the node in hex, default the Logger's. Requests go to the
+ *       base plus ISOTP_REQ_OFFSET and replies come from the base plus
+ *       ISOTP_RESP_OFFSET
+ *   -s  STmin to ask the node for, encoded as in a flow control frame
+ *   -t  Longest wait for each message, default 10 seconds
+ *   -e  Fails xfer unless the reply matches what was sent
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "CAN.h"
+#include "FSAE_can.h"
+#include "FSAE_isotp.h"
+#include "FSAE_nvm.h"
+
+#define RX_MAX (1 << 20)
+
+// Time left before exiting for the last frames queued to reach the bus
+#define LINGER_MS 100
+
+// Defined for FSAE_can, driven from the main loop here
+volatile uint32_t millis = 0;
+
+static ISOTP_link tp;
+static uint8_t rx_buf[RX_MAX];
+static uint32_t rx_len = 0;
+static uint8_t rx_done = 0;
+static uint8_t tx_done = 0;
+static uint8_t tx_result = ISOTP_SUCCESS;
+static uint32_t timeout_ms = 10000;
+
+static void on_rx(ISOTP_link* l, uint8_t* data, uint32_t len) {
+  rx_len = len;
+  rx_done = 1;
+}
+
+static void on_tx(ISOTP_link* l, uint8_t result) {
+  tx_result = result;
+  tx_done = 1;
+}
+
+static void on_frame(CAN_message msg) {
+  ISOTP_receive(&tp, msg);
+}
+
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
+  if (C1INTbits.RBIF) {
+    CAN_dispatch_messages();
+  }
+
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
+  }
+
+  IFS4CLR = _IFS4_CAN1IF_MASK; // Clear CAN1 Interrupt Flag
+}
+
+/**
+ * void service(void)
+ *
+ * One pass of the main loop.
+ */
+static void service(void) {
+  millis = (uint32_t) (host_micros() / 1000);
+  ISOTP_service(&tp);
+}
+
+/**
+ * void print_rate(const char* what, uint32_t len, uint64_t start)
+ *
+ * Prints the throughput of a transfer of <len> bytes begun at <start>.
+ */
+static void print_rate(const char* what, uint32_t len, uint64_t start) {
+  double seconds = (host_micros() - start) / 1000000.0;
+  printf("%s %u bytes in %.3f s, %.0f bytes/s\n", what, len, seconds,
+      seconds > 0 ? len / seconds : 0.0);
+}
+
+/**
+ * int send_message(const uint8_t* data, uint32_t len)
+ *
+ * Sends a message and waits for it to finish.
+ *
+ * @returns 0 on success, -1 on failure
+ */
+static int send_message(const uint8_t* data, uint32_t len) {
+  uint64_t start = host_micros();
+
+  tx_done = 0;
+  if (ISOTP_send(&tp, data, len) != ISOTP_SUCCESS) {
+    return -1;
+  }
+  while (!tx_done) {
+    service();
+  }
+  if (tx_result != ISOTP_SUCCESS) {
+    fprintf(stderr, "isotp: send failed with result %u\n", tx_result);
+    return -1;
+  }
+  print_rate("Sent", len, start);
+  return 0;
+}
+
+/**
+ * int recv_message(void)
+ *
+ * Waits up to the timeout for a message, which is left in <rx_buf>.
+ *
+ * @returns 0 on success, -1 on timeout
+ */
+static int recv_message(void) {
+  uint64_t start = host_micros();
+  uint64_t first = 0;
+
+  while (!rx_done) {
+    service();
+    if (first == 0 && tp.rx_state == ISOTP_RECV) {
+      first = host_micros();
+    }
+    if (host_micros() - start > timeout_ms * 1000ULL) {
+      fprintf(stderr, "isotp: no reply, %u errors\n", tp.errors);
+      return -1;
+    }
+  }
+  rx_done = 0;
+  print_rate("Received", rx_len, first != 0 ? first : start);
+  return 0;
+}
+
+/**
+ * uint8_t* read_file(const char* path, uint32_t* len)
+ *
+ * @returns The contents of the file at <path>, or NULL if it can't be read
+ */
+static uint8_t* read_file(const char* path, uint32_t* len) {
+  FILE* file = fopen(path, "rb");
+  uint8_t* data;
+  long size;
+
+  if (file == NULL || fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0) {
+    fprintf(stderr, "isotp: cannot read %s\n", path);
+    return NULL;
+  }
+  rewind(file);
+  data = malloc(size + 1);
+  *len = (uint32_t) fread(data, 1, size, file);
+  fclose(file);
+  return data;
+}
+
+/**
+ * int write_file(const char* path, const uint8_t* data, uint32_t len)
+ *
+ * @returns 0 on success, -1 on failure
+ */
+static int write_file(const char* path, const uint8_t* data, uint32_t len) {
+  FILE* file = fopen(path, "wb");
+  if (file == NULL || fwrite(data, 1, len, file) != len) {
+    fprintf(stderr, "isotp: cannot write %s\n", path);
+    return -1;
+  }
+  fclose(file);
+  return 0;
+}
+
+/**
+ * void put_be32(uint8_t* data, uint32_t value)
+ *
+ * Stores <value> big-endian, as the NVM requests carry it.
+ */
+static void put_be32(uint8_t* data, uint32_t value) {
+  data[0] = value >> 24;
+  data[1] = (value >> 16) & 0xFF;
+  data[2] = (value >> 8) & 0xFF;
+  data[3] = value & 0xFF;
+}
+
+/**
+ * int dump(uint32_t addr, uint32_t len, const char* out)
+ *
+ * Reads a range of the node's NVM into a file.
+ *
+ * @returns 0 on success, -1 on failure
+ */
+static int dump(uint32_t addr, uint32_t len, const char* out) {
+  uint8_t req[NVM_REQ_HDR + 4];
+
+  req[0] = NVM_READ_REQ;
+  put_be32(&req[1], addr);
+  put_be32(&req[NVM_REQ_HDR], len);
+  if (send_message(req, sizeof(req)) != 0 || recv_message() != 0) {
+    return -1;
+  }
+  if (rx_buf[0] != NVM_SUCCESS || rx_len != len + 1) {
+    fprintf(stderr, "isotp: read failed with status %u\n", rx_buf[0]);
+    return -1;
+  }
+  return write_file(out, &rx_buf[1], len);
+}
+
+/**
+ * int load(uint32_t addr, const char* path)
+ *
+ * Writes a file to the node's NVM, NVM_WRITE_MAX bytes per request.
+ *
+ * @returns 0 on success, -1 on failure
+ */
+static int load(uint32_t addr, const char* path) {
+  static uint8_t req[NVM_REQ_HDR + NVM_WRITE_MAX];
+  uint32_t len = 0;
+  uint32_t pos;
+  uint8_t* data = read_file(path, &len);
+
+  if (data == NULL) {
+    return -1;
+  }
+  for (pos = 0; pos < len; pos += NVM_WRITE_MAX) {
+    uint32_t size = len - pos < NVM_WRITE_MAX ? len - pos : NVM_WRITE_MAX;
+    req[0] = NVM_WRITE_REQ;
+    put_be32(&req[1], addr + pos);
+    memcpy(&req[NVM_REQ_HDR], data + pos, size);
+    if (send_message(req, NVM_REQ_HDR + size) != 0 || recv_message() != 0) {
+      return -1;
+    }
+    if (rx_len != 1 || rx_buf[0] != NVM_SUCCESS) {
+      fprintf(stderr, "isotp: write at 0x%X failed with status %u\n", addr + pos, rx_buf[0]);
+      return -1;
+    }
+  }
+  free(data);
+  return 0;
+}
+
+static void usage(void) {
+  fprintf(stderr, "Usage: isotp [-n id] [-s stmin] [-t seconds] [-e] "
+      "send FILE | recv OUT | xfer FILE [OUT] | dump ADDR LEN OUT | load ADDR FILE\n");
+  exit(2);
+}
+
+int main(int argc, char* argv[]) {
+  uint32_t base = LOGGER_ID;
+  uint8_t st_min = 0;
+  uint8_t expect = 0;
+  const char* cmd;
+  uint8_t* data;
+  uint32_t len = 0;
+  uint64_t linger;
+  int result = -1;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:s:t:e")) != -1) {
+    switch (opt) {
+      case 'n':
+        base = (uint32_t) strtoul(optarg, NULL, 16);
+        break;
+      case 's':
+        st_min = (uint8_t) strtoul(optarg, NULL, 16);
+        break;
+      case 't':
+        timeout_ms = (uint32_t) (atof(optarg) * 1000);
+        break;
+      case 'e':
+        expect = 1;
+        break;
+      default:
+        usage();
+    }
+  }
+  if (optind == argc) {
+    usage();
+  }
+  cmd = argv[optind++];
+  argc -= optind;
+  argv += optind;
+
+  ISOTP_init(&tp, base + ISOTP_REQ_OFFSET, base + ISOTP_RESP_OFFSET, rx_buf,
+      sizeof(rx_buf), on_rx, on_tx);
+  tp.st_min = st_min;
+  CAN_subscribe(base + ISOTP_RESP_OFFSET, 1, on_frame, CAN_NORMAL);
+  init_can();
+  STI();
+
+  if (strcmp(cmd, "send") == 0 && argc == 1) {
+    if ((data = read_file(argv[0], &len)) != NULL) {
+      result = send_message(data, len);
+    }
+  } else if (strcmp(cmd, "recv") == 0 && argc == 1) {
+    if (recv_message() == 0) {
+      result = write_file(argv[0], rx_buf, rx_len);
+    }
+  } else if (strcmp(cmd, "xfer") == 0 && (argc == 1 || argc == 2)) {
+    if ((data = read_file(argv[0], &len)) != NULL && send_message(data, len) == 0 &&
+        recv_message() == 0) {
+      result = argc == 2 ? write_file(argv[1], rx_buf, rx_len) : 0;
+      if (expect && (rx_len != len || memcmp(rx_buf, data, len) != 0)) {
+        fprintf(stderr, "isotp: reply differs from what was sent\n");
+        result = -1;
+      }
+    }
+  } else if (strcmp(cmd, "dump") == 0 && argc == 3) {
+    result = dump(strtoul(argv[0], NULL, 0), strtoul(argv[1], NULL, 0), argv[2]);
+  } else if (strcmp(cmd, "load") == 0 && argc == 2) {
+    result = load(strtoul(argv[0], NULL, 0), argv[1]);
+  } else {
+    usage();
+  }
+
+  linger = host_micros() + LINGER_MS * 1000;
+  while (host_micros() < linger) {
+    service();
+  }
+
+  printf("%u frames dropped, %u errors\n", tp.ring_drops, tp.errors);
+  return result == 0 ? 0 : 1;
+}
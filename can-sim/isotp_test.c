@@ -0,0 +1,77 @@
+/**
+ * ISO-TP Echo Node
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs as a node under canbus with base ID ECHO_ID, sends back the first
+ * message it receives over ISO-TP and exits once the reply has been sent.
+ * Run with the isotp tool's xfer command to test both ends of a transfer.
+ */
+#include <stdio.h>
+#include "CAN.h"
+#include "FSAE_can.h"
+#include "FSAE_isotp.h"
+
+#define ECHO_ID 0x7A0
+#define ECHO_MAX (1 << 18)
+
+// Time left before exiting for the last frames queued to reach the bus
+#define LINGER_MS 100
+
+// Defined for FSAE_can, driven from the main loop here
+volatile uint32_t millis = 0;
+
+static ISOTP_link tp;
+static uint8_t buf[ECHO_MAX];
+static int done = 0;
+static int result = 1;
+
+static void on_rx(ISOTP_link* l, uint8_t* data, uint32_t len) {
+  if (ISOTP_send(l, data, len) != ISOTP_SUCCESS) {
+    done = 1;
+  }
+}
+
+static void on_tx(ISOTP_link* l, uint8_t status) {
+  result = status != ISOTP_SUCCESS;
+  done = 1;
+}
+
+static void on_frame(CAN_message msg) {
+  ISOTP_receive(&tp, msg);
+}
+
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
+  if (C1INTbits.RBIF) {
+    CAN_dispatch_messages();
+  }
+
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
+  }
+
+  IFS4CLR = _IFS4_CAN1IF_MASK; // Clear CAN1 Interrupt Flag
+}
+
+int main(void) {
+  uint64_t linger;
+
+  ISOTP_init(&tp, ECHO_ID + ISOTP_RESP_OFFSET, ECHO_ID + ISOTP_REQ_OFFSET, buf,
+      sizeof(buf), on_rx, on_tx);
+  CAN_subscribe(ECHO_ID + ISOTP_REQ_OFFSET, 1, on_frame, CAN_NORMAL);
+  init_can();
+  STI();
+
+  while (!done) {
+    millis = (uint32_t) (host_micros() / 1000);
+    ISOTP_service(&tp);
+  }
+  linger = host_micros() + LINGER_MS * 1000;
+  while (host_micros() < linger);
+
+  printf("Echoed %u bytes, %u frames dropped, %u errors\n", tp.tx_len,
+      tp.ring_drops, tp.errors);
+  return result;
+}
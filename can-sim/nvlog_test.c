@@ -0,0 +1,155 @@
+/**
+ * NVM Record Log Power Failure Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs on its own against the simulated 25LC1024, with its write cycles
+ * taking no time. Puts and deletes random values under random keys while the
+ * chip's power is cut during a random write cycle, then mounts the log again
+ * as a node would after the brown-out. Passes if every key reads back with
+ * the last value put before the cut, or for the key being put when it came,
+ * with either its old or new value. Also checks that mounting reads far less
+ * than the whole log, and that the writes were spread over every page of it.
+ *
+ * Usage: nvlog_test [SEED]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "FSAE_nvlog.h"
+
+#define LOG_ADDR 0x10000
+#define LOG_SIZE (8 * NVLOG_SEG_SIZE)
+#define CUTS     300
+#define MAX_CUT  60 // Most write cycles before the power is cut
+
+// Most page writes allowed over the mean, for writes to count as spread
+#define MAX_WEAR 3
+
+// Values expected, with a length of 0 for none
+static uint8_t values[NVLOG_KEYS][NVLOG_DATA_MAX];
+static uint16_t lens[NVLOG_KEYS];
+
+static uint8_t put[NVLOG_DATA_MAX];
+static uint8_t back[NVLOG_DATA_MAX];
+
+static NvLog nvlog;
+
+/**
+ * uint32_t spi_bytes(void)
+ *
+ * @returns Bytes moved over SPI so far, both ways
+ */
+static uint32_t spi_bytes(void) {
+  return spi_dma_stats.bytes + spi_pio_stats.bytes;
+}
+
+/**
+ * int matches(uint16_t key, const uint8_t* value, uint16_t len)
+ *
+ * @returns Whether <key> reads back as the <len> bytes at <value>, or as
+ *          having no value if <len> is 0
+ */
+static int matches(uint16_t key, const uint8_t* value, uint16_t len) {
+  uint16_t got = 0;
+  uint8_t result = nvlog_get(&nvlog, key, back, sizeof(back), &got);
+
+  if (len == 0) {
+    return result == NVLOG_ERR_KEY;
+  }
+  return result == NVLOG_SUCCESS && got == len && memcmp(back, value, len) == 0;
+}
+
+int main(int argc, char* argv[]) {
+  uint32_t seed = argc > 1 ? (uint32_t) strtoul(argv[1], NULL, 0) : 1;
+  uint32_t puts = 0, kept = 0, replaced = 0;
+  uint32_t mount_max = 0, bytes;
+  uint32_t wear_min = UINT32_MAX, wear_max = 0, wear_sum = 0;
+  uint32_t cut, addr, i;
+  int passed = 1;
+
+  srand(seed);
+  host_nvm_fast(1);
+  SPIConn* conn = init_nvm_std();
+  if (nvlog_mount(&nvlog, conn, LOG_ADDR, LOG_SIZE) != NVLOG_SUCCESS) {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  for (cut = 0; cut < CUTS && passed; cut++) {
+    uint16_t key = 0, len = 0;
+
+    host_nvm_cut_power(1 + (uint32_t) rand() % MAX_CUT);
+    while (host_nvm_powered()) {
+      key = (uint16_t) ((uint32_t) rand() % NVLOG_KEYS);
+      len = rand() % 8 == 0 ? 0 : (uint16_t) (1 + (uint32_t) rand() % NVLOG_DATA_MAX);
+      for (i = 0; i < len; i++) {
+        put[i] = (uint8_t) rand();
+      }
+
+      uint8_t result = len != 0 ? nvlog_put(&nvlog, key, put, len) : nvlog_delete(&nvlog, key);
+      if (!host_nvm_powered()) {
+        break; // Cut off, so the put may not have happened
+      }
+      if (result != NVLOG_SUCCESS) {
+        printf("Put %u failed with %u\n", puts, result);
+        passed = 0;
+        break;
+      }
+      memcpy(values[key], put, len);
+      lens[key] = len;
+      puts++;
+    }
+
+    // Power back on, as after a brown-out
+    host_nvm_power_on();
+    bytes = spi_bytes();
+    if (nvlog_mount(&nvlog, conn, LOG_ADDR, LOG_SIZE) != NVLOG_SUCCESS) {
+      printf("Mount %u failed\n", cut);
+      passed = 0;
+      break;
+    }
+    if (spi_bytes() - bytes > mount_max) {
+      mount_max = spi_bytes() - bytes;
+    }
+
+    // The key being put keeps its old value or takes the new one
+    if (matches(key, values[key], lens[key])) {
+      kept++;
+    } else if (matches(key, put, len)) {
+      memcpy(values[key], put, len);
+      lens[key] = len;
+      replaced++;
+    } else {
+      printf("Key %u being put at cut %u lost its value\n", key, cut);
+      passed = 0;
+    }
+
+    for (i = 0; i < NVLOG_KEYS; i++) {
+      if (!matches(i, values[i], lens[i])) {
+        printf("Key %u wrong after cut %u\n", i, cut);
+        passed = 0;
+      }
+    }
+  }
+
+  for (addr = LOG_ADDR; addr < LOG_ADDR + LOG_SIZE; addr += _NVM_PAGE) {
+    uint32_t writes = host_nvm_page_writes(addr);
+    wear_min = writes < wear_min ? writes : wear_min;
+    wear_max = writes > wear_max ? writes : wear_max;
+    wear_sum += writes;
+  }
+
+  printf("%u power cuts over %u puts: %u cut off keeping the old value, %u with the new\n",
+      cut, puts, kept, replaced);
+  printf("Mount read at most %u bytes of the %u byte log\n", mount_max, LOG_SIZE);
+  printf("Page writes min %u, mean %u, max %u\n", wear_min,
+      wear_sum / (LOG_SIZE / _NVM_PAGE), wear_max);
+
+  passed = passed && mount_max < LOG_SIZE / 4 && wear_min > 0 &&
+    wear_max <= MAX_WEAR * wear_sum / (LOG_SIZE / _NVM_PAGE);
+  printf("%s\n", passed ? "PASS" : "FAIL");
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/**
+ * NVM Asynchronous Write Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs on its own against the simulated 25LC1024, whose write cycles take
+ * their datasheet time. Times a blocking write, then fills the asynchronous
+ * write queue and runs nvm_service() in a loop until it drains. Passes if no
+ * pass of the loop waited out a write cycle, the writes finished in the order
+ * they were queued, the queue refused one write too many and everything
+ * reads back as written.
+ *
+ * Passes are timed in CPU time, which a busy wait for the chip uses up but a
+ * busy host descheduling the test does not.
+ */
+#include <stdio.h>
+#include <time.h>
+#include "FSAE_nvm.h"
+
+#define BLOCK_ADDR 0x14000
+#define BLOCK_SIZE 4096
+
+// Longest pass of the main loop allowed, well under one 6ms write cycle
+#define MAX_PASS_US 2000
+
+typedef struct {
+  uint32_t addr;
+  uint32_t size;
+} write_spec;
+
+// Whole pages, a range crossing a page boundary, and single bytes
+static const write_spec specs[_NVM_ASYNC_LEN] = {
+  {0x10000, 4096}, {0x11080, 300}, {0x12000, 1024}, {0x12400, 1},
+  {0x12501, 1}, {0x125FF, 2}, {0x12700, 255}, {0x12801, 256}
+};
+
+// Defined for FSAE_can, which the library links in
+volatile uint32_t millis = 0;
+
+static uint8_t data[_NVM_ASYNC_LEN][BLOCK_SIZE];
+static uint8_t back[BLOCK_SIZE];
+static uint8_t handles[_NVM_ASYNC_LEN];
+static uint8_t finished[_NVM_ASYNC_LEN];
+static uint32_t finished_count = 0;
+static uint32_t in_order = 1;
+
+/**
+ * uint64_t cpu_micros(void)
+ *
+ * @returns CPU time used by this thread in microseconds
+ */
+static uint64_t cpu_micros(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static void on_done(uint8_t handle, uint8_t result) {
+  if (finished_count >= _NVM_ASYNC_LEN || handle != handles[finished_count] ||
+      result != NVM_SUCCESS) {
+    in_order = 0;
+  }
+  finished[finished_count++] = handle;
+}
+
+int main(void) {
+  uint64_t start, pass, longest = 0;
+  uint32_t passes = 0;
+  uint32_t pages = 0;
+  uint32_t intact = 1;
+  uint32_t refused;
+  double blocking_ms, async_ms;
+  uint32_t i, j;
+  int passed;
+
+  SPIConn* conn = init_nvm_std();
+
+  for (i = 0; i < _NVM_ASYNC_LEN; i++) {
+    for (j = 0; j < specs[i].size; j++) {
+      data[i][j] = (uint8_t) (i * 31 + j * 7);
+    }
+    pages += ((specs[i].addr + specs[i].size - 1) >> 8) - (specs[i].addr >> 8) + 1;
+  }
+
+  // Blocking write, for comparison
+  start = cpu_micros();
+  nvm_write_data(conn, BLOCK_ADDR, BLOCK_SIZE, data[0]);
+  blocking_ms = (cpu_micros() - start) / 1000.0;
+
+  // Fill the queue, then run the main loop until it drains
+  start = host_micros();
+  for (i = 0; i < _NVM_ASYNC_LEN; i++) {
+    if (nvm_write_async(conn, specs[i].addr, specs[i].size, data[i], on_done,
+          &handles[i]) != NVM_SUCCESS) {
+      printf("FAIL\n");
+      return 1;
+    }
+  }
+  refused = nvm_write_async(conn, 0, 1, data[0], on_done, NULL) == NVM_ERR_BUSY;
+
+  while (nvm_write_pending(handles[_NVM_ASYNC_LEN - 1])) {
+    pass = cpu_micros();
+    nvm_service();
+    pass = cpu_micros() - pass;
+    if (pass > longest) {
+      longest = pass;
+    }
+    passes++;
+  }
+  async_ms = (host_micros() - start) / 1000.0;
+
+  for (i = 0; i < _NVM_ASYNC_LEN; i++) {
+    nvm_read_data(conn, specs[i].addr, specs[i].size, back);
+    if (memcmp(back, data[i], specs[i].size) != 0) {
+      intact = 0;
+    }
+  }
+
+  printf("Blocking write of %u bytes: %.1f ms of CPU in one call\n", BLOCK_SIZE, blocking_ms);
+  printf("Asynchronous writes of %u pages: %.1f ms over %u passes, longest %llu us of CPU\n",
+      pages, async_ms, passes, (unsigned long long) longest);
+
+  passed = longest < MAX_PASS_US && in_order && finished_count == _NVM_ASYNC_LEN &&
+    refused && intact;
+  printf("%s\n", passed ? "PASS" : "FAIL");
+
+  return passed ? 0 : 1;
+}
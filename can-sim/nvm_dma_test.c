@@ -0,0 +1,75 @@
+/**
+ * NVM DMA Transfer Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs on its own against the simulated 25LC1024. Mounts the chip and reads
+ * its superblock with DMA bursts and again with PIO, then writes a block each
+ * way and reads it back the other way. Passes if both paths move the same
+ * data and each burst went the way spi_dma_enabled asked. Prints the bytes/s
+ * each path achieved, from spi_dma_stats and spi_pio_stats.
+ */
+#include <stdio.h>
+#include "FSAE_nvm.h"
+
+#define BLOCK_ADDR 0x10000
+#define BLOCK_SIZE 4096
+
+// Defined for FSAE_can, which the library links in
+volatile uint32_t millis = 0;
+
+static _NvmSuperblock sb_dma;
+static _NvmSuperblock sb_pio;
+static uint8_t data[2][BLOCK_SIZE];
+static uint8_t back[2][BLOCK_SIZE];
+
+int main(void) {
+  uint32_t dma_rate, pio_rate;
+  uint32_t dma_bytes;
+  uint32_t i;
+  int passed;
+
+  SPIConn* conn = init_nvm_std();
+
+  for (i = 0; i < BLOCK_SIZE; i++) {
+    data[0][i] = (uint8_t) (i * 7);
+    data[1][i] = (uint8_t) (i * 13 + 1);
+  }
+
+  // Superblock, by DMA and then by PIO
+  spi_dma_stats = (SPIBurstStats) {0};
+  nvm_read_data(conn, 0, sizeof(_NvmSuperblock), &sb_dma);
+  dma_rate = spi_burst_rate(&spi_dma_stats);
+
+  spi_dma_enabled = 0;
+  spi_pio_stats = (SPIBurstStats) {0};
+  dma_bytes = spi_dma_stats.bytes;
+  nvm_read_data(conn, 0, sizeof(_NvmSuperblock), &sb_pio);
+  pio_rate = spi_burst_rate(&spi_pio_stats);
+
+  // A block written by PIO and read back by DMA, and the other way around
+  nvm_write_data(conn, BLOCK_ADDR + BLOCK_SIZE, BLOCK_SIZE, data[1]);
+  nvm_read_data(conn, BLOCK_ADDR, BLOCK_SIZE, back[0]);
+  passed = spi_dma_stats.bytes == dma_bytes;
+
+  spi_dma_enabled = 1;
+  nvm_write_data(conn, BLOCK_ADDR, BLOCK_SIZE, data[0]);
+  nvm_read_data(conn, BLOCK_ADDR + BLOCK_SIZE, BLOCK_SIZE, back[1]);
+  spi_dma_enabled = 0;
+  nvm_read_data(conn, BLOCK_ADDR, BLOCK_SIZE, back[0]);
+
+  printf("Superblock read of %u bytes: DMA %u bytes/s, PIO %u bytes/s\n",
+      (unsigned) sizeof(_NvmSuperblock), dma_rate, pio_rate);
+  printf("All bursts: DMA %u bytes at %u bytes/s, PIO %u bytes at %u bytes/s\n",
+      spi_dma_stats.bytes, spi_burst_rate(&spi_dma_stats), spi_pio_stats.bytes,
+      spi_burst_rate(&spi_pio_stats));
+
+  passed = passed && dma_bytes >= sizeof(_NvmSuperblock) &&
+    sb_dma.vcode == _NVM_SB_VER && memcmp(&sb_dma, &sb_pio, sizeof(sb_dma)) == 0 &&
+    memcmp(back[0], data[0], BLOCK_SIZE) == 0 && memcmp(back[1], data[1], BLOCK_SIZE) == 0;
+  printf("%s\n", passed ? "PASS" : "FAIL");
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/**
+ * NVM Superblock Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs on its own against the simulated 25LC1024. Allocates a block, then a
+ * batch of blocks with the superblock sync deferred, and counts the chip's
+ * write cycles for each. Passes if a single allocation writes only the
+ * superblock pages it changed, the batch writes each changed page once, and a
+ * second mount of the chip finds every block where it was allocated.
+ */
+#include <stdio.h>
+#include "FSAE_nvm.h"
+
+#define ONE_SIZE    100
+#define BATCH_LEN   8
+#define BATCH_SIZE  300
+
+// Superblock pages an allocation changes, one for its node and one for its
+// page flags, when neither crosses a page boundary
+#define CHANGED_PAGES 2
+
+// Defined for FSAE_can, which the library links in
+volatile uint32_t millis = 0;
+
+int main(void) {
+  uint8_t ids[BATCH_LEN][16];
+  uint8_t data[ONE_SIZE];
+  uint8_t back[ONE_SIZE];
+  uint8_t fds[BATCH_LEN];
+  uint8_t fd, fd2;
+  uint32_t cycles, one, batch, sync, remount;
+  uint32_t found = 1;
+  uint32_t i;
+  int passed;
+
+  SPIConn* conn = init_nvm_std();
+  printf("Fresh superblock: %u write cycles\n", host_nvm_write_cycles());
+
+  // One allocation, clearing one data page
+  cycles = host_nvm_write_cycles();
+  if (nvm_alloc(conn, (uint8_t*) "one", 1, ONE_SIZE, &fd) != NVM_SUCCESS) {
+    printf("FAIL\n");
+    return 1;
+  }
+  one = host_nvm_write_cycles() - cycles - 1;
+  for (i = 0; i < ONE_SIZE; i++) {
+    data[i] = i * 7;
+  }
+  nvm_write(conn, fd, data);
+
+  // A batch, clearing two data pages each, with the superblock written once
+  nvm_defer_sync(conn);
+  cycles = host_nvm_write_cycles();
+  for (i = 0; i < BATCH_LEN; i++) {
+    snprintf((char*) ids[i], sizeof(ids[i]), "batch%u", i);
+    if (nvm_alloc(conn, ids[i], 1, BATCH_SIZE, &fds[i]) != NVM_SUCCESS) {
+      printf("FAIL\n");
+      return 1;
+    }
+  }
+  batch = host_nvm_write_cycles() - cycles - 2 * BATCH_LEN;
+  cycles = host_nvm_write_cycles();
+  nvm_sync(conn);
+  sync = host_nvm_write_cycles() - cycles;
+
+  // Mount the chip again as a second connection, reading back the superblock
+  SPIConn* conn2 = init_nvm_std();
+  cycles = host_nvm_write_cycles();
+  if (nvm_alloc(conn2, (uint8_t*) "one", 1, ONE_SIZE, &fd2) != NVM_SUCCESS || fd2 != fd) {
+    found = 0;
+  }
+  for (i = 0; i < BATCH_LEN; i++) {
+    if (nvm_alloc(conn2, ids[i], 1, BATCH_SIZE, &fd2) != NVM_SUCCESS || fd2 != fds[i]) {
+      found = 0;
+    }
+  }
+  remount = host_nvm_write_cycles() - cycles;
+  nvm_read(conn2, fd, back);
+
+  printf("Superblock pages written: %u for one allocation, %u for %u deferred, "
+      "%u at sync, %u on the second mount\n", one, batch, BATCH_LEN, sync, remount);
+
+  passed = one <= CHANGED_PAGES && batch == 0 && sync <= CHANGED_PAGES &&
+    remount == 0 && found && memcmp(data, back, ONE_SIZE) == 0;
+  printf("%s\n", passed ? "PASS" : "FAIL");
+
+  return passed ? 0 : 1;
+}
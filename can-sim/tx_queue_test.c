@@ -0,0 +1,135 @@
+/**
+ * Transmit Queue Load Test
+ *
+ * Processor:   Linux host
+ * Compiler:    gcc
+ * Created:     2026
+ *
+ * Runs as a node under canbus. Every millisecond it queues one critical frame
+ * carrying a sequence number and a burst of low priority frames, offering
+ * more traffic than the bus can carry. Passes if every critical frame is
+ * transmitted, in order, while the transmit queue drops low priority frames
+ * to keep up. Then queues far more frames under one ID than the queue holds,
+ * at once, and passes if the oldest were dropped: the frames sent are in
+ * order, end with the newest, and skip a single run of dropped frames.
+ */
+#include <stdio.h>
+#include "FSAE_can.h"
+
+#define CRITICAL_ID 0x080
+#define BULK_ID     0x600
+#define BULK_PER_MS 8
+#define RUN_MS      2000
+#define SAME_ID     0x700
+#define SAME_FRAMES 1000
+
+// Time allowed for the queue to drain after the last frame is queued
+#define DRAIN_US 100000
+
+// Required by FSAE_can for receive timestamps, which are unused here
+volatile uint32_t millis = 0;
+
+static volatile uint32_t critical_sent = 0;
+static volatile uint32_t out_of_order = 0;
+static volatile uint32_t bulk_sent = 0;
+static volatile uint32_t same_sent = 0;
+static volatile uint32_t same_last = 0;
+static volatile uint32_t same_gaps = 0;
+
+/**
+ * void on_tx(uint32_t id, uint32_t dlc, const uint8_t * data)
+ *
+ * Called by the host backend as each frame leaves for the bus.
+ */
+static void on_tx(uint32_t id, uint32_t dlc, const uint8_t * data) {
+  (void) dlc;
+  if (id == CRITICAL_ID) {
+    uint32_t seq = data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t) data[3] << 24);
+    if (seq != critical_sent) {
+      out_of_order++;
+    }
+    critical_sent++;
+  } else if (id == SAME_ID) {
+    uint32_t seq = data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t) data[3] << 24);
+    if (same_sent == 0 ? seq != 0 : seq != same_last + 1) {
+      same_gaps++;
+    }
+    same_last = seq;
+    same_sent++;
+  } else {
+    bulk_sent++;
+  }
+}
+
+void ISR(_CAN1_VECTOR, IPL4SRS) can_inthnd(void) {
+  if (C1INTbits.TBIF) {
+    CAN_tx_service(); // Refill the transmit FIFOs
+  }
+
+  IFS4CLR = _IFS4_CAN1IF_MASK; // Clear CAN1 Interrupt Flag
+}
+
+int main(void) {
+  uint32_t bulk_drops = 0;
+  uint32_t same_drops;
+  uint64_t start;
+  uint32_t ms;
+  uint32_t i;
+  int passed;
+
+  init_can();
+  host_can_set_tx_handler(on_tx);
+  STI();
+
+  start = host_micros();
+  for (ms = 0; ms < RUN_MS; ms++) {
+    CAN_data data = {0};
+
+    while (host_micros() < start + ms * 1000ULL);
+
+    data.word0 = ms;
+    CAN_send_message(CRITICAL_ID, 8, data);
+
+    for (i = 0; i < BULK_PER_MS; i++) {
+      data.word0 = i;
+      CAN_send_message(BULK_ID + i, 8, data);
+    }
+  }
+
+  start = host_micros();
+  while (critical_sent < RUN_MS && host_micros() < start + DRAIN_US);
+
+  for (i = 0; i < BULK_PER_MS; i++) {
+    bulk_drops += CAN_tx_drops[BULK_ID + i];
+  }
+
+  printf("Critical: %u of %u sent, %u out of order, %u dropped\n", critical_sent,
+      RUN_MS, out_of_order, CAN_tx_drops[CRITICAL_ID]);
+  printf("Bulk: %u sent, %u dropped\n", bulk_sent, bulk_drops);
+
+  // Bulk drops show the queue was actually saturated
+  passed = critical_sent == RUN_MS && out_of_order == 0 &&
+    CAN_tx_drops[CRITICAL_ID] == 0 && bulk_drops > 0;
+
+  // One ID, far faster than the bus, so only the newest frames should remain
+  for (i = 0; i < SAME_FRAMES; i++) {
+    CAN_data data = {0};
+    data.word0 = i;
+    CAN_send_message(SAME_ID, 8, data);
+  }
+
+  start = host_micros();
+  while (same_sent + CAN_tx_drops[SAME_ID] < SAME_FRAMES && host_micros() < start + DRAIN_US);
+  same_drops = CAN_tx_drops[SAME_ID];
+
+  printf("Same ID: %u of %u sent, last %u, %u dropped in %u runs\n", same_sent,
+      SAME_FRAMES, same_last, same_drops, same_gaps);
+
+  // The oldest frames were dropped, bar any the hardware FIFOs took first
+  passed = passed && same_sent + same_drops == SAME_FRAMES && same_drops > 0 &&
+    same_last == SAME_FRAMES - 1 && same_gaps == 1;
+
+  printf("%s\n", passed ? "PASS" : "FAIL");
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file browser.cpp
+ * Implementation of the SpecModel class.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include "browser.h"
+
+// Internal ID of top level rows. Child rows store their parent's row + 1.
+#define SPEC_TOP_LEVEL 0
+
+SpecModel::SpecModel(QObject* parent) : QAbstractItemModel(parent) {}
+
+void SpecModel::setSpec(map<uint16_t, Message>& messages,
+    QVector<DerivedChannel>& derivedChannels) {
+  beginResetModel();
+  groups.clear();
+
+  typedef map<uint16_t, Message>::iterator it_msg;
+  for (it_msg msgIt = messages.begin(); msgIt != messages.end(); msgIt++) {
+    SpecGroup group;
+    group.msg = msgIt->second;
+    group.isDerived = false;
+
+    for (int i = 0; i < group.msg.sigs.size(); i++) {
+      SpecChannel chn;
+      chn.sig = group.msg.sigs[i];
+      chn.checked = true;
+      group.channels.push_back(chn);
+    }
+    groups.push_back(group);
+  }
+
+  if (derivedChannels.size() > 0) {
+    SpecGroup group;
+    group.isDerived = true;
+
+    for (int i = 0; i < derivedChannels.size(); i++) {
+      SpecChannel chn;
+      chn.chn = derivedChannels[i];
+      chn.checked = true;
+      group.channels.push_back(chn);
+    }
+    groups.push_back(group);
+  }
+
+  endResetModel();
+  setFilter(QString());
+}
+
+void SpecModel::setFilter(QString filter) {
+  beginResetModel();
+  visibleGroups.clear();
+  visibleChannels.clear();
+
+  for (unsigned int g = 0; g < groups.size(); g++) {
+    SpecGroup& group = groups[g];
+    bool groupMatch = filter.isEmpty() || (!group.isDerived &&
+        QString::number(group.msg.id, 16).contains(filter, Qt::CaseInsensitive));
+
+    vector<int> channels;
+    for (unsigned int i = 0; i < group.channels.size(); i++) {
+      SpecChannel& chn = group.channels[i];
+      QString title = group.isDerived ? chn.chn.title : chn.sig.title;
+      QString units = group.isDerived ? chn.chn.units : chn.sig.units;
+      if (groupMatch || title.contains(filter, Qt::CaseInsensitive) ||
+          units.contains(filter, Qt::CaseInsensitive)) {
+        channels.push_back(i);
+      }
+    }
+
+    if (!channels.empty()) {
+      visibleGroups.push_back(g);
+      visibleChannels.push_back(channels);
+    }
+  }
+
+  endResetModel();
+}
+
+void SpecModel::setAllChecked(bool checked) {
+  for (unsigned int row = 0; row < visibleGroups.size(); row++) {
+    SpecGroup& group = groups[visibleGroups[row]];
+    for (unsigned int i = 0; i < visibleChannels[row].size(); i++) {
+      group.channels[visibleChannels[row][i]].checked = checked;
+    }
+  }
+
+  if (!visibleGroups.empty()) {
+    emit dataChanged(index(0, SPEC_COL_NAME),
+        index(visibleGroups.size() - 1, SPEC_COL_NAME));
+    for (unsigned int row = 0; row < visibleGroups.size(); row++) {
+      QModelIndex parent = index(row, SPEC_COL_NAME);
+      emit dataChanged(index(0, SPEC_COL_NAME, parent),
+          index(visibleChannels[row].size() - 1, SPEC_COL_NAME, parent));
+    }
+  }
+  emit selectionChanged();
+}
+
+int SpecModel::getSelection(map<uint16_t, vector<bool> >& exportSignals,
+    vector<bool>& exportDerived) {
+  int count = 0;
+  exportSignals.clear();
+  exportDerived.clear();
+
+  for (unsigned int g = 0; g < groups.size(); g++) {
+    SpecGroup& group = groups[g];
+    vector<bool>& selection = group.isDerived ? exportDerived :
+      exportSignals[group.msg.id];
+
+    for (unsigned int i = 0; i < group.channels.size(); i++) {
+      selection.push_back(group.channels[i].checked);
+      count += group.channels[i].checked ? 1 : 0;
+    }
+  }
+
+  return count;
+}
+
+QModelIndex SpecModel::index(int row, int column,
+    const QModelIndex& parent) const {
+  if (row < 0 || column < 0 || column >= SPEC_NUM_COLS) {
+    return QModelIndex();
+  }
+
+  if (!parent.isValid()) {
+    if ((unsigned int) row >= visibleGroups.size()) {
+      return QModelIndex();
+    }
+    return createIndex(row, column, (quintptr) SPEC_TOP_LEVEL);
+  }
+
+  if (parent.internalId() != SPEC_TOP_LEVEL ||
+      (unsigned int) row >= visibleChannels[parent.row()].size()) {
+    return QModelIndex();
+  }
+  return createIndex(row, column, (quintptr) (parent.row() + 1));
+}
+
+QModelIndex SpecModel::parent(const QModelIndex& child) const {
+  if (!child.isValid() || child.internalId() == SPEC_TOP_LEVEL) {
+    return QModelIndex();
+  }
+  return createIndex(child.internalId() - 1, SPEC_COL_NAME, (quintptr) SPEC_TOP_LEVEL);
+}
+
+int SpecModel::rowCount(const QModelIndex& parent) const {
+  if (!parent.isValid()) {
+    return visibleGroups.size();
+  }
+  if (parent.internalId() == SPEC_TOP_LEVEL && parent.column() == SPEC_COL_NAME) {
+    return visibleChannels[parent.row()].size();
+  }
+  return 0;
+}
+
+int SpecModel::columnCount(const QModelIndex&) const {
+  return SPEC_NUM_COLS;
+}
+
+QVariant SpecModel::data(const QModelIndex& index, int role) const {
+  if (!index.isValid()) {
+    return QVariant();
+  }
+
+  // Message (or derived channel group) rows
+  if (index.internalId() == SPEC_TOP_LEVEL) {
+    const SpecGroup& group = groups[visibleGroups[index.row()]];
+    if (role == Qt::CheckStateRole && index.column() == SPEC_COL_NAME) {
+      return groupState(group);
+    } else if (role == Qt::DisplayRole) {
+      switch (index.column()) {
+        case SPEC_COL_NAME:
+          return group.isDerived ? QString("Derived Channels") :
+            "0x" + QString::number(group.msg.id, 16);
+        case SPEC_COL_DETAILS:
+          return group.isDerived ?
+            QString("Signals: %1").arg(group.channels.size()) :
+            Message(group.msg).toString();
+      }
+    }
+    return QVariant();
+  }
+
+  // Channel rows
+  const SpecGroup& group = groups[visibleGroups[index.internalId() - 1]];
+  const vector<int>& channels = visibleChannels[index.internalId() - 1];
+  const SpecChannel& chn = group.channels[channels[index.row()]];
+
+  if (role == Qt::CheckStateRole && index.column() == SPEC_COL_NAME) {
+    return chn.checked ? Qt::Checked : Qt::Unchecked;
+  } else if (role == Qt::DisplayRole) {
+    switch (index.column()) {
+      case SPEC_COL_NAME:
+        return group.isDerived ? chn.chn.title : chn.sig.title;
+      case SPEC_COL_UNITS:
+        return group.isDerived ? chn.chn.units : chn.sig.units;
+      case SPEC_COL_DETAILS:
+        return group.isDerived ? DerivedChannel(chn.chn).formula :
+          Signal(chn.sig).toString();
+    }
+  }
+  return QVariant();
+}
+
+bool SpecModel::setData(const QModelIndex& index, const QVariant& value,
+    int role) {
+  if (!index.isValid() || role != Qt::CheckStateRole ||
+      index.column() != SPEC_COL_NAME) {
+    return false;
+  }
+
+  bool checked = value.toInt() == Qt::Checked;
+
+  if (index.internalId() == SPEC_TOP_LEVEL) {
+    // Checking a message applies to every channel currently shown under it
+    SpecGroup& group = groups[visibleGroups[index.row()]];
+    vector<int>& channels = visibleChannels[index.row()];
+    for (unsigned int i = 0; i < channels.size(); i++) {
+      group.channels[channels[i]].checked = checked;
+    }
+
+    emit dataChanged(index, index);
+    emit dataChanged(this->index(0, SPEC_COL_NAME, index),
+        this->index(channels.size() - 1, SPEC_COL_NAME, index));
+  } else {
+    int row = index.internalId() - 1;
+    SpecGroup& group = groups[visibleGroups[row]];
+    group.channels[visibleChannels[row][index.row()]].checked = checked;
+
+    emit dataChanged(index, index);
+    QModelIndex parent = this->index(row, SPEC_COL_NAME);
+    emit dataChanged(parent, parent);
+  }
+
+  emit selectionChanged();
+  return true;
+}
+
+Qt::ItemFlags SpecModel::flags(const QModelIndex& index) const {
+  if (!index.isValid()) {
+    return Qt::NoItemFlags;
+  }
+
+  Qt::ItemFlags flags = Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+  if (index.column() == SPEC_COL_NAME) {
+    flags |= Qt::ItemIsUserCheckable;
+  }
+  return flags;
+}
+
+QVariant SpecModel::headerData(int section, Qt::Orientation orientation,
+    int role) const {
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+    return QVariant();
+  }
+
+  switch (section) {
+    case SPEC_COL_NAME:
+      return QString("Channel");
+    case SPEC_COL_UNITS:
+      return QString("Units");
+    case SPEC_COL_DETAILS:
+      return QString("Details");
+  }
+  return QVariant();
+}
+
+Qt::CheckState SpecModel::groupState(const SpecGroup& group) const {
+  unsigned int checked = 0;
+  for (unsigned int i = 0; i < group.channels.size(); i++) {
+    checked += group.channels[i].checked ? 1 : 0;
+  }
+
+  if (checked == 0) {
+    return Qt::Unchecked;
+  } else if (checked == group.channels.size()) {
+    return Qt::Checked;
+  }
+  return Qt::PartiallyChecked;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file browser.h
+ * Item model used to browse and select channels of the scanned CAN spec.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef BROWSER_H
+#define BROWSER_H
+
+#include <map>
+#include <vector>
+#include <QVariant>
+#include <QModelIndex>
+#include <QAbstractItemModel>
+#include "config.h"
+#include "derived.h"
+
+using std::map;
+using std::vector;
+
+// Columns shown for every row of the spec browser
+#define SPEC_COL_NAME    0
+#define SPEC_COL_UNITS   1
+#define SPEC_COL_DETAILS 2
+#define SPEC_NUM_COLS    3
+
+// A single channel (DBC signal or derived channel) in the spec browser
+struct SpecChannel {
+  Signal sig;
+  DerivedChannel chn;
+  bool checked;
+};
+
+// A message, or the group of derived channels, in the spec browser
+struct SpecGroup {
+  Message msg;
+  bool isDerived;
+  vector<SpecChannel> channels;
+};
+
+/**
+ * Two level model of the CAN spec. Top level rows are messages (plus one row
+ * holding the derived channels) and their children are the channels.
+ *
+ * The model only stores the parsed spec. Display strings are built on demand
+ * for the rows the view actually shows, so a full-car DBC with thousands of
+ * signals costs no more to open than a small one. Filtering is done in the
+ * model itself so that a message stays visible when any of its channels match.
+ */
+class SpecModel : public QAbstractItemModel {
+  Q_OBJECT
+
+  public:
+
+    SpecModel(QObject* parent = 0);
+
+    /**
+     * Replaces the spec shown by the model. Every channel starts checked.
+     */
+    void setSpec(map<uint16_t, Message>& messages,
+        QVector<DerivedChannel>& derivedChannels);
+
+    /**
+     * Shows only the channels whose title or units contain <filter>, and the
+     * messages whose ID contains it. Matching is case insensitive.
+     */
+    void setFilter(QString filter);
+
+    /**
+     * Checks or unchecks every channel currently shown.
+     */
+    void setAllChecked(bool checked);
+
+    /**
+     * Returns the checked state of every channel.
+     *
+     * @param exportSignals Filled with the checked state of each signal, by
+     *     message ID.
+     * @param exportDerived Filled with the checked state of each derived
+     *     channel.
+     * @returns The number of checked channels.
+     */
+    int getSelection(map<uint16_t, vector<bool> >& exportSignals,
+        vector<bool>& exportDerived);
+
+    QModelIndex index(int row, int column,
+        const QModelIndex& parent = QModelIndex()) const;
+    QModelIndex parent(const QModelIndex& child) const;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+    bool setData(const QModelIndex& index, const QVariant& value,
+        int role = Qt::EditRole);
+    Qt::ItemFlags flags(const QModelIndex& index) const;
+    QVariant headerData(int section, Qt::Orientation orientation,
+        int role = Qt::DisplayRole) const;
+
+  signals:
+
+    /**
+     * Emitted whenever a channel is checked or unchecked.
+     */
+    void selectionChanged();
+
+  private:
+
+    /**
+     * Returns the check state of a group from the state of its channels.
+     */
+    Qt::CheckState groupState(const SpecGroup& group) const;
+
+    vector<SpecGroup> groups;
+
+    // Index into groups of each visible top level row
+    vector<int> visibleGroups;
+
+    // Index into the group's channels of each visible child row, by top level
+    // row
+    vector< vector<int> > visibleChannels;
+};
+
+#endif // BROWSER_H
@@ -0,0 +1,502 @@
+/**
+ * @file busload.cpp
+ * Implementation of the AppBusLoad class.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include <cmath>
+#include <cstring>
+#include "busload.h"
+
+using std::ios;
+using std::ifstream;
+
+// Upper edges of the jitter histogram bins, as a ratio of the median period
+static const double BUSLOAD_JITTER_EDGES[BUSLOAD_JITTER_BINS - 1] =
+  {0.5, 0.8, 0.95, 1.05, 1.25, 2.0};
+
+static const char* BUSLOAD_JITTER_LABELS[BUSLOAD_JITTER_BINS] =
+  {"<0.5", "0.5-0.8", "0.8-0.95", "0.95-1.05", "1.05-1.25", "1.25-2", ">2"};
+
+//================================ FRAME BITS ==================================
+
+int busload_frame_bits(uint16_t id, uint8_t dlc, const uint8_t* data, int* stuffBits) {
+  uint8_t bits[98];
+  int numBits = 0;
+  uint8_t dataLen = dlc > 8 ? 8 : dlc;
+
+  // Start of frame, identifier, RTR, IDE, r0 and DLC
+  bits[numBits++] = 0;
+  for (int i = 10; i >= 0; i--) {
+    bits[numBits++] = (id >> i) & 1;
+  }
+  bits[numBits++] = 0;
+  bits[numBits++] = 0;
+  bits[numBits++] = 0;
+  for (int i = 3; i >= 0; i--) {
+    bits[numBits++] = (dlc >> i) & 1;
+  }
+  for (int i = 0; i < dataLen; i++) {
+    for (int j = 7; j >= 0; j--) {
+      bits[numBits++] = (data[i] >> j) & 1;
+    }
+  }
+
+  // CRC-15 over everything so far
+  uint16_t crc = 0;
+  for (int i = 0; i < numBits; i++) {
+    bool next = bits[i] ^ ((crc >> 14) & 1);
+    crc = (crc << 1) & 0x7FFF;
+    if (next) {
+      crc ^= 0x4599;
+    }
+  }
+  for (int i = 14; i >= 0; i--) {
+    bits[numBits++] = (crc >> i) & 1;
+  }
+
+  // A stuff bit of the opposite level follows every five equal bits, and
+  // itself starts the next run
+  int stuff = 0;
+  int run = 1;
+  uint8_t last = bits[0];
+  for (int i = 1; i < numBits; i++) {
+    if (bits[i] == last) {
+      run++;
+    } else {
+      last = bits[i];
+      run = 1;
+    }
+
+    if (run == 5) {
+      stuff++;
+      last = !last;
+      run = 1;
+    }
+  }
+
+  *stuffBits = stuff;
+
+  // CRC delimiter, ACK slot, ACK delimiter, end of frame and interframe space
+  return numBits + stuff + 3 + 7 + 3;
+}
+
+//================================= ID LOAD ====================================
+
+double IdLoad::medianInterval() {
+  uint64_t cumulative = 0;
+  for (int i = 0; i < BUSLOAD_PERIOD_BINS; i++) {
+    cumulative += intervalBins[i];
+    if (cumulative * 2 >= intervals) {
+      return BUSLOAD_PERIOD_MIN * pow(2.0, (i + 0.5) / BUSLOAD_PERIOD_BINS_PER_OCTAVE);
+    }
+  }
+  return 0.0;
+}
+
+//=============================== APP BUS LOAD =================================
+
+bool AppBusLoad::analyze(QString filename) {
+  reset();
+
+  AppConfig config;
+  messages = config.getMessages();
+
+  AppHeader header;
+  if (!header.read()) {
+    emit error(QString("Problem reading CAN.h, which is needed to group IDs by node."));
+    return false;
+  }
+  QStringList nodeNames = QString(BUSLOAD_NODES).split(" ");
+  map<uint16_t, QString> idBases = header.getIdBases();
+  idRanges.clear();
+  typedef map<uint16_t, QString>::iterator it_base;
+  for (it_base baseIt = idBases.begin(); baseIt != idBases.end(); baseIt++) {
+    uint16_t span = nodeNames.contains(baseIt->second) ? BUSLOAD_NODE_SPAN : 1;
+    idRanges[baseIt->first] = std::make_pair((uint16_t) (baseIt->first + span), baseIt->second);
+  }
+
+  bool isVectorFile = filename.endsWith(".asc", Qt::CaseInsensitive);
+  if (!(isVectorFile ? readVector(filename) : readCustom(filename))) {
+    return false;
+  }
+
+  QString outFilename = filename;
+  outFilename.replace(".txt", ".busload.txt", Qt::CaseInsensitive);
+  outFilename.replace(".asc", ".busload.txt", Qt::CaseInsensitive);
+  return write(outFilename);
+}
+
+void AppBusLoad::reset() {
+  ids.clear();
+  nodes.clear();
+  frames = 0;
+  bits = 0;
+  stuffBits = 0;
+  outOfOrder = 0;
+  firstTime = 0.0;
+  lastTime = 0.0;
+  window = 0;
+  windowBits = 0;
+  peakUtilization = 0.0;
+  utilizationBins.assign(BUSLOAD_UTIL_BINS, 0);
+  burst = 0;
+  maxBurst = 0;
+  bursts = 0;
+}
+
+bool AppBusLoad::readCustom(QString filename) {
+  ifstream infile(filename.toLocal8Bit().data(), ios::in | ios::binary);
+  if (!(infile && infile.good())) {
+    emit error("Problem with input file. Try again or try another file.");
+    return false;
+  }
+
+  infile.seekg(0, infile.end);
+  double length = infile.tellg();
+  infile.seekg(0, infile.beg);
+
+  // Largest record is the ID, one word per signal and the timestamp
+  size_t maxRecord = 6;
+  typedef map<uint16_t, Message>::iterator it_msg;
+  for (it_msg msgIt = messages.begin(); msgIt != messages.end(); msgIt++) {
+    size_t record = 6 + 2 * msgIt->second.sigs.size();
+    maxRecord = record > maxRecord ? record : maxRecord;
+  }
+
+  vector<uint8_t> buffer(BUSLOAD_CHUNK_SIZE + maxRecord);
+  size_t start = 0;
+  size_t end = 0;
+  double consumed = 0.0;
+  int progressCounter = 0;
+  bool atEnd = false;
+  uint8_t data[8];
+
+  emit progress(0);
+
+  while (!atEnd) {
+    // Carry the partial record at the end of the last chunk over
+    memmove(&buffer[0], &buffer[start], end - start);
+    end -= start;
+    consumed += start;
+    start = 0;
+
+    infile.read((char*) &buffer[end], BUSLOAD_CHUNK_SIZE);
+    end += infile.gcount();
+    atEnd = infile.gcount() == 0 || infile.eof();
+
+    while (end - start >= (atEnd ? 2 : maxRecord)) {
+      const uint8_t* record = &buffer[start];
+      uint16_t msgId = record[1] << 8 | record[0];
+
+      map<uint16_t, Message>::iterator msgIt = messages.find(msgId);
+      if (msgIt == messages.end()) {
+        // Resynchronize the same way the converter does
+        start += 2;
+        continue;
+      }
+
+      Message& msg = msgIt->second;
+      size_t words = msg.sigs.size();
+      if (end - start < 6 + 2 * words) {
+        break;
+      }
+
+      memset(data, 0, sizeof(data));
+      memcpy(data, record + 2, 2 * words > 8 ? 8 : 2 * words);
+
+      const uint8_t* stamp = record + 2 + 2 * words;
+      double upper = stamp[3] << 8 | stamp[2];
+      double lower = ((double) (stamp[1] << 8 | stamp[0])) / 0x8000;
+      addFrame(upper + lower - 1.0, msgId, msg.dlc, data);
+
+      start += 6 + 2 * words;
+    }
+
+    if (length > 0 && ((consumed + start) / length) * 100.0 > progressCounter) {
+      progressCounter = (int) (((consumed + start) / length) * 100.0);
+      emit progress(progressCounter);
+    }
+  }
+
+  infile.close();
+  return true;
+}
+
+bool AppBusLoad::readVector(QString filename) {
+  QFile inputFile(filename);
+  if (!inputFile.open(QIODevice::ReadOnly)) {
+    emit error("Problem with input file. Try again or try another file.");
+    return false;
+  }
+
+  double length = inputFile.size();
+  int progressCounter = 0;
+  uint8_t data[8];
+
+  emit progress(0);
+
+  inputFile.readLine();
+  while (!inputFile.atEnd()) {
+    QString line = QString::fromLatin1(inputFile.readLine()).simplified();
+    QStringList sections = line.split(" ", QString::SkipEmptyParts);
+
+    // Same line filter as the converter
+    if (sections.size() < 6 || sections[1].compare("1") || sections[3].compare("Rx") ||
+        sections[2].endsWith('x')) {
+      continue;
+    }
+
+    bool successful = true;
+    uint16_t msgId = sections[2].toUInt(&successful, 10);
+    if (!successful) {
+      continue;
+    }
+
+    uint8_t dlc = sections[5].toUInt(&successful, 10);
+    if (!successful) {
+      continue;
+    }
+
+    for (int i = 0; i < 8; i++) {
+      data[i] = (i < dlc && 6 + i < sections.size()) ? sections[6 + i].toUInt(&successful, 10) : 0;
+    }
+
+    addFrame(sections[0].toDouble(), msgId, dlc, data);
+
+    if (length > 0 && (inputFile.pos() / length) * 100.0 > progressCounter) {
+      progressCounter = (int) ((inputFile.pos() / length) * 100.0);
+      emit progress(progressCounter);
+    }
+  }
+
+  inputFile.close();
+  return true;
+}
+
+void AppBusLoad::addFrame(double timestamp, uint16_t id, uint8_t dlc,
+    const uint8_t* data) {
+  int stuff;
+  int frameBits = busload_frame_bits(id, dlc, data, &stuff);
+
+  if (frames == 0) {
+    firstTime = timestamp;
+    lastTime = timestamp;
+  }
+
+  // Timing is only meaningful for frames in order, but every frame still
+  // counts towards the load
+  bool inOrder = frames == 0 || timestamp >= lastTime;
+  if (!inOrder) {
+    outOfOrder++;
+  }
+
+  frames++;
+  bits += frameBits;
+  stuffBits += stuff;
+
+  IdLoad& idLoad = ids[id];
+  NodeLoad& node = nodes[nodeName(id)];
+
+  if (inOrder) {
+    // Bus utilization and back to back runs on the whole bus
+    advanceWindow((int64_t) ((timestamp - firstTime) / BUSLOAD_WINDOW));
+    if (frames > 1 && timestamp - lastTime < BUSLOAD_BURST_GAP) {
+      if (++burst == 2) {
+        bursts++;
+      }
+    } else {
+      burst = 1;
+    }
+    maxBurst = burst > maxBurst ? burst : maxBurst;
+    lastTime = timestamp;
+
+    // Back to back runs from a single node
+    if (node.count > 0 && timestamp - node.lastTime < BUSLOAD_BURST_GAP) {
+      node.burst++;
+    } else {
+      node.burst = 1;
+    }
+    node.maxBurst = node.burst > node.maxBurst ? node.burst : node.maxBurst;
+    node.lastTime = timestamp;
+
+    // Inter-arrival time of this ID
+    if (idLoad.count > 0) {
+      double dt = timestamp - idLoad.lastTime;
+      idLoad.intervals++;
+      double delta = dt - idLoad.intervalMean;
+      idLoad.intervalMean += delta / idLoad.intervals;
+      idLoad.intervalM2 += delta * (dt - idLoad.intervalMean);
+      idLoad.intervalMin = (idLoad.intervals == 1 || dt < idLoad.intervalMin) ? dt : idLoad.intervalMin;
+      idLoad.intervalMax = (idLoad.intervals == 1 || dt > idLoad.intervalMax) ? dt : idLoad.intervalMax;
+
+      int bin = dt > BUSLOAD_PERIOD_MIN ?
+        (int) (log2(dt / BUSLOAD_PERIOD_MIN) * BUSLOAD_PERIOD_BINS_PER_OCTAVE) : 0;
+      bin = bin >= BUSLOAD_PERIOD_BINS ? BUSLOAD_PERIOD_BINS - 1 : bin;
+      idLoad.intervalBins[bin]++;
+
+      if (dt < BUSLOAD_BURST_GAP) {
+        if (++idLoad.burst == 2) {
+          idLoad.bursts++;
+        }
+      } else {
+        idLoad.burst = 1;
+      }
+    } else {
+      idLoad.firstTime = timestamp;
+      idLoad.burst = 1;
+    }
+    idLoad.maxBurst = idLoad.burst > idLoad.maxBurst ? idLoad.burst : idLoad.maxBurst;
+    idLoad.lastTime = timestamp;
+  }
+
+  windowBits += frameBits;
+
+  idLoad.id = id;
+  idLoad.dlc = dlc;
+  idLoad.count++;
+  idLoad.bits += frameBits;
+
+  node.count++;
+  node.bits += frameBits;
+}
+
+void AppBusLoad::advanceWindow(int64_t window) {
+  if (window <= this->window) {
+    return;
+  }
+
+  double utilization = windowBits / (BUSLOAD_BITRATE * BUSLOAD_WINDOW);
+  peakUtilization = utilization > peakUtilization ? utilization : peakUtilization;
+
+  int bin = (int) (utilization * BUSLOAD_UTIL_BINS);
+  bin = bin >= BUSLOAD_UTIL_BINS ? BUSLOAD_UTIL_BINS - 1 : bin;
+  utilizationBins[bin]++;
+
+  // Windows with no frames at all
+  utilizationBins[0] += window - this->window - 1;
+
+  this->window = window;
+  this->windowBits = 0;
+}
+
+QString AppBusLoad::nodeName(uint16_t id) {
+  map<uint16_t, std::pair<uint16_t, QString> >::iterator it = idRanges.upper_bound(id);
+  if (it == idRanges.begin() || id >= (--it)->second.first) {
+    return QString("UNKNOWN");
+  }
+  return it->second.second;
+}
+
+bool AppBusLoad::write(QString filename) {
+  // Close the final partial window
+  advanceWindow(window + 1);
+
+  ofstream outFile(filename.toLocal8Bit().data(), ios::out | ios::trunc);
+  if (!(outFile && outFile.good())) {
+    emit error(QString("Problem opening bus load file."));
+    return false;
+  }
+
+  double duration = lastTime - firstTime;
+  double capacity = duration * BUSLOAD_BITRATE;
+
+  outFile << QString("Session: %1 s - %2 s (%3 s), %4 frames, %5 out of order")
+    .arg(firstTime, 0, 'f', 3).arg(lastTime, 0, 'f', 3).arg(duration, 0, 'f', 3)
+    .arg((qulonglong) frames).arg((qulonglong) outOfOrder).toStdString() << '\n';
+
+  outFile << QString("Utilization at %1 kbit/s: mean %2 %, peak %3 % (%4 ms windows)")
+    .arg(BUSLOAD_BITRATE / 1000.0, 0, 'f', 0)
+    .arg(capacity > 0.0 ? 100.0 * bits / capacity : 0.0, 0, 'f', 1)
+    .arg(100.0 * peakUtilization, 0, 'f', 1).arg(BUSLOAD_WINDOW * 1000.0, 0, 'f', 0)
+    .toStdString() << '\n';
+
+  outFile << QString("Stuff bits: %1 (%2 % of frame bits)").arg((qulonglong) stuffBits)
+    .arg(bits > 0 ? 100.0 * stuffBits / bits : 0.0, 0, 'f', 1).toStdString() << '\n';
+
+  outFile << QString("Back to back runs (< %1 us apart): %2, longest %3 frames")
+    .arg(BUSLOAD_BURST_GAP * 1e6, 0, 'f', 0).arg((qulonglong) bursts).arg(maxBurst)
+    .toStdString() << '\n';
+
+  // Utilization histogram
+  uint64_t windows = 0;
+  for (int i = 0; i < BUSLOAD_UTIL_BINS; i++) {
+    windows += utilizationBins[i];
+  }
+
+  outFile << '\n' << QString("%1 %2 %3").arg("Utilization", -12).arg("Windows", 12)
+    .arg("[%]", 8).toStdString() << '\n';
+  for (int i = 0; i < BUSLOAD_UTIL_BINS; i++) {
+    int low = i * 100 / BUSLOAD_UTIL_BINS;
+    int high = (i + 1) * 100 / BUSLOAD_UTIL_BINS;
+    outFile << QString("%1 %2 %3").arg(QString("%1-%2%").arg(low).arg(high), -12)
+      .arg((qulonglong) utilizationBins[i], 12)
+      .arg(windows > 0 ? 100.0 * utilizationBins[i] / windows : 0.0, 8, 'f', 2)
+      .toStdString() << '\n';
+  }
+
+  // Per node
+  outFile << '\n' << QString("%1 %2 %3 %4 %5").arg("Node", -12).arg("Frames", 12)
+    .arg("Rate [Hz]", 10).arg("Load [%]", 9).arg("Max Run", 8).toStdString() << '\n';
+
+  typedef map<QString, NodeLoad>::iterator it_node;
+  for (it_node nodeIt = nodes.begin(); nodeIt != nodes.end(); nodeIt++) {
+    NodeLoad& node = nodeIt->second;
+    outFile << QString("%1 %2 %3 %4 %5").arg(nodeIt->first, -12)
+      .arg((qulonglong) node.count, 12)
+      .arg(duration > 0.0 ? node.count / duration : 0.0, 10, 'f', 1)
+      .arg(capacity > 0.0 ? 100.0 * node.bits / capacity : 0.0, 9, 'f', 2)
+      .arg(node.maxBurst, 8).toStdString() << '\n';
+  }
+
+  // Per ID, with a jitter histogram relative to the median period
+  QString jitterHeader;
+  for (int i = 0; i < BUSLOAD_JITTER_BINS; i++) {
+    jitterHeader += QString(" %1").arg(BUSLOAD_JITTER_LABELS[i], 9);
+  }
+
+  outFile << '\n' << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9 %10 %11 %12")
+    .arg("ID", -6).arg("Node", -12).arg("DLC", 3).arg("Frames", 10)
+    .arg("Rate [Hz]", 10).arg("Period [ms]", 11).arg("Jitter [ms]", 11)
+    .arg("Min [ms]", 9).arg("Max [ms]", 9).arg("Load [%]", 9).arg("Max Run", 8)
+    .arg(jitterHeader).toStdString() << '\n';
+
+  typedef map<uint16_t, IdLoad>::iterator it_id;
+  for (it_id idIt = ids.begin(); idIt != ids.end(); idIt++) {
+    IdLoad& idLoad = idIt->second;
+    double idDuration = idLoad.lastTime - idLoad.firstTime;
+    double stddev = idLoad.intervals > 1 ?
+      sqrt(idLoad.intervalM2 / (idLoad.intervals - 1)) : 0.0;
+
+    // Fraction of intervals in each jitter bin
+    QString jitter;
+    double median = idLoad.medianInterval();
+    uint64_t jitterBins[BUSLOAD_JITTER_BINS] = {0};
+    for (int i = 0; i < BUSLOAD_PERIOD_BINS && median > 0.0; i++) {
+      double center = BUSLOAD_PERIOD_MIN * pow(2.0, (i + 0.5) / BUSLOAD_PERIOD_BINS_PER_OCTAVE);
+      int bin = 0;
+      while (bin < BUSLOAD_JITTER_BINS - 1 && center / median >= BUSLOAD_JITTER_EDGES[bin]) {
+        bin++;
+      }
+      jitterBins[bin] += idLoad.intervalBins[i];
+    }
+    for (int i = 0; i < BUSLOAD_JITTER_BINS; i++) {
+      jitter += QString(" %1").arg(idLoad.intervals > 0 ?
+          100.0 * jitterBins[i] / idLoad.intervals : 0.0, 9, 'f', 1);
+    }
+
+    outFile << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9 %10 %11 %12")
+      .arg(QString("0x%1").arg(idLoad.id, 3, 16, QChar('0')), -6)
+      .arg(nodeName(idLoad.id), -12).arg(idLoad.dlc, 3)
+      .arg((qulonglong) idLoad.count, 10)
+      .arg(idDuration > 0.0 ? idLoad.intervals / idDuration : 0.0, 10, 'f', 1)
+      .arg(median * 1000.0, 11, 'f', 2).arg(stddev * 1000.0, 11, 'f', 3)
+      .arg(idLoad.intervalMin * 1000.0, 9, 'f', 2).arg(idLoad.intervalMax * 1000.0, 9, 'f', 2)
+      .arg(capacity > 0.0 ? 100.0 * idLoad.bits / capacity : 0.0, 9, 'f', 2)
+      .arg(idLoad.maxBurst, 8).arg(jitter).toStdString() << '\n';
+  }
+
+  outFile.close();
+  return true;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file busload.h
+ * Analyzes bus load and frame timing of recorded logs.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef BUSLOAD_H
+#define BUSLOAD_H
+
+#include <map>
+#include <utility>
+#include <vector>
+#include <fstream>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include "config.h"
+#include "header.h"
+
+using std::map;
+using std::vector;
+using std::ofstream;
+
+// Nominal bit rate of the car's CAN bus
+#define BUSLOAD_BITRATE 1000000.0
+
+// Length of the windows used for instantaneous utilization, in seconds
+#define BUSLOAD_WINDOW 0.010
+
+// Frames starting closer together than this are back to back on the bus, in
+// seconds. An 8 byte frame takes about 130 us at 1 Mbit/s.
+#define BUSLOAD_BURST_GAP 0.0002
+
+// Size of each chunk read from custom log files
+#define BUSLOAD_CHUNK_SIZE (1 << 20)
+
+// Inter-arrival times are binned logarithmically from BUSLOAD_PERIOD_MIN with
+// BUSLOAD_PERIOD_BINS_PER_OCTAVE bins per doubling, so the median period can
+// be found to within about 4% without storing every interval
+#define BUSLOAD_PERIOD_MIN 0.00001
+#define BUSLOAD_PERIOD_BINS_PER_OCTAVE 16
+#define BUSLOAD_PERIOD_BINS (BUSLOAD_PERIOD_BINS_PER_OCTAVE * 21)
+
+// Number of bins in the utilization histogram
+#define BUSLOAD_UTIL_BINS 20
+
+// Number of bins in the jitter histogram, relative to the median period
+#define BUSLOAD_JITTER_BINS 7
+
+// IDs each node sends from its *_ID base in CAN.h, [base, base + span). The
+// nodes use up to 16 IDs, including their ISO-TP and health offsets. Every
+// other *_ID define, such as ERROR_ID or the tire temperature sensors, is a
+// single ID.
+#define BUSLOAD_NODE_SPAN 0x010
+#define BUSLOAD_NODES "SPM MOTEC GCM LOGGER WHEEL ADL PDM PDM_CONFIG"
+
+/**
+ * Returns the number of bits a standard data frame occupies on the bus,
+ * including stuff bits and interframe space.
+ *
+ * @param id The 11 bit identifier.
+ * @param dlc The data length code.
+ * @param data The <dlc> data bytes.
+ * @param stuffBits Set to the number of stuff bits in the frame.
+ */
+int busload_frame_bits(uint16_t id, uint8_t dlc, const uint8_t* data, int* stuffBits);
+
+// Timing statistics accumulated for one message ID
+struct IdLoad {
+  uint16_t id;
+  uint8_t dlc;
+  uint64_t count;
+  uint64_t bits;
+  double firstTime;
+  double lastTime;
+
+  // Inter-arrival time statistics
+  uint64_t intervals;
+  double intervalMean;
+  double intervalM2;
+  double intervalMin;
+  double intervalMax;
+  vector<uint64_t> intervalBins;
+
+  // Runs of frames of this ID sent back to back
+  uint32_t burst;
+  uint32_t maxBurst;
+  uint64_t bursts;
+
+  IdLoad() {
+    id = 0;
+    dlc = 0;
+    count = 0;
+    bits = 0;
+    firstTime = 0.0;
+    lastTime = 0.0;
+    intervals = 0;
+    intervalMean = 0.0;
+    intervalM2 = 0.0;
+    intervalMin = 0.0;
+    intervalMax = 0.0;
+    intervalBins.resize(BUSLOAD_PERIOD_BINS, 0);
+    burst = 0;
+    maxBurst = 0;
+    bursts = 0;
+  }
+
+  /**
+   * Returns the median inter-arrival time, estimated from intervalBins.
+   */
+  double medianInterval();
+};
+
+// Load statistics accumulated for one node (*_ID base)
+struct NodeLoad {
+  QString name;
+  uint64_t count;
+  uint64_t bits;
+  double lastTime;
+  uint32_t burst;
+  uint32_t maxBurst;
+
+  NodeLoad() {
+    count = 0;
+    bits = 0;
+    lastTime = 0.0;
+    burst = 0;
+    maxBurst = 0;
+  }
+};
+
+/**
+ * Class which streams through a recorded log once and reports the actual send
+ * rate, inter-arrival jitter and burst sizes of every message ID and node, and
+ * the utilization of the bus including stuff bits.
+ *
+ * Custom logs only store the signal words of each message, so stuff bits are
+ * counted from the logged words and the DLC from config.dbc. Vector logs store
+ * the full payload.
+ */
+class AppBusLoad : public QObject {
+  Q_OBJECT
+
+  public:
+
+    /**
+     * Analyzes a log file and writes a .busload.txt report next to it.
+     *
+     * @param filename The log file to analyze.
+     * @returns Whether the analysis was successful.
+     */
+    bool analyze(QString filename);
+
+  signals:
+
+    /**
+     * Error handler that will be connected to an error function in the display
+     * class. Calling this method will display a error message box.
+     *
+     * @params error The error message to display.
+     */
+    void error(QString error);
+
+    /**
+     * Updates the progress bar with the latest progress counter.
+     *
+     * @param progress The latest progress counter to display.
+     */
+    void progress(int progress);
+
+  private:
+
+    /**
+     * Resets every statistic.
+     */
+    void reset();
+
+    /**
+     * Streams through a custom uSD log in fixed size chunks.
+     */
+    bool readCustom(QString filename);
+
+    /**
+     * Streams through a Vector log one line at a time.
+     */
+    bool readVector(QString filename);
+
+    /**
+     * Adds a single frame to the statistics.
+     */
+    void addFrame(double timestamp, uint16_t id, uint8_t dlc, const uint8_t* data);
+
+    /**
+     * Closes every utilization window before <window>.
+     */
+    void advanceWindow(int64_t window);
+
+    /**
+     * Writes the report.
+     */
+    bool write(QString filename);
+
+    /**
+     * Returns the name of the node that sends the given ID.
+     */
+    QString nodeName(uint16_t id);
+
+    map<uint16_t, Message> messages;
+
+    // Name and end of the range of IDs each *_ID define covers, by base
+    map<uint16_t, std::pair<uint16_t, QString> > idRanges;
+
+    map<uint16_t, IdLoad> ids;
+    map<QString, NodeLoad> nodes;
+
+    uint64_t frames;
+    uint64_t bits;
+    uint64_t stuffBits;
+    uint64_t outOfOrder;
+    double firstTime;
+    double lastTime;
+
+    // Utilization of each BUSLOAD_WINDOW
+    int64_t window;
+    uint64_t windowBits;
+    double peakUtilization;
+    vector<uint64_t> utilizationBins;
+
+    // Runs of frames sent back to back by any node
+    uint32_t burst;
+    uint32_t maxBurst;
+    uint64_t bursts;
+};
+
+#endif // BUSLOAD_H
@@ -7,5 +7,7 @@ QT += gui core widgets
 CONFIG += qt
 CONFIG += c++11
 
-HEADERS += config.h data.h display.h compute.h
-SOURCES += config.cpp data.cpp display.cpp compute.cpp main.cpp
+HEADERS += config.h data.h display.h compute.h derived.h stats.h lod.h viewer.h compress.h browser.h header.h busload.h crosscheck.h codegen.h
+SOURCES += config.cpp data.cpp display.cpp compute.cpp derived.cpp stats.cpp lod.cpp viewer.cpp compress.cpp browser.cpp header.cpp busload.cpp crosscheck.cpp codegen.cpp main.cpp
+
+LIBS += -llz4 -lzstd
@@ -0,0 +1,257 @@
+/**
+ * @file codegen.cpp
+ * Implementation of the AppCodeGen class.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include <cmath>
+#include "codegen.h"
+
+bool AppCodeGen::generate(QString filename) {
+  report.clear();
+
+  AppConfig config;
+  messages = config.getMessages();
+  if (messages.empty()) {
+    report.append("Problem reading config.dbc.");
+    return false;
+  }
+
+  QFile outFile(filename);
+  if (!outFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    report.append(QString("Problem opening output file: %1").arg(filename));
+    return false;
+  }
+
+  QTextStream out(&outFile);
+  out << "/**\n";
+  out << " * FSAE Library CAN Pack/Unpack Functions\n";
+  out << " *\n";
+  out << " * Generated by can-translator --codegen from config.dbc. Do not edit.\n";
+  out << " */\n";
+  out << "#ifndef CAN_GEN_H\n";
+  out << "#define CAN_GEN_H\n\n";
+  out << "#include <stdint.h>\n\n";
+  out << "/**\n";
+  out << " * Converts a raw field to Q" << (32 - CODEGEN_Q) << "." << CODEGEN_Q
+    << " physical units using a signal's scale constants.\n";
+  out << " */\n";
+  out << "#define CAN_GEN_Q16(raw, sig) (((int64_t) (raw)) * sig##_SCL_Q16 + sig##_OFF_Q16)\n";
+
+  int written = 0;
+  int skipped = 0;
+  typedef map<uint16_t, Message>::iterator it_msg;
+  for (it_msg msgIt = messages.begin(); msgIt != messages.end(); msgIt++) {
+    Message& msg = msgIt->second;
+    QString name = identifier(msg.name);
+
+    out << "\n/**\n";
+    out << " * " << msg.name << " (0x" << QString::number(msg.id, 16) << ")\n";
+    out << " */\n";
+    out << "#define CAN_" << name << "_ID 0x" << QString::number(msg.id, 16) << "\n";
+    out << "#define CAN_" << name << "_DLC " << (int) msg.dlc << "\n";
+
+    QVector<Signal> sigs;
+    for (int i = 0; i < msg.sigs.size(); i++) {
+      if (writeSignal(out, msg, msg.sigs[i])) {
+        sigs.append(msg.sigs[i]);
+        written++;
+      } else {
+        skipped++;
+      }
+    }
+
+    writeMessage(out, msg, sigs);
+  }
+
+  out << "\n#endif /* CAN_GEN_H */\n";
+  outFile.close();
+
+  report.append(QString("Wrote %1 signals in %2 messages to %3, skipped %4.")
+      .arg(written).arg(messages.size()).arg(filename).arg(skipped));
+  return true;
+}
+
+bool AppCodeGen::writeSignal(QTextStream& out, const Message& msg, const Signal& sig) {
+  QString name = identifier(msg.name) + "_" + identifier(sig.title);
+  int width = typeWidth(sig.bitLen);
+  QString type = rawType(sig);
+  QString utype = QString("uint%1_t").arg(width);
+
+  // Work out which bytes the signal covers
+  int firstByte;
+  int numBytes;
+  int bitOffset;
+  if (sig.isBigEndian) {
+    if (sig.startBit % 8 != 7 || sig.bitLen % 8 != 0) {
+      report.append(QString("Skipped %1.%2: big endian signals must be whole bytes.")
+          .arg(msg.name).arg(sig.title));
+      return false;
+    }
+    firstByte = sig.startBit / 8;
+    numBytes = sig.bitLen / 8;
+    bitOffset = 0;
+  } else {
+    firstByte = sig.startBit / 8;
+    bitOffset = sig.startBit % 8;
+    numBytes = (bitOffset + sig.bitLen + 7) / 8;
+  }
+  if (sig.bitLen == 0 || firstByte + numBytes > 8) {
+    report.append(QString("Skipped %1.%2: signal does not fit in 8 bytes.")
+        .arg(msg.name).arg(sig.title));
+    return false;
+  }
+
+  // Scale constants, noting when Q16.16 cannot represent them exactly
+  double sclQ = sig.scalar * (1 << CODEGEN_Q);
+  double offQ = sig.offset * (1 << CODEGEN_Q);
+  long long sclFixed = llround(sclQ);
+  long long offFixed = llround(offQ);
+
+  out << "\n// " << sig.title << " <" << sig.units << ">: " << (int) sig.bitLen << " bit "
+    << (sig.isSigned ? "signed" : "unsigned") << " "
+    << (sig.isBigEndian ? "big" : "little") << " endian at bit " << (int) sig.startBit
+    << ", scalar " << QString::number(sig.scalar, 'g', 10)
+    << ", offset " << QString::number(sig.offset, 'g', 10) << "\n";
+  if (sclFixed != sclQ || offFixed != offQ) {
+    out << "// Q" << (32 - CODEGEN_Q) << "." << CODEGEN_Q
+      << " scale constants are rounded\n";
+  }
+  if (sclFixed == 0 && sig.scalar != 0.0) {
+    report.append(QString("%1.%2: scalar rounds to zero in Q%3.%4.").arg(msg.name)
+        .arg(sig.title).arg(32 - CODEGEN_Q).arg(CODEGEN_Q));
+  }
+  out << "#define CAN_" << name << "_SCL_Q16 " << sclFixed << "LL\n";
+  out << "#define CAN_" << name << "_OFF_Q16 " << offFixed << "LL\n";
+
+  // Unpack
+  int accWidth = sig.isBigEndian ? width : (numBytes * 8 <= 32 ? 32 : 64);
+  QString accType = QString("uint%1_t").arg(accWidth);
+  QString mask = QString("0x%1").arg(sig.bitLen == 64 ? QString("FFFFFFFFFFFFFFFF") :
+      QString::number((((uint64_t) 1) << sig.bitLen) - 1, 16).toUpper());
+  if (accWidth == 64) {
+    mask += "ULL";
+  }
+
+  QStringList terms;
+  for (int i = 0; i < numBytes; i++) {
+    int shift = sig.isBigEndian ? 8 * (numBytes - 1 - i) : 8 * i;
+    QString term = QString("(%1) data[%2]").arg(accType).arg(firstByte + i);
+    if (shift > 0) {
+      term += QString(" << %1").arg(shift);
+    }
+    terms.append(numBytes > 1 ? "(" + term + ")" : term);
+  }
+  QString expr = terms.join(" | ");
+  if (bitOffset > 0) {
+    expr = QString("(%1) >> %2").arg(expr).arg(bitOffset);
+  }
+  if (numBytes * 8 - bitOffset > sig.bitLen) {
+    expr = QString("(%1) & %2").arg(expr).arg(mask);
+  }
+
+  out << "static inline " << type << " CAN_unpack_" << name << "(const uint8_t* data) {\n";
+  out << "  " << utype << " raw = (" << utype << ") (" << expr << ");\n";
+  if (sig.isSigned && sig.bitLen != width) {
+    int extend = width - sig.bitLen;
+    out << "  return ((" << type << ") (raw << " << extend << ")) >> " << extend << ";\n";
+  } else {
+    out << "  return (" << type << ") raw;\n";
+  }
+  out << "}\n";
+
+  // Pack, keeping bits of the bytes that belong to other signals
+  out << "static inline void CAN_pack_" << name << "(uint8_t* data, " << type
+    << " value) {\n";
+  QString rawExpr = QString("(%1) value").arg(accType);
+  if (sig.bitLen != accWidth) {
+    rawExpr = QString("(%1 & %2)").arg(rawExpr).arg(mask);
+  }
+  if (bitOffset > 0) {
+    rawExpr = QString("%1 << %2").arg(rawExpr).arg(bitOffset);
+  }
+  out << "  " << accType << " raw = " << rawExpr << ";\n";
+  for (int i = 0; i < numBytes; i++) {
+    int shift = sig.isBigEndian ? 8 * (numBytes - 1 - i) : 8 * i;
+    QString byteExpr = shift > 0 ? QString("(uint8_t) (raw >> %1)").arg(shift) :
+      QString("(uint8_t) raw");
+
+    int low = i == 0 ? bitOffset : 0;
+    int high = bitOffset + sig.bitLen - 8 * i;
+    high = high > 8 ? 8 : high;
+    int covered = ((1 << high) - 1) & ~((1 << low) - 1);
+
+    out << "  data[" << (firstByte + i) << "] = ";
+    if (covered != 0xFF) {
+      out << "(data[" << (firstByte + i) << "] & 0x"
+        << QString::number(~covered & 0xFF, 16).toUpper() << ") | ";
+    }
+    out << byteExpr << ";\n";
+  }
+  out << "}\n";
+
+  return true;
+}
+
+void AppCodeGen::writeMessage(QTextStream& out, const Message& msg, QVector<Signal>& sigs) {
+  if (sigs.empty()) {
+    return;
+  }
+
+  QString name = identifier(msg.name);
+
+  out << "\ntypedef struct {\n";
+  for (int i = 0; i < sigs.size(); i++) {
+    out << "  " << rawType(sigs[i]) << " " << identifier(sigs[i].title) << ";\n";
+  }
+  out << "} CAN_" << name << "_t;\n";
+
+  out << "static inline void CAN_unpack_" << name << "(const uint8_t* data, CAN_"
+    << name << "_t* msg) {\n";
+  for (int i = 0; i < sigs.size(); i++) {
+    QString sigName = identifier(sigs[i].title);
+    out << "  msg->" << sigName << " = CAN_unpack_" << name << "_" << sigName
+      << "(data);\n";
+  }
+  out << "}\n";
+
+  out << "static inline void CAN_pack_" << name << "(uint8_t* data, const CAN_"
+    << name << "_t* msg) {\n";
+  out << "  uint8_t i;\n";
+  out << "  for (i = 0; i < CAN_" << name << "_DLC; i++) {\n";
+  out << "    data[i] = 0;\n";
+  out << "  }\n";
+  for (int i = 0; i < sigs.size(); i++) {
+    QString sigName = identifier(sigs[i].title);
+    out << "  CAN_pack_" << name << "_" << sigName << "(data, msg->" << sigName
+      << ");\n";
+  }
+  out << "}\n";
+}
+
+QString AppCodeGen::identifier(QString name) {
+  QString result = name;
+  for (int i = 0; i < result.length(); i++) {
+    if (!(result[i].isLetterOrNumber() || result[i] == '_') || result[i].toLatin1() == 0) {
+      result[i] = '_';
+    }
+  }
+  return result;
+}
+
+int AppCodeGen::typeWidth(int bitLen) {
+  if (bitLen <= 8) {
+    return 8;
+  } else if (bitLen <= 16) {
+    return 16;
+  } else if (bitLen <= 32) {
+    return 32;
+  } else {
+    return 64;
+  }
+}
+
+QString AppCodeGen::rawType(const Signal& sig) {
+  return QString(sig.isSigned ? "int%1_t" : "uint%1_t").arg(typeWidth(sig.bitLen));
+}
@@ -0,0 +1,96 @@
+/**
+ * @file codegen.h
+ * Generates firmware pack/unpack functions from config.dbc.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include <map>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QCoreApplication>
+#include "config.h"
+
+using std::map;
+
+// Number of fractional bits in the generated fixed-point scale constants
+#define CODEGEN_Q 16
+
+/**
+ * Class which writes a C header with static inline, integer-only pack and
+ * unpack functions for every signal in config.dbc, so the nodes do not have to
+ * hand-decode frames with shifts and doubles.
+ *
+ * For a message MSG with signal SIG the header contains:
+ *
+ *   CAN_MSG_ID, CAN_MSG_DLC            The message ID and length
+ *   CAN_unpack_MSG_SIG(data)           The raw field, sign extended
+ *   CAN_pack_MSG_SIG(data, raw)        Stores the raw field, keeping other bits
+ *   CAN_MSG_SIG_SCL_Q16, _OFF_Q16      Scalar and offset in Q16.16
+ *   CAN_MSG_t, CAN_unpack_MSG(data, m) The raw fields of the whole message
+ *   CAN_pack_MSG(data, m)
+ *
+ * CAN_GEN_Q16(raw, CAN_MSG_SIG) converts a raw field to Q16.16 physical units.
+ * Little endian signals may start at any bit. Big endian signals must be whole
+ * bytes, which is the only big endian layout the translator decodes.
+ */
+class AppCodeGen : public QObject {
+  Q_OBJECT
+
+  public:
+
+    /**
+     * Reads config.dbc and writes the generated header.
+     *
+     * @param filename The header to write.
+     * @returns Whether the header was written. Skipped signals are listed in
+     *     <report> but do not fail generation.
+     */
+    bool generate(QString filename);
+
+    /**
+     * Skipped signals and other notes, followed by a summary.
+     */
+    QStringList report;
+
+  private:
+
+    /**
+     * Writes the constants and functions for one signal.
+     *
+     * @returns Whether the signal's layout is supported.
+     */
+    bool writeSignal(QTextStream& out, const Message& msg, const Signal& sig);
+
+    /**
+     * Writes the struct and whole-message functions for one message.
+     */
+    void writeMessage(QTextStream& out, const Message& msg, QVector<Signal>& sigs);
+
+    /**
+     * Returns <name> with every character that is not valid in a C identifier
+     * replaced by an underscore.
+     */
+    QString identifier(QString name);
+
+    /**
+     * Returns the width of the smallest standard integer type that holds
+     * <bitLen> bits.
+     */
+    int typeWidth(int bitLen);
+
+    /**
+     * Returns the C type that holds the raw value of <sig>.
+     */
+    QString rawType(const Signal& sig);
+
+    map<uint16_t, Message> messages;
+};
+
+#endif // CODEGEN_H
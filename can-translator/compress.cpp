@@ -0,0 +1,260 @@
+/**
+ * @file compress.cpp
+ * Implementation of the BlockWriter and CompressThread classes.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include <cstring>
+#include "compress.h"
+
+using std::ios;
+
+QString compressSuffix(CompressCodec codec) {
+  switch (codec) {
+    case COMPRESS_LZ4:
+      return QString(".lz4");
+    case COMPRESS_ZSTD:
+      return QString(".zst");
+    default:
+      return QString("");
+  }
+}
+
+//============================== COMPRESS THREAD ===============================
+
+CompressThread::CompressThread() : QThread() {
+  codec = COMPRESS_NONE;
+  failed = false;
+  closing = false;
+  lz4Context = NULL;
+  zstdContext = NULL;
+}
+
+CompressThread::~CompressThread() {
+  if (isRunning()) {
+    finish();
+  }
+  freeCodec();
+}
+
+bool CompressThread::begin(QString filename, CompressCodec codec, bool append) {
+  this->codec = codec;
+  this->failed = false;
+  this->closing = false;
+  this->queue.clear();
+
+  file.open(filename.toLocal8Bit().data(),
+      ios::out | ios::binary | (append ? ios::app : ios::trunc));
+  if (!(file && file.good())) {
+    return false;
+  }
+
+  if (!beginCodec()) {
+    file.close();
+    freeCodec();
+    return false;
+  }
+
+  start();
+  return true;
+}
+
+bool CompressThread::beginCodec() {
+  if (codec == COMPRESS_LZ4) {
+    if (LZ4F_isError(LZ4F_createCompressionContext(&lz4Context, LZ4F_VERSION))) {
+      lz4Context = NULL;
+      return false;
+    }
+
+    LZ4F_preferences_t prefs;
+    memset(&prefs, 0, sizeof(prefs));
+    prefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+
+    output.resize(LZ4F_compressBound(COMPRESS_BLOCK_SIZE, &prefs) + LZ4F_HEADER_SIZE_MAX);
+    size_t length = LZ4F_compressBegin(lz4Context, &output[0], output.size(), &prefs);
+    if (LZ4F_isError(length)) {
+      return false;
+    }
+    file.write(&output[0], length);
+  } else if (codec == COMPRESS_ZSTD) {
+    zstdContext = ZSTD_createCCtx();
+    if (!zstdContext || ZSTD_isError(ZSTD_CCtx_setParameter(zstdContext,
+            ZSTD_c_compressionLevel, COMPRESS_ZSTD_LEVEL)) ||
+        ZSTD_isError(ZSTD_CCtx_setParameter(zstdContext, ZSTD_c_checksumFlag, 1))) {
+      return false;
+    }
+    output.resize(ZSTD_CStreamOutSize());
+  }
+
+  return file.good();
+}
+
+void CompressThread::push(vector<char>& block) {
+  QMutexLocker locker(&mutex);
+  while (queue.size() >= COMPRESS_QUEUE_DEPTH) {
+    notFull.wait(&mutex);
+  }
+
+  queue.push_back(vector<char>());
+  queue.back().swap(block);
+  notEmpty.wakeOne();
+}
+
+bool CompressThread::finish() {
+  mutex.lock();
+  closing = true;
+  notEmpty.wakeOne();
+  mutex.unlock();
+
+  wait();
+
+  if (!failed && !compressEnd()) {
+    failed = true;
+  }
+
+  file.close();
+  freeCodec();
+  return !failed && !file.fail();
+}
+
+void CompressThread::run() {
+  vector<char> block;
+
+  while (true) {
+    mutex.lock();
+    while (queue.empty() && !closing) {
+      notEmpty.wait(&mutex);
+    }
+    if (queue.empty()) {
+      mutex.unlock();
+      return;
+    }
+
+    block.swap(queue.front());
+    queue.pop_front();
+    notFull.wakeOne();
+    mutex.unlock();
+
+    // Keep draining after a failure so the converter never blocks on a full
+    // queue, the error is reported by finish()
+    if (!failed && !compressBlock(block)) {
+      failed = true;
+    }
+    block.clear();
+  }
+}
+
+bool CompressThread::compressBlock(const vector<char>& block) {
+  if (block.empty()) {
+    return true;
+  }
+
+  if (codec == COMPRESS_NONE) {
+    file.write(&block[0], block.size());
+  } else if (codec == COMPRESS_LZ4) {
+    size_t length = LZ4F_compressUpdate(lz4Context, &output[0], output.size(),
+        &block[0], block.size(), NULL);
+    if (LZ4F_isError(length)) {
+      return false;
+    }
+    file.write(&output[0], length);
+  } else if (codec == COMPRESS_ZSTD) {
+    ZSTD_inBuffer in = {&block[0], block.size(), 0};
+    while (in.pos < in.size) {
+      ZSTD_outBuffer out = {&output[0], output.size(), 0};
+      if (ZSTD_isError(ZSTD_compressStream2(zstdContext, &out, &in, ZSTD_e_continue))) {
+        return false;
+      }
+      file.write(&output[0], out.pos);
+    }
+  }
+
+  return file.good();
+}
+
+bool CompressThread::compressEnd() {
+  if (codec == COMPRESS_LZ4) {
+    size_t length = LZ4F_compressEnd(lz4Context, &output[0], output.size(), NULL);
+    if (LZ4F_isError(length)) {
+      return false;
+    }
+    file.write(&output[0], length);
+  } else if (codec == COMPRESS_ZSTD) {
+    ZSTD_inBuffer in = {NULL, 0, 0};
+    size_t remaining;
+    do {
+      ZSTD_outBuffer out = {&output[0], output.size(), 0};
+      remaining = ZSTD_compressStream2(zstdContext, &out, &in, ZSTD_e_end);
+      if (ZSTD_isError(remaining)) {
+        return false;
+      }
+      file.write(&output[0], out.pos);
+    } while (remaining > 0);
+  }
+
+  return file.good();
+}
+
+void CompressThread::freeCodec() {
+  if (lz4Context) {
+    LZ4F_freeCompressionContext(lz4Context);
+    lz4Context = NULL;
+  }
+  if (zstdContext) {
+    ZSTD_freeCCtx(zstdContext);
+    zstdContext = NULL;
+  }
+}
+
+//=============================== BLOCK WRITER =================================
+
+BlockWriter::BlockWriter() {
+  isOpen = false;
+}
+
+bool BlockWriter::open(QString filename, CompressCodec codec, bool append) {
+  if (!thread.begin(filename + compressSuffix(codec), codec, append)) {
+    return false;
+  }
+
+  block.resize(COMPRESS_BLOCK_SIZE);
+  setp(&block[0], &block[0] + block.size());
+  isOpen = true;
+  return true;
+}
+
+bool BlockWriter::close() {
+  if (!isOpen) {
+    return false;
+  }
+
+  pushBlock();
+  setp(NULL, NULL);
+  isOpen = false;
+  return thread.finish();
+}
+
+int BlockWriter::overflow(int c) {
+  if (!isOpen) {
+    return traits_type::eof();
+  }
+
+  pushBlock();
+  block.resize(COMPRESS_BLOCK_SIZE);
+  setp(&block[0], &block[0] + block.size());
+
+  if (c != traits_type::eof()) {
+    *pptr() = (char) c;
+    pbump(1);
+  }
+  return traits_type::not_eof(c);
+}
+
+void BlockWriter::pushBlock() {
+  block.resize(pptr() - pbase());
+  if (!block.empty()) {
+    thread.push(block);
+  }
+  block.clear();
+}
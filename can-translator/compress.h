@@ -0,0 +1,159 @@
+/**
+ * @file compress.h
+ * Buffered output with optional block compression on a separate thread.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef COMPRESS_H
+#define COMPRESS_H
+
+#include <deque>
+#include <vector>
+#include <fstream>
+#include <streambuf>
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+#include <lz4frame.h>
+#include <zstd.h>
+
+using std::deque;
+using std::vector;
+using std::ofstream;
+
+// Size of each block handed to the compression thread
+#define COMPRESS_BLOCK_SIZE (1 << 20)
+
+// Maximum number of blocks waiting to be compressed. Once full, the converter
+// blocks until the compression thread catches up, bounding memory use.
+#define COMPRESS_QUEUE_DEPTH 4
+
+// zstd level used for converted logs. Level 3 is the zstd default and keeps
+// up with conversion on a single core.
+#define COMPRESS_ZSTD_LEVEL 3
+
+/**
+ * Output compression codecs. The output is a standard LZ4 or zstd frame, so it
+ * can be decompressed with the lz4 and zstd command line tools.
+ */
+enum CompressCodec {
+  COMPRESS_NONE,
+  COMPRESS_LZ4,
+  COMPRESS_ZSTD
+};
+
+/**
+ * Returns the filename suffix appended to output compressed with <codec>.
+ */
+QString compressSuffix(CompressCodec codec);
+
+/**
+ * Thread which compresses and writes the blocks queued by a BlockWriter. The
+ * queue is bounded so a slow disk or codec applies back pressure to the
+ * converter rather than buffering the whole log in memory.
+ */
+class CompressThread : public QThread {
+  Q_OBJECT
+
+  public:
+
+    CompressThread();
+    ~CompressThread();
+
+    /**
+     * Opens the output file and starts the thread.
+     *
+     * @returns Whether the file and codec were initialized successfully.
+     */
+    bool begin(QString filename, CompressCodec codec, bool append);
+
+    /**
+     * Queues a block for compression, waiting while the queue is full. The
+     * contents of <block> are swapped out, leaving it empty.
+     */
+    void push(vector<char>& block);
+
+    /**
+     * Waits for every queued block to be written, ends the frame and closes
+     * the output file.
+     *
+     * @returns Whether every block was compressed and written successfully.
+     */
+    bool finish();
+
+  private:
+
+    /**
+     * Compresses and writes blocks until the queue is empty and closed.
+     */
+    void run();
+
+    bool beginCodec();
+    bool compressBlock(const vector<char>& block);
+    bool compressEnd();
+    void freeCodec();
+
+    CompressCodec codec;
+    ofstream file;
+    bool failed;
+
+    LZ4F_cctx* lz4Context;
+    ZSTD_CCtx* zstdContext;
+    vector<char> output;
+
+    QMutex mutex;
+    QWaitCondition notEmpty;
+    QWaitCondition notFull;
+    deque< vector<char> > queue;
+    bool closing;
+};
+
+/**
+ * Stream buffer which collects output into large blocks and passes them to a
+ * CompressThread. Attach it to a std::ostream to keep the usual formatting of
+ * the converted output while moving compression and disk writes off the
+ * conversion thread.
+ */
+class BlockWriter : public std::streambuf {
+
+  public:
+
+    BlockWriter();
+
+    /**
+     * Opens the output file.
+     *
+     * @param filename The name of the file to write, without codec suffix.
+     * @param codec The compression codec to use.
+     * @param append Whether to append to an existing file. Compressed frames
+     *     may be concatenated, so this is valid for every codec.
+     * @returns Whether the file was opened successfully.
+     */
+    bool open(QString filename, CompressCodec codec, bool append);
+
+    /**
+     * Flushes the last partial block and waits for the compression thread.
+     *
+     * @returns Whether every write was successful.
+     */
+    bool close();
+
+  protected:
+
+    /**
+     * Called by the stream when the current block is full.
+     */
+    int overflow(int c);
+
+  private:
+
+    void pushBlock();
+
+    CompressThread thread;
+    vector<char> block;
+    bool isOpen;
+};
+
+#endif // COMPRESS_H
@@ -3,7 +3,7 @@
  *
  * @author Andrew Mass
  * @date Created: 2016-03-15
- * @date Modified: 2016-03-15
+ * @date Modified: 2026-10-18
  */
 #include "compute.h"
 
@@ -25,3 +25,15 @@ void CoalesceComputeThread::run() {
   finish(this->data->coalesceLogfiles(this->filenames));
 }
 
+
+void BusLoadComputeThread::run() {
+  for(int i = 0; i < filenames.size(); i++) {
+    emit addFileProgress(this->filenames.at(i));
+
+    if(!this->busLoad->analyze(this->filenames.at(i))) {
+      finish(false);
+      return;
+    }
+  }
+  finish(true);
+}
@@ -3,7 +3,7 @@
  *
  * @author Andrew Mass
  * @date Created: 2016-03-15
- * @date Modified: 2016-03-15
+ * @date Modified: 2026-10-18
  */
 #ifndef COMPUTE_H
 #define COMPUTE_H
@@ -11,6 +11,7 @@
 #include <QThread>
 #include <QObject>
 #include "data.h"
+#include "busload.h"
 
 /**
  * Class which handles multithreading of the conversion process so that we
@@ -98,4 +99,48 @@ class CoalesceComputeThread : public QThread {
     void run();
 };
 
+/**
+ * Class which handles multithreading of the bus load analysis so that we
+ * don't lock up the GUI thread while analyzing logfiles.
+ */
+class BusLoadComputeThread : public QThread {
+  Q_OBJECT
+
+  public:
+
+    /**
+     * A list of logfiles to analyze.
+     */
+    QStringList filenames;
+
+    /**
+     * Pointer to the instance of the bus load class used for the computation.
+     */
+    AppBusLoad* busLoad;
+
+  signals:
+
+    /**
+     * Signal to be executed upon finishing the computation.
+     *
+     * @param success Whether the analysis was successful.
+     */
+    void finish(bool success);
+
+    /**
+     * Signal to be emitted whenever we need to add another file progress
+     * bar to the progress bar layout.
+     *
+     * @param filename - The name of the file to add the progress bar for.
+     */
+    void addFileProgress(QString filename);
+
+  private:
+
+    /**
+     * Starts the thread's main computation.
+     */
+    void run();
+};
+
 #endif /* COMPUTE_H */
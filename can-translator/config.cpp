@@ -3,8 +3,9 @@
  *
  * @author Andrew Mass
  * @date Created: 2014-06-24
- * @date Modified: 2016-03-13
+ * @date Modified: 2026-10-18
  */
+#include <cmath>
 #include "config.h"
 
 /**
@@ -114,6 +115,11 @@ Message AppConfig::getMessage(QVector<QString> messageBlock) {
     return Message();
   }
 
+  msg.name = sections[2];
+  if (msg.name.endsWith(":")) {
+    msg.name.chop(1);
+  }
+
   msg.dlc = sections[3].toUInt(&successful);
   if (!successful) {
     emit error(QString("Invalid DLC for message with ID: %1").arg(QString::number(msg.id, 16)));
@@ -228,3 +234,71 @@ Signal AppConfig::getSignal(QString signalDef) {
 
   return sig;
 }
+
+/**
+ * double Signal::decode(uint64_t data)
+ *
+ * Extracts this signal from the data bytes of a message and applies the
+ * scalar and offset.
+ *
+ * @param data The data bytes of the message, with byte 0 in the low byte.
+ * @returns The decoded value of the signal.
+ */
+double Signal::decode(uint64_t data) const {
+  double value;
+
+  uint8_t shift = isBigEndian ? startBit - 7 : startBit;
+  uint64_t sigData = (data >> shift) & ((uint64_t) (pow(2, bitLen) - 1));
+
+  if (bitLen <= 8) {
+    value = isSigned ? ((int8_t) sigData) : ((uint8_t) sigData);
+  } else if (bitLen > 8 && bitLen <= 16) {
+    if (!isBigEndian) {
+      value = isSigned ? ((int16_t) sigData) : ((uint16_t) sigData);
+    } else {
+      if (isSigned) {
+        uint8_t* sigDataArray = (uint8_t*) &sigData;
+        value = (int16_t) (sigDataArray[0] << 8 | sigDataArray[1]);
+      } else {
+        uint8_t* sigDataArray = (uint8_t*) &sigData;
+        value = (uint16_t) (sigDataArray[0] << 8 | sigDataArray[1]);
+      }
+    }
+  } else if (bitLen > 16 && bitLen <= 32) {
+    if (!isBigEndian) {
+      value = isSigned ? (double) ((int32_t) sigData) : (double) ((uint32_t) sigData);
+    } else {
+      if (isSigned) {
+        uint8_t* sigDataArray = (uint8_t*) &sigData;
+        value = (int32_t) (sigDataArray[0] << 24 | sigDataArray[1] << 16 |
+            sigDataArray[2] << 8 | sigDataArray[3]);
+      } else {
+        uint8_t* sigDataArray = (uint8_t*) &sigData;
+        value = (uint32_t) (sigDataArray[0] << 24 | sigDataArray[1] << 16 |
+            sigDataArray[2] << 8 | sigDataArray[3]);
+      }
+    }
+  } else if (bitLen > 32) {
+    if (!isBigEndian) {
+      value = isSigned ? (double) ((int64_t) sigData) : (double) ((uint64_t) sigData);
+    } else {
+      if (isSigned) {
+        uint8_t* sigDataArray = (uint8_t*) &sigData;
+        value = (int64_t) (((int64_t) sigDataArray[0]) << 56 |
+            ((int64_t) sigDataArray[1]) << 48 | ((int64_t) sigDataArray[2]) << 40 |
+            ((int64_t) sigDataArray[3]) << 32 | ((int64_t) sigDataArray[4]) << 24 |
+            ((int64_t) sigDataArray[5]) << 16 | ((int64_t) sigDataArray[6]) << 8 |
+            ((int64_t) sigDataArray[7]));
+      } else {
+        uint8_t* sigDataArray = (uint8_t*) &sigData;
+        value = (uint64_t) (((uint64_t) sigDataArray[0]) << 56 |
+            ((uint64_t) sigDataArray[1]) << 48 | ((uint64_t) sigDataArray[2]) << 40 |
+            ((uint64_t) sigDataArray[3]) << 32 | ((uint64_t) sigDataArray[4]) << 24 |
+            ((uint64_t) sigDataArray[5]) << 16 | ((uint64_t) sigDataArray[6]) << 8 |
+            ((uint64_t) sigDataArray[7]));
+      }
+    }
+  }
+
+  return (value * scalar) + offset;
+}
@@ -3,7 +3,7 @@
  *
  * @author Andrew Mass
  * @date Created: 2014-06-24
- * @date Modified: 2016-03-13
+ * @date Modified: 2026-10-18
  */
 #ifndef CONFIG_H
 #define CONFIG_H
@@ -49,6 +49,8 @@ struct Signal {
     return !(title.isEmpty() && units.isEmpty());
   }
 
+  double decode(uint64_t data) const;
+
   QString toString() {
     return title + "<" + units + ">" + " isS: " + (isSigned ? "T" : "F") +
         " isBE: " + (isBigEndian ? "T" : "F") + " S: " + QString::number(scalar) +
@@ -61,11 +63,13 @@ struct Signal {
 // Struct that represents one CAN message definition
 struct Message {
   uint16_t id;
+  QString name;
   uint8_t dlc;
   QVector<Signal> sigs;
 
   Message() {
     id = 0;
+    name = "";
     dlc = 0;
   }
 
@@ -0,0 +1,255 @@
+/**
+ * @file crosscheck.cpp
+ * Implementation of the AppCrossCheck class.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include <cmath>
+#include <random>
+#include "crosscheck.h"
+
+using std::mt19937;
+
+/**
+ * Returns whether two decoded values agree to within rounding error.
+ */
+static bool crosscheck_equal(double a, double b) {
+  double scale = fabs(a) > 1.0 ? fabs(a) : 1.0;
+  return fabs(a - b) <= 1e-9 * scale;
+}
+
+bool AppCrossCheck::run() {
+  report.clear();
+
+  if (!header.read()) {
+    report.append(QString("Problem reading CAN header: %1").arg(header.filename));
+    return false;
+  }
+
+  AppConfig config;
+  messages = config.getMessages();
+  if (messages.empty()) {
+    report.append("Problem reading config.dbc.");
+    return false;
+  }
+
+  if (!readEntries()) {
+    return false;
+  }
+
+  int failed = 0;
+  map<QString, bool> checkedDefines;
+  for (int i = 0; i < entries.size(); i++) {
+    QString reason = check(entries[i]);
+    if (reason.isEmpty()) {
+      report.append(QString("OK    %1").arg(entries[i].title));
+    } else {
+      report.append(QString("FAIL  %1 (crosscheck.cfg:%2): %3").arg(entries[i].title)
+          .arg(entries[i].line).arg(reason));
+      failed++;
+    }
+    checkedDefines[entries[i].byteDefine] = true;
+  }
+
+  // Byte positions the firmware defines but nothing checks
+  QStringList unchecked;
+  for (int i = 0; i < header.defines.size(); i++) {
+    QString name = header.defines[i].name;
+    if (name.endsWith("_BYTE") && checkedDefines.count(name) == 0) {
+      unchecked.append(name);
+    }
+  }
+  if (!unchecked.isEmpty()) {
+    report.append(QString("Not in crosscheck.cfg: %1").arg(unchecked.join(" ")));
+  }
+
+  report.append(QString("%1 of %2 signals passed, %3 *_BYTE defines unchecked.")
+      .arg(entries.size() - failed).arg(entries.size()).arg(unchecked.size()));
+  return failed == 0;
+}
+
+bool AppCrossCheck::readEntries() {
+  entries.clear();
+
+  QFile cfgFile(QCoreApplication::applicationDirPath().append("/crosscheck.cfg"));
+  if (!cfgFile.open(QIODevice::ReadOnly)) {
+    report.append("Problem opening crosscheck.cfg.");
+    return false;
+  }
+
+  QTextStream inStream(&cfgFile);
+  int lineNum = 0;
+  bool successful = true;
+  while (!inStream.atEnd()) {
+    QString line = inStream.readLine().simplified();
+    lineNum++;
+
+    if (line.isEmpty() || line.startsWith("#")) {
+      continue;
+    }
+
+    QStringList sections = line.split(" ", QString::SkipEmptyParts);
+    if (sections.size() != 7 && sections.size() != 8) {
+      report.append(QString("crosscheck.cfg:%1: Expected 7 or 8 fields.").arg(lineNum));
+      successful = false;
+      continue;
+    }
+
+    CrossCheckEntry entry;
+    bool ok = true;
+    entry.title = sections[0];
+    entry.idExpr = sections[1];
+    entry.byteDefine = sections[2];
+    entry.scalarDefine = sections[3];
+    entry.length = sections[4].toInt(&ok);
+    entry.isBigEndian = sections[5].compare("BIG", Qt::CaseInsensitive) == 0;
+    entry.isSigned = sections[6].compare("S", Qt::CaseInsensitive) == 0;
+    entry.offset = sections.size() == 8 ? sections[7].toDouble(&ok) : 0.0;
+    entry.line = lineNum;
+
+    if (!ok || !(entry.length == 1 || entry.length == 2 || entry.length == 4) ||
+        !(entry.isBigEndian || sections[5].compare("LITTLE", Qt::CaseInsensitive) == 0) ||
+        !(entry.isSigned || sections[6].compare("U", Qt::CaseInsensitive) == 0)) {
+      report.append(QString("crosscheck.cfg:%1: Invalid field.").arg(lineNum));
+      successful = false;
+      continue;
+    }
+
+    entries.append(entry);
+  }
+
+  cfgFile.close();
+  return successful;
+}
+
+bool AppCrossCheck::evalId(QString expr, uint16_t* id) {
+  QStringList terms = expr.split("+");
+  double base;
+  if (!header.number(terms[0], &base)) {
+    return false;
+  }
+
+  uint addend = 0;
+  bool ok = true;
+  if (terms.size() == 2) {
+    addend = terms[1].toUInt(&ok, 0);
+  } else if (terms.size() > 2) {
+    return false;
+  }
+
+  *id = (uint16_t) base + addend;
+  return ok;
+}
+
+QString AppCrossCheck::check(CrossCheckEntry& entry) {
+  uint16_t id;
+  if (!evalId(entry.idExpr, &id)) {
+    return QString("Unknown message %1").arg(entry.idExpr);
+  }
+
+  double byteValue;
+  if (!header.number(entry.byteDefine, &byteValue)) {
+    return QString("%1 not defined in CAN.h").arg(entry.byteDefine);
+  }
+  int byte = (int) byteValue;
+
+  double scalar = 1.0;
+  if (entry.scalarDefine != "-" && !header.number(entry.scalarDefine, &scalar)) {
+    return QString("%1 not defined in CAN.h").arg(entry.scalarDefine);
+  }
+
+  // Find the signal, and complain if it lives in a different message
+  if (messages.count(id) == 0) {
+    return QString("Message 0x%1 not in config.dbc").arg(id, 0, 16);
+  }
+  Message& msg = messages[id];
+  int sigIndex = -1;
+  for (int i = 0; i < msg.sigs.size(); i++) {
+    if (msg.sigs[i].title == entry.title) {
+      sigIndex = i;
+    }
+  }
+  if (sigIndex < 0) {
+    typedef map<uint16_t, Message>::iterator it_msg;
+    for (it_msg msgIt = messages.begin(); msgIt != messages.end(); msgIt++) {
+      for (int i = 0; i < msgIt->second.sigs.size(); i++) {
+        if (msgIt->second.sigs[i].title == entry.title) {
+          return QString("Signal is in message 0x%1 in config.dbc, not 0x%2")
+            .arg(msgIt->first, 0, 16).arg(id, 0, 16);
+        }
+      }
+    }
+    return QString("Signal not in config.dbc");
+  }
+  Signal& sig = msg.sigs[sigIndex];
+
+  // Compare the layout field by field
+  int bitLen = 8 * entry.length;
+  int startBit = entry.isBigEndian ? 8 * byte + 7 : 8 * byte;
+  if (byte + entry.length > msg.dlc) {
+    return QString("%1 = %2 runs past DLC %3").arg(entry.byteDefine).arg(byte).arg(msg.dlc);
+  }
+  if (sig.startBit != startBit || sig.bitLen != bitLen) {
+    return QString("%1 = %2 gives %3|%4, config.dbc has %5|%6").arg(entry.byteDefine)
+      .arg(byte).arg(startBit).arg(bitLen).arg(sig.startBit).arg(sig.bitLen);
+  }
+  if (sig.isBigEndian != entry.isBigEndian) {
+    return QString("Endianness differs, config.dbc is %1")
+      .arg(sig.isBigEndian ? "BIG" : "LITTLE");
+  }
+  if (sig.isSigned != entry.isSigned) {
+    return QString("Signedness differs, config.dbc is %1").arg(sig.isSigned ? "S" : "U");
+  }
+  if (!crosscheck_equal(sig.scalar, scalar)) {
+    return QString("%1 = %2, config.dbc scalar is %3").arg(entry.scalarDefine)
+      .arg(scalar, 0, 'g', 10).arg(sig.scalar, 0, 'g', 10);
+  }
+  if (!crosscheck_equal(sig.offset, -entry.offset * scalar)) {
+    return QString("Offset %1 gives %2, config.dbc offset is %3").arg(entry.offset)
+      .arg(-entry.offset * scalar, 0, 'g', 10).arg(sig.offset, 0, 'g', 10);
+  }
+
+  // Pack random raw values the way the firmware does and decode them both
+  // ways, starting with the edges of the raw range
+  mt19937 rng(CROSSCHECK_SEED);
+  uint32_t mask = bitLen == 32 ? 0xFFFFFFFF : (((uint32_t) 1) << bitLen) - 1;
+  for (int trial = 0; trial < CROSSCHECK_TRIALS; trial++) {
+    uint32_t raw;
+    switch (trial) {
+      case 0:  raw = 0; break;
+      case 1:  raw = mask; break;
+      case 2:  raw = mask >> 1; break;
+      case 3:  raw = (mask >> 1) + 1; break;
+      default: raw = rng() & mask; break;
+    }
+
+    uint8_t data[8] = {0};
+    for (int i = 0; i < entry.length; i++) {
+      int shift = entry.isBigEndian ? 8 * (entry.length - 1 - i) : 8 * i;
+      data[byte + i] = (raw >> shift) & 0xFF;
+    }
+
+    uint64_t data64 = 0;
+    for (int i = 0; i < 8; i++) {
+      data64 |= ((uint64_t) data[i]) << (8 * i);
+    }
+
+    // The nodes cast to a signed type of the field's width before scaling
+    double rawValue = raw;
+    if (entry.isSigned && bitLen < 32) {
+      rawValue = (raw & (1 << (bitLen - 1))) ? (double) raw - (mask + 1.0) : (double) raw;
+    } else if (entry.isSigned) {
+      rawValue = (int32_t) raw;
+    }
+
+    double firmware = (rawValue - entry.offset) * scalar;
+    double translator = sig.decode(data64);
+    if (!crosscheck_equal(firmware, translator)) {
+      return QString("Raw 0x%1 decodes to %2 in firmware, %3 in translator")
+        .arg(raw, 0, 16).arg(firmware, 0, 'g', 10).arg(translator, 0, 'g', 10);
+    }
+  }
+
+  return QString();
+}
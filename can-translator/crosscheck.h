@@ -0,0 +1,103 @@
+/**
+ * @file crosscheck.h
+ * Validates the firmware CAN packing in FSAE.X/CAN.h against config.dbc.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef CROSSCHECK_H
+#define CROSSCHECK_H
+
+#include <map>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QCoreApplication>
+#include "config.h"
+#include "header.h"
+
+using std::map;
+
+// Number of random raw values packed and decoded per signal
+#define CROSSCHECK_TRIALS 1000
+
+// Fixed seed so every run checks the same values
+#define CROSSCHECK_SEED 2016
+
+// Struct that represents one line of crosscheck.cfg, describing how the
+// firmware packs a single DBC signal
+struct CrossCheckEntry {
+  QString title;
+  QString idExpr;
+  QString byteDefine;
+  QString scalarDefine;
+  int length;
+  bool isBigEndian;
+  bool isSigned;
+  double offset;
+  int line;
+};
+
+/**
+ * Class which checks that the byte positions and scalars the firmware uses
+ * (the *_BYTE and *_SCL defines in CAN.h) agree with the layout of the same
+ * signals in config.dbc.
+ *
+ * CAN.h does not say which message, width, endianness or signedness a define
+ * belongs to, so those come from crosscheck.cfg, one signal per line:
+ *
+ *   # Title  Message     Byte define   Scalar define  Bytes  Endian  Sign  [Offset]
+ *   RPM      MOTEC_ID+0  ENG_RPM_BYTE  ENG_RPM_SCL    2      BIG     U
+ *
+ * Every signal is compared field by field against the DBC, then packed the way
+ * CAN_parse_bytes() expects for CROSSCHECK_TRIALS random raw values, decoded by
+ * the translator, and compared to (raw - offset) * scalar with raw cast to a
+ * signed type of the field's width, as the nodes do.
+ */
+class AppCrossCheck : public QObject {
+  Q_OBJECT
+
+  public:
+
+    /**
+     * Reads crosscheck.cfg, CAN.h and config.dbc and checks every entry.
+     *
+     * @returns Whether every entry passed.
+     */
+    bool run();
+
+    /**
+     * One line per entry describing the result, followed by a summary.
+     */
+    QStringList report;
+
+  private:
+
+    /**
+     * Reads crosscheck.cfg from the application directory.
+     *
+     * @returns Whether the file was read and every line parsed.
+     */
+    bool readEntries();
+
+    /**
+     * Checks a single entry.
+     *
+     * @returns An empty string if the entry passed, otherwise the reason it
+     *     failed.
+     */
+    QString check(CrossCheckEntry& entry);
+
+    /**
+     * Evaluates a message ID expression of the form NAME_ID or NAME_ID+N.
+     */
+    bool evalId(QString expr, uint16_t* id);
+
+    AppHeader header;
+    map<uint16_t, Message> messages;
+    QVector<CrossCheckEntry> entries;
+};
+
+#endif // CROSSCHECK_H
@@ -4,25 +4,54 @@
  *
  * @author Andrew Mass
  * @date Created: 2014-07-12
- * @date Modified: 2015-06-07
+ * @date Modified: 2026-10-18
  */
 #include "data.h"
 
+AppData::AppData() : QObject(), outFile(&outBuffer) {
+  this->writePyramid = false;
+  this->compression = COMPRESS_NONE;
+}
+
 bool AppData::readData(bool isVectorFile) {
   QString outFilename = this->filename;
   outFilename.replace(".txt", ".out.txt", Qt::CaseInsensitive);
   outFilename.replace(".asc", ".out.txt", Qt::CaseInsensitive);
-  this->outFile.open(outFilename.toLocal8Bit().data(), ios::out | ios::app);
-
-  if (!(this->outFile && this->outFile.good())) {
+  if (!outBuffer.open(outFilename, compression, true)) {
     emit error(QString("Problem opening output file."));
+    return false;
   }
+  this->outFile.clear();
 
-  writeAxis();
+  // Derived channels that fail to compile have already reported why
+  if (!writeAxis()) {
+    outBuffer.close();
+    return false;
+  }
+
+  if (writePyramid && !pyramid.open(outFilename, channelNames)) {
+    emit error(QString("Problem opening preview pyramid files."));
+    outBuffer.close();
+    return false;
+  }
 
   bool success = isVectorFile ? readDataVector() : readDataCustom();
 
-  this->outFile.close();
+  if (!outBuffer.close() || !this->outFile.good()) {
+    emit error(QString("Problem writing output file."));
+    success = false;
+  }
+
+  if (writePyramid && !pyramid.close()) {
+    emit error(QString("Problem writing preview pyramid files."));
+    success = false;
+  }
+
+  if (success) {
+    QString summaryFilename = outFilename;
+    summaryFilename.replace(".out.txt", ".summary.txt", Qt::CaseInsensitive);
+    success = stats.write(summaryFilename);
+  }
 
   return success;
 }
@@ -175,10 +204,13 @@ bool AppData::writeAxis() {
 
   latestValues.clear();
   messageIndices.clear();
+  channelNames.clear();
+  exported.clear();
 
   vector<double> vec_time;
   vec_time.push_back(0.0);
   latestValues.push_back(vec_time);
+  exported.push_back(vector<bool>(1, true));
 
   AppConfig config;
   map<unsigned short, Message> messages = config.getMessages();
@@ -190,26 +222,59 @@ bool AppData::writeAxis() {
     Message msg = msgIt->second;
 
     vector<double> vec_msg;
+    vector<bool> vec_exported;
 
     for(int i = 0; i < msg.sigs.size(); i++) {
       Signal sig = msg.sigs[i];
-      this->outFile << "  " << sig.title.toStdString() << " [" << sig.units.toStdString() << "]";
       vec_msg.push_back(0.0);
+
+      bool isExported = exportSignals.count(msg.id) == 0 ||
+        (unsigned int) i >= exportSignals[msg.id].size() || exportSignals[msg.id][i];
+      vec_exported.push_back(isExported);
+      if (isExported) {
+        this->outFile << "  " << sig.title.toStdString() << " [" << sig.units.toStdString() << "]";
+        channelNames.append(sig.title + " [" + sig.units + "]");
+      }
     }
 
     latestValues.push_back(vec_msg);
+    exported.push_back(vec_exported);
     messageIndices[msg.id] = indexCounter;
     indexCounter++;
   }
 
+  // Derived channels are stored after every message
+  if (!derived.compile(messages, messageIndices, indexCounter)) {
+    return false;
+  }
+
+  vector<bool> vec_exported;
+  for (int i = 0; i < derived.channels.size(); i++) {
+    DerivedChannel chn = derived.channels[i];
+    bool isExported = (unsigned int) i >= exportDerived.size() || exportDerived[i];
+    vec_exported.push_back(isExported);
+    if (isExported) {
+      this->outFile << "  " << chn.title.toStdString() << " [" << chn.units.toStdString() << "]";
+      channelNames.append(chn.title + " [" + chn.units + "]");
+    }
+  }
+  latestValues.push_back(vector<double>(derived.channels.size(), 0.0));
+  exported.push_back(vec_exported);
+
+  stats.init(messages, messageIndices, derived, indexCounter);
+
   return true;
 }
 
 void AppData::writeLine() {
-  this->outFile << endl;
+  this->outFile << '\n';
 
   for(unsigned int i = 0; i < latestValues.size(); i++) {
     for(unsigned int j = 0; j < latestValues[i].size(); j++) {
+      if (!exported[i][j]) {
+        continue;
+      }
+
       if (i == 0) {
         this->outFile << latestTimestamp.toStdString();
       } else {
@@ -273,17 +338,20 @@ void AppData::processBuffer(unsigned char * buffer, int length) {
         iter += 2;
       }
 
-      if(badChnFound) {
-        // Skip this message and don't write to the file.
-        iter += 4;
-        continue;
-      }
-
       double upper = buffer[iter + 3] << 8 | buffer[iter + 2];
       double lower = ((double) (buffer[iter + 1] << 8 | buffer[iter])) / 0x8000;
       double timestamp = upper + lower - 1.0;
       iter += 4;
 
+      if(badChnFound) {
+        // Skip this message and don't write to the file, but count the time
+        // its channels spent outside of their limits.
+        if(latestValues[0][0] == 0.0 || abs(timestamp - latestValues[0][0]) <= 1.0) {
+          stats.updateLimits(msg.id, timestamp, values);
+        }
+        continue;
+      }
+
       /**
        * We were experiencing problems with corrupt messages (or messages not understood by the
        * translator interpreted as being corrupt) screwing up the natural, increasing order of
@@ -296,7 +364,7 @@ void AppData::processBuffer(unsigned char * buffer, int length) {
         for(int i = 0; i < j; i++) {
           latestValues[messageIndices[msg.id]][i] = values[i];
         }
-        writeLine();
+        recordLine(msg.id, timestamp);
       } else {
         if(++badTimeCounter < 6) {
           emit error(QString("Invalid timestamp: %1. Previous: %2.")
@@ -373,68 +441,29 @@ void AppData::processLine(QString line) {
 
   int j = 0;
   for (int i = 0; i < msg.sigs.size(); i++) {
-    Signal sig = msg.sigs[i];
+    latestValues[messageIndices[msg.id]][j] = msg.sigs[i].decode(data);
+    j++;
+  }
 
-    double value;
+  latestTimestamp = sections[0];
 
-    uint8_t startBit = sig.isBigEndian ? sig.startBit - 7 : sig.startBit;
-    uint64_t sigData = (data >> startBit) & ((uint64_t) (pow(2, sig.bitLen) - 1));
+  recordLine(msg.id, latestTimestamp.toDouble());
+}
 
-    if (sig.bitLen <= 8) {
-      value = sig.isSigned ? ((int8_t) sigData) : ((uint8_t) sigData);
-    } else if (sig.bitLen > 8 && sig.bitLen <= 16) {
-      if (!sig.isBigEndian) {
-        value = sig.isSigned ? ((int16_t) sigData) : ((uint16_t) sigData);
-      } else {
-        if (sig.isSigned) {
-          uint8_t* sigDataArray = (uint8_t*) &sigData;
-          value = (int16_t) (sigDataArray[0] << 8 | sigDataArray[1]);
-        } else {
-          uint8_t* sigDataArray = (uint8_t*) &sigData;
-          value = (uint16_t) (sigDataArray[0] << 8 | sigDataArray[1]);
-        }
-      }
-    } else if (sig.bitLen > 16 && sig.bitLen <= 32) {
-      if (!sig.isBigEndian) {
-        value = sig.isSigned ? ((int32_t) sigData) : ((uint32_t) sigData);
-      } else {
-        if (sig.isSigned) {
-          uint8_t* sigDataArray = (uint8_t*) &sigData;
-          value = (int32_t) (sigDataArray[0] << 24 | sigDataArray[1] << 16 |
-              sigDataArray[2] << 8 | sigDataArray[3]);
-        } else {
-          uint8_t* sigDataArray = (uint8_t*) &sigData;
-          value = (uint32_t) (sigDataArray[0] << 24 | sigDataArray[1] << 16 |
-              sigDataArray[2] << 8 | sigDataArray[3]);
-        }
-      }
-    } else if (sig.bitLen > 32) {
-      if (!sig.isBigEndian) {
-        value = sig.isSigned ? ((int64_t) sigData) : ((uint64_t) sigData);
-      } else {
-        if (sig.isSigned) {
-          uint8_t* sigDataArray = (uint8_t*) &sigData;
-          value = (int64_t) (((int64_t) sigDataArray[0]) << 56 |
-              ((int64_t) sigDataArray[1]) << 48 | ((int64_t) sigDataArray[2]) << 40 |
-              ((int64_t) sigDataArray[3]) << 32 | ((int64_t) sigDataArray[4]) << 24 |
-              ((int64_t) sigDataArray[5]) << 16 | ((int64_t) sigDataArray[6]) << 8 |
-              ((int64_t) sigDataArray[7]));
-        } else {
-          uint8_t* sigDataArray = (uint8_t*) &sigData;
-          value = (uint64_t) (((uint64_t) sigDataArray[0]) << 56 |
-              ((uint64_t) sigDataArray[1]) << 48 | ((uint64_t) sigDataArray[2]) << 40 |
-              ((uint64_t) sigDataArray[3]) << 32 | ((uint64_t) sigDataArray[4]) << 24 |
-              ((uint64_t) sigDataArray[5]) << 16 | ((uint64_t) sigDataArray[6]) << 8 |
-              ((uint64_t) sigDataArray[7]));
+void AppData::recordLine(uint16_t msgId, double timestamp) {
+  derived.update(msgId, latestValues);
+  stats.update(msgId, timestamp, latestValues, derived);
+  writeLine();
+
+  if (writePyramid) {
+    rowValues.clear();
+    for (unsigned int i = 1; i < latestValues.size(); i++) {
+      for (unsigned int j = 0; j < latestValues[i].size(); j++) {
+        if (exported[i][j]) {
+          rowValues.push_back(latestValues[i][j]);
         }
       }
     }
-
-    latestValues[messageIndices[msg.id]][j] = (value * sig.scalar) + sig.offset;
-    j++;
+    pyramid.addRow(timestamp, rowValues);
   }
-
-  latestTimestamp = sections[0];
-
-  writeLine();
 }
@@ -4,16 +4,21 @@
  *
  * @author Andrew Mass
  * @date Created: 2014-07-12
- * @date Modified: 2015-06-07
+ * @date Modified: 2026-10-18
  */
 #ifndef DATA_H
 #define DATA_H
 
 #include <map>
 #include <fstream>
+#include <ostream>
 #include <QObject>
 #include <vector>
 #include "config.h"
+#include "derived.h"
+#include "stats.h"
+#include "lod.h"
+#include "compress.h"
 
 using std::ios;
 using std::map;
@@ -21,6 +26,7 @@ using std::endl;
 using std::vector;
 using std::ifstream;
 using std::ofstream;
+using std::ostream;
 
 #define LOGFILE_COALESCE_SEPARATION 30.0
 
@@ -32,6 +38,11 @@ class AppData : public QObject {
 
   public:
 
+    /**
+     * Default constructor for AppData class.
+     */
+    AppData();
+
     /**
      * Opens up a data file and iterates through it, converting the raw data
      * to a format that can be imported into Darab.
@@ -70,6 +81,38 @@ class AppData : public QObject {
      */
     QString filename;
 
+    /**
+     * The derived channels computed alongside the converted data.
+     */
+    AppDerived derived;
+
+    /**
+     * The per-channel statistics accumulated during conversion.
+     */
+    AppStats stats;
+
+    /**
+     * If true, a min/max decimation pyramid is written alongside the output
+     * file for fast plotting.
+     */
+    bool writePyramid;
+
+    /**
+     * The compression codec applied to the output file.
+     */
+    CompressCodec compression;
+
+    /**
+     * The signals of each message to write to the output, by message ID.
+     * Messages missing from the map are written in full.
+     */
+    map<uint16_t, vector<bool> > exportSignals;
+
+    /**
+     * The derived channels to write to the output. Written in full if empty.
+     */
+    vector<bool> exportDerived;
+
   signals:
 
     /**
@@ -103,11 +146,32 @@ class AppData : public QObject {
      */
     vector< vector<double> > latestValues;
 
+    /**
+     * Whether each value in latestValues is written to the output, built from
+     * exportSignals and exportDerived.
+     */
+    vector< vector<bool> > exported;
+
     /**
      * Holds the latest values for the timestamp of the message
      */
     QString latestTimestamp;
 
+    /**
+     * The "Title [units]" name of every exported channel, in output order.
+     */
+    QStringList channelNames;
+
+    /**
+     * The decimation pyramid written when writePyramid is set.
+     */
+    LodPyramid pyramid;
+
+    /**
+     * Scratch space holding the flattened values of a single output row.
+     */
+    vector<double> rowValues;
+
     /**
      * Converts data from our custom uSD logging protocol. Opens up a data
      * file and iterates through it, converting the raw data to a format that
@@ -143,15 +207,30 @@ class AppData : public QObject {
      */
     void processLine(QString line);
 
+    /**
+     * Called once a message has been converted into latestValues. Updates the
+     * derived channels and statistics, then writes the output line.
+     *
+     * @param msgId The ID of the message that was converted.
+     * @param timestamp The timestamp of the message in seconds.
+     */
+    void recordLine(uint16_t msgId, double timestamp);
+
     /**
      * Stores the scanned CAN spec configuration.
      */
     map<uint16_t, Message> messages;
 
     /**
-     * Stores the open handle to the output file.
+     * Collects the output into blocks which are compressed and written on a
+     * separate thread.
+     */
+    BlockWriter outBuffer;
+
+    /**
+     * Formats the output into outBuffer.
      */
-    ofstream outFile;
+    ostream outFile;
 };
 
 #endif // DATA_H
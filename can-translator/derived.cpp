@@ -0,0 +1,425 @@
+/**
+ * @file derived.cpp
+ * Implementation of the AppDerived and DerivedCompiler classes.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include <set>
+#include <cmath>
+#include "derived.h"
+
+using std::set;
+
+QVector<DerivedChannel> AppDerived::getChannels() {
+  QVector<DerivedChannel> defs;
+
+  QFile derivedFile(QCoreApplication::applicationDirPath().append("/derived.cfg"));
+  if (!derivedFile.exists()) {
+    return defs;
+  }
+
+  if (!derivedFile.open(QIODevice::ReadOnly)) {
+    emit error("Derived channel file was not opened.");
+    return defs;
+  }
+
+  QTextStream inStream(&derivedFile);
+  while (!inStream.atEnd()) {
+    QString line = inStream.readLine().simplified();
+
+    // Skip blank lines and comments
+    if (line.isEmpty() || line.startsWith("#")) {
+      continue;
+    }
+
+    // Title [units] = formula
+    int eq = line.indexOf('=');
+    int open = line.indexOf('[');
+    int close = line.indexOf(']');
+    if (eq < 0 || open < 0 || close < open || close > eq) {
+      emit error(QString("Invalid derived channel definition: %1").arg(line));
+      return QVector<DerivedChannel>();
+    }
+
+    DerivedChannel chn;
+    chn.title = line.left(open).trimmed();
+    chn.units = line.mid(open + 1, close - open - 1).trimmed();
+    chn.formula = line.mid(eq + 1).trimmed();
+
+    if (chn.title.isEmpty() || chn.title.contains(' ') || chn.formula.isEmpty()) {
+      emit error(QString("Invalid derived channel definition: %1").arg(line));
+      return QVector<DerivedChannel>();
+    }
+
+    defs.append(chn);
+  }
+
+  derivedFile.close();
+  return defs;
+}
+
+bool AppDerived::compile(map<uint16_t, Message>& messages,
+    map<unsigned short, int>& messageIndices, int group) {
+  this->group = group;
+  this->dependents.clear();
+  this->channels = getChannels();
+
+  // Symbol table of every name a formula may reference, and the set of
+  // messages each name depends on
+  map<QString, DerivedOp> symbols;
+  map<QString, set<uint16_t> > symbolDeps;
+  set<QString> ambiguous;
+
+  typedef map<uint16_t, Message>::iterator it_msg;
+  for (it_msg msgIt = messages.begin(); msgIt != messages.end(); msgIt++) {
+    Message& msg = msgIt->second;
+    for (int i = 0; i < msg.sigs.size(); i++) {
+      if (symbols.count(msg.sigs[i].title)) {
+        ambiguous.insert(msg.sigs[i].title);
+        continue;
+      }
+
+      DerivedOp op(DerivedOp::SIGNAL);
+      op.group = messageIndices[msg.id];
+      op.index = i;
+      symbols[msg.sigs[i].title] = op;
+      symbolDeps[msg.sigs[i].title].insert(msg.id);
+    }
+  }
+
+  for (int k = 0; k < channels.size(); k++) {
+    DerivedChannel& chn = channels[k];
+
+    if (symbols.count(chn.title)) {
+      emit error(QString("Derived channel %1 shadows an existing channel.").arg(chn.title));
+      channels.clear();
+      return false;
+    }
+
+    DerivedCompiler compiler(chn.formula, symbols);
+    QString result = compiler.compile();
+    if (!result.isEmpty()) {
+      emit error(QString("Invalid formula for derived channel %1: %2")
+          .arg(chn.title).arg(result));
+      channels.clear();
+      return false;
+    }
+    chn.code = compiler.code;
+
+    // Collect the messages this channel depends on, through other derived
+    // channels if necessary
+    set<uint16_t> deps;
+    typedef map<QString, DerivedOp>::iterator it_sym;
+    for (it_sym symIt = symbols.begin(); symIt != symbols.end(); symIt++) {
+      for (unsigned int j = 0; j < compiler.operands.size(); j++) {
+        if (symIt->second.group == compiler.operands[j].group &&
+            symIt->second.index == compiler.operands[j].index) {
+          if (ambiguous.count(symIt->first)) {
+            emit error(QString("Derived channel %1 references ambiguous signal %2.")
+                .arg(chn.title).arg(symIt->first));
+            channels.clear();
+            return false;
+          }
+          set<uint16_t>& symDeps = symbolDeps[symIt->first];
+          deps.insert(symDeps.begin(), symDeps.end());
+        }
+      }
+    }
+
+    // Channels are only allowed to reference channels defined above them, so
+    // definition order is always a valid evaluation order
+    typedef set<uint16_t>::iterator it_dep;
+    for (it_dep depIt = deps.begin(); depIt != deps.end(); depIt++) {
+      dependents[*depIt].push_back(k);
+    }
+
+    DerivedOp op(DerivedOp::SIGNAL);
+    op.group = group;
+    op.index = k;
+    symbols[chn.title] = op;
+    symbolDeps[chn.title] = deps;
+  }
+
+  return true;
+}
+
+void AppDerived::update(uint16_t msgId, vector< vector<double> >& latestValues) {
+  map<uint16_t, vector<int> >::iterator it = dependents.find(msgId);
+  if (it == dependents.end()) {
+    return;
+  }
+
+  vector<int>& indices = it->second;
+  for (unsigned int i = 0; i < indices.size(); i++) {
+    latestValues[group][indices[i]] = evaluate(channels[indices[i]].code, latestValues);
+  }
+}
+
+vector<int>* AppDerived::getDependents(uint16_t msgId) {
+  map<uint16_t, vector<int> >::iterator it = dependents.find(msgId);
+  return it == dependents.end() ? NULL : &(it->second);
+}
+
+double AppDerived::evaluate(vector<DerivedOp>& code,
+    vector< vector<double> >& latestValues) {
+  double stack[DERIVED_STACK_SIZE];
+  int top = -1;
+
+  for (unsigned int i = 0; i < code.size(); i++) {
+    DerivedOp& op = code[i];
+    switch (op.code) {
+      case DerivedOp::CONST:
+        stack[++top] = op.value;
+        break;
+      case DerivedOp::SIGNAL:
+        stack[++top] = latestValues[op.group][op.index];
+        break;
+      case DerivedOp::NEG:
+        stack[top] = -stack[top];
+        break;
+      case DerivedOp::ADD:
+        top--;
+        stack[top] = stack[top] + stack[top + 1];
+        break;
+      case DerivedOp::SUB:
+        top--;
+        stack[top] = stack[top] - stack[top + 1];
+        break;
+      case DerivedOp::MUL:
+        top--;
+        stack[top] = stack[top] * stack[top + 1];
+        break;
+      case DerivedOp::DIV:
+        top--;
+        stack[top] = stack[top + 1] == 0.0 ? 0.0 : stack[top] / stack[top + 1];
+        break;
+      case DerivedOp::ABS:
+        stack[top] = fabs(stack[top]);
+        break;
+      case DerivedOp::SQRT:
+        stack[top] = stack[top] < 0.0 ? 0.0 : sqrt(stack[top]);
+        break;
+      case DerivedOp::MIN:
+      case DerivedOp::MAX:
+      case DerivedOp::SUM:
+      case DerivedOp::AVG: {
+        top -= op.argc - 1;
+        double acc = stack[top];
+        for (int j = 1; j < op.argc; j++) {
+          double v = stack[top + j];
+          if (op.code == DerivedOp::MIN) {
+            acc = v < acc ? v : acc;
+          } else if (op.code == DerivedOp::MAX) {
+            acc = v > acc ? v : acc;
+          } else {
+            acc += v;
+          }
+        }
+        stack[top] = op.code == DerivedOp::AVG ? acc / op.argc : acc;
+        break;
+      }
+    }
+  }
+
+  return stack[0];
+}
+
+DerivedCompiler::DerivedCompiler(QString formula, map<QString, DerivedOp>& symbols)
+    : formula(formula), symbols(symbols) {
+  pos = 0;
+  depth = 0;
+  maxDepth = 0;
+}
+
+QString DerivedCompiler::compile() {
+  if (!parseExpr()) {
+    return errorMessage;
+  }
+
+  skipSpace();
+  if (pos < formula.length()) {
+    fail(QString("Unexpected '%1'").arg(formula[pos]));
+    return errorMessage;
+  }
+
+  if (maxDepth > DERIVED_STACK_SIZE) {
+    fail("Formula is too deeply nested");
+    return errorMessage;
+  }
+
+  return QString();
+}
+
+bool DerivedCompiler::parseExpr() {
+  if (!parseTerm()) {
+    return false;
+  }
+
+  skipSpace();
+  while (pos < formula.length() && (formula[pos] == '+' || formula[pos] == '-')) {
+    DerivedOp op(formula[pos++] == '+' ? DerivedOp::ADD : DerivedOp::SUB);
+    if (!parseTerm()) {
+      return false;
+    }
+    code.push_back(op);
+    depth--;
+    skipSpace();
+  }
+
+  return true;
+}
+
+bool DerivedCompiler::parseTerm() {
+  if (!parseUnary()) {
+    return false;
+  }
+
+  skipSpace();
+  while (pos < formula.length() && (formula[pos] == '*' || formula[pos] == '/')) {
+    DerivedOp op(formula[pos++] == '*' ? DerivedOp::MUL : DerivedOp::DIV);
+    if (!parseUnary()) {
+      return false;
+    }
+    code.push_back(op);
+    depth--;
+    skipSpace();
+  }
+
+  return true;
+}
+
+bool DerivedCompiler::parseUnary() {
+  skipSpace();
+  if (pos < formula.length() && formula[pos] == '-') {
+    pos++;
+    if (!parseUnary()) {
+      return false;
+    }
+    code.push_back(DerivedOp(DerivedOp::NEG));
+    return true;
+  }
+
+  return parseAtom();
+}
+
+bool DerivedCompiler::parseAtom() {
+  skipSpace();
+  if (pos >= formula.length()) {
+    return fail("Unexpected end of formula");
+  }
+
+  QChar c = formula[pos];
+
+  // Parenthesized expression
+  if (c == '(') {
+    pos++;
+    if (!parseExpr()) {
+      return false;
+    }
+    skipSpace();
+    if (pos >= formula.length() || formula[pos] != ')') {
+      return fail("Missing ')'");
+    }
+    pos++;
+    return true;
+  }
+
+  // Numeric constant
+  if (c.isDigit() || c == '.') {
+    int start = pos;
+    while (pos < formula.length() && (formula[pos].isDigit() || formula[pos] == '.')) {
+      pos++;
+    }
+    bool successful = true;
+    DerivedOp op(DerivedOp::CONST);
+    op.value = formula.mid(start, pos - start).toDouble(&successful);
+    if (!successful) {
+      return fail(QString("Invalid number '%1'").arg(formula.mid(start, pos - start)));
+    }
+    code.push_back(op);
+    maxDepth = ++depth > maxDepth ? depth : maxDepth;
+    return true;
+  }
+
+  // Channel name or function call
+  if (c.isLetter() || c == '_') {
+    int start = pos;
+    while (pos < formula.length() && (formula[pos].isLetterOrNumber() || formula[pos] == '_')) {
+      pos++;
+    }
+    QString name = formula.mid(start, pos - start);
+
+    skipSpace();
+    if (pos < formula.length() && formula[pos] == '(') {
+      DerivedOp op;
+      QString func = name.toLower();
+      if (func == "abs") {
+        op.code = DerivedOp::ABS;
+      } else if (func == "sqrt") {
+        op.code = DerivedOp::SQRT;
+      } else if (func == "min") {
+        op.code = DerivedOp::MIN;
+      } else if (func == "max") {
+        op.code = DerivedOp::MAX;
+      } else if (func == "sum") {
+        op.code = DerivedOp::SUM;
+      } else if (func == "avg") {
+        op.code = DerivedOp::AVG;
+      } else {
+        return fail(QString("Unknown function '%1'").arg(name));
+      }
+
+      pos++;
+      op.argc = 0;
+      do {
+        if (op.argc > 0) {
+          pos++; // Skip ','
+        }
+        if (!parseExpr()) {
+          return false;
+        }
+        op.argc++;
+        skipSpace();
+      } while (pos < formula.length() && formula[pos] == ',');
+
+      if (pos >= formula.length() || formula[pos] != ')') {
+        return fail("Missing ')'");
+      }
+      pos++;
+
+      bool unary = op.code == DerivedOp::ABS || op.code == DerivedOp::SQRT;
+      if (unary && op.argc != 1) {
+        return fail(QString("%1() takes exactly one argument").arg(func));
+      }
+
+      code.push_back(op);
+      depth -= op.argc - 1;
+      return true;
+    }
+
+    map<QString, DerivedOp>::iterator it = symbols.find(name);
+    if (it == symbols.end()) {
+      return fail(QString("Unknown channel '%1'").arg(name));
+    }
+    code.push_back(it->second);
+    operands.push_back(it->second);
+    maxDepth = ++depth > maxDepth ? depth : maxDepth;
+    return true;
+  }
+
+  return fail(QString("Unexpected '%1'").arg(c));
+}
+
+void DerivedCompiler::skipSpace() {
+  while (pos < formula.length() && formula[pos].isSpace()) {
+    pos++;
+  }
+}
+
+bool DerivedCompiler::fail(QString message) {
+  if (errorMessage.isEmpty()) {
+    errorMessage = message;
+  }
+  return false;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file derived.h
+ * Compiles and evaluates derived (math) channels during conversion.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef DERIVED_H
+#define DERIVED_H
+
+#include <map>
+#include <vector>
+#include <QObject>
+#include "config.h"
+
+using std::map;
+using std::vector;
+
+// Maximum depth of the evaluation stack for a single derived channel
+#define DERIVED_STACK_SIZE 32
+
+// Single instruction of a compiled derived channel formula
+struct DerivedOp {
+  enum Code {
+    CONST,   // Push <value>
+    SIGNAL,  // Push latestValues[group][index]
+    NEG,
+    ADD,
+    SUB,
+    MUL,
+    DIV,     // Division by zero yields zero so Darab never sees inf/nan
+    ABS,
+    SQRT,
+    MIN,     // Variadic, <argc> operands
+    MAX,     // Variadic, <argc> operands
+    SUM,     // Variadic, <argc> operands
+    AVG      // Variadic, <argc> operands
+  };
+
+  Code code;
+  double value;
+  int group;
+  int index;
+  int argc;
+
+  DerivedOp(Code c = CONST) {
+    code = c;
+    value = 0.0;
+    group = 0;
+    index = 0;
+    argc = 0;
+  }
+};
+
+// Struct that represents one derived channel definition from derived.cfg
+struct DerivedChannel {
+  QString title;
+  QString units;
+  QString formula;
+
+  // Compiled formula in postfix order
+  vector<DerivedOp> code;
+
+  bool valid() {
+    return !(title.isEmpty() && formula.isEmpty());
+  }
+
+  QString toString() {
+    return title + "<" + units + "> = " + formula;
+  }
+};
+
+/**
+ * Class which reads user formulas from derived.cfg, compiles them against the
+ * scanned CAN spec and evaluates them as messages are converted.
+ *
+ * Formulas may reference any signal title from config.dbc, or any derived
+ * channel defined above them in derived.cfg. Each channel tracks the set of
+ * messages it (transitively) depends on, so converting a message only
+ * recomputes the derived channels that can actually change.
+ */
+class AppDerived : public QObject {
+  Q_OBJECT
+
+  public:
+
+    /**
+     * Reads derived.cfg from the application directory. A missing file is not
+     * an error, it simply means there are no derived channels.
+     *
+     * @returns The parsed (but not compiled) derived channel definitions.
+     */
+    QVector<DerivedChannel> getChannels();
+
+    /**
+     * Reads and compiles all derived channels. The values of the derived
+     * channels are stored in latestValues[group].
+     *
+     * @param messages The scanned CAN spec.
+     * @param messageIndices Map of message ID to its group in latestValues.
+     * @param group The group in latestValues reserved for derived channels.
+     * @returns Whether every derived channel compiled successfully.
+     */
+    bool compile(map<uint16_t, Message>& messages,
+        map<unsigned short, int>& messageIndices, int group);
+
+    /**
+     * Recomputes every derived channel that depends on the given message.
+     *
+     * @param msgId The ID of the message that was just converted.
+     * @param latestValues The latest values of all channels.
+     */
+    void update(uint16_t msgId, vector< vector<double> >& latestValues);
+
+    /**
+     * Returns the indices of the derived channels that depend on the given
+     * message, or NULL if there are none.
+     */
+    vector<int>* getDependents(uint16_t msgId);
+
+    /**
+     * The compiled derived channels, in definition order.
+     */
+    QVector<DerivedChannel> channels;
+
+  signals:
+
+    /**
+     * Error handler that will be connected to an error function in the display
+     * class. Calling this method will display a error message box.
+     *
+     * @params error The error message to display.
+     */
+    void error(QString error);
+
+  private:
+
+    /**
+     * Evaluates a single compiled formula.
+     */
+    double evaluate(vector<DerivedOp>& code,
+        vector< vector<double> >& latestValues);
+
+    /**
+     * Map of message ID to the indices of derived channels that must be
+     * recomputed when that message is converted, in definition order.
+     */
+    map<uint16_t, vector<int> > dependents;
+
+    /**
+     * The group in latestValues holding the derived channel values.
+     */
+    int group;
+};
+
+/**
+ * Recursive descent parser which compiles a single formula into postfix
+ * DerivedOps. Grammar:
+ *
+ *   expr   := term (('+' | '-') term)*
+ *   term   := unary (('*' | '/') unary)*
+ *   unary  := '-' unary | atom
+ *   atom   := number | name | name '(' expr (',' expr)* ')' | '(' expr ')'
+ */
+class DerivedCompiler {
+
+  public:
+
+    DerivedCompiler(QString formula, map<QString, DerivedOp>& symbols);
+
+    /**
+     * Compiles the formula.
+     *
+     * @returns An empty string on success, otherwise a description of the
+     *     first error encountered.
+     */
+    QString compile();
+
+    /**
+     * The compiled formula in postfix order.
+     */
+    vector<DerivedOp> code;
+
+    /**
+     * The signal/derived channel operands the formula references.
+     */
+    vector<DerivedOp> operands;
+
+  private:
+
+    bool parseExpr();
+    bool parseTerm();
+    bool parseUnary();
+    bool parseAtom();
+    void skipSpace();
+    bool fail(QString message);
+
+    QString formula;
+    map<QString, DerivedOp>& symbols;
+    int pos;
+    int depth;
+    int maxDepth;
+    QString errorMessage;
+};
+
+#endif // DERIVED_H
@@ -4,7 +4,7 @@
  *
  * @author Andrew Mass
  * @date Created: 2014-06-24
- * @date Modified: 2016-03-20
+ * @date Modified: 2026-10-18
  */
 #include "display.h"
 
@@ -13,6 +13,8 @@ AppDisplay::AppDisplay() : QWidget() {
   data = new AppData();
   computeThread = new ComputeThread();
   coalesceComputeThread = new CoalesceComputeThread();
+  busLoad = new AppBusLoad();
+  busLoadComputeThread = new BusLoadComputeThread();
 
   layout = new QVBoxLayout();
 
@@ -24,12 +26,18 @@ AppDisplay::AppDisplay() : QWidget() {
   connect(data, SIGNAL(error(QString)), this, SLOT(handleError(QString)));
   connect(data, SIGNAL(progress(int)), this, SLOT(updateProgress(int)));
   connect(config, SIGNAL(error(QString)), this, SLOT(handleError(QString)));
+  connect(&data->derived, SIGNAL(error(QString)), this, SLOT(handleError(QString)));
+  connect(&data->stats, SIGNAL(error(QString)), this, SLOT(handleError(QString)));
+  connect(busLoad, SIGNAL(error(QString)), this, SLOT(handleError(QString)));
+  connect(busLoad, SIGNAL(progress(int)), this, SLOT(updateProgress(int)));
 
   computeThread->data = data;
   coalesceComputeThread->data = data;
+  busLoadComputeThread->busLoad = busLoad;
 
   layout_headers = new QVBoxLayout();
   layout_reads = new QHBoxLayout();
+  layout_options = new QHBoxLayout();
   layout_main = new QHBoxLayout();
   layout_config = new QVBoxLayout();
   layout_progress = new QVBoxLayout();
@@ -55,7 +63,7 @@ AppDisplay::AppDisplay() : QWidget() {
   layout_headers->addWidget(lbl_subheader, 1);
 
   lbl_keymaps = new QLabel();
-  lbl_keymaps->setText("[c] Convert Custom File     [v] Convert Vector File     [s] Coalesce Converted Logfiles     [q] Quit");
+  lbl_keymaps->setText("[c] Convert Custom File     [v] Convert Vector File     [s] Coalesce Converted Logfiles     [p] View Converted Logfile     [b] Analyze Bus Load     [q] Quit");
   lbl_keymaps->setFont(font_subheader);
   lbl_keymaps->setAlignment(Qt::AlignCenter);
   layout_headers->addWidget(lbl_keymaps, 1);
@@ -72,23 +80,61 @@ AppDisplay::AppDisplay() : QWidget() {
   btn_coalesce->setText("Coalesce Converted Logfiles");
   layout_reads->addWidget(btn_coalesce, 1);
 
+  btn_busload = new QPushButton();
+  btn_busload->setText("Analyze Bus Load");
+  layout_reads->addWidget(btn_busload, 1);
+
+  btn_view = new QPushButton();
+  btn_view->setText("View Converted Logfile");
+  layout_reads->addWidget(btn_view, 1);
+
   layout->addLayout(layout_reads);
 
+  chk_pyramid = new QCheckBox();
+  chk_pyramid->setText("Write Preview Pyramid");
+  layout_options->addWidget(chk_pyramid, 1);
+
+  // Items are added in CompressCodec order
+  cmb_compression = new QComboBox();
+  cmb_compression->addItem("Uncompressed Output");
+  cmb_compression->addItem("LZ4 Compressed Output (.lz4)");
+  cmb_compression->addItem("Zstandard Compressed Output (.zst)");
+  layout_options->addWidget(cmb_compression, 1);
+
+  layout->addLayout(layout_options);
+
   // Configure config area (left side)
-  area_config = new QScrollArea();
-  area_config_helper = new QWidget();
-  area_config_helper->setLayout(layout_config);
-  area_config->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
-  area_config->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-  area_config->setWidgetResizable(true);
-  area_config->setWidget(area_config_helper);
+  layout_filter = new QHBoxLayout();
+  layout_config->addLayout(layout_filter);
+
+  edit_filter = new QLineEdit();
+  edit_filter->setPlaceholderText("Filter channels...");
+  edit_filter->setClearButtonEnabled(true);
+  layout_filter->addWidget(edit_filter, 1);
+
+  btn_select_all = new QPushButton();
+  btn_select_all->setText("Select All");
+  layout_filter->addWidget(btn_select_all);
+
+  btn_select_none = new QPushButton();
+  btn_select_none->setText("Select None");
+  layout_filter->addWidget(btn_select_none);
+
+  lbl_selection = new QLabel();
+  layout_filter->addWidget(lbl_selection);
+
+  model_config = new SpecModel(this);
+  tree_config = new QTreeView();
+  tree_config->setUniformRowHeights(true);
+  tree_config->setModel(model_config);
+  layout_config->addWidget(tree_config, 1);
 
   // Configure progress area (right side)
   bar_convert = new QProgressBar();
   layout_progress->addWidget(bar_convert, 1);
 
   // Add config and progress areas to main layout
-  layout_main->addWidget(area_config);
+  layout_main->addLayout(layout_config, 1);
   layout_main->addLayout(layout_progress);
   layout->addLayout(layout_main);
 
@@ -98,29 +144,26 @@ AppDisplay::AppDisplay() : QWidget() {
     this->successful = true;
   }
 
-  // Add message defintions to config area
-  typedef map<uint16_t, Message>::iterator it_msg;
-  for(it_msg msgIt = messages.begin(); msgIt != messages.end(); msgIt++) {
-    Message msg = msgIt->second;
-
-    QGroupBox* messageGroup = new QGroupBox(msg.toString());
-    QVBoxLayout* signalsLayout = new QVBoxLayout();
-    messageGroup->setLayout(signalsLayout);
-
-    for (Signal sig: msg.sigs) {
-      signalsLayout->addWidget(new QLabel(sig.toString()));
-    }
-
-    layout_config->addWidget(messageGroup);
-  }
+  // Add message and derived channel defintions to config area
+  QVector<DerivedChannel> derivedChannels = data->derived.getChannels();
+  model_config->setSpec(messages, derivedChannels);
+  updateSelection();
 
   connect(computeThread, SIGNAL(finish(bool)), this, SLOT(convertFinish(bool)));
   connect(computeThread, SIGNAL(addFileProgress(QString)), this, SLOT(addFileProgress(QString)));
   connect(coalesceComputeThread, SIGNAL(finish(bool)), this, SLOT(coalesceFinish(bool)));
+  connect(busLoadComputeThread, SIGNAL(finish(bool)), this, SLOT(busLoadFinish(bool)));
+  connect(busLoadComputeThread, SIGNAL(addFileProgress(QString)), this, SLOT(addFileProgress(QString)));
 
   connect(btn_read_custom, SIGNAL(clicked()), this, SLOT(readDataCustom()));
   connect(btn_read_vector, SIGNAL(clicked()), this, SLOT(readDataVector()));
   connect(btn_coalesce, SIGNAL(clicked()), this, SLOT(coalesceLogfiles()));
+  connect(btn_busload, SIGNAL(clicked()), this, SLOT(analyzeBusLoad()));
+  connect(btn_view, SIGNAL(clicked()), this, SLOT(viewLogfile()));
+  connect(btn_select_all, SIGNAL(clicked()), this, SLOT(selectAllChannels()));
+  connect(btn_select_none, SIGNAL(clicked()), this, SLOT(selectNoChannels()));
+  connect(edit_filter, SIGNAL(textChanged(QString)), this, SLOT(filterChannels(QString)));
+  connect(model_config, SIGNAL(selectionChanged()), this, SLOT(updateSelection()));
 }
 
 void AppDisplay::addFileProgress(QString filename) {
@@ -135,10 +178,33 @@ void AppDisplay::readDataVector() {
   readData(true);
 }
 
+void AppDisplay::filterChannels(QString filter) {
+  model_config->setFilter(filter);
+  if (!filter.isEmpty()) {
+    tree_config->expandAll();
+  }
+}
+
+void AppDisplay::selectAllChannels() {
+  model_config->setAllChecked(true);
+}
+
+void AppDisplay::selectNoChannels() {
+  model_config->setAllChecked(false);
+}
+
+void AppDisplay::updateSelection() {
+  map<uint16_t, vector<bool> > exportSignals;
+  vector<bool> exportDerived;
+  int count = model_config->getSelection(exportSignals, exportDerived);
+  lbl_selection->setText(QString("%1 Selected").arg(count));
+}
+
 void AppDisplay::coalesceLogfiles() {
   btn_read_custom->setEnabled(false);
   btn_read_vector->setEnabled(false);
   btn_coalesce->setEnabled(false);
+  btn_busload->setEnabled(false);
 
   QFileDialog dialog(this);
   dialog.setDirectory(".");
@@ -154,10 +220,62 @@ void AppDisplay::coalesceLogfiles() {
   }
 }
 
+void AppDisplay::analyzeBusLoad() {
+  btn_read_custom->setEnabled(false);
+  btn_read_vector->setEnabled(false);
+  btn_coalesce->setEnabled(false);
+  btn_busload->setEnabled(false);
+
+  QFileDialog dialog(this);
+  dialog.setDirectory(".");
+  dialog.setNameFilter("*.txt *.TXT *.asc *.ASC");
+  dialog.setFileMode(QFileDialog::ExistingFiles);
+  if(dialog.exec()) {
+    busLoadComputeThread->filenames = dialog.selectedFiles();
+    busLoadComputeThread->start();
+  } else {
+    QMessageBox::critical(this, "File Dialog Error",
+        "A team of highly trained monkeys has been dispatched to help you.");
+    busLoadFinish(false);
+  }
+}
+
+void AppDisplay::busLoadFinish(bool success) {
+  if(success) {
+    QMessageBox::information(this, "Bus Load Analysis Completed!",
+        "Reports (.busload.txt) are stored in the same directory as the input files.");
+  }
+
+  btn_read_custom->setEnabled(true);
+  btn_read_vector->setEnabled(true);
+  btn_coalesce->setEnabled(true);
+  btn_busload->setEnabled(true);
+}
+
+void AppDisplay::viewLogfile() {
+  QFileDialog dialog(this);
+  dialog.setDirectory(".");
+  dialog.setNameFilter(QString("*.lod%1").arg(LOD_FACTORS[0]));
+  dialog.setFileMode(QFileDialog::ExistingFile);
+  if(!dialog.exec()) {
+    return;
+  }
+
+  AppViewer* viewer = new AppViewer();
+  if(viewer->open(dialog.selectedFiles().first())) {
+    viewer->show();
+  } else {
+    delete viewer;
+    handleError("Problem opening preview pyramid. Convert the logfile with "
+        "\"Write Preview Pyramid\" checked to view it.");
+  }
+}
+
 void AppDisplay::readData(bool isVectorFile) {
   btn_read_custom->setEnabled(false);
   btn_read_vector->setEnabled(false);
   btn_coalesce->setEnabled(false);
+  btn_busload->setEnabled(false);
 
   QFileDialog dialog(this);
   dialog.setDirectory(".");
@@ -166,6 +284,9 @@ void AppDisplay::readData(bool isVectorFile) {
   if(dialog.exec()) {
     computeThread->filenames = dialog.selectedFiles();
 
+    data->writePyramid = chk_pyramid->isChecked();
+    data->compression = (CompressCodec) cmb_compression->currentIndex();
+    model_config->getSelection(data->exportSignals, data->exportDerived);
     computeThread->isVectorFile = isVectorFile;
     computeThread->start();
   } else {
@@ -182,7 +303,8 @@ void AppDisplay::convertFinish(bool success) {
       QMessageBox::information(this, "Conversion Completed!",
           QString("Output File: %1").arg(
             filename.replace(".txt", ".out.txt", Qt::CaseInsensitive)
-                    .replace(".asc", ".out.txt", Qt::CaseInsensitive)));
+                    .replace(".asc", ".out.txt", Qt::CaseInsensitive)
+            + compressSuffix(data->compression)));
     } else {
       QMessageBox::information(this, "Convesion Completed!",
           "Output files are stored in the same directory as the input files.");
@@ -192,6 +314,7 @@ void AppDisplay::convertFinish(bool success) {
   btn_read_custom->setEnabled(true);
   btn_read_vector->setEnabled(true);
   btn_coalesce->setEnabled(true);
+  btn_busload->setEnabled(true);
 }
 
 void AppDisplay::coalesceFinish(bool success) {
@@ -203,6 +326,7 @@ void AppDisplay::coalesceFinish(bool success) {
   btn_read_custom->setEnabled(true);
   btn_read_vector->setEnabled(true);
   btn_coalesce->setEnabled(true);
+  btn_busload->setEnabled(true);
 }
 
 void AppDisplay::handleError(QString error) {
@@ -229,6 +353,16 @@ void AppDisplay::keyPressEvent(QKeyEvent* e) {
     btn_coalesce->click();
   }
 
+  // Opens bus load analysis dialog.
+  if(e->text() == "b") {
+    btn_busload->click();
+  }
+
+  // Opens converted logfile viewer.
+  if(e->text() == "p") {
+    btn_view->click();
+  }
+
   // Quits the application.
   if(e->text() == "q") {
     QApplication::quit();
@@ -4,7 +4,7 @@
  *
  * @author Andrew Mass
  * @date Created: 2014-06-24
- * @date Modified: 2016-03-20
+ * @date Modified: 2026-10-18
  */
 #ifndef APP_DISPLAY_H
 #define APP_DISPLAY_H
@@ -12,18 +12,22 @@
 #include <QFont>
 #include <QLabel>
 #include <QCheckBox>
+#include <QComboBox>
 #include <QKeyEvent>
-#include <QGroupBox>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QPushButton>
 #include <QVBoxLayout>
-#include <QScrollArea>
+#include <QTreeView>
+#include <QLineEdit>
+#include <QHeaderView>
 #include <QApplication>
 #include <QProgressBar>
 #include "data.h"
 #include "config.h"
 #include "compute.h"
+#include "viewer.h"
+#include "browser.h"
 
 #define WIDTH 1400
 #define HEIGHT 720
@@ -78,6 +82,47 @@ class AppDisplay : public QWidget {
      */
     void coalesceLogfiles();
 
+    /**
+     * Starts the bus load analysis of the selected logfiles when btn_busload
+     * is pressed.
+     */
+    void analyzeBusLoad();
+
+    /**
+     * Called when the bus load thread has finished.
+     *
+     * @param success Whether the analysis was successful.
+     */
+    void busLoadFinish(bool success);
+
+    /**
+     * Opens a converted logfile in a new viewer window when btn_view is
+     * pressed.
+     */
+    void viewLogfile();
+
+    /**
+     * Shows only the channels matching the text in edit_filter.
+     *
+     * @param filter The current text of edit_filter.
+     */
+    void filterChannels(QString filter);
+
+    /**
+     * Checks every channel currently shown in the spec browser.
+     */
+    void selectAllChannels();
+
+    /**
+     * Unchecks every channel currently shown in the spec browser.
+     */
+    void selectNoChannels();
+
+    /**
+     * Updates the count of channels selected for export.
+     */
+    void updateSelection();
+
     /**
      * Called when the thread has fininshed the conversion process.
      *
@@ -126,29 +171,42 @@ class AppDisplay : public QWidget {
 
     AppConfig* config;
     AppData* data;
+    AppBusLoad* busLoad;
 
     QVBoxLayout* layout;
     QVBoxLayout* layout_headers;
     QHBoxLayout* layout_reads;
+    QHBoxLayout* layout_options;
     QHBoxLayout* layout_main;
     QVBoxLayout* layout_config;
+    QHBoxLayout* layout_filter;
     QVBoxLayout* layout_progress;
 
-    QScrollArea* area_config;
-    QWidget* area_config_helper;
+    SpecModel* model_config;
+    QTreeView* tree_config;
+    QLineEdit* edit_filter;
 
     QLabel* lbl_header;
     QLabel* lbl_subheader;
     QLabel* lbl_keymaps;
+    QLabel* lbl_selection;
 
     QPushButton* btn_read_custom;
     QPushButton* btn_read_vector;
     QPushButton* btn_coalesce;
+    QPushButton* btn_view;
+    QPushButton* btn_busload;
+    QPushButton* btn_select_all;
+    QPushButton* btn_select_none;
+
+    QCheckBox* chk_pyramid;
+    QComboBox* cmb_compression;
 
     QProgressBar* bar_convert;
 
     ComputeThread* computeThread;
     CoalesceComputeThread* coalesceComputeThread;
+    BusLoadComputeThread* busLoadComputeThread;
 };
 
 #endif // APP_DISPLAY_H
@@ -0,0 +1,92 @@
+/**
+ * @file header.cpp
+ * Implementation of the AppHeader class.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include "header.h"
+
+bool AppHeader::read() {
+  QString directory = QCoreApplication::applicationDirPath();
+  if (QFile::exists(directory + "/CAN.h")) {
+    return read(directory + "/CAN.h");
+  }
+  return read(directory + "/../FSAE.X/CAN.h");
+}
+
+bool AppHeader::read(QString filename) {
+  this->filename = filename;
+  this->defines.clear();
+  this->index.clear();
+
+  QFile headerFile(filename);
+  if (!headerFile.open(QIODevice::ReadOnly)) {
+    emit error(QString("Problem opening CAN header: %1").arg(filename));
+    return false;
+  }
+
+  QTextStream inStream(&headerFile);
+  int lineNum = 0;
+  while (!inStream.atEnd()) {
+    QString line = inStream.readLine();
+    lineNum++;
+
+    // Strip trailing comments
+    int comment = line.indexOf("//");
+    if (comment >= 0) {
+      line = line.left(comment);
+    }
+
+    QStringList sections = line.simplified().split(" ", QString::SkipEmptyParts);
+    if (sections.size() < 3 || sections[0] != "#define") {
+      continue;
+    }
+
+    HeaderDefine def;
+    def.name = sections[1];
+    def.value = line.simplified().section(" ", 2);
+    def.line = lineNum;
+
+    index[def.name] = defines.size();
+    defines.append(def);
+  }
+
+  headerFile.close();
+  return true;
+}
+
+bool AppHeader::number(QString name, double* value) {
+  map<QString, int>::iterator it = index.find(name);
+  if (it == index.end()) {
+    return false;
+  }
+
+  QString text = defines[it->second].value;
+  if (text.startsWith("(") && text.endsWith(")")) {
+    text = text.mid(1, text.length() - 2).trimmed();
+  }
+
+  bool ok = false;
+  uint integer = text.toUInt(&ok, 0);
+  if (ok) {
+    *value = integer;
+    return true;
+  }
+
+  *value = text.toDouble(&ok);
+  return ok;
+}
+
+map<uint16_t, QString> AppHeader::getIdBases() {
+  map<uint16_t, QString> bases;
+
+  for (int i = 0; i < defines.size(); i++) {
+    double id;
+    if (defines[i].name.endsWith("_ID") && number(defines[i].name, &id)) {
+      bases[(uint16_t) id] = defines[i].name.left(defines[i].name.length() - 3);
+    }
+  }
+
+  return bases;
+}
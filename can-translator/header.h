@@ -0,0 +1,96 @@
+/**
+ * @file header.h
+ * Reads the #define constants of the firmware CAN header.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef HEADER_H
+#define HEADER_H
+
+#include <map>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QTextStream>
+#include <QCoreApplication>
+#include <stdint.h>
+
+using std::map;
+
+// Struct that represents a single #define from the firmware CAN header
+struct HeaderDefine {
+  QString name;
+  QString value;
+  int line;
+};
+
+/**
+ * Class which reads FSAE.X/CAN.h so the translator can use the same message
+ * ID bases, byte positions and scalars as the firmware.
+ */
+class AppHeader : public QObject {
+  Q_OBJECT
+
+  public:
+
+    /**
+     * Reads CAN.h from the application directory, or from ../FSAE.X/ when
+     * running from the source tree.
+     *
+     * @returns Whether the header was found and read.
+     */
+    bool read();
+
+    /**
+     * Reads the given header file.
+     *
+     * @returns Whether the header was read.
+     */
+    bool read(QString filename);
+
+    /**
+     * Looks up the numeric value of a define.
+     *
+     * @param name The name of the define.
+     * @param value Set to the value of the define.
+     * @returns Whether the define exists and has a numeric value.
+     */
+    bool number(QString name, double* value);
+
+    /**
+     * Returns the node name of each message ID base, keyed by the base. The
+     * names are the *_ID defines without the _ID suffix.
+     */
+    map<uint16_t, QString> getIdBases();
+
+    /**
+     * Every define in the header, in the order they appear.
+     */
+    QVector<HeaderDefine> defines;
+
+    /**
+     * The name of the header that was read.
+     */
+    QString filename;
+
+  signals:
+
+    /**
+     * Error handler that will be connected to an error function in the display
+     * class. Calling this method will display a error message box.
+     *
+     * @params error The error message to display.
+     */
+    void error(QString error);
+
+  private:
+
+    /**
+     * Map of define name to its index in defines.
+     */
+    map<QString, int> index;
+};
+
+#endif // HEADER_H
@@ -0,0 +1,295 @@
+/**
+ * @file lod.cpp
+ * Implementation of the LodWriter and LodPyramid classes.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include <string.h>
+#include "lod.h"
+
+using std::ios;
+
+QString lodFilename(QString outFilename, uint32_t factor) {
+  QString filename = outFilename;
+  QString suffix = QString(".lod%1").arg(factor);
+  if (filename.endsWith(".out.txt", Qt::CaseInsensitive)) {
+    return filename.left(filename.length() - 8) + suffix;
+  }
+  return filename + suffix;
+}
+
+//=============================== LOD WRITER ===================================
+
+LodWriter::LodWriter() {
+  next = NULL;
+  memset(&header, 0, sizeof(LodHeader));
+  bucketRows = 0;
+  bucketTime = 0.0;
+  blockRow = 0;
+}
+
+LodWriter::~LodWriter() {
+  if (file.is_open()) {
+    close();
+  }
+}
+
+bool LodWriter::open(QString filename, uint32_t factor, QStringList names) {
+  file.open(filename.toLocal8Bit().data(), ios::out | ios::trunc | ios::binary);
+  if (!(file && file.good())) {
+    return false;
+  }
+
+  QByteArray nameBytes = names.join("\n").toUtf8();
+  while (nameBytes.size() % 8 != 0) {
+    nameBytes.append("\n", 1);
+  }
+
+  memset(&header, 0, sizeof(LodHeader));
+  memcpy(header.magic, LOD_MAGIC, sizeof(header.magic));
+  header.version = LOD_VERSION;
+  header.factor = factor;
+  header.numChannels = names.size();
+  header.colsPerChannel = factor == 1 ? 1 : 2;
+  header.blockRows = LOD_BLOCK_ROWS;
+  header.namesLength = nameBytes.size();
+  header.numRows = 0;
+
+  file.write((const char*) &header, sizeof(LodHeader));
+  file.write(nameBytes.constData(), nameBytes.size());
+
+  bucketRows = 0;
+  bucketMin.assign(header.numChannels, 0.0f);
+  bucketMax.assign(header.numChannels, 0.0f);
+
+  blockRow = 0;
+  blockTimes.assign(header.blockRows, 0.0);
+  blockColumns.assign(header.numChannels * header.colsPerChannel * header.blockRows, 0.0f);
+
+  return file.good();
+}
+
+void LodWriter::addRow(double timestamp, const vector<double>& values) {
+  if (header.factor == 1) {
+    for (uint32_t i = 0; i < header.numChannels; i++) {
+      bucketMin[i] = values[i];
+    }
+    emitRow(timestamp, &bucketMin[0], &bucketMin[0], 1);
+    return;
+  }
+
+  if (bucketRows == 0) {
+    bucketTime = timestamp;
+    for (uint32_t i = 0; i < header.numChannels; i++) {
+      bucketMin[i] = bucketMax[i] = values[i];
+    }
+  } else {
+    for (uint32_t i = 0; i < header.numChannels; i++) {
+      float v = values[i];
+      bucketMin[i] = v < bucketMin[i] ? v : bucketMin[i];
+      bucketMax[i] = v > bucketMax[i] ? v : bucketMax[i];
+    }
+  }
+
+  if (++bucketRows == header.factor) {
+    emitRow(bucketTime, &bucketMin[0], &bucketMax[0], bucketRows);
+    bucketRows = 0;
+  }
+}
+
+void LodWriter::addBucket(double timestamp, const float* mins, const float* maxs,
+    uint32_t rows) {
+  if (bucketRows == 0) {
+    bucketTime = timestamp;
+    for (uint32_t i = 0; i < header.numChannels; i++) {
+      bucketMin[i] = mins[i];
+      bucketMax[i] = maxs[i];
+    }
+  } else {
+    for (uint32_t i = 0; i < header.numChannels; i++) {
+      bucketMin[i] = mins[i] < bucketMin[i] ? mins[i] : bucketMin[i];
+      bucketMax[i] = maxs[i] > bucketMax[i] ? maxs[i] : bucketMax[i];
+    }
+  }
+
+  bucketRows += rows;
+  if (bucketRows >= header.factor) {
+    emitRow(bucketTime, &bucketMin[0], &bucketMax[0], bucketRows);
+    bucketRows = 0;
+  }
+}
+
+bool LodWriter::close() {
+  if (!file.is_open()) {
+    return false;
+  }
+
+  // Emit the last partial bucket
+  if (bucketRows > 0) {
+    emitRow(bucketTime, &bucketMin[0], &bucketMax[0], bucketRows);
+    bucketRows = 0;
+  }
+
+  // Pad and write the last partial block
+  if (blockRow > 0) {
+    for (uint32_t r = blockRow; r < header.blockRows; r++) {
+      blockTimes[r] = blockTimes[blockRow - 1];
+    }
+    uint32_t numCols = header.numChannels * header.colsPerChannel;
+    for (uint32_t c = 0; c < numCols; c++) {
+      for (uint32_t r = blockRow; r < header.blockRows; r++) {
+        blockColumns[c * header.blockRows + r] = 0.0f;
+      }
+    }
+    flushBlock();
+  }
+
+  // Rewrite the header now that the number of rows is known
+  file.seekp(0, ios::beg);
+  file.write((const char*) &header, sizeof(LodHeader));
+
+  bool success = file.good();
+  file.close();
+  return success;
+}
+
+void LodWriter::emitRow(double timestamp, const float* mins, const float* maxs,
+    uint32_t rows) {
+  uint32_t blockRows = header.blockRows;
+
+  blockTimes[blockRow] = timestamp;
+  if (header.colsPerChannel == 1) {
+    for (uint32_t i = 0; i < header.numChannels; i++) {
+      blockColumns[i * blockRows + blockRow] = mins[i];
+    }
+  } else {
+    for (uint32_t i = 0; i < header.numChannels; i++) {
+      blockColumns[(2 * i) * blockRows + blockRow] = mins[i];
+      blockColumns[(2 * i + 1) * blockRows + blockRow] = maxs[i];
+    }
+  }
+
+  header.numRows++;
+  if (++blockRow == blockRows) {
+    flushBlock();
+  }
+
+  if (next) {
+    next->addBucket(timestamp, mins, maxs, rows);
+  }
+}
+
+void LodWriter::flushBlock() {
+  file.write((const char*) &blockTimes[0], blockTimes.size() * sizeof(double));
+  file.write((const char*) &blockColumns[0], blockColumns.size() * sizeof(float));
+  blockRow = 0;
+}
+
+//=============================== LOD READER ===================================
+
+LodReader::LodReader() {
+  memset(&header, 0, sizeof(LodHeader));
+  map = NULL;
+  data = NULL;
+  blockBytes = 0;
+}
+
+LodReader::~LodReader() {
+  if (map) {
+    file.unmap(map);
+  }
+  file.close();
+}
+
+bool LodReader::open(QString filename) {
+  file.setFileName(filename);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  qint64 size = file.size();
+  if (size < (qint64) sizeof(LodHeader)) {
+    return false;
+  }
+
+  map = file.map(0, size);
+  if (!map) {
+    return false;
+  }
+
+  memcpy(&header, map, sizeof(LodHeader));
+  if (memcmp(header.magic, LOD_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != LOD_VERSION || header.blockRows == 0 ||
+      header.colsPerChannel == 0 || header.colsPerChannel > 2) {
+    return false;
+  }
+
+  uint64_t numCols = header.numChannels * header.colsPerChannel;
+  uint64_t numBlocks = (header.numRows + header.blockRows - 1) / header.blockRows;
+  uint64_t dataOffset = sizeof(LodHeader) + header.namesLength;
+  blockBytes = header.blockRows * (sizeof(double) + numCols * sizeof(float));
+  if ((uint64_t) size < dataOffset + numBlocks * blockBytes) {
+    return false;
+  }
+
+  QString nameString = QString::fromUtf8((const char*) map + sizeof(LodHeader),
+      header.namesLength);
+  names = nameString.split("\n", QString::SkipEmptyParts);
+  if ((uint32_t) names.size() != header.numChannels) {
+    return false;
+  }
+
+  data = map + dataOffset;
+  return true;
+}
+
+uint64_t LodReader::lowerBound(double timestamp) {
+  uint64_t lo = 0;
+  uint64_t hi = header.numRows;
+  while (lo < hi) {
+    uint64_t mid = lo + (hi - lo) / 2;
+    if (time(mid) < timestamp) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+//=============================== LOD PYRAMID ==================================
+
+bool LodPyramid::open(QString outFilename, QStringList names) {
+  for (int i = 0; i < LOD_NUM_LEVELS; i++) {
+    if (!levels[i].open(lodFilename(outFilename, LOD_FACTORS[i]), LOD_FACTORS[i], names)) {
+      return false;
+    }
+    levels[i].next = (i + 1 < LOD_NUM_LEVELS) ? &levels[i + 1] : NULL;
+  }
+  hasRows = false;
+  lastTime = 0.0;
+  return true;
+}
+
+void LodPyramid::addRow(double timestamp, const vector<double>& values) {
+  // Small backward jumps are accepted by the converter, but LodReader bisects
+  // on time, so hold the time at the last written value until it catches up
+  if (hasRows && timestamp < lastTime) {
+    timestamp = lastTime;
+  }
+  hasRows = true;
+  lastTime = timestamp;
+
+  levels[0].addRow(timestamp, values);
+}
+
+bool LodPyramid::close() {
+  bool success = true;
+
+  // Close from finest to coarsest so partial buckets cascade correctly
+  for (int i = 0; i < LOD_NUM_LEVELS; i++) {
+    success = levels[i].close() && success;
+  }
+  return success;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file lod.h
+ * Writes multi-resolution (level of detail) copies of the converted data.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef LOD_H
+#define LOD_H
+
+#include <vector>
+#include <fstream>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <stdint.h>
+
+using std::vector;
+using std::ofstream;
+
+/**
+ * Level of detail files are block-columnar so that a viewer can memory map
+ * them and read any range of a single channel without touching the others.
+ *
+ * Each file starts with a LodHeader followed by <namesLength> bytes of
+ * newline separated channel names (padded to 8 bytes). The rest of the file
+ * is a sequence of fixed size blocks of <blockRows> rows each:
+ *
+ *   double time[blockRows]
+ *   float  column[numChannels * colsPerChannel][blockRows]
+ *
+ * A file with <factor> 1 holds the full rate data with one column per
+ * channel. Decimated files hold one bucket of <factor> rows per row, with a
+ * min and max column per channel and the time of the first row in the bucket.
+ * The last block is padded. All values are stored little-endian.
+ */
+#define LOD_MAGIC      "IMLOD01"
+#define LOD_VERSION    1
+#define LOD_BLOCK_ROWS 1024
+
+// Decimation factors written alongside the converted output, the first being
+// the full rate data
+#define LOD_NUM_LEVELS 4
+static const uint32_t LOD_FACTORS[LOD_NUM_LEVELS] = {1, 10, 100, 1000};
+
+// Struct representing the fixed size header of a level of detail file
+struct LodHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t factor;
+  uint32_t numChannels;
+  uint32_t colsPerChannel;
+  uint32_t blockRows;
+  uint32_t namesLength;
+  uint64_t numRows;
+};
+
+/**
+ * Returns the level of detail filename for the given converted output file
+ * and decimation factor.
+ */
+QString lodFilename(QString outFilename, uint32_t factor);
+
+/**
+ * Class which writes a single level of detail file. Rows are decimated into
+ * buckets of <factor> rows as they arrive.
+ */
+class LodWriter {
+
+  public:
+
+    LodWriter();
+    ~LodWriter();
+
+    /**
+     * Opens the output file and writes the header.
+     *
+     * @param filename The name of the file to write.
+     * @param factor The number of input rows per output row.
+     * @param names The names of each channel.
+     * @returns Whether the file was opened successfully.
+     */
+    bool open(QString filename, uint32_t factor, QStringList names);
+
+    /**
+     * Adds a single full rate row.
+     */
+    void addRow(double timestamp, const vector<double>& values);
+
+    /**
+     * Adds an already decimated bucket spanning <rows> full rate rows. Used to
+     * cascade one level into the next without revisiting the full rate data.
+     */
+    void addBucket(double timestamp, const float* mins, const float* maxs,
+        uint32_t rows);
+
+    /**
+     * Flushes any partial bucket and block, and finalizes the header.
+     *
+     * @returns Whether every write was successful.
+     */
+    bool close();
+
+    /**
+     * The next (coarser) level that completed buckets are passed to, or NULL.
+     */
+    LodWriter* next;
+
+  private:
+
+    /**
+     * Writes one row, covering <rows> full rate rows, and passes it on to the
+     * next level.
+     */
+    void emitRow(double timestamp, const float* mins, const float* maxs, uint32_t rows);
+    void flushBlock();
+
+    ofstream file;
+    LodHeader header;
+
+    // The bucket currently being accumulated
+    uint32_t bucketRows;
+    double bucketTime;
+    vector<float> bucketMin;
+    vector<float> bucketMax;
+
+    // The block currently being filled
+    uint32_t blockRow;
+    vector<double> blockTimes;
+    vector<float> blockColumns;
+};
+
+/**
+ * Class which reads a level of detail file through a memory map, so only the
+ * blocks that are actually accessed are loaded from disk.
+ */
+class LodReader {
+
+  public:
+
+    LodReader();
+    ~LodReader();
+
+    /**
+     * Maps the given file and validates its header.
+     *
+     * @returns Whether the file is a valid level of detail file.
+     */
+    bool open(QString filename);
+
+    /**
+     * Returns the index of the first row with a time at or after <timestamp>.
+     * Relies on the row times being non-decreasing, which LodPyramid ensures.
+     */
+    uint64_t lowerBound(double timestamp);
+
+    /**
+     * Returns the time of row <row>.
+     */
+    inline double time(uint64_t row) {
+      const uchar* block = data + (row / header.blockRows) * blockBytes;
+      return ((const double*) block)[row % header.blockRows];
+    }
+
+    /**
+     * Returns the value of column <col> at row <row>.
+     */
+    inline float value(uint32_t col, uint64_t row) {
+      const uchar* block = data + (row / header.blockRows) * blockBytes;
+      const float* columns = (const float*) (block + header.blockRows * sizeof(double));
+      return columns[col * header.blockRows + row % header.blockRows];
+    }
+
+    /**
+     * Returns the min/max columns of channel <chn>. For the full rate level
+     * both are the same column.
+     */
+    inline uint32_t minCol(uint32_t chn) {
+      return chn * header.colsPerChannel;
+    }
+
+    inline uint32_t maxCol(uint32_t chn) {
+      return chn * header.colsPerChannel + header.colsPerChannel - 1;
+    }
+
+    LodHeader header;
+    QStringList names;
+
+  private:
+
+    QFile file;
+    uchar* map;
+    const uchar* data;
+    uint64_t blockBytes;
+};
+
+/**
+ * Class which writes every decimated level of detail for one conversion in a
+ * single streaming pass. Each level is fed from the level below it, so the
+ * cost per converted row is that of the finest level.
+ */
+class LodPyramid {
+
+  public:
+
+    /**
+     * Opens one LodWriter per level in LOD_FACTORS.
+     *
+     * @returns Whether every file was opened successfully.
+     */
+    bool open(QString outFilename, QStringList names);
+
+    /**
+     * Adds a single full rate row to the finest level. Timestamps are clamped
+     * to be non-decreasing so every level can be searched with lowerBound().
+     */
+    void addRow(double timestamp, const vector<double>& values);
+
+    /**
+     * Closes every level.
+     *
+     * @returns Whether every write was successful.
+     */
+    bool close();
+
+  private:
+
+    LodWriter levels[LOD_NUM_LEVELS];
+
+    bool hasRows;
+    double lastTime;
+};
+
+#endif // LOD_H
@@ -4,11 +4,62 @@
  *
  * @author Andrew Mass
  * @date Created: 2014-06-24
- * @date Modified: 2014-06-24
+ * @date Modified: 2026-10-18
  */
+#include <cstring>
 #include "display.h"
+#include "crosscheck.h"
+#include "codegen.h"
+
+/**
+ * Runs the firmware cross-check without a window and prints the report, so it
+ * can be run as part of every firmware build.
+ */
+static int run_crosscheck(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+
+  AppCrossCheck crossCheck;
+  bool passed = crossCheck.run();
+
+  QTextStream out(stdout);
+  for (int i = 0; i < crossCheck.report.size(); i++) {
+    out << crossCheck.report[i] << "\n";
+  }
+  out.flush();
+
+  return passed ? 0 : 1;
+}
+
+/**
+ * Generates the firmware pack/unpack header without a window. The header is
+ * written to the given file, or CAN_gen.h in the application directory.
+ */
+static int run_codegen(int argc, char *argv[]) {
+  QCoreApplication app(argc, argv);
+
+  QString filename = argc > 2 ? QString(argv[2]) :
+    QCoreApplication::applicationDirPath().append("/CAN_gen.h");
+
+  AppCodeGen codeGen;
+  bool successful = codeGen.generate(filename);
+
+  QTextStream out(stdout);
+  for (int i = 0; i < codeGen.report.size(); i++) {
+    out << codeGen.report[i] << "\n";
+  }
+  out.flush();
+
+  return successful ? 0 : 1;
+}
 
 int main(int argc, char *argv[]) {
+  if (argc > 1 && strcmp(argv[1], "--crosscheck") == 0) {
+    return run_crosscheck(argc, argv);
+  }
+  if (argc > 1 && strcmp(argv[1], "--codegen") == 0) {
+    return run_codegen(argc, argv);
+  }
+
   QApplication app(argc, argv);
 
   AppDisplay display;
@@ -0,0 +1,284 @@
+/**
+ * @file stats.cpp
+ * Implementation of the AppStats and TDigest classes.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include <cmath>
+#include <algorithm>
+#include "stats.h"
+
+using std::ios;
+using std::sort;
+
+//================================= TDIGEST ====================================
+
+/**
+ * Scale function k1 from the t-digest paper, and its inverse. Centroids are
+ * allowed to grow until they span one unit of k, which keeps them small near
+ * the tails and large near the median.
+ */
+static double tdigest_k(double q) {
+  return (TDIGEST_COMPRESSION / (2.0 * M_PI)) * asin(2.0 * q - 1.0);
+}
+
+static double tdigest_k_inv(double k) {
+  double x = k * (2.0 * M_PI) / TDIGEST_COMPRESSION;
+  x = x > M_PI / 2.0 ? M_PI / 2.0 : x;
+  return (sin(x) + 1.0) / 2.0;
+}
+
+TDigest::TDigest() {
+  totalWeight = 0.0;
+  min = 0.0;
+  max = 0.0;
+}
+
+void TDigest::add(double value) {
+  if (totalWeight == 0.0 || value < min) {
+    min = value;
+  }
+  if (totalWeight == 0.0 || value > max) {
+    max = value;
+  }
+
+  buffer.push_back(Centroid(value, 1.0));
+  totalWeight += 1.0;
+
+  if (buffer.size() >= TDIGEST_BUFFER_SIZE) {
+    compress();
+  }
+}
+
+double TDigest::quantile(double q) {
+  compress();
+
+  if (centroids.empty()) {
+    return 0.0;
+  } else if (centroids.size() == 1) {
+    return centroids[0].mean;
+  }
+
+  double index = q * totalWeight;
+
+  // Interpolate between the minimum and the center of the first centroid
+  Centroid& first = centroids.front();
+  if (index < first.weight / 2.0) {
+    return min + (first.mean - min) * (index / (first.weight / 2.0));
+  }
+
+  // Interpolate between the centers of neighboring centroids
+  double cumulative = 0.0;
+  for (unsigned int i = 0; i + 1 < centroids.size(); i++) {
+    double left = cumulative + centroids[i].weight / 2.0;
+    double right = cumulative + centroids[i].weight + centroids[i + 1].weight / 2.0;
+    if (index < right) {
+      double frac = (index - left) / (right - left);
+      return centroids[i].mean + frac * (centroids[i + 1].mean - centroids[i].mean);
+    }
+    cumulative += centroids[i].weight;
+  }
+
+  // Interpolate between the center of the last centroid and the maximum
+  Centroid& last = centroids.back();
+  double frac = (index - (totalWeight - last.weight / 2.0)) / (last.weight / 2.0);
+  frac = frac > 1.0 ? 1.0 : frac;
+  return last.mean + (max - last.mean) * frac;
+}
+
+void TDigest::compress() {
+  if (buffer.empty()) {
+    return;
+  }
+
+  buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+  sort(buffer.begin(), buffer.end());
+  centroids.clear();
+
+  double weightSoFar = 0.0;
+  double weightLimit = totalWeight * tdigest_k_inv(tdigest_k(0.0) + 1.0);
+  Centroid current = buffer[0];
+
+  for (unsigned int i = 1; i < buffer.size(); i++) {
+    Centroid& next = buffer[i];
+    if (weightSoFar + current.weight + next.weight <= weightLimit) {
+      current.weight += next.weight;
+      current.mean += (next.mean - current.mean) * next.weight / current.weight;
+    } else {
+      weightSoFar += current.weight;
+      centroids.push_back(current);
+      weightLimit = totalWeight * tdigest_k_inv(tdigest_k(weightSoFar / totalWeight) + 1.0);
+      current = next;
+    }
+  }
+
+  centroids.push_back(current);
+  buffer.clear();
+}
+
+//============================== CHANNEL STATS =================================
+
+void ChannelStats::add(double timestamp, double value) {
+  addLimits(timestamp, value);
+
+  count++;
+  if (count == 1) {
+    min = value;
+    max = value;
+  } else {
+    min = value < min ? value : min;
+    max = value > max ? value : max;
+  }
+
+  double delta = value - mean;
+  mean += delta / count;
+  m2 += delta * (value - mean);
+
+  digest.add(value);
+}
+
+void ChannelStats::addLimits(double timestamp, double value) {
+  // The previous value is held until this sample, so charge the elapsed time
+  // to whichever side of the limits it was on
+  if (hasLast && hasLimits && timestamp > lastTime) {
+    double dt = timestamp - lastTime;
+    if (lastValue < limitMin) {
+      timeBelow += dt;
+    } else if (lastValue > limitMax) {
+      timeAbove += dt;
+    }
+  }
+
+  hasLast = true;
+  lastTime = timestamp;
+  lastValue = value;
+}
+
+//================================ APP STATS ===================================
+
+void AppStats::init(map<uint16_t, Message>& messages,
+    map<unsigned short, int>& messageIndices, AppDerived& derived,
+    int derivedGroup) {
+  this->channels.clear();
+  this->messageCounts.clear();
+  this->messageIndices = messageIndices;
+  this->derivedGroup = derivedGroup;
+  this->firstTime = 0.0;
+  this->lastTime = 0.0;
+  this->totalCount = 0;
+
+  // Group 0 is the time channel, which has no statistics
+  channels.resize(derivedGroup + 1);
+
+  typedef map<uint16_t, Message>::iterator it_msg;
+  for (it_msg msgIt = messages.begin(); msgIt != messages.end(); msgIt++) {
+    Message& msg = msgIt->second;
+    vector<ChannelStats>& group = channels[messageIndices[msg.id]];
+
+    for (int i = 0; i < msg.sigs.size(); i++) {
+      ChannelStats chn;
+      chn.title = msg.sigs[i].title;
+      chn.units = msg.sigs[i].units;
+      chn.hasLimits = msg.sigs[i].min < msg.sigs[i].max;
+      chn.limitMin = msg.sigs[i].min;
+      chn.limitMax = msg.sigs[i].max;
+      group.push_back(chn);
+    }
+  }
+
+  for (int i = 0; i < derived.channels.size(); i++) {
+    ChannelStats chn;
+    chn.title = derived.channels[i].title;
+    chn.units = derived.channels[i].units;
+    channels[derivedGroup].push_back(chn);
+  }
+}
+
+void AppStats::update(uint16_t msgId, double timestamp,
+    vector< vector<double> >& latestValues, AppDerived& derived) {
+  updateMessage(msgId, timestamp, latestValues[messageIndices[msgId]]);
+
+  vector<int>* dependents = derived.getDependents(msgId);
+  if (dependents) {
+    for (unsigned int i = 0; i < dependents->size(); i++) {
+      int idx = (*dependents)[i];
+      channels[derivedGroup][idx].add(timestamp, latestValues[derivedGroup][idx]);
+    }
+  }
+}
+
+void AppStats::updateMessage(uint16_t msgId, double timestamp,
+    const vector<double>& values) {
+  if (totalCount++ == 0) {
+    firstTime = timestamp;
+  }
+  lastTime = timestamp;
+  messageCounts[msgId]++;
+
+  vector<ChannelStats>& group = channels[messageIndices[msgId]];
+  for (unsigned int i = 0; i < group.size() && i < values.size(); i++) {
+    group[i].add(timestamp, values[i]);
+  }
+}
+
+void AppStats::updateLimits(uint16_t msgId, double timestamp,
+    const vector<double>& values) {
+  vector<ChannelStats>& group = channels[messageIndices[msgId]];
+  for (unsigned int i = 0; i < group.size() && i < values.size(); i++) {
+    group[i].addLimits(timestamp, values[i]);
+  }
+}
+
+bool AppStats::write(QString filename) {
+  ofstream outFile(filename.toLocal8Bit().data(), ios::out | ios::trunc);
+  if (!(outFile && outFile.good())) {
+    emit error(QString("Problem opening summary file."));
+    return false;
+  }
+
+  double duration = lastTime - firstTime;
+
+  outFile << QString("Session: %1 s - %2 s (%3 s), %4 messages")
+    .arg(firstTime, 0, 'f', 3).arg(lastTime, 0, 'f', 3).arg(duration, 0, 'f', 3)
+    .arg((qulonglong) totalCount).toStdString() << '\n';
+
+  outFile << '\n' << QString("%1 %2 %3").arg("ID", -7).arg("Count", 12)
+    .arg("Rate [Hz]", 12).toStdString() << '\n';
+
+  typedef map<unsigned short, uint64_t>::iterator it_cnt;
+  for (it_cnt cntIt = messageCounts.begin(); cntIt != messageCounts.end(); cntIt++) {
+    double rate = duration > 0.0 ? cntIt->second / duration : 0.0;
+    outFile << QString("0x%1   %2 %3").arg(cntIt->first, 3, 16, QChar('0'))
+      .arg((qulonglong) cntIt->second, 12).arg(rate, 12, 'f', 1).toStdString() << '\n';
+  }
+
+  outFile << '\n' << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9 %10 %11 %12")
+    .arg("Channel", -24).arg("Units", -8).arg("Count", 10).arg("Min", 12)
+    .arg("Max", 12).arg("Mean", 12).arg("StdDev", 12).arg("P1", 12)
+    .arg("P50", 12).arg("P99", 12).arg("Below [s]", 10).arg("Above [s]", 10)
+    .toStdString() << '\n';
+
+  for (unsigned int g = 0; g < channels.size(); g++) {
+    for (unsigned int i = 0; i < channels[g].size(); i++) {
+      ChannelStats& chn = channels[g][i];
+      if (chn.count == 0) {
+        continue;
+      }
+
+      double stddev = chn.count > 1 ? sqrt(chn.m2 / (chn.count - 1)) : 0.0;
+      QString below = chn.hasLimits ? QString::number(chn.timeBelow, 'f', 3) : QString("-");
+      QString above = chn.hasLimits ? QString::number(chn.timeAbove, 'f', 3) : QString("-");
+
+      outFile << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9 %10 %11 %12")
+        .arg(chn.title, -24).arg(chn.units, -8).arg((qulonglong) chn.count, 10)
+        .arg(chn.min, 12, 'g', 6).arg(chn.max, 12, 'g', 6).arg(chn.mean, 12, 'g', 6)
+        .arg(stddev, 12, 'g', 6).arg(chn.digest.quantile(0.01), 12, 'g', 6)
+        .arg(chn.digest.quantile(0.5), 12, 'g', 6).arg(chn.digest.quantile(0.99), 12, 'g', 6)
+        .arg(below, 10).arg(above, 10).toStdString() << '\n';
+    }
+  }
+
+  outFile.close();
+  return true;
+}
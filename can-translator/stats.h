@@ -0,0 +1,215 @@
+/**
+ * @file stats.h
+ * Streaming per-channel statistics computed during conversion.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef STATS_H
+#define STATS_H
+
+#include <map>
+#include <vector>
+#include <fstream>
+#include <QObject>
+#include "config.h"
+#include "derived.h"
+
+using std::map;
+using std::vector;
+using std::ofstream;
+
+// Compression factor of the t-digest. Higher is more accurate but larger.
+#define TDIGEST_COMPRESSION 100
+
+// Number of unmerged samples buffered before the t-digest is compressed
+#define TDIGEST_BUFFER_SIZE (5 * TDIGEST_COMPRESSION)
+
+// Struct representing a single t-digest centroid
+struct Centroid {
+  double mean;
+  double weight;
+
+  Centroid(double m = 0.0, double w = 0.0) {
+    mean = m;
+    weight = w;
+  }
+
+  bool operator<(const Centroid& other) const {
+    return mean < other.mean;
+  }
+};
+
+/**
+ * Merging t-digest (Dunning & Ertl) used to estimate percentiles of a channel
+ * in a single pass with bounded memory. Accuracy is best near the tails, which
+ * is where the interesting percentiles (p1, p99) are.
+ */
+class TDigest {
+
+  public:
+
+    TDigest();
+
+    /**
+     * Adds a single sample to the digest.
+     */
+    void add(double value);
+
+    /**
+     * Estimates the value at quantile <q>, where 0 <= q <= 1.
+     */
+    double quantile(double q);
+
+  private:
+
+    /**
+     * Merges the buffered samples into the centroid list.
+     */
+    void compress();
+
+    vector<Centroid> centroids;
+    vector<Centroid> buffer;
+    double totalWeight;
+    double min;
+    double max;
+};
+
+// Struct holding the running statistics of a single channel
+struct ChannelStats {
+  QString title;
+  QString units;
+
+  // Channel limits from config.dbc. Derived channels have no limits.
+  bool hasLimits;
+  double limitMin;
+  double limitMax;
+
+  uint64_t count;
+  double min;
+  double max;
+  double mean;
+  double m2; // Sum of squared differences from the mean (Welford)
+
+  // Time spent outside of the channel limits
+  double timeBelow;
+  double timeAbove;
+
+  // Latest sample, accepted or not, which holds until the next one
+  bool hasLast;
+  double lastTime;
+  double lastValue;
+
+  TDigest digest;
+
+  ChannelStats() {
+    hasLimits = false;
+    limitMin = 0.0;
+    limitMax = 0.0;
+    count = 0;
+    min = 0.0;
+    max = 0.0;
+    mean = 0.0;
+    m2 = 0.0;
+    timeBelow = 0.0;
+    timeAbove = 0.0;
+    hasLast = false;
+    lastTime = 0.0;
+    lastValue = 0.0;
+  }
+
+  void add(double timestamp, double value);
+  void addLimits(double timestamp, double value);
+};
+
+/**
+ * Class which accumulates statistics for every channel as messages are
+ * converted, and writes them to a compact summary file afterwards.
+ */
+class AppStats : public QObject {
+  Q_OBJECT
+
+  public:
+
+    /**
+     * Resets all statistics and sets up one entry per channel, laid out the
+     * same way as latestValues.
+     */
+    void init(map<uint16_t, Message>& messages,
+        map<unsigned short, int>& messageIndices, AppDerived& derived,
+        int derivedGroup);
+
+    /**
+     * Records the latest values of every channel affected by the converted
+     * message.
+     *
+     * @param msgId The ID of the message that was just converted.
+     * @param timestamp The timestamp of the message in seconds.
+     * @param latestValues The latest values of all channels.
+     * @param derived The derived channels, used to find affected channels.
+     */
+    void update(uint16_t msgId, double timestamp,
+        vector< vector<double> >& latestValues, AppDerived& derived);
+
+    /**
+     * Records the values of the converted message's own signals only.
+     *
+     * @param msgId The ID of the message that was just converted.
+     * @param timestamp The timestamp of the message in seconds.
+     * @param values The values of the message's signals, in order.
+     */
+    void updateMessage(uint16_t msgId, double timestamp, const vector<double>& values);
+
+    /**
+     * Counts the time the message's signals spend outside of their limits,
+     * for a message rejected because one of its values is out of range. Its
+     * values are left out of every other statistic and the message counts,
+     * since a corrupt frame would skew them.
+     *
+     * @param msgId The ID of the rejected message.
+     * @param timestamp The timestamp of the message in seconds.
+     * @param values The values of the message's signals, in order.
+     */
+    void updateLimits(uint16_t msgId, double timestamp, const vector<double>& values);
+
+    /**
+     * Writes the summary of all channels to <filename>.
+     *
+     * @returns Whether the write was successful.
+     */
+    bool write(QString filename);
+
+  signals:
+
+    /**
+     * Error handler that will be connected to an error function in the display
+     * class. Calling this method will display a error message box.
+     *
+     * @params error The error message to display.
+     */
+    void error(QString error);
+
+  private:
+
+    /**
+     * Statistics for each channel, indexed the same as latestValues.
+     */
+    vector< vector<ChannelStats> > channels;
+
+    /**
+     * Map of messageId to the position of the message in channels.
+     */
+    map<unsigned short, int> messageIndices;
+
+    /**
+     * Number of times each message was converted.
+     */
+    map<unsigned short, uint64_t> messageCounts;
+
+    int derivedGroup;
+    double firstTime;
+    double lastTime;
+    uint64_t totalCount;
+};
+
+#endif // STATS_H
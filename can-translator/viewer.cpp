@@ -0,0 +1,317 @@
+/**
+ * @file viewer.cpp
+ * Implementation of the AppViewer and PlotWidget classes.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#include "viewer.h"
+
+// Smallest visible time span in seconds
+#define VIEWER_MIN_SPAN 0.001
+
+// Height in pixels reserved for the time axis labels
+#define VIEWER_AXIS_HEIGHT 20
+
+//================================ PLOT WIDGET =================================
+
+PlotWidget::PlotWidget(QWidget* parent) : QWidget(parent) {
+  logStart = 0.0;
+  logEnd = 0.0;
+  viewStart = 0.0;
+  viewEnd = 0.0;
+  dragging = false;
+  dragX = 0;
+  dragViewStart = 0.0;
+
+  this->setMinimumSize(400, 200);
+}
+
+void PlotWidget::setLevels(vector<LodReader*> levels) {
+  this->levels = levels;
+  this->channelMin.clear();
+  this->channelMax.clear();
+
+  if (levels.empty() || levels[0]->header.numRows == 0) {
+    return;
+  }
+
+  LodReader* finest = levels.front();
+  logStart = finest->time(0);
+  logEnd = finest->time(finest->header.numRows - 1);
+
+  // The coarsest level is small enough to scan entirely, and its min/max
+  // columns cover every full rate row
+  LodReader* coarsest = levels.back();
+  for (uint32_t chn = 0; chn < coarsest->header.numChannels; chn++) {
+    float low = 0.0f;
+    float high = 0.0f;
+    for (uint64_t row = 0; row < coarsest->header.numRows; row++) {
+      float rowMin = coarsest->value(coarsest->minCol(chn), row);
+      float rowMax = coarsest->value(coarsest->maxCol(chn), row);
+      low = (row == 0 || rowMin < low) ? rowMin : low;
+      high = (row == 0 || rowMax > high) ? rowMax : high;
+    }
+    channelMin.push_back(low);
+    channelMax.push_back(high);
+  }
+
+  resetView();
+}
+
+void PlotWidget::setChannels(QVector<int> channels) {
+  this->channels = channels;
+  update();
+}
+
+void PlotWidget::resetView() {
+  viewStart = logStart;
+  viewEnd = logEnd > logStart ? logEnd : logStart + VIEWER_MIN_SPAN;
+  update();
+}
+
+LodReader* PlotWidget::chooseLevel() {
+  uint64_t budget = (uint64_t) width() * VIEWER_ROWS_PER_PIXEL;
+  for (unsigned int i = 0; i < levels.size(); i++) {
+    uint64_t rows = levels[i]->lowerBound(viewEnd) - levels[i]->lowerBound(viewStart);
+    if (rows <= budget) {
+      return levels[i];
+    }
+  }
+  return levels.back();
+}
+
+void PlotWidget::paintEvent(QPaintEvent*) {
+  QPainter painter(this);
+  painter.fillRect(rect(), Qt::white);
+
+  if (levels.empty() || channels.empty() || levels[0]->header.numRows == 0) {
+    painter.setPen(Qt::black);
+    painter.drawText(rect(), Qt::AlignCenter, "No channels selected.");
+    return;
+  }
+
+  LodReader* level = chooseLevel();
+  int plotHeight = height() - VIEWER_AXIS_HEIGHT;
+  int lane = plotHeight / channels.size();
+
+  for (int i = 0; i < channels.size(); i++) {
+    int top = i * lane;
+    painter.setPen(Qt::lightGray);
+    painter.drawLine(0, top + lane - 1, width(), top + lane - 1);
+    drawChannel(painter, level, channels[i], top, lane);
+  }
+
+  // Time axis and the level of detail currently in use
+  painter.setPen(Qt::black);
+  painter.drawLine(0, plotHeight, width(), plotHeight);
+  painter.drawText(QRect(4, plotHeight, width() - 8, VIEWER_AXIS_HEIGHT),
+      Qt::AlignLeft | Qt::AlignVCenter, QString("%1 s").arg(viewStart, 0, 'f', 3));
+  painter.drawText(QRect(4, plotHeight, width() - 8, VIEWER_AXIS_HEIGHT),
+      Qt::AlignRight | Qt::AlignVCenter, QString("%1 s").arg(viewEnd, 0, 'f', 3));
+  painter.drawText(QRect(4, plotHeight, width() - 8, VIEWER_AXIS_HEIGHT),
+      Qt::AlignCenter, QString("1:%1").arg(level->header.factor));
+}
+
+void PlotWidget::drawChannel(QPainter& painter, LodReader* level, int chn,
+    int top, int lane) {
+  int w = width();
+  double span = viewEnd - viewStart;
+  pixelMin.assign(w, 0.0f);
+  pixelMax.assign(w, 0.0f);
+  vector<bool> pixelSet(w, false);
+
+  // Include one row either side of the visible range so lines reach the edges
+  uint64_t first = level->lowerBound(viewStart);
+  uint64_t last = level->lowerBound(viewEnd);
+  first = first > 0 ? first - 1 : first;
+  last = last < level->header.numRows ? last + 1 : last;
+
+  uint32_t colMin = level->minCol(chn);
+  uint32_t colMax = level->maxCol(chn);
+  for (uint64_t row = first; row < last; row++) {
+    int px = (int) ((level->time(row) - viewStart) / span * w);
+    px = px < 0 ? 0 : (px >= w ? w - 1 : px);
+
+    float rowMin = level->value(colMin, row);
+    float rowMax = level->value(colMax, row);
+    if (!pixelSet[px]) {
+      pixelSet[px] = true;
+      pixelMin[px] = rowMin;
+      pixelMax[px] = rowMax;
+    } else {
+      pixelMin[px] = rowMin < pixelMin[px] ? rowMin : pixelMin[px];
+      pixelMax[px] = rowMax > pixelMax[px] ? rowMax : pixelMax[px];
+    }
+  }
+
+  // Scale the lane to the range of the channel over the entire log
+  float low = channelMin[chn];
+  float high = channelMax[chn];
+  double scale = high > low ? (lane - 8) / (double) (high - low) : 0.0;
+  int base = top + lane - 4;
+  int flat = top + lane / 2;
+
+  painter.setPen(QColor::fromHsv((chn * 47) % 360, 255, 200));
+  int prevX = -1;
+  int prevY = 0;
+  for (int px = 0; px < w; px++) {
+    if (!pixelSet[px]) {
+      continue;
+    }
+
+    int yMin = scale > 0.0 ? base - (int) ((pixelMin[px] - low) * scale) : flat;
+    int yMax = scale > 0.0 ? base - (int) ((pixelMax[px] - low) * scale) : flat;
+    if (prevX >= 0) {
+      painter.drawLine(prevX, prevY, px, yMin);
+    }
+    painter.drawLine(px, yMin, px, yMax);
+
+    prevX = px;
+    prevY = yMax;
+  }
+
+  painter.setPen(Qt::black);
+  painter.drawText(4, top + 14, QString("%1  [%2, %3]").arg(levels[0]->names[chn])
+      .arg(low, 0, 'g', 6).arg(high, 0, 'g', 6));
+}
+
+void PlotWidget::wheelEvent(QWheelEvent* e) {
+  // A log with a single timestamp has nothing to zoom into
+  if (levels.empty() || width() == 0 || logEnd <= logStart) {
+    return;
+  }
+
+  // Zoom about the time under the cursor
+  double span = viewEnd - viewStart;
+  double anchor = viewStart + span * e->x() / width();
+  double factor = e->angleDelta().y() > 0 ? 0.8 : 1.25;
+  double newSpan = span * factor;
+  newSpan = newSpan < VIEWER_MIN_SPAN ? VIEWER_MIN_SPAN : newSpan;
+  newSpan = newSpan > logEnd - logStart ? logEnd - logStart : newSpan;
+
+  viewStart = anchor - (anchor - viewStart) * newSpan / span;
+  viewStart = viewStart < logStart ? logStart : viewStart;
+  viewStart = viewStart + newSpan > logEnd ? logEnd - newSpan : viewStart;
+  viewEnd = viewStart + newSpan;
+
+  e->accept();
+  update();
+}
+
+void PlotWidget::mousePressEvent(QMouseEvent* e) {
+  if (e->button() == Qt::LeftButton) {
+    dragging = true;
+    dragX = e->x();
+    dragViewStart = viewStart;
+  }
+}
+
+void PlotWidget::mouseMoveEvent(QMouseEvent* e) {
+  if (!dragging || width() == 0 || logEnd <= logStart) {
+    return;
+  }
+
+  double span = viewEnd - viewStart;
+  viewStart = dragViewStart + (dragX - e->x()) * span / width();
+  viewStart = viewStart + span > logEnd ? logEnd - span : viewStart;
+  viewStart = viewStart < logStart ? logStart : viewStart;
+  viewEnd = viewStart + span;
+  update();
+}
+
+void PlotWidget::mouseReleaseEvent(QMouseEvent* e) {
+  if (e->button() == Qt::LeftButton) {
+    dragging = false;
+  }
+}
+
+void PlotWidget::mouseDoubleClickEvent(QMouseEvent*) {
+  resetView();
+}
+
+//================================ APP VIEWER ==================================
+
+AppViewer::AppViewer() : QWidget() {
+  layout = new QHBoxLayout();
+  layout_channels = new QVBoxLayout();
+
+  this->resize(VIEWER_WIDTH, VIEWER_HEIGHT);
+  this->setWindowTitle("Illini Motorsports CAN Translator - Log Viewer");
+  this->setAttribute(Qt::WA_DeleteOnClose);
+  this->setLayout(layout);
+
+  lbl_help = new QLabel();
+  lbl_help->setText("Scroll to zoom, drag to pan,\ndouble click to reset.\n[q] Close");
+  layout_channels->addWidget(lbl_help);
+
+  list_channels = new QListWidget();
+  list_channels->setMaximumWidth(260);
+  layout_channels->addWidget(list_channels, 1);
+
+  plot = new PlotWidget();
+
+  layout->addLayout(layout_channels);
+  layout->addWidget(plot, 1);
+
+  connect(list_channels, SIGNAL(itemChanged(QListWidgetItem*)), this, SLOT(updateChannels()));
+}
+
+AppViewer::~AppViewer() {
+  for (unsigned int i = 0; i < levels.size(); i++) {
+    delete levels[i];
+  }
+}
+
+bool AppViewer::open(QString filename) {
+  QString suffix = QString(".lod%1").arg(LOD_FACTORS[0]);
+  if (!filename.endsWith(suffix)) {
+    return false;
+  }
+  QString base = filename.left(filename.length() - suffix.length());
+
+  for (int i = 0; i < LOD_NUM_LEVELS; i++) {
+    LodReader* level = new LodReader();
+    if (!level->open(base + QString(".lod%1").arg(LOD_FACTORS[i]))) {
+      delete level;
+      return false;
+    }
+    levels.push_back(level);
+  }
+
+  for (int i = 1; i < LOD_NUM_LEVELS; i++) {
+    if (levels[i]->header.numChannels != levels[0]->header.numChannels) {
+      return false;
+    }
+  }
+
+  this->setWindowTitle(QString("Illini Motorsports CAN Translator - %1").arg(base));
+  plot->setLevels(levels);
+
+  list_channels->clear();
+  for (int i = 0; i < levels[0]->names.size(); i++) {
+    QListWidgetItem* item = new QListWidgetItem(levels[0]->names[i]);
+    item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+    item->setCheckState(Qt::Unchecked);
+    list_channels->addItem(item);
+  }
+
+  return true;
+}
+
+void AppViewer::updateChannels() {
+  QVector<int> channels;
+  for (int i = 0; i < list_channels->count(); i++) {
+    if (list_channels->item(i)->checkState() == Qt::Checked) {
+      channels.push_back(i);
+    }
+  }
+  plot->setChannels(channels);
+}
+
+void AppViewer::keyPressEvent(QKeyEvent* e) {
+  // Closes the viewer.
+  if (e->text() == "q") {
+    this->close();
+  }
+}
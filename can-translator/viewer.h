@@ -0,0 +1,148 @@
+/**
+ * @file viewer.h
+ * Time-series viewer for converted logfiles.
+ *
+ * @date Created: 2026-10-18
+ * @date Modified: 2026-10-18
+ */
+#ifndef VIEWER_H
+#define VIEWER_H
+
+#include <vector>
+#include <QPen>
+#include <QLabel>
+#include <QWidget>
+#include <QPainter>
+#include <QKeyEvent>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QListWidget>
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QWheelEvent>
+#include "lod.h"
+
+using std::vector;
+
+#define VIEWER_WIDTH 1400
+#define VIEWER_HEIGHT 720
+
+// Maximum number of rows read per pixel column before switching to a coarser
+// level of detail. Keeps the cost of a repaint independent of the log length.
+#define VIEWER_ROWS_PER_PIXEL 4
+
+/**
+ * Widget which plots the selected channels of a set of level of detail files
+ * in stacked lanes. Each repaint picks the finest level that has at most
+ * VIEWER_ROWS_PER_PIXEL rows per pixel in the visible range, and reduces those
+ * rows to one min/max pair per pixel column.
+ */
+class PlotWidget : public QWidget {
+  Q_OBJECT
+
+  public:
+
+    PlotWidget(QWidget* parent = 0);
+
+    /**
+     * Sets the levels of detail to plot from, ordered finest first.
+     */
+    void setLevels(vector<LodReader*> levels);
+
+    /**
+     * Sets the channels to plot, by index.
+     */
+    void setChannels(QVector<int> channels);
+
+    /**
+     * Zooms out to show the entire log.
+     */
+    void resetView();
+
+  protected:
+
+    void paintEvent(QPaintEvent* e);
+    void wheelEvent(QWheelEvent* e);
+    void mousePressEvent(QMouseEvent* e);
+    void mouseMoveEvent(QMouseEvent* e);
+    void mouseReleaseEvent(QMouseEvent* e);
+    void mouseDoubleClickEvent(QMouseEvent* e);
+
+  private:
+
+    /**
+     * Returns the finest level with few enough rows in the visible range.
+     */
+    LodReader* chooseLevel();
+
+    /**
+     * Draws a single channel into the lane <lane> pixels high at <top>.
+     */
+    void drawChannel(QPainter& painter, LodReader* level, int chn, int top, int lane);
+
+    vector<LodReader*> levels;
+    QVector<int> channels;
+
+    // Range of each channel over the entire log, used to scale its lane
+    vector<float> channelMin;
+    vector<float> channelMax;
+
+    // Scratch space holding the min/max of each pixel column
+    vector<float> pixelMin;
+    vector<float> pixelMax;
+
+    double logStart;
+    double logEnd;
+    double viewStart;
+    double viewEnd;
+
+    bool dragging;
+    int dragX;
+    double dragViewStart;
+};
+
+/**
+ * Window which lists the channels of a converted log and plots the selected
+ * ones. The log is read from the level of detail files written alongside it,
+ * which are memory mapped so only the visible ranges are loaded.
+ */
+class AppViewer : public QWidget {
+  Q_OBJECT
+
+  public:
+
+    AppViewer();
+    ~AppViewer();
+
+    /**
+     * Opens every level of detail file belonging to a converted log.
+     *
+     * @param filename The full rate (.lod1) file of the converted log.
+     * @returns Whether the log was opened successfully.
+     */
+    bool open(QString filename);
+
+  protected:
+
+    void keyPressEvent(QKeyEvent* e);
+
+  private slots:
+
+    /**
+     * Called when a channel is checked or unchecked in the channel list.
+     */
+    void updateChannels();
+
+  private:
+
+    vector<LodReader*> levels;
+
+    QHBoxLayout* layout;
+    QVBoxLayout* layout_channels;
+
+    QLabel* lbl_help;
+    QListWidget* list_channels;
+    PlotWidget* plot;
+};
+
+#endif // VIEWER_H